@@ -0,0 +1,527 @@
+/**
+ *
+ *  @file bench_common.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_ASYNC_BENCH_COMMON_HPP
+#define VIX_ASYNC_BENCH_COMMON_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <vix/async/core/io_context.hpp>
+#include <vix/async/core/scheduler.hpp>
+#include <vix/async/core/task.hpp>
+#include <vix/async/version.hpp>
+
+namespace vix::async::bench
+{
+  /**
+   * @brief Clock used by all benchmarks.
+   */
+  using clock = std::chrono::steady_clock;
+
+  /**
+   * @brief Nanoseconds elapsed since @p from.
+   *
+   * @param from Start time.
+   * @return Elapsed nanoseconds.
+   */
+  inline std::uint64_t elapsed_ns(clock::time_point from) noexcept
+  {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - from).count());
+  }
+
+  /**
+   * @brief Seconds elapsed since @p from.
+   *
+   * @param from Start time.
+   * @return Elapsed seconds.
+   */
+  inline double seconds_since(clock::time_point from) noexcept
+  {
+    return std::chrono::duration<double>(clock::now() - from).count();
+  }
+
+  /**
+   * @brief Keep the optimizer from discarding a computed value.
+   *
+   * @tparam T Value type.
+   * @param v Value to keep alive.
+   */
+  template <typename T>
+  inline void do_not_optimize(const T &v) noexcept
+  {
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(v) : "memory");
+#else
+    static volatile const void *sink;
+    sink = &v;
+#endif
+  }
+
+  /**
+   * @brief Latency summary computed from raw samples.
+   */
+  struct latency_summary
+  {
+    std::uint64_t count{0};
+    double mean{0.0};
+    std::uint64_t min{0};
+    std::uint64_t p50{0};
+    std::uint64_t p90{0};
+    std::uint64_t p99{0};
+    std::uint64_t p999{0};
+    std::uint64_t max{0};
+  };
+
+  /**
+   * @brief Nearest-rank percentile of sorted samples.
+   *
+   * @param sorted Samples in ascending order (non-empty).
+   * @param q Quantile in [0, 1].
+   * @return Sample at that rank.
+   */
+  inline std::uint64_t percentile(const std::vector<std::uint64_t> &sorted, double q) noexcept
+  {
+    const double pos = q * static_cast<double>(sorted.size() - 1);
+    return sorted[static_cast<std::size_t>(pos + 0.5)];
+  }
+
+  /**
+   * @brief Summarize latency samples (sorts a copy).
+   *
+   * @param samples Raw samples in nanoseconds.
+   * @return Summary; all zero when empty.
+   */
+  inline latency_summary summarize(std::vector<std::uint64_t> samples)
+  {
+    latency_summary s;
+    if (samples.empty())
+    {
+      return s;
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    double sum = 0.0;
+    for (const auto v : samples)
+    {
+      sum += static_cast<double>(v);
+    }
+
+    s.count = samples.size();
+    s.mean = sum / static_cast<double>(samples.size());
+    s.min = samples.front();
+    s.p50 = percentile(samples, 0.50);
+    s.p90 = percentile(samples, 0.90);
+    s.p99 = percentile(samples, 0.99);
+    s.p999 = percentile(samples, 0.999);
+    s.max = samples.back();
+    return s;
+  }
+
+  /**
+   * @brief One benchmark result.
+   */
+  struct result
+  {
+    /** @brief Benchmark name, dot-separated (e.g. "scheduler.post_fn.mp4"). */
+    std::string name;
+
+    /** @brief Operations performed in the timed region. */
+    std::uint64_t ops{0};
+
+    /** @brief Duration of the timed region in seconds. */
+    double seconds{0.0};
+
+    /** @brief Latency distribution (per op, or per batch; see unit). */
+    latency_summary latency{};
+
+    /** @brief What one latency sample measures (e.g. "op", "batch/op"). */
+    std::string latency_unit{"op"};
+
+    /** @brief Free-form numeric parameters (threads, sizes, ...). */
+    std::map<std::string, double> params{};
+
+    /** @brief Free-form numeric extra metrics. */
+    std::map<std::string, double> extra{};
+
+    /**
+     * @brief Throughput of the timed region.
+     *
+     * @return Operations per second.
+     */
+    double ops_per_sec() const noexcept
+    {
+      return seconds > 0.0 ? static_cast<double>(ops) / seconds : 0.0;
+    }
+  };
+
+  /**
+   * @brief Write a string as a JSON string literal.
+   *
+   * @param os Output stream.
+   * @param s String to write.
+   */
+  inline void write_json_string(std::ostream &os, std::string_view s)
+  {
+    os << '"';
+    for (const char c : s)
+    {
+      if (c == '"' || c == '\\')
+      {
+        os << '\\' << c;
+      }
+      else if (static_cast<unsigned char>(c) < 0x20)
+      {
+        os << ' ';
+      }
+      else
+      {
+        os << c;
+      }
+    }
+    os << '"';
+  }
+
+  /**
+   * @brief Write a map of numbers as a JSON object.
+   *
+   * @param os Output stream.
+   * @param m Values.
+   */
+  inline void write_json_numbers(std::ostream &os, const std::map<std::string, double> &m)
+  {
+    os << '{';
+    bool first = true;
+    for (const auto &[k, v] : m)
+    {
+      if (!first)
+      {
+        os << ',';
+      }
+      first = false;
+      write_json_string(os, k);
+      os << ':' << v;
+    }
+    os << '}';
+  }
+
+  /**
+   * @brief Write all results as one JSON document.
+   *
+   * @param os Output stream.
+   * @param suite Suite name.
+   * @param results Results to write.
+   */
+  inline void write_json(std::ostream &os, std::string_view suite, const std::vector<result> &results)
+  {
+    os << "{\"suite\":";
+    write_json_string(os, suite);
+    os << ",\"version\":";
+    write_json_string(os, ::vix::async::version_string);
+    os << ",\"results\":[";
+
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+      const result &r = results[i];
+      const latency_summary &l = r.latency;
+
+      os << (i == 0 ? "\n" : ",\n");
+      os << "{\"name\":";
+      write_json_string(os, r.name);
+      os << ",\"ops\":" << r.ops
+         << ",\"seconds\":" << r.seconds
+         << ",\"ops_per_sec\":" << r.ops_per_sec()
+         << ",\"latency_ns\":{\"unit\":";
+      write_json_string(os, r.latency_unit);
+      os << ",\"count\":" << l.count
+         << ",\"mean\":" << l.mean
+         << ",\"min\":" << l.min
+         << ",\"p50\":" << l.p50
+         << ",\"p90\":" << l.p90
+         << ",\"p99\":" << l.p99
+         << ",\"p999\":" << l.p999
+         << ",\"max\":" << l.max
+         << "},\"params\":";
+      write_json_numbers(os, r.params);
+      os << ",\"extra\":";
+      write_json_numbers(os, r.extra);
+      os << '}';
+    }
+
+    os << "\n]}\n";
+  }
+
+  /**
+   * @brief Command line options shared by the bench executables.
+   */
+  struct options
+  {
+    /** @brief Only run benchmarks whose name contains this string. */
+    std::string filter{};
+
+    /** @brief Write JSON to this file instead of stdout. */
+    std::string out{};
+
+    /** @brief Scale factor applied to iteration counts. */
+    double scale{1.0};
+
+    /**
+     * @brief Scale an iteration count.
+     *
+     * @param n Nominal count.
+     * @return Scaled count, at least 1.
+     */
+    std::uint64_t n(std::uint64_t nominal) const noexcept
+    {
+      const auto v = static_cast<std::uint64_t>(static_cast<double>(nominal) * scale);
+      return v == 0 ? 1 : v;
+    }
+
+    /**
+     * @brief Whether a benchmark is selected by the filter.
+     *
+     * @param name Benchmark name.
+     * @return true if it should run.
+     */
+    bool selected(std::string_view name) const noexcept
+    {
+      return filter.empty() || name.find(filter) != std::string_view::npos;
+    }
+  };
+
+  /**
+   * @brief Parse a comma-separated list of positive integers ("1,8,64").
+   *
+   * @param s List text; zero and malformed items are skipped.
+   * @return Parsed values.
+   */
+  inline std::vector<std::size_t> parse_list(std::string_view s)
+  {
+    std::vector<std::size_t> v;
+    while (!s.empty())
+    {
+      const auto comma = s.find(',');
+      const std::string item(s.substr(0, comma));
+      const auto x = std::strtoull(item.c_str(), nullptr, 10);
+      if (x > 0)
+      {
+        v.push_back(static_cast<std::size_t>(x));
+      }
+      if (comma == std::string_view::npos)
+      {
+        break;
+      }
+      s.remove_prefix(comma + 1);
+    }
+    return v;
+  }
+
+  /**
+   * @brief Parse --filter=, --out= and --scale= (or --quick) arguments.
+   *
+   * @param argc Argument count.
+   * @param argv Arguments.
+   * @return Parsed options.
+   */
+  inline options parse_options(int argc, char **argv)
+  {
+    options o;
+
+    for (int i = 1; i < argc; ++i)
+    {
+      const std::string_view a(argv[i]);
+
+      if (a.rfind("--filter=", 0) == 0)
+      {
+        o.filter = std::string(a.substr(9));
+      }
+      else if (a.rfind("--out=", 0) == 0)
+      {
+        o.out = std::string(a.substr(6));
+      }
+      else if (a.rfind("--scale=", 0) == 0)
+      {
+        o.scale = std::strtod(std::string(a.substr(8)).c_str(), nullptr);
+        if (o.scale <= 0.0)
+        {
+          o.scale = 1.0;
+        }
+      }
+      else if (a == "--quick")
+      {
+        o.scale = 0.05;
+      }
+      else if (a == "--help" || a == "-h")
+      {
+        std::cerr << "usage: " << argv[0]
+                  << " [--filter=<substr>] [--out=<file.json>] [--scale=<x>|--quick]\n";
+        std::exit(0);
+      }
+    }
+
+    return o;
+  }
+
+  /**
+   * @brief Emit results to stdout or the --out file; progress goes to stderr.
+   *
+   * @param o Options.
+   * @param suite Suite name.
+   * @param results Results.
+   * @return Process exit code.
+   */
+  inline int emit(const options &o, std::string_view suite, const std::vector<result> &results)
+  {
+    if (o.out.empty())
+    {
+      write_json(std::cout, suite, results);
+      return 0;
+    }
+
+    std::ofstream f(o.out, std::ios::trunc);
+    if (!f)
+    {
+      std::cerr << "cannot write " << o.out << "\n";
+      return 1;
+    }
+
+    write_json(f, suite, results);
+    return f ? 0 : 1;
+  }
+
+  /**
+   * @brief Print a one-line human summary of a result to stderr.
+   *
+   * @param r Result.
+   */
+  inline void print_progress(const result &r)
+  {
+    char line[256];
+    std::snprintf(
+        line,
+        sizeof(line),
+        "%-44s %14.0f ops/s  p50 %9llu ns  p99 %9llu ns\n",
+        r.name.c_str(),
+        r.ops_per_sec(),
+        static_cast<unsigned long long>(r.latency.p50),
+        static_cast<unsigned long long>(r.latency.p99));
+    std::cerr << line;
+  }
+
+  /**
+   * @brief Runs ctx.run() on a background thread for the lifetime of the object.
+   */
+  struct loop_thread
+  {
+    /** @brief Context driven by the thread. */
+    core::io_context &ctx;
+
+    /** @brief Thread running ctx.run(). */
+    std::thread t;
+
+    /**
+     * @brief Start running @p c on a new thread.
+     *
+     * @param c Context to run.
+     */
+    explicit loop_thread(core::io_context &c)
+        : ctx(c),
+          t([this]()
+            { ctx.run(); })
+    {
+    }
+
+    /**
+     * @brief Stop the context and join the thread.
+     */
+    ~loop_thread()
+    {
+      ctx.stop();
+      if (t.joinable())
+      {
+        t.join();
+      }
+    }
+
+    loop_thread(const loop_thread &) = delete;
+    loop_thread &operator=(const loop_thread &) = delete;
+  };
+
+  /**
+   * @brief Start a task on a running scheduler and block until it completes.
+   *
+   * @param sched Scheduler whose run() is active on another thread.
+   * @param t Task to run.
+   *
+   * @throws Whatever the task throws.
+   */
+  inline void sync_wait(core::scheduler &sched, core::task<void> t)
+  {
+    auto p = std::make_shared<std::promise<void>>();
+    auto fut = p->get_future();
+
+    auto wrapper = [](std::shared_ptr<std::promise<void>> done, core::task<void> inner) -> core::task<void>
+    {
+      try
+      {
+        co_await inner;
+        done->set_value();
+      }
+      catch (...)
+      {
+        done->set_exception(std::current_exception());
+      }
+    };
+
+    std::move(wrapper(p, std::move(t))).start(sched);
+    fut.get();
+  }
+
+  /**
+   * @brief Spin (yielding) until @p counter reaches @p target.
+   *
+   * @param counter Counter incremented by other threads.
+   * @param target Value to wait for.
+   */
+  inline void wait_for(const std::atomic<std::uint64_t> &counter, std::uint64_t target)
+  {
+    while (counter.load(std::memory_order_acquire) < target)
+    {
+      std::this_thread::yield();
+    }
+  }
+
+} // namespace vix::async::bench
+
+#endif // VIX_ASYNC_BENCH_COMMON_HPP
@@ -0,0 +1,996 @@
+/**
+ *
+ *  @file core_bench.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include "bench_common.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <vix/async/core/arena.hpp>
+#include <vix/async/core/broadcast.hpp>
+#include <vix/async/core/cancel.hpp>
+#include <vix/async/core/io_context.hpp>
+#include <vix/async/core/scheduler.hpp>
+#include <vix/async/core/shared_mutex.hpp>
+#include <vix/async/core/spsc_queue.hpp>
+#include <vix/async/core/task.hpp>
+#include <vix/async/core/thread_pool.hpp>
+#include <vix/async/core/timer.hpp>
+#include <vix/async/core/when.hpp>
+#include <vix/async/detail/scan.hpp>
+
+using namespace vix::async;
+using namespace vix::async::bench;
+
+namespace
+{
+  /**
+   * Samples recorded per op are grouped into batches when a single op is
+   * shorter than the cost of reading the clock.
+   */
+  constexpr std::uint64_t batch_size = 64;
+
+  core::task<int> leaf(int v)
+  {
+    co_return v;
+  }
+
+  core::task<int> leaf_in(core::request_arena &, int v)
+  {
+    co_return v;
+  }
+
+  // ------------------------------------------------------------------
+  // scheduler
+  // ------------------------------------------------------------------
+
+  /**
+   * Post callables from @p producers threads; every callable records its
+   * post-to-run latency.
+   */
+  result bench_post_fn(const options &o, std::size_t producers)
+  {
+    const std::uint64_t per_producer = o.n(1'000'000) / producers;
+    const std::uint64_t total = per_producer * producers;
+
+    core::io_context ctx;
+    auto &sched = ctx.get_scheduler();
+
+    std::vector<std::uint64_t> samples(total);
+    std::atomic<std::uint64_t> done{0};
+
+    loop_thread loop(ctx);
+
+    const auto t0 = clock::now();
+
+    std::vector<std::thread> threads;
+    threads.reserve(producers);
+    for (std::size_t p = 0; p < producers; ++p)
+    {
+      threads.emplace_back(
+          [&, p]()
+          {
+            const std::uint64_t base = p * per_producer;
+            for (std::uint64_t i = 0; i < per_producer; ++i)
+            {
+              const auto posted = clock::now();
+              sched.post(
+                  [&samples, &done, posted, slot = base + i]()
+                  {
+                    samples[slot] = elapsed_ns(posted);
+                    done.fetch_add(1, std::memory_order_release);
+                  });
+            }
+          });
+    }
+
+    for (auto &t : threads)
+    {
+      t.join();
+    }
+    wait_for(done, total);
+
+    result r;
+    r.name = producers == 1 ? "scheduler.post_fn.sp" : "scheduler.post_fn.mp" + std::to_string(producers);
+    r.ops = total;
+    r.seconds = seconds_since(t0);
+    r.latency = summarize(std::move(samples));
+    r.latency_unit = "post_to_run";
+    r.params["producers"] = static_cast<double>(producers);
+    return r;
+  }
+
+  /**
+   * @p concurrency coroutines each hop onto the scheduler repeatedly through
+   * schedule(); every hop is one handle post plus one resume.
+   */
+  result bench_resume(const options &o, std::size_t concurrency)
+  {
+    const std::uint64_t per_task = o.n(1'000'000) / concurrency;
+    const std::uint64_t total = per_task * concurrency;
+
+    core::io_context ctx;
+    auto &sched = ctx.get_scheduler();
+
+    std::vector<std::uint64_t> samples;
+    samples.reserve(total / batch_size + concurrency);
+    std::atomic<std::uint64_t> done{0};
+
+    auto hopper = [](core::scheduler &s, std::uint64_t n, std::vector<std::uint64_t> *out, std::atomic<std::uint64_t> *finished) -> core::task<void>
+    {
+      co_await s.schedule();
+      auto batch_start = clock::now();
+      for (std::uint64_t i = 1; i <= n; ++i)
+      {
+        co_await s.schedule();
+        if (i % batch_size == 0)
+        {
+          // All hoppers run on the scheduler thread: no lock needed.
+          out->push_back(elapsed_ns(batch_start) / batch_size);
+          batch_start = clock::now();
+        }
+      }
+      finished->fetch_add(1, std::memory_order_release);
+    };
+
+    loop_thread loop(ctx);
+
+    const auto t0 = clock::now();
+    for (std::size_t c = 0; c < concurrency; ++c)
+    {
+      hopper(sched, per_task, &samples, &done).start(sched);
+    }
+    wait_for(done, concurrency);
+
+    result r;
+    r.name = concurrency == 1 ? "scheduler.resume.c1" : "scheduler.resume.c" + std::to_string(concurrency);
+    r.ops = total;
+    r.seconds = seconds_since(t0);
+    r.latency = summarize(std::move(samples));
+    r.latency_unit = "batch_mean";
+    r.params["concurrency"] = static_cast<double>(concurrency);
+    return r;
+  }
+
+  // ------------------------------------------------------------------
+  // task
+  // ------------------------------------------------------------------
+
+  /**
+   * Create a child task and await it inline (symmetric transfer, no
+   * scheduler round trip). With @p arena, the child frames come from a
+   * request_arena instead of the global heap.
+   */
+  result bench_task_await(const options &o, bool arena)
+  {
+    const std::uint64_t total = o.n(5'000'000);
+
+    core::io_context ctx;
+    auto &sched = ctx.get_scheduler();
+    loop_thread loop(ctx);
+
+    std::vector<std::uint64_t> samples;
+    samples.reserve(total / batch_size + 1);
+    double seconds = 0.0;
+
+    auto body = [arena](std::uint64_t n, std::vector<std::uint64_t> *out, double *secs) -> core::task<void>
+    {
+      core::request_arena frames;
+      std::uint64_t sum = 0;
+      const auto t0 = clock::now();
+      auto batch_start = t0;
+      for (std::uint64_t i = 1; i <= n; ++i)
+      {
+        const int v = static_cast<int>(i & 0xff);
+        if (arena)
+        {
+          sum += static_cast<std::uint64_t>(co_await leaf_in(frames, v));
+        }
+        else
+        {
+          sum += static_cast<std::uint64_t>(co_await leaf(v));
+        }
+        if (i % batch_size == 0)
+        {
+          out->push_back(elapsed_ns(batch_start) / batch_size);
+          batch_start = clock::now();
+        }
+      }
+      *secs = seconds_since(t0);
+      do_not_optimize(sum);
+    };
+
+    sync_wait(sched, body(total, &samples, &seconds));
+
+    result r;
+    r.name = arena ? "task.create_await.arena" : "task.create_await";
+    r.ops = total;
+    r.seconds = seconds;
+    r.latency = summarize(std::move(samples));
+    r.latency_unit = "batch_mean";
+    return r;
+  }
+
+  /**
+   * Create a task and destroy it without running it (frame allocation and
+   * promise construction only).
+   */
+  result bench_task_create(const options &o)
+  {
+    const std::uint64_t total = o.n(5'000'000);
+
+    std::vector<std::uint64_t> samples;
+    samples.reserve(total / batch_size + 1);
+
+    const auto t0 = clock::now();
+    auto batch_start = t0;
+    for (std::uint64_t i = 1; i <= total; ++i)
+    {
+      auto t = leaf(static_cast<int>(i));
+      do_not_optimize(t);
+      if (i % batch_size == 0)
+      {
+        samples.push_back(elapsed_ns(batch_start) / batch_size);
+        batch_start = clock::now();
+      }
+    }
+
+    result r;
+    r.name = "task.create_destroy";
+    r.ops = total;
+    r.seconds = seconds_since(t0);
+    r.latency = summarize(std::move(samples));
+    r.latency_unit = "batch_mean";
+    return r;
+  }
+
+  // ------------------------------------------------------------------
+  // when_all
+  // ------------------------------------------------------------------
+
+  template <std::size_t... Is>
+  core::task<void> fan_out(core::scheduler &sched, std::index_sequence<Is...>)
+  {
+    auto results = co_await core::when_all(sched, leaf(static_cast<int>(Is))...);
+    do_not_optimize(results);
+  }
+
+  /**
+   * Await when_all over N immediately-ready children; each child runner is
+   * started through the scheduler.
+   */
+  template <std::size_t N>
+  result bench_when_all(const options &o)
+  {
+    const std::uint64_t total = o.n(200'000);
+
+    core::io_context ctx;
+    auto &sched = ctx.get_scheduler();
+    loop_thread loop(ctx);
+
+    std::vector<std::uint64_t> samples;
+    samples.reserve(total);
+    double seconds = 0.0;
+
+    auto body = [](core::scheduler &s, std::uint64_t n, std::vector<std::uint64_t> *out, double *secs) -> core::task<void>
+    {
+      const auto t0 = clock::now();
+      for (std::uint64_t i = 0; i < n; ++i)
+      {
+        const auto start = clock::now();
+        co_await fan_out(s, std::make_index_sequence<N>{});
+        out->push_back(elapsed_ns(start));
+      }
+      *secs = seconds_since(t0);
+    };
+
+    sync_wait(sched, body(sched, total, &samples, &seconds));
+
+    result r;
+    r.name = "when_all.fanout" + std::to_string(N);
+    r.ops = total;
+    r.seconds = seconds;
+    r.latency = summarize(std::move(samples));
+    r.params["children"] = static_cast<double>(N);
+    r.extra["children_per_sec"] = r.ops_per_sec() * static_cast<double>(N);
+    return r;
+  }
+
+  // ------------------------------------------------------------------
+  // broadcast
+  // ------------------------------------------------------------------
+
+  /**
+   * One broadcast send to 1000 suspended subscribers, until every one of
+   * them has received it. The message is shared, not copied, and the
+   * wakeups go to the scheduler as a single batch.
+   */
+  result bench_broadcast(const options &o)
+  {
+    constexpr std::uint64_t subscribers = 1000;
+    const std::uint64_t total = o.n(20'000);
+
+    core::io_context ctx;
+    auto &sched = ctx.get_scheduler();
+    loop_thread loop(ctx);
+
+    std::vector<std::uint64_t> samples;
+    samples.reserve(total);
+    double seconds = 0.0;
+
+    using channel = core::broadcast<std::uint64_t>;
+
+    auto subscriber = [](channel::subscriber sub, std::uint64_t n, std::uint64_t *delivered) -> core::task<void>
+    {
+      for (std::uint64_t i = 0; i < n; ++i)
+      {
+        channel::message m = co_await sub.recv();
+        do_not_optimize(m);
+        ++*delivered;
+      }
+    };
+
+    auto body = [&subscriber](core::scheduler &s, std::uint64_t n, std::vector<std::uint64_t> *out, double *secs) -> core::task<void>
+    {
+      channel ch(s, 16);
+      std::uint64_t delivered = 0;
+      for (std::uint64_t i = 0; i < subscribers; ++i)
+      {
+        subscriber(ch.subscribe(), n, &delivered).start(s);
+      }
+      co_await s.schedule();
+
+      const auto t0 = clock::now();
+      for (std::uint64_t i = 0; i < n; ++i)
+      {
+        const auto start = clock::now();
+        ch.send(i);
+        while (delivered < (i + 1) * subscribers)
+        {
+          co_await s.schedule();
+        }
+        out->push_back(elapsed_ns(start));
+      }
+      *secs = seconds_since(t0);
+    };
+
+    sync_wait(sched, body(sched, total, &samples, &seconds));
+
+    result r;
+    r.name = "broadcast.fanout1000";
+    r.ops = total;
+    r.seconds = seconds;
+    r.latency = summarize(std::move(samples));
+    r.params["subscribers"] = static_cast<double>(subscribers);
+    r.extra["deliveries_per_sec"] = r.ops_per_sec() * static_cast<double>(subscribers);
+    return r;
+  }
+
+  // ------------------------------------------------------------------
+  // shared_mutex
+  // ------------------------------------------------------------------
+
+  /**
+   * co_await lock_shared() plus unlock_shared() with no writer around: one
+   * fetch_add and one fetch_sub, no suspension.
+   */
+  result bench_shared_mutex_read(const options &o)
+  {
+    const std::uint64_t total = o.n(20'000'000);
+
+    core::io_context ctx;
+    auto &sched = ctx.get_scheduler();
+    loop_thread loop(ctx);
+
+    double seconds = 0.0;
+
+    auto body = [](std::uint64_t n, double *secs) -> core::task<void>
+    {
+      core::async_shared_mutex m;
+      const auto t0 = clock::now();
+      for (std::uint64_t i = 0; i < n; ++i)
+      {
+        co_await m.lock_shared();
+        do_not_optimize(m);
+        m.unlock_shared();
+      }
+      *secs = seconds_since(t0);
+    };
+
+    sync_wait(sched, body(total, &seconds));
+
+    result r;
+    r.name = "shared_mutex.read_uncontended";
+    r.ops = total;
+    r.seconds = seconds;
+    r.latency.count = 1;
+    r.latency.mean = seconds * 1e9 / static_cast<double>(total);
+    r.latency_unit = "mean_only";
+    return r;
+  }
+
+  // ------------------------------------------------------------------
+  // spsc_queue
+  // ------------------------------------------------------------------
+
+  /**
+   * A plain thread pushes values in batches of 32; a coroutine on the
+   * io_context pops them with pop_batch(), suspending only when the ring
+   * runs dry.
+   */
+  result bench_spsc_handoff(const options &o)
+  {
+    constexpr std::size_t batch = 32;
+    const std::uint64_t total = o.n(20'000'000);
+
+    core::io_context ctx;
+    auto &sched = ctx.get_scheduler();
+    loop_thread loop(ctx);
+
+    core::spsc_queue<std::uint64_t> q(sched, 4096);
+    double seconds = 0.0;
+
+    auto body = [](core::spsc_queue<std::uint64_t> &queue, std::uint64_t n, double *secs) -> core::task<void>
+    {
+      std::array<std::uint64_t, batch> buf{};
+      std::uint64_t received = 0;
+      const auto t0 = clock::now();
+      while (received < n)
+      {
+        received += co_await queue.pop_batch(buf);
+        do_not_optimize(buf);
+      }
+      *secs = seconds_since(t0);
+    };
+
+    std::thread producer([&q, total]()
+                         {
+      std::array<std::uint64_t, batch> buf{};
+      std::uint64_t sent = 0;
+      while (sent < total)
+      {
+        const std::size_t want = total - sent < batch ? static_cast<std::size_t>(total - sent) : batch;
+        for (std::size_t i = 0; i < want; ++i)
+        {
+          buf[i] = sent + i;
+        }
+        const std::size_t n = q.try_push_batch(std::span<std::uint64_t>(buf.data(), want));
+        sent += n;
+        if (n == 0)
+        {
+          std::this_thread::yield();
+        }
+      } });
+
+    sync_wait(sched, body(q, total, &seconds));
+    producer.join();
+
+    result r;
+    r.name = "spsc_queue.handoff";
+    r.ops = total;
+    r.seconds = seconds;
+    r.latency.count = 1;
+    r.latency.mean = seconds * 1e9 / static_cast<double>(total);
+    r.latency_unit = "mean_only";
+    r.params["batch"] = static_cast<double>(batch);
+    return r;
+  }
+
+  // ------------------------------------------------------------------
+  // thread_pool
+  // ------------------------------------------------------------------
+
+  /**
+   * co_await thread_pool::submit() from the scheduler: enqueue, run on a
+   * worker, resume back on the scheduler.
+   */
+  result bench_pool_rtt(const options &o)
+  {
+    const std::uint64_t total = o.n(200'000);
+
+    core::io_context ctx;
+    auto &sched = ctx.get_scheduler();
+    auto &pool = ctx.cpu_pool();
+    loop_thread loop(ctx);
+
+    std::vector<std::uint64_t> samples;
+    samples.reserve(total);
+    double seconds = 0.0;
+
+    auto body = [](core::thread_pool &tp, std::uint64_t n, std::vector<std::uint64_t> *out, double *secs) -> core::task<void>
+    {
+      const auto t0 = clock::now();
+      for (std::uint64_t i = 0; i < n; ++i)
+      {
+        const auto start = clock::now();
+        const int v = co_await tp.submit([]()
+                                         { return 1; });
+        do_not_optimize(v);
+        out->push_back(elapsed_ns(start));
+      }
+      *secs = seconds_since(t0);
+    };
+
+    sync_wait(sched, body(pool, total, &samples, &seconds));
+
+    result r;
+    r.name = "thread_pool.submit.rtt";
+    r.ops = total;
+    r.seconds = seconds;
+    r.latency = summarize(std::move(samples));
+    return r;
+  }
+
+  /**
+   * Fire-and-forget submit(std::function) throughput from one producer;
+   * every job records its submit-to-run latency.
+   */
+  result bench_pool_submit(const options &o)
+  {
+    const std::uint64_t total = o.n(1'000'000);
+
+    core::io_context ctx;
+    auto &pool = ctx.cpu_pool();
+
+    std::vector<std::uint64_t> samples(total);
+    std::atomic<std::uint64_t> done{0};
+
+    const auto t0 = clock::now();
+    for (std::uint64_t i = 0; i < total; ++i)
+    {
+      const auto submitted = clock::now();
+      pool.submit(std::function<void()>(
+          [&samples, &done, submitted, i]()
+          {
+            samples[i] = elapsed_ns(submitted);
+            done.fetch_add(1, std::memory_order_release);
+          }));
+    }
+    wait_for(done, total);
+
+    result r;
+    r.name = "thread_pool.submit.fire_and_forget";
+    r.ops = total;
+    r.seconds = seconds_since(t0);
+    r.latency = summarize(std::move(samples));
+    r.latency_unit = "submit_to_run";
+    return r;
+  }
+
+  // ------------------------------------------------------------------
+  // timer
+  // ------------------------------------------------------------------
+
+  /**
+   * Insert far-future timers (never fire during the run).
+   */
+  result bench_timer_insert(const options &o)
+  {
+    const std::uint64_t total = o.n(500'000);
+
+    core::io_context ctx;
+    auto &timers = ctx.timers();
+
+    std::vector<std::uint64_t> samples;
+    samples.reserve(total / batch_size + 1);
+
+    const auto t0 = clock::now();
+    auto batch_start = t0;
+    for (std::uint64_t i = 1; i <= total; ++i)
+    {
+      timers.after(std::chrono::hours(1), []() {});
+      if (i % batch_size == 0)
+      {
+        samples.push_back(elapsed_ns(batch_start) / batch_size);
+        batch_start = clock::now();
+      }
+    }
+
+    result r;
+    r.name = "timer.insert";
+    r.ops = total;
+    r.seconds = seconds_since(t0);
+    r.latency = summarize(std::move(samples));
+    r.latency_unit = "batch_mean";
+    return r;
+  }
+
+  /**
+   * Insert timers whose token is cancelled before they expire and measure
+   * until the timer thread has skipped all of them. A trailing sentinel
+   * timer marks the end, since the queue is drained in deadline order.
+   */
+  result bench_timer_cancel(const options &o)
+  {
+    const std::uint64_t total = o.n(500'000);
+
+    core::io_context ctx;
+    auto &timers = ctx.timers();
+    loop_thread loop(ctx);
+
+    core::cancel_source cs;
+    std::atomic<std::uint64_t> done{0};
+
+    const auto t0 = clock::now();
+    const auto deadline = std::chrono::milliseconds(1);
+    for (std::uint64_t i = 0; i < total; ++i)
+    {
+      timers.after(deadline, []() {}, cs.token());
+    }
+    cs.request_cancel();
+
+    const auto cancelled_at = clock::now();
+    timers.after(std::chrono::milliseconds(2), [&done]()
+                 { done.fetch_add(1, std::memory_order_release); });
+    wait_for(done, 1);
+
+    result r;
+    r.name = "timer.insert_cancel";
+    r.ops = total;
+    r.seconds = seconds_since(t0);
+    r.latency = summarize({elapsed_ns(cancelled_at)});
+    r.latency_unit = "cancel_to_drained";
+    return r;
+  }
+
+  /**
+   * Insert already-due timers and measure fire throughput plus lateness
+   * (deadline to callback on the scheduler thread).
+   */
+  result bench_timer_fire(const options &o)
+  {
+    const std::uint64_t total = o.n(500'000);
+
+    core::io_context ctx;
+    auto &timers = ctx.timers();
+    loop_thread loop(ctx);
+
+    std::vector<std::uint64_t> samples(total);
+    std::atomic<std::uint64_t> done{0};
+
+    const auto t0 = clock::now();
+    for (std::uint64_t i = 0; i < total; ++i)
+    {
+      const auto due = clock::now();
+      timers.after(
+          std::chrono::nanoseconds(0),
+          [&samples, &done, due, i]()
+          {
+            samples[i] = elapsed_ns(due);
+            done.fetch_add(1, std::memory_order_release);
+          });
+    }
+    wait_for(done, total);
+
+    result r;
+    r.name = "timer.fire";
+    r.ops = total;
+    r.seconds = seconds_since(t0);
+    r.latency = summarize(std::move(samples));
+    r.latency_unit = "deadline_to_callback";
+    return r;
+  }
+
+  // ------------------------------------------------------------------
+  // cancel_token
+  // ------------------------------------------------------------------
+
+  /**
+   * Poll is_cancelled() on a live token: the cost paid by every cancellable
+   * loop iteration.
+   */
+  result bench_cancel_poll(const options &o)
+  {
+    const std::uint64_t total = o.n(50'000'000);
+
+    core::cancel_source cs;
+    const core::cancel_token ct = cs.token();
+
+    std::uint64_t hits = 0;
+    const auto t0 = clock::now();
+    for (std::uint64_t i = 0; i < total; ++i)
+    {
+      do_not_optimize(ct);
+      hits += ct.is_cancelled() ? 1u : 0u;
+    }
+    const double secs = seconds_since(t0);
+    do_not_optimize(hits);
+
+    result r;
+    r.name = "cancel.is_cancelled";
+    r.ops = total;
+    r.seconds = secs;
+    r.latency.count = 1;
+    r.latency.mean = secs * 1e9 / static_cast<double>(total);
+    r.latency_unit = "mean_only";
+    return r;
+  }
+
+  /**
+   * Create a cancel_source and take a token from it (shared state
+   * allocation plus refcount traffic).
+   */
+  result bench_cancel_source(const options &o)
+  {
+    const std::uint64_t total = o.n(5'000'000);
+
+    std::vector<std::uint64_t> samples;
+    samples.reserve(total / batch_size + 1);
+
+    const auto t0 = clock::now();
+    auto batch_start = t0;
+    for (std::uint64_t i = 1; i <= total; ++i)
+    {
+      core::cancel_source cs;
+      core::cancel_token ct = cs.token();
+      do_not_optimize(ct);
+      if (i % batch_size == 0)
+      {
+        samples.push_back(elapsed_ns(batch_start) / batch_size);
+        batch_start = clock::now();
+      }
+    }
+
+    result r;
+    r.name = "cancel.source_token";
+    r.ops = total;
+    r.seconds = seconds_since(t0);
+    r.latency = summarize(std::move(samples));
+    r.latency_unit = "batch_mean";
+    return r;
+  }
+
+  /**
+   * submit() round trip with a live token, to compare against
+   * thread_pool.submit.rtt (which passes an empty token).
+   */
+  result bench_cancel_submit(const options &o)
+  {
+    const std::uint64_t total = o.n(200'000);
+
+    core::io_context ctx;
+    auto &sched = ctx.get_scheduler();
+    auto &pool = ctx.cpu_pool();
+    loop_thread loop(ctx);
+
+    core::cancel_source cs;
+    std::vector<std::uint64_t> samples;
+    samples.reserve(total);
+    double seconds = 0.0;
+
+    auto body = [](core::thread_pool &tp, core::cancel_token ct, std::uint64_t n, std::vector<std::uint64_t> *out, double *secs) -> core::task<void>
+    {
+      const auto t0 = clock::now();
+      for (std::uint64_t i = 0; i < n; ++i)
+      {
+        const auto start = clock::now();
+        const int v = co_await tp.submit([]()
+                                         { return 1; },
+                                         ct);
+        do_not_optimize(v);
+        out->push_back(elapsed_ns(start));
+      }
+      *secs = seconds_since(t0);
+    };
+
+    sync_wait(sched, body(pool, cs.token(), total, &samples, &seconds));
+
+    result r;
+    r.name = "cancel.submit_with_token.rtt";
+    r.ops = total;
+    r.seconds = seconds;
+    r.latency = summarize(std::move(samples));
+    return r;
+  }
+
+  // ------------------------------------------------------------------
+  // delimiter scanning
+  // ------------------------------------------------------------------
+
+  /**
+   * About 1 MiB of line-oriented input and the delimiter that splits it.
+   */
+  struct scan_corpus
+  {
+    std::string text;
+    std::string delimiter;
+    std::size_t records{0};
+  };
+
+  constexpr std::size_t scan_corpus_size = 1 << 20;
+
+  std::string random_text(std::mt19937 &rng, std::size_t n)
+  {
+    static constexpr std::string_view chars = "abcdefghijklmnopqrstuvwxyz0123456789 =:/.-_";
+    std::string out(n, ' ');
+    for (auto &c : out)
+    {
+      c = chars[rng() % chars.size()];
+    }
+    return out;
+  }
+
+  /**
+   * "log": 80-120 byte lines split on "\n". "http_lines" / "http_heads":
+   * request heads of ~10 header lines, split on "\r\n" or "\r\n\r\n".
+   * "long": 4 KiB lines split on "\n".
+   */
+  scan_corpus make_scan_corpus(std::string_view kind)
+  {
+    std::mt19937 rng(42);
+    scan_corpus c;
+    c.delimiter = kind == "http_lines" ? "\r\n" : kind == "http_heads" ? "\r\n\r\n"
+                                                                          : "\n";
+    while (c.text.size() < scan_corpus_size)
+    {
+      if (kind == "log")
+      {
+        c.text += random_text(rng, 80 + rng() % 41);
+        c.text += '\n';
+      }
+      else if (kind == "long")
+      {
+        c.text += random_text(rng, 4096);
+        c.text += '\n';
+      }
+      else
+      {
+        c.text += "GET /" + random_text(rng, 8 + rng() % 40) + " HTTP/1.1\r\n";
+        for (int h = 0; h < 9; ++h)
+        {
+          c.text += "X-Header-" + std::to_string(h) + ": " + random_text(rng, 10 + rng() % 50) + "\r\n";
+        }
+        c.text += "\r\n";
+      }
+    }
+
+    for (std::size_t pos = 0; (pos = detail::find(c.text, c.delimiter, pos)) != std::string::npos; pos += c.delimiter.size())
+    {
+      ++c.records;
+    }
+    return c;
+  }
+
+  /**
+   * Split the corpus into records the way a buffered reader does: scan from
+   * the end of the previous delimiter to the next one.
+   */
+  result bench_scan(const options &o, std::string_view kind, detail::simd_level level)
+  {
+    const scan_corpus c = make_scan_corpus(kind);
+    const std::uint64_t passes = o.n(64);
+
+    std::vector<std::uint64_t> samples;
+    samples.reserve(passes);
+
+    std::size_t found = 0;
+    const auto t0 = clock::now();
+    for (std::uint64_t p = 0; p < passes; ++p)
+    {
+      const auto start = clock::now();
+      const char *data = c.text.data();
+      std::size_t pos = 0;
+      while (pos < c.text.size())
+      {
+        const std::size_t at = detail::scan_pattern(level, data + pos, c.text.size() - pos, c.delimiter);
+        if (at == c.text.size() - pos)
+        {
+          break;
+        }
+        pos += at + c.delimiter.size();
+        ++found;
+      }
+      do_not_optimize(pos);
+      samples.push_back(elapsed_ns(start));
+    }
+    const double secs = seconds_since(t0);
+    do_not_optimize(found);
+
+    result r;
+    r.name = "scan." + std::string(kind) + "." + detail::to_string(level);
+    r.ops = passes * c.records;
+    r.seconds = secs;
+    r.latency = summarize(std::move(samples));
+    r.latency_unit = "pass";
+    r.params["corpus_bytes"] = static_cast<double>(c.text.size());
+    r.params["record_bytes"] = static_cast<double>(c.text.size()) / static_cast<double>(c.records);
+    r.params["delimiter_bytes"] = static_cast<double>(c.delimiter.size());
+    r.extra["bytes_per_sec"] = secs > 0.0 ? static_cast<double>(passes * c.text.size()) / secs : 0.0;
+    return r;
+  }
+
+  struct entry
+  {
+    std::string name;
+    std::function<result(const options &)> run;
+  };
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  const options o = parse_options(argc, argv);
+
+  const std::size_t hw = std::max<std::size_t>(2, std::thread::hardware_concurrency());
+
+  std::vector<entry> entries = {
+      {"scheduler.post_fn.sp", [](const options &op)
+       { return bench_post_fn(op, 1); }},
+      {"scheduler.post_fn.mp", [hw](const options &op)
+       { return bench_post_fn(op, std::min<std::size_t>(hw, 8)); }},
+      {"scheduler.resume.c1", [](const options &op)
+       { return bench_resume(op, 1); }},
+      {"scheduler.resume.c64", [](const options &op)
+       { return bench_resume(op, 64); }},
+      {"task.create_destroy", bench_task_create},
+      {"task.create_await", [](const options &op)
+       { return bench_task_await(op, false); }},
+      {"task.create_await.arena", [](const options &op)
+       { return bench_task_await(op, true); }},
+      {"when_all.fanout2", bench_when_all<2>},
+      {"when_all.fanout8", bench_when_all<8>},
+      {"broadcast.fanout1000", bench_broadcast},
+      {"shared_mutex.read_uncontended", bench_shared_mutex_read},
+      {"spsc_queue.handoff", bench_spsc_handoff},
+      {"thread_pool.submit.rtt", bench_pool_rtt},
+      {"thread_pool.submit.fire_and_forget", bench_pool_submit},
+      {"timer.insert", bench_timer_insert},
+      {"timer.insert_cancel", bench_timer_cancel},
+      {"timer.fire", bench_timer_fire},
+      {"cancel.is_cancelled", bench_cancel_poll},
+      {"cancel.source_token", bench_cancel_source},
+      {"cancel.submit_with_token.rtt", bench_cancel_submit},
+  };
+
+  // One cell per corpus and per level the CPU supports; scalar is the baseline.
+  for (const std::string_view kind : {"log", "http_lines", "http_heads", "long"})
+  {
+    for (const auto level : {detail::simd_level::scalar, detail::simd_level::sse2, detail::simd_level::avx2, detail::simd_level::neon})
+    {
+      // Single-byte delimiters go to memchr at every level.
+      const bool multi_byte = kind.starts_with("http");
+      if (!detail::scan_supported(level) || (!multi_byte && level != detail::simd_level::scalar))
+      {
+        continue;
+      }
+      entries.push_back({"scan." + std::string(kind) + "." + detail::to_string(level), [kind, level](const options &op)
+                         { return bench_scan(op, kind, level); }});
+    }
+  }
+
+  std::vector<result> results;
+  for (const auto &e : entries)
+  {
+    if (!o.selected(e.name))
+    {
+      continue;
+    }
+
+    results.push_back(e.run(o));
+    print_progress(results.back());
+  }
+
+  return emit(o, "core", results);
+}
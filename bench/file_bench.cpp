@@ -0,0 +1,313 @@
+/**
+ *
+ *  @file file_bench.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include "bench_common.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <vix/async/core/io_context.hpp>
+#include <vix/async/core/task.hpp>
+#include <vix/async/fs/file.hpp>
+#include <vix/async/fs/file_service.hpp>
+
+using namespace vix::async;
+using namespace vix::async::bench;
+
+namespace
+{
+  enum class pattern
+  {
+    seq,
+    rand
+  };
+
+  enum class op_kind
+  {
+    read,
+    write
+  };
+
+  struct cell
+  {
+    pattern pat;
+    op_kind op;
+    std::size_t block;
+    std::size_t qd;
+    std::uint64_t file_size;
+    std::uint64_t ops;
+  };
+
+  std::string cell_name(const cell &c, bool sync)
+  {
+    std::string n = sync ? "fs.sync." : "fs.";
+    n += c.pat == pattern::seq ? "seq_" : "rand_";
+    n += c.op == op_kind::read ? "read" : "write";
+    n += ".b" + std::to_string(c.block);
+    if (!sync)
+    {
+      n += ".qd" + std::to_string(c.qd);
+    }
+    return n;
+  }
+
+  /**
+   * Offset of the i-th operation: consecutive blocks for seq, a fixed
+   * pseudo-random block (splitmix64) for rand. Both wrap at the file size.
+   */
+  std::uint64_t offset_of(const cell &c, std::uint64_t i) noexcept
+  {
+    const std::uint64_t blocks = c.file_size / c.block;
+    if (c.pat == pattern::seq)
+    {
+      return (i % blocks) * c.block;
+    }
+
+    std::uint64_t z = i + 0x9e3779b97f4a7c15ull;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    z ^= z >> 31;
+    return (z % blocks) * c.block;
+  }
+
+  struct shared_state
+  {
+    std::uint64_t next{0};
+    std::atomic<std::uint64_t> finished{0};
+    std::uint64_t errors{0};
+  };
+
+  core::task<void> worker(fs::async_file &f, const cell &c, shared_state &st, std::vector<std::uint64_t> &samples)
+  {
+    std::vector<std::byte> buf(c.block, std::byte{0x5a});
+
+    // Workers share one event loop thread, so next needs no atomics.
+    while (st.next < c.ops)
+    {
+      const std::uint64_t off = offset_of(c, st.next++);
+      const auto t0 = clock::now();
+
+      try
+      {
+        if (c.op == op_kind::read)
+        {
+          do_not_optimize(co_await f.async_read_at(off, buf));
+        }
+        else
+        {
+          do_not_optimize(co_await f.async_write_at(off, buf));
+        }
+      }
+      catch (const std::system_error &)
+      {
+        ++st.errors;
+      }
+
+      samples.push_back(elapsed_ns(t0));
+    }
+
+    st.finished.fetch_add(1, std::memory_order_release);
+  }
+
+  result finish(const cell &c, std::string name, std::uint64_t ops, double secs, std::vector<std::uint64_t> samples)
+  {
+    result r;
+    r.name = std::move(name);
+    r.ops = ops;
+    r.seconds = secs;
+    r.latency = summarize(std::move(samples));
+    r.params["block"] = static_cast<double>(c.block);
+    r.params["qd"] = static_cast<double>(c.qd);
+    r.params["file_mib"] = static_cast<double>(c.file_size >> 20);
+    r.extra["mib_per_sec"] = r.ops_per_sec() * static_cast<double>(c.block) / (1024.0 * 1024.0);
+    return r;
+  }
+
+  result run_async(core::io_context &ctx, fs::async_file &f, const cell &c)
+  {
+    shared_state st;
+    std::vector<std::vector<std::uint64_t>> samples(c.qd);
+    for (auto &s : samples)
+    {
+      s.reserve(static_cast<std::size_t>(c.ops / c.qd + 1));
+    }
+
+    const auto t0 = clock::now();
+    for (std::size_t i = 0; i < c.qd; ++i)
+    {
+      std::move(worker(f, c, st, samples[i])).start(ctx.get_scheduler());
+    }
+    wait_for(st.finished, c.qd);
+    const double secs = seconds_since(t0);
+
+    std::vector<std::uint64_t> all;
+    all.reserve(static_cast<std::size_t>(c.ops));
+    for (const auto &s : samples)
+    {
+      all.insert(all.end(), s.begin(), s.end());
+    }
+
+    result r = finish(c, cell_name(c, false), c.ops, secs, std::move(all));
+    r.params["io_uring"] = ctx.files().uses_io_uring() ? 1.0 : 0.0;
+    r.extra["errors"] = static_cast<double>(st.errors);
+    return r;
+  }
+
+  /**
+   * Baseline: the same access pattern with blocking pread/pwrite on the
+   * calling thread, one operation at a time.
+   */
+  result run_sync(int fd, const cell &c)
+  {
+    std::vector<std::byte> buf(c.block, std::byte{0x5a});
+    std::vector<std::uint64_t> samples;
+    samples.reserve(static_cast<std::size_t>(c.ops));
+    std::uint64_t errors = 0;
+
+    const auto t0 = clock::now();
+    for (std::uint64_t i = 0; i < c.ops; ++i)
+    {
+      const auto off = static_cast<off_t>(offset_of(c, i));
+      const auto s0 = clock::now();
+      const ssize_t n = c.op == op_kind::read
+                            ? ::pread(fd, buf.data(), buf.size(), off)
+                            : ::pwrite(fd, buf.data(), buf.size(), off);
+      errors += n < 0 ? 1 : 0;
+      samples.push_back(elapsed_ns(s0));
+    }
+    const double secs = seconds_since(t0);
+
+    result r = finish(c, cell_name(c, true), c.ops, secs, std::move(samples));
+    r.extra["errors"] = static_cast<double>(errors);
+    return r;
+  }
+
+  bool prefill(int fd, std::uint64_t size)
+  {
+    std::vector<std::byte> chunk(1 << 20, std::byte{0xa5});
+    for (std::uint64_t off = 0; off < size; off += chunk.size())
+    {
+      const std::size_t len = static_cast<std::size_t>(std::min<std::uint64_t>(chunk.size(), size - off));
+      if (::pwrite(fd, chunk.data(), len, static_cast<off_t>(off)) != static_cast<ssize_t>(len))
+      {
+        return false;
+      }
+    }
+    return ::fsync(fd) == 0;
+  }
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  const options o = parse_options(argc, argv);
+
+  std::vector<std::size_t> blocks{4096, 65536};
+  std::vector<std::size_t> qds{1, 32};
+  std::uint64_t file_mib = 64;
+  std::string dir = std::filesystem::temp_directory_path().string();
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string_view a(argv[i]);
+    if (a.rfind("--blocks=", 0) == 0)
+    {
+      blocks = parse_list(a.substr(9));
+    }
+    else if (a.rfind("--qds=", 0) == 0)
+    {
+      qds = parse_list(a.substr(6));
+    }
+    else if (a.rfind("--file-mib=", 0) == 0)
+    {
+      const auto v = parse_list(a.substr(11));
+      file_mib = v.empty() ? file_mib : v.front();
+    }
+    else if (a.rfind("--dir=", 0) == 0)
+    {
+      dir = std::string(a.substr(6));
+    }
+  }
+
+  const std::uint64_t file_size = file_mib << 20;
+  const std::string path = (std::filesystem::path(dir) / ("vix_async_file_bench." + std::to_string(::getpid()))).string();
+
+  const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd < 0 || !prefill(fd, file_size))
+  {
+    std::perror(path.c_str());
+    return 1;
+  }
+
+  std::vector<result> results;
+
+  {
+    core::io_context ctx;
+    loop_thread loop(ctx);
+
+    fs::async_file f(ctx, ::dup(fd));
+    std::fprintf(stderr, "file backend: %s\n", ctx.files().uses_io_uring() ? "io_uring" : "blocking pool");
+
+    for (const op_kind op : {op_kind::write, op_kind::read})
+    {
+      for (const pattern pat : {pattern::seq, pattern::rand})
+      {
+        for (const auto b : blocks)
+        {
+          if (b == 0 || b > file_size)
+          {
+            continue;
+          }
+
+          const std::uint64_t ops = o.n(file_size / b);
+
+          const cell base{pat, op, b, 1, file_size, ops};
+          if (o.selected(cell_name(base, true)))
+          {
+            results.push_back(run_sync(fd, base));
+            print_progress(results.back());
+          }
+
+          for (const auto q : qds)
+          {
+            const cell c{pat, op, b, q, file_size, ops};
+            if (!o.selected(cell_name(c, false)))
+            {
+              continue;
+            }
+
+            results.push_back(run_async(ctx, f, c));
+            print_progress(results.back());
+          }
+        }
+      }
+    }
+  }
+
+  ::close(fd);
+  std::remove(path.c_str());
+
+  return emit(o, "fs", results);
+}
@@ -0,0 +1,437 @@
+/**
+ *
+ *  @file http_bench.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include "bench_common.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+
+#include <vix/async/core/io_context.hpp>
+#include <vix/async/core/spawn.hpp>
+#include <vix/async/core/task.hpp>
+#include <vix/async/http/client.hpp>
+#include <vix/async/http/parser.hpp>
+#include <vix/async/http/server.hpp>
+#include <vix/async/net/tcp.hpp>
+
+using namespace vix::async;
+using namespace vix::async::bench;
+
+namespace
+{
+  /**
+   * The server answers GET /<n> with an n-byte body. "get" cells drive it
+   * with raw pipelined requests (comparable with net.rpc); "client" cells go
+   * through http::client, one request in flight per connection.
+   */
+  constexpr std::size_t read_chunk = 64 * 1024;
+
+  enum class mode
+  {
+    get,
+    client
+  };
+
+  const char *mode_name(mode m) noexcept
+  {
+    return m == mode::get ? "get" : "client";
+  }
+
+  void set_nodelay(net::tcp_stream &s) noexcept
+  {
+    try
+    {
+      const int fd = s.native_handle();
+      const int one = 1;
+      ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+    catch (...)
+    {
+    }
+  }
+
+  double cpu_seconds() noexcept
+  {
+    rusage ru{};
+    ::getrusage(RUSAGE_SELF, &ru);
+    const auto tv = [](const timeval &t)
+    {
+      return static_cast<double>(t.tv_sec) + static_cast<double>(t.tv_usec) * 1e-6;
+    };
+    return tv(ru.ru_utime) + tv(ru.ru_stime);
+  }
+
+  // ------------------------------------------------------------------
+  // server
+  // ------------------------------------------------------------------
+
+  core::task<void> handle(const http::request &req, http::response &res)
+  {
+    std::size_t n = 0;
+    for (const char c : req.head.target.substr(1))
+    {
+      n = n * 10 + static_cast<std::size_t>(c - '0');
+    }
+    res.body.assign(n, 'x');
+    co_return;
+  }
+
+  /**
+   * HTTP server running on its own io_context.
+   */
+  struct server
+  {
+    core::io_context ctx;
+    std::unique_ptr<net::tcp_listener> listener;
+    std::unique_ptr<http::server> http;
+    std::unique_ptr<loop_thread> loop;
+
+    explicit server(std::uint16_t port)
+    {
+      loop = std::make_unique<loop_thread>(ctx);
+      listener = net::make_tcp_listener(ctx);
+      http = std::make_unique<http::server>(ctx, handle);
+
+      auto listen = [](net::tcp_listener *l, std::uint16_t p) -> core::task<void>
+      {
+        const net::tcp_endpoint ep{"127.0.0.1", p};
+        co_await l->async_listen(ep, 1024);
+      };
+      sync_wait(ctx.get_scheduler(), listen(listener.get(), port));
+
+      auto serve = [](http::server *h, net::tcp_listener *l) -> core::task<void>
+      {
+        try
+        {
+          co_await h->async_serve(*l);
+        }
+        catch (const std::system_error &)
+        {
+        }
+      };
+      core::spawn_detached(ctx, serve(http.get(), listener.get()));
+    }
+
+    ~server()
+    {
+      listener->close();
+      loop.reset();
+    }
+  };
+
+  // ------------------------------------------------------------------
+  // load generator
+  // ------------------------------------------------------------------
+
+  struct cell
+  {
+    mode m{mode::get};
+    std::size_t connections{1};
+    std::size_t size{64};
+    std::size_t depth{1};
+    std::uint16_t port{0};
+    clock::duration duration{};
+  };
+
+  struct conn_stats
+  {
+    std::vector<std::uint64_t> samples;
+    std::uint64_t errors{0};
+  };
+
+  std::string cell_name(mode m, std::size_t c, std::size_t s, std::size_t d)
+  {
+    std::string name = std::string("http.") + mode_name(m) + ".c" + std::to_string(c) + ".s" + std::to_string(s);
+    if (m == mode::get)
+    {
+      name += ".d" + std::to_string(d);
+    }
+    return name;
+  }
+
+  /**
+   * Number of bytes of the first complete response in @p buf, 0 if more
+   * input is needed.
+   */
+  std::size_t complete_response(std::string_view buf, http::response_head &head)
+  {
+    const auto r = http::parse_response(buf, head);
+    if (r.status == http::parse_status::incomplete)
+    {
+      return 0;
+    }
+    if (r.status == http::parse_status::invalid)
+    {
+      throw std::system_error(core::make_error_code(core::errc::invalid_argument));
+    }
+
+    const auto framing = http::response_body(head, "GET");
+    if (!framing || framing->kind != http::body_kind::length)
+    {
+      throw std::system_error(core::make_error_code(core::errc::invalid_argument));
+    }
+
+    const std::size_t total = r.size + static_cast<std::size_t>(framing->length);
+    return buf.size() >= total ? total : 0;
+  }
+
+  /**
+   * One closed-loop connection keeping @c depth pipelined GETs in flight
+   * until the deadline, then draining the outstanding responses.
+   */
+  core::task<void> get_conn(core::io_context &ctx, cell c, clock::time_point deadline, conn_stats *st, std::atomic<std::uint64_t> *finished)
+  {
+    auto s = net::make_tcp_stream(ctx);
+
+    const std::string request = "GET /" + std::to_string(c.size) + " HTTP/1.1\r\nHost: bench\r\n\r\n";
+    std::string out;
+    std::string in;
+    std::vector<std::byte> chunk(read_chunk);
+    std::deque<clock::time_point> in_flight;
+    http::response_head head;
+
+    try
+    {
+      const net::tcp_endpoint ep{"127.0.0.1", c.port};
+      co_await s->async_connect(ep);
+      set_nodelay(*s);
+
+      for (std::size_t i = 0; i < c.depth; ++i)
+      {
+        out += request;
+        in_flight.push_back(clock::now());
+      }
+      co_await s->async_write(std::as_bytes(std::span<const char>(out.data(), out.size())));
+
+      std::size_t consumed = 0;
+      while (!in_flight.empty())
+      {
+        const std::size_t n = co_await s->async_read(std::span<std::byte>(chunk.data(), chunk.size()));
+        if (n == 0)
+        {
+          ++st->errors;
+          break;
+        }
+        in.append(reinterpret_cast<const char *>(chunk.data()), n);
+
+        out.clear();
+        const bool sending = clock::now() < deadline;
+        while (!in_flight.empty())
+        {
+          const std::size_t used = complete_response(std::string_view(in).substr(consumed), head);
+          if (used == 0)
+          {
+            break;
+          }
+          consumed += used;
+          st->samples.push_back(elapsed_ns(in_flight.front()));
+          in_flight.pop_front();
+
+          if (sending)
+          {
+            out += request;
+            in_flight.push_back(clock::now());
+          }
+        }
+
+        if (consumed == in.size())
+        {
+          in.clear();
+          consumed = 0;
+        }
+
+        if (!out.empty())
+        {
+          co_await s->async_write(std::as_bytes(std::span<const char>(out.data(), out.size())));
+        }
+      }
+    }
+    catch (const std::system_error &)
+    {
+      ++st->errors;
+    }
+
+    s->close();
+    finished->fetch_add(1, std::memory_order_release);
+  }
+
+  /**
+   * One connection issuing requests through http::client until the deadline.
+   */
+  core::task<void> client_conn(core::io_context &ctx, cell c, clock::time_point deadline, conn_stats *st, std::atomic<std::uint64_t> *finished)
+  {
+    http::client cl(ctx);
+    const net::tcp_endpoint ep{"127.0.0.1", c.port};
+    const std::string target = "/" + std::to_string(c.size);
+
+    try
+    {
+      while (clock::now() < deadline)
+      {
+        const auto t0 = clock::now();
+        const auto res = co_await cl.async_get(ep, target);
+        if (res.body.size() != c.size)
+        {
+          ++st->errors;
+        }
+        st->samples.push_back(elapsed_ns(t0));
+      }
+    }
+    catch (const std::system_error &)
+    {
+      ++st->errors;
+    }
+
+    cl.close_idle();
+    finished->fetch_add(1, std::memory_order_release);
+  }
+
+  result run_cell(const cell &c)
+  {
+    core::io_context ctx;
+    loop_thread loop(ctx);
+
+    std::vector<conn_stats> stats(c.connections);
+    std::atomic<std::uint64_t> finished{0};
+
+    const double cpu0 = cpu_seconds();
+    const auto t0 = clock::now();
+    const auto deadline = t0 + c.duration;
+
+    for (std::size_t i = 0; i < c.connections; ++i)
+    {
+      if (c.m == mode::get)
+      {
+        core::spawn_detached(ctx, get_conn(ctx, c, deadline, &stats[i], &finished));
+      }
+      else
+      {
+        core::spawn_detached(ctx, client_conn(ctx, c, deadline, &stats[i], &finished));
+      }
+    }
+    wait_for(finished, c.connections);
+
+    const double secs = seconds_since(t0);
+    const double cpu = cpu_seconds() - cpu0;
+
+    std::vector<std::uint64_t> samples;
+    std::uint64_t errors = 0;
+    for (auto &st : stats)
+    {
+      samples.insert(samples.end(), st.samples.begin(), st.samples.end());
+      errors += st.errors;
+    }
+
+    result r;
+    r.name = cell_name(c.m, c.connections, c.size, c.depth);
+    r.ops = samples.size();
+    r.seconds = secs;
+    r.latency = summarize(std::move(samples));
+    r.latency_unit = "request_to_response";
+    r.params["connections"] = static_cast<double>(c.connections);
+    r.params["size"] = static_cast<double>(c.size);
+    r.params["depth"] = static_cast<double>(c.m == mode::get ? c.depth : 1);
+    r.extra["errors"] = static_cast<double>(errors);
+    r.extra["bytes_per_sec"] = r.ops_per_sec() * static_cast<double>(c.size);
+    // Process-wide: includes both the server and the load generator.
+    r.extra["cpu_us_per_req"] = r.ops > 0 ? cpu * 1e6 / static_cast<double>(r.ops) : 0.0;
+    r.extra["cpu_utilization"] = secs > 0.0 ? cpu / secs : 0.0;
+    return r;
+  }
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  const options o = parse_options(argc, argv);
+
+  std::vector<std::size_t> conns{1, 8, 64};
+  std::vector<std::size_t> sizes{64, 4096};
+  std::vector<std::size_t> depths{1, 16};
+  std::vector<mode> modes{mode::get, mode::client};
+  std::uint16_t port = 39421;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string_view a(argv[i]);
+    if (a.rfind("--conns=", 0) == 0)
+    {
+      conns = parse_list(a.substr(8));
+    }
+    else if (a.rfind("--sizes=", 0) == 0)
+    {
+      sizes = parse_list(a.substr(8));
+    }
+    else if (a.rfind("--depths=", 0) == 0)
+    {
+      depths = parse_list(a.substr(9));
+    }
+    else if (a == "--mode=get")
+    {
+      modes = {mode::get};
+    }
+    else if (a == "--mode=client")
+    {
+      modes = {mode::client};
+    }
+    else if (a.rfind("--port=", 0) == 0)
+    {
+      port = static_cast<std::uint16_t>(std::strtoul(std::string(a.substr(7)).c_str(), nullptr, 10));
+    }
+  }
+
+  const auto per_cell = std::chrono::duration_cast<clock::duration>(
+      std::chrono::duration<double>(std::max(0.1, o.scale)));
+
+  std::vector<result> results;
+  server srv(port);
+
+  for (const mode m : modes)
+  {
+    for (const auto c : conns)
+    {
+      for (const auto s : sizes)
+      {
+        // Client cells keep one request in flight per connection.
+        const std::vector<std::size_t> cell_depths = m == mode::get ? depths : std::vector<std::size_t>{1};
+        for (const auto d : cell_depths)
+        {
+          const cell cl{m, c, s, d, port, per_cell};
+          if (!o.selected(cell_name(m, c, s, d)))
+          {
+            continue;
+          }
+
+          results.push_back(run_cell(cl));
+          print_progress(results.back());
+        }
+      }
+    }
+  }
+
+  return emit(o, "http", results);
+}
@@ -0,0 +1,518 @@
+/**
+ *
+ *  @file net_bench.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include "bench_common.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <new>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+
+#include <vix/async/core/io_context.hpp>
+#include <vix/async/core/scheduler.hpp>
+#include <vix/async/core/spawn.hpp>
+#include <vix/async/core/task.hpp>
+#include <vix/async/net/tcp.hpp>
+
+using namespace vix::async;
+using namespace vix::async::bench;
+
+namespace
+{
+  /** Heap allocations of the whole process, on any thread. */
+  std::atomic<std::uint64_t> g_allocs{0};
+} // namespace
+
+// Once inlined, the replacements below look like operator new paired with
+// free() to GCC.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void *operator new(std::size_t n)
+{
+  g_allocs.fetch_add(1, std::memory_order_relaxed);
+  if (void *p = std::malloc(n != 0 ? n : 1))
+  {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace
+{
+  /**
+   * Request/response protocol: every request starts with an 8-byte header
+   * (request payload length, response length; little-endian u32 each)
+   * followed by the payload. The server answers with exactly the requested
+   * number of bytes. Echo mode has no header: the server writes back what it
+   * reads.
+   */
+  constexpr std::size_t rpc_header_size = 8;
+
+  constexpr std::size_t read_chunk = 64 * 1024;
+
+  enum class mode
+  {
+    rpc,
+    echo
+  };
+
+  const char *mode_name(mode m) noexcept
+  {
+    return m == mode::rpc ? "rpc" : "echo";
+  }
+
+  void put_u32(std::byte *p, std::uint32_t v) noexcept
+  {
+    for (int i = 0; i < 4; ++i)
+    {
+      p[i] = static_cast<std::byte>((v >> (8 * i)) & 0xffu);
+    }
+  }
+
+  std::uint32_t get_u32(const std::byte *p) noexcept
+  {
+    std::uint32_t v = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+      v |= static_cast<std::uint32_t>(p[i]) << (8 * i);
+    }
+    return v;
+  }
+
+  /**
+   * Disable Nagle so that pipelined small writes measure the runtime, not
+   * delayed-ACK interaction.
+   */
+  void set_nodelay(net::tcp_stream &s) noexcept
+  {
+    try
+    {
+      const int fd = s.native_handle();
+      const int one = 1;
+      ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+    catch (...)
+    {
+    }
+  }
+
+  double cpu_seconds() noexcept
+  {
+    rusage ru{};
+    ::getrusage(RUSAGE_SELF, &ru);
+    const auto tv = [](const timeval &t)
+    {
+      return static_cast<double>(t.tv_sec) + static_cast<double>(t.tv_usec) * 1e-6;
+    };
+    return tv(ru.ru_utime) + tv(ru.ru_stime);
+  }
+
+  // ------------------------------------------------------------------
+  // server
+  // ------------------------------------------------------------------
+
+  /**
+   * Buffered server session: parses every complete request in the input
+   * buffer and answers all of them with a single write.
+   */
+  core::task<void> rpc_session(std::unique_ptr<net::tcp_stream> s)
+  {
+    set_nodelay(*s);
+
+    std::vector<std::byte> in;
+    std::vector<std::byte> out;
+    std::vector<std::byte> chunk(read_chunk);
+    std::size_t consumed = 0;
+
+    try
+    {
+      for (;;)
+      {
+        const std::size_t n = co_await s->async_read(std::span<std::byte>(chunk.data(), chunk.size()));
+        if (n == 0)
+        {
+          break;
+        }
+
+        in.insert(in.end(), chunk.begin(), chunk.begin() + static_cast<std::ptrdiff_t>(n));
+
+        out.clear();
+        for (;;)
+        {
+          const std::size_t avail = in.size() - consumed;
+          if (avail < rpc_header_size)
+          {
+            break;
+          }
+
+          const std::uint32_t req_len = get_u32(in.data() + consumed);
+          const std::uint32_t resp_len = get_u32(in.data() + consumed + 4);
+          if (avail < rpc_header_size + req_len)
+          {
+            break;
+          }
+
+          consumed += rpc_header_size + req_len;
+          out.resize(out.size() + resp_len, std::byte{0x5a});
+        }
+
+        if (consumed == in.size())
+        {
+          in.clear();
+          consumed = 0;
+        }
+
+        if (!out.empty())
+        {
+          co_await s->async_write(std::span<const std::byte>(out.data(), out.size()));
+        }
+      }
+    }
+    catch (const std::system_error &)
+    {
+    }
+
+    s->close();
+  }
+
+  core::task<void> echo_session(std::unique_ptr<net::tcp_stream> s)
+  {
+    set_nodelay(*s);
+
+    std::vector<std::byte> buf(read_chunk);
+
+    try
+    {
+      for (;;)
+      {
+        const std::size_t n = co_await s->async_read(std::span<std::byte>(buf.data(), buf.size()));
+        if (n == 0)
+        {
+          break;
+        }
+
+        co_await s->async_write(std::span<const std::byte>(buf.data(), n));
+      }
+    }
+    catch (const std::system_error &)
+    {
+    }
+
+    s->close();
+  }
+
+  core::task<void> accept_loop(core::io_context &ctx, net::tcp_listener *l, mode m)
+  {
+    try
+    {
+      while (l->is_open())
+      {
+        auto s = co_await l->async_accept();
+        if (m == mode::rpc)
+        {
+          core::spawn_detached(ctx, rpc_session(std::move(s)));
+        }
+        else
+        {
+          core::spawn_detached(ctx, echo_session(std::move(s)));
+        }
+      }
+    }
+    catch (const std::system_error &)
+    {
+    }
+  }
+
+  /**
+   * Server running on its own io_context (scheduler thread + net thread).
+   */
+  struct server
+  {
+    core::io_context ctx;
+    std::unique_ptr<net::tcp_listener> listener;
+    std::unique_ptr<loop_thread> loop;
+
+    server(mode m, std::uint16_t port)
+    {
+      loop = std::make_unique<loop_thread>(ctx);
+      listener = net::make_tcp_listener(ctx);
+
+      auto listen = [](net::tcp_listener *l, std::uint16_t p) -> core::task<void>
+      {
+        const net::tcp_endpoint ep{"127.0.0.1", p};
+        co_await l->async_listen(ep, 1024);
+      };
+      sync_wait(ctx.get_scheduler(), listen(listener.get(), port));
+
+      core::spawn_detached(ctx, accept_loop(ctx, listener.get(), m));
+    }
+
+    ~server()
+    {
+      listener->close();
+      loop.reset();
+    }
+  };
+
+  // ------------------------------------------------------------------
+  // load generator
+  // ------------------------------------------------------------------
+
+  struct cell
+  {
+    mode m{mode::rpc};
+    std::size_t connections{1};
+    std::size_t size{64};
+    std::size_t depth{1};
+    std::uint16_t port{0};
+    clock::duration duration{};
+  };
+
+  struct conn_stats
+  {
+    std::vector<std::uint64_t> samples;
+    std::uint64_t errors{0};
+  };
+
+  /**
+   * One closed-loop connection keeping @c depth requests in flight until the
+   * deadline, then draining the outstanding responses.
+   */
+  core::task<void> client_conn(core::io_context &ctx, cell c, clock::time_point deadline, conn_stats *st, std::atomic<std::uint64_t> *finished)
+  {
+    auto s = net::make_tcp_stream(ctx);
+
+    const std::size_t req_size = c.m == mode::rpc ? rpc_header_size + c.size : c.size;
+    const std::size_t resp_size = c.size;
+
+    std::vector<std::byte> request(req_size, std::byte{0x42});
+    if (c.m == mode::rpc)
+    {
+      put_u32(request.data(), static_cast<std::uint32_t>(c.size));
+      put_u32(request.data() + 4, static_cast<std::uint32_t>(c.size));
+    }
+
+    std::vector<std::byte> out;
+    std::vector<std::byte> chunk(read_chunk);
+    std::deque<clock::time_point> in_flight;
+    std::size_t partial = 0;
+
+    try
+    {
+      const net::tcp_endpoint ep{"127.0.0.1", c.port};
+      co_await s->async_connect(ep);
+      set_nodelay(*s);
+
+      for (std::size_t i = 0; i < c.depth; ++i)
+      {
+        out.insert(out.end(), request.begin(), request.end());
+        in_flight.push_back(clock::now());
+      }
+      co_await s->async_write(std::span<const std::byte>(out.data(), out.size()));
+
+      while (!in_flight.empty())
+      {
+        const std::size_t n = co_await s->async_read(std::span<std::byte>(chunk.data(), chunk.size()));
+        if (n == 0)
+        {
+          ++st->errors;
+          break;
+        }
+
+        partial += n;
+        out.clear();
+
+        const bool sending = clock::now() < deadline;
+        while (partial >= resp_size && !in_flight.empty())
+        {
+          partial -= resp_size;
+          st->samples.push_back(elapsed_ns(in_flight.front()));
+          in_flight.pop_front();
+
+          if (sending)
+          {
+            out.insert(out.end(), request.begin(), request.end());
+            in_flight.push_back(clock::now());
+          }
+        }
+
+        if (!out.empty())
+        {
+          co_await s->async_write(std::span<const std::byte>(out.data(), out.size()));
+        }
+      }
+    }
+    catch (const std::system_error &)
+    {
+      ++st->errors;
+    }
+
+    s->close();
+    finished->fetch_add(1, std::memory_order_release);
+  }
+
+  result run_cell(const cell &c)
+  {
+    core::io_context ctx;
+    loop_thread loop(ctx);
+
+    std::vector<conn_stats> stats(c.connections);
+    std::atomic<std::uint64_t> finished{0};
+
+    const double cpu0 = cpu_seconds();
+    const std::uint64_t allocs0 = g_allocs.load(std::memory_order_relaxed);
+    const auto t0 = clock::now();
+    const auto deadline = t0 + c.duration;
+
+    for (std::size_t i = 0; i < c.connections; ++i)
+    {
+      core::spawn_detached(ctx, client_conn(ctx, c, deadline, &stats[i], &finished));
+    }
+    wait_for(finished, c.connections);
+
+    const double secs = seconds_since(t0);
+    const double cpu = cpu_seconds() - cpu0;
+    const std::uint64_t allocs = g_allocs.load(std::memory_order_relaxed) - allocs0;
+
+    std::vector<std::uint64_t> samples;
+    std::uint64_t errors = 0;
+    for (auto &st : stats)
+    {
+      samples.insert(samples.end(), st.samples.begin(), st.samples.end());
+      errors += st.errors;
+    }
+
+    result r;
+    r.name = std::string("net.") + mode_name(c.m) + ".c" + std::to_string(c.connections) + ".s" + std::to_string(c.size) + ".d" + std::to_string(c.depth);
+    r.ops = samples.size();
+    r.seconds = secs;
+    r.latency = summarize(std::move(samples));
+    r.latency_unit = "request_to_response";
+    r.params["connections"] = static_cast<double>(c.connections);
+    r.params["size"] = static_cast<double>(c.size);
+    r.params["depth"] = static_cast<double>(c.depth);
+    r.extra["errors"] = static_cast<double>(errors);
+    r.extra["bytes_per_sec"] = r.ops_per_sec() * static_cast<double>(c.size);
+    // Process-wide: includes both the server and the load generator.
+    r.extra["cpu_us_per_req"] = r.ops > 0 ? cpu * 1e6 / static_cast<double>(r.ops) : 0.0;
+    r.extra["cpu_utilization"] = secs > 0.0 ? cpu / secs : 0.0;
+    // Process-wide as well; task frames dominate.
+    r.extra["allocs_per_req"] = r.ops > 0 ? static_cast<double>(allocs) / static_cast<double>(r.ops) : 0.0;
+    return r;
+  }
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  const options o = parse_options(argc, argv);
+
+  std::vector<std::size_t> conns{1, 8, 64};
+  std::vector<std::size_t> sizes{64, 4096};
+  std::vector<std::size_t> depths{1, 16};
+  std::vector<mode> modes{mode::rpc, mode::echo};
+  std::uint16_t port = 39411;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string_view a(argv[i]);
+    if (a.rfind("--conns=", 0) == 0)
+    {
+      conns = parse_list(a.substr(8));
+    }
+    else if (a.rfind("--sizes=", 0) == 0)
+    {
+      sizes = parse_list(a.substr(8));
+    }
+    else if (a.rfind("--depths=", 0) == 0)
+    {
+      depths = parse_list(a.substr(9));
+    }
+    else if (a == "--mode=rpc")
+    {
+      modes = {mode::rpc};
+    }
+    else if (a == "--mode=echo")
+    {
+      modes = {mode::echo};
+    }
+    else if (a.rfind("--port=", 0) == 0)
+    {
+      port = static_cast<std::uint16_t>(std::strtoul(std::string(a.substr(7)).c_str(), nullptr, 10));
+    }
+  }
+
+  const auto per_cell = std::chrono::duration_cast<clock::duration>(
+      std::chrono::duration<double>(std::max(0.1, o.scale)));
+
+  std::vector<result> results;
+
+  for (const mode m : modes)
+  {
+    const std::uint16_t p = static_cast<std::uint16_t>(port + (m == mode::rpc ? 0 : 1));
+    server srv(m, p);
+
+    for (const auto c : conns)
+    {
+      for (const auto s : sizes)
+      {
+        for (const auto d : depths)
+        {
+          const cell cl{m, c, s, d, p, per_cell};
+          const std::string name = std::string("net.") + mode_name(m) + ".c" + std::to_string(c) + ".s" + std::to_string(s) + ".d" + std::to_string(d);
+          if (!o.selected(name))
+          {
+            continue;
+          }
+
+          results.push_back(run_cell(cl));
+          print_progress(results.back());
+        }
+      }
+    }
+  }
+
+  return emit(o, "net", results);
+}
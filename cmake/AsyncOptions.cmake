@@ -2,12 +2,28 @@ include_guard(GLOBAL)
 
 option(ASYNC_BUILD_TESTS "Build Async tests" ON)
 option(ASYNC_BUILD_EXAMPLES "Build Async examples" OFF)
+option(ASYNC_BUILD_BENCH "Build Async benchmarks (vix_async_bench)" OFF)
 
 option(ASYNC_WARNINGS_AS_ERRORS "Treat warnings as errors" OFF)
 
 option(ASYNC_ENABLE_SANITIZERS "Enable AddressSanitizer + UBSan (where supported)" OFF)
 option(ASYNC_ENABLE_TSAN "Enable ThreadSanitizer (where supported)" OFF)
 
+set(ASYNC_LOG_MIN_LEVEL "0" CACHE STRING
+  "Minimum compiled-in log level (0=trace 1=debug 2=info 3=warn 4=error 5=fatal 6=off)")
+set_property(CACHE ASYNC_LOG_MIN_LEVEL PROPERTY STRINGS 0 1 2 3 4 5 6)
+
+option(ASYNC_ENABLE_METRICS "Collect runtime metrics (io_context::metrics())" ON)
+option(ASYNC_ENABLE_HISTOGRAMS "Record latency histograms in runtime metrics (core/histogram.hpp)" ON)
+
+option(ASYNC_ENABLE_TRACING "Record task lifecycle traces (core/trace.hpp)" OFF)
+
+option(ASYNC_ENABLE_TASK_REGISTRY "Track live tasks for async stack dumps (core/task_registry.hpp)" OFF)
+
+option(ASYNC_ENABLE_IO_URING "Use io_uring for file I/O on Linux when the kernel supports it (fs/file.hpp)" ON)
+
+option(ASYNC_ENABLE_SIMD "Use SSE2/AVX2/NEON for delimiter scanning (detail/scan.hpp)" ON)
+
 option(ASYNC_USE_MOLD "Use mold linker when available (Linux only)" OFF)
 
 if(NOT CMAKE_CONFIGURATION_TYPES AND NOT CMAKE_BUILD_TYPE)
@@ -27,21 +27,47 @@
 #include <vix/async/version.hpp>
 
 // core
+#include <vix/async/core/arena.hpp>
+#include <vix/async/core/broadcast.hpp>
 #include <vix/async/core/cancel.hpp>
 #include <vix/async/core/error.hpp>
+#include <vix/async/core/executor.hpp>
+#include <vix/async/core/histogram.hpp>
 #include <vix/async/core/io_context.hpp>
+#include <vix/async/core/metrics.hpp>
+#include <vix/async/core/retry.hpp>
 #include <vix/async/core/scheduler.hpp>
+#include <vix/async/core/shared_mutex.hpp>
 #include <vix/async/core/signal.hpp>
 #include <vix/async/core/spawn.hpp>
+#include <vix/async/core/spsc_queue.hpp>
 #include <vix/async/core/task.hpp>
+#include <vix/async/core/task_registry.hpp>
 #include <vix/async/core/thread_pool.hpp>
 #include <vix/async/core/timer.hpp>
+#include <vix/async/core/trace.hpp>
+#include <vix/async/core/watchdog.hpp>
 #include <vix/async/core/when.hpp>
 
+// fs
+#include <vix/async/fs/file.hpp>
+#include <vix/async/fs/file_service.hpp>
+#include <vix/async/fs/mapped_file.hpp>
+
+// http
+#include <vix/async/http/client.hpp>
+#include <vix/async/http/parser.hpp>
+#include <vix/async/http/server.hpp>
+
 // net
 #include <vix/async/net/asio_net_service.hpp>
+#include <vix/async/net/buffer_pool.hpp>
 #include <vix/async/net/dns.hpp>
+#include <vix/async/net/framing.hpp>
 #include <vix/async/net/tcp.hpp>
 #include <vix/async/net/udp.hpp>
 
+// process
+#include <vix/async/process/process.hpp>
+
 #endif // VIX_ASYNC_ASYNC_HPP
@@ -0,0 +1,185 @@
+/**
+ *
+ *  @file arena.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_ASYNC_ARENA_HPP
+#define VIX_ASYNC_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+#include <vix/async/core/task.hpp>
+#include <vix/async/detail/config.hpp>
+
+namespace vix::async::core
+{
+  /**
+   * @brief Bump allocator for everything one request allocates.
+   *
+   * Allocation moves a pointer inside the current chunk; a new chunk (at
+   * least chunk_size bytes) is taken from the heap when it runs out.
+   * Deallocation is free: memory comes back all at once when the arena is
+   * destroyed or release()d. The most recent allocation is the exception;
+   * freeing it rolls the pointer back, so a child task created, awaited and
+   * destroyed in a loop keeps reusing the same bytes.
+   *
+   * Coroutine frames: a task coroutine taking the arena (or any
+   * std::pmr::memory_resource) by reference allocates its frame from it.
+   * Pass the arena down to the children that should share it:
+   *
+   * @code
+   * task<int> parse(request_arena &a, std::string_view body);
+   *
+   * task<int> handle(request_arena &a, std::string_view body)
+   * {
+   *   std::pmr::vector<int> scratch(&a);   // containers too
+   *   co_return co_await parse(a, body);   // frame from the arena
+   * }
+   *
+   * int n = co_await with_arena([&](request_arena &a) { return handle(a, body); });
+   * @endcode
+   *
+   * GCC 12 may report a spurious -Wmismatched-new-delete on such coroutines
+   * at -O0 (GCC bug 109224).
+   *
+   * Not thread-safe: a request's tasks all run on one io_context thread.
+   * Objects allocated from the arena must not outlive it.
+   */
+  class request_arena final : public std::pmr::memory_resource
+  {
+  public:
+    /**
+     * @brief Construct an empty arena (no memory is taken until first use).
+     *
+     * @param chunk_size Minimum size of the chunks taken from the heap.
+     */
+    explicit request_arena(std::size_t chunk_size = ASYNC_ARENA_CHUNK_SIZE) noexcept;
+
+    /**
+     * @brief Free every chunk.
+     */
+    ~request_arena() override;
+
+    request_arena(const request_arena &) = delete;
+    request_arena &operator=(const request_arena &) = delete;
+
+    /**
+     * @brief Free everything allocated so far, keeping the first chunk.
+     */
+    void release() noexcept;
+
+    /**
+     * @brief Bytes handed out since construction or release().
+     */
+    [[nodiscard]] std::size_t bytes_used() const noexcept
+    {
+      return used_;
+    }
+
+    /**
+     * @brief Chunks currently held.
+     */
+    [[nodiscard]] std::size_t chunk_count() const noexcept
+    {
+      return chunks_;
+    }
+
+  private:
+    /**
+     * @brief Heap chunk header; the usable bytes follow it.
+     */
+    struct chunk
+    {
+      chunk *next;
+      std::size_t size;
+    };
+
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+      const auto p = reinterpret_cast<std::uintptr_t>(cur_);
+      const std::uintptr_t aligned = (p + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+      if (cur_ != nullptr && aligned + bytes <= reinterpret_cast<std::uintptr_t>(end_))
+      {
+        last_ = reinterpret_cast<char *>(aligned);
+        cur_ = last_ + bytes;
+        used_ += bytes;
+        return last_;
+      }
+      return allocate_slow(bytes, alignment);
+    }
+
+    void do_deallocate(void *p, std::size_t bytes, std::size_t) override
+    {
+      if (p == last_ && last_ + bytes == cur_)
+      {
+        cur_ = last_;
+        last_ = nullptr;
+        used_ -= bytes;
+      }
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+      return this == &other;
+    }
+
+    void *allocate_slow(std::size_t bytes, std::size_t alignment);
+
+    std::size_t chunk_size_;
+    chunk *head_{nullptr};
+    chunk *first_{nullptr}; // first regular chunk; kept by release()
+    char *cur_{nullptr};
+    char *end_{nullptr};
+    char *last_{nullptr};
+    std::size_t used_{0};
+    std::size_t chunks_{0};
+  };
+
+  /**
+   * @brief Run a request's root task with a fresh arena.
+   *
+   * fn receives the arena and returns the root task; the arena and
+   * everything allocated from it are freed as soon as the root task
+   * completes.
+   *
+   * @tparam Fn Callable taking request_arena & and returning task<T>.
+   * @param fn Root task factory.
+   * @param chunk_size Chunk size of the arena.
+   * @return task<T> with the root task's result.
+   */
+  template <typename Fn>
+  auto with_arena(Fn fn, std::size_t chunk_size = ASYNC_ARENA_CHUNK_SIZE)
+      -> task<typename detail::task_result<std::invoke_result_t<Fn &, request_arena &>>::type>
+  {
+    using T = typename detail::task_result<std::invoke_result_t<Fn &, request_arena &>>::type;
+
+    request_arena arena(chunk_size);
+    auto root = fn(arena);
+    if constexpr (std::is_void_v<T>)
+    {
+      co_await root;
+    }
+    else
+    {
+      T value = co_await root;
+      co_return value;
+    }
+  }
+
+} // namespace vix::async::core
+
+#endif // VIX_ASYNC_ARENA_HPP
@@ -0,0 +1,458 @@
+/**
+ *
+ *  @file broadcast.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_ASYNC_BROADCAST_HPP
+#define VIX_ASYNC_BROADCAST_HPP
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <vix/async/core/error.hpp>
+#include <vix/async/core/scheduler.hpp>
+#include <vix/async/core/task.hpp>
+
+namespace vix::async::core
+{
+  /**
+   * @brief What happens to a subscriber that falls more than capacity behind.
+   */
+  enum class lag_policy : std::uint8_t
+  {
+    /**
+     * @brief recv() throws errc::overflow once, then continues from the
+     * oldest message still retained. lagged() counts what was skipped.
+     */
+    report,
+
+    /**
+     * @brief The subscriber is dropped: recv() throws errc::overflow from
+     * then on and it no longer counts as a receiver.
+     */
+    disconnect
+  };
+
+  /**
+   * @brief Multi-producer, multi-subscriber broadcast channel.
+   *
+   * Every subscriber sees every message sent after it subscribed. Messages
+   * are stored once, as shared_ptr<const T>, in a ring of capacity slots.
+   * Each subscriber only keeps a cursor into that ring, so a send costs
+   * one slot whatever the number of subscribers, and all of them receive
+   * the same object.
+   *
+   * A send wakes every suspended subscriber with a single
+   * scheduler::post_batch(). The sender never waits: a subscriber more
+   * than capacity messages behind has lost the overwritten ones, which
+   * lag_policy reports or punishes.
+   *
+   * send() and close() are thread-safe. Each subscriber must be used by
+   * one coroutine at a time. Subscribers may outlive the channel; they
+   * then drain what is left and see errc::closed.
+   *
+   * @code
+   * broadcast<config> updates(ctx.get_scheduler(), 64);
+   * auto sub = updates.subscribe();
+   * updates.send(load_config());
+   * std::shared_ptr<const config> c = co_await sub.recv();
+   * @endcode
+   *
+   * @tparam T Message type.
+   */
+  template <typename T>
+  class broadcast
+  {
+  public:
+    /**
+     * @brief Shared, immutable message.
+     */
+    using message = std::shared_ptr<const T>;
+
+  private:
+    /**
+     * @brief State shared by the channel and its subscribers.
+     */
+    struct state
+    {
+      state(scheduler &s, std::size_t cap, lag_policy p)
+          : sched(&s), capacity(cap != 0 ? cap : 1), policy(p), ring(capacity)
+      {
+      }
+
+      /** @brief Scheduler resuming woken subscribers. */
+      scheduler *sched;
+
+      /** @brief Ring size. */
+      std::size_t capacity;
+
+      /** @brief Handling of subscribers that fall behind. */
+      lag_policy policy;
+
+      /** @brief Protects everything below. */
+      std::mutex m;
+
+      /** @brief Message n is in ring[n % capacity] while n + capacity > next. */
+      std::vector<message> ring;
+
+      /** @brief Sequence number of the next message. */
+      std::uint64_t next{0};
+
+      /** @brief No more sends. */
+      bool closed{false};
+
+      /** @brief Live, connected subscribers. */
+      std::size_t receivers{0};
+
+      /** @brief Suspended recv() calls. */
+      std::vector<std::coroutine_handle<>> waiting;
+
+      /** @brief Empty buffer swapped with waiting on each wakeup, to keep its capacity. */
+      std::vector<std::coroutine_handle<>> spare;
+    };
+
+    /**
+     * @brief Resume every suspended subscriber in one batch.
+     *
+     * @param st Shared state, with st.m held by lock.
+     * @param lock Lock on st.m, released before posting.
+     */
+    static void wake_all(state &st, std::unique_lock<std::mutex> &lock)
+    {
+      if (st.waiting.empty())
+      {
+        return;
+      }
+
+      std::vector<std::coroutine_handle<>> woken;
+      woken.swap(st.waiting);
+      st.waiting.swap(st.spare);
+      lock.unlock();
+
+      st.sched->post_batch(woken);
+
+      woken.clear();
+      lock.lock();
+      if (st.spare.capacity() < woken.capacity())
+      {
+        st.spare.swap(woken);
+      }
+    }
+
+  public:
+    /**
+     * @brief Receiving end of a broadcast channel.
+     *
+     * Obtained from broadcast::subscribe(). Move-only; destroying it
+     * unsubscribes.
+     */
+    class subscriber
+    {
+    public:
+      /**
+       * @brief Construct a detached subscriber (recv() throws errc::closed).
+       */
+      subscriber() = default;
+
+      subscriber(subscriber &&other) noexcept
+          : st_(std::move(other.st_)),
+            cursor_(other.cursor_),
+            lagged_(other.lagged_),
+            connected_(std::exchange(other.connected_, false))
+      {
+      }
+
+      subscriber &operator=(subscriber &&other) noexcept
+      {
+        if (this != &other)
+        {
+          disconnect();
+          st_ = std::move(other.st_);
+          cursor_ = other.cursor_;
+          lagged_ = other.lagged_;
+          connected_ = std::exchange(other.connected_, false);
+        }
+        return *this;
+      }
+
+      subscriber(const subscriber &) = delete;
+      subscriber &operator=(const subscriber &) = delete;
+
+      ~subscriber()
+      {
+        disconnect();
+      }
+
+      /**
+       * @brief Receive the next message, suspending until one is sent.
+       *
+       * @return The message, shared with every other subscriber.
+       * @throws std::system_error errc::overflow when messages were lost
+       *         (see lag_policy), errc::closed once the channel is closed
+       *         and drained.
+       */
+      task<message> recv()
+      {
+        struct wait_awaitable
+        {
+          subscriber *self;
+
+          static constexpr const char *awaiting_label() noexcept { return "broadcast recv"; }
+
+          bool await_ready() const noexcept
+          {
+            return false;
+          }
+
+          bool await_suspend(std::coroutine_handle<> h)
+          {
+            state &st = *self->st_;
+            std::lock_guard<std::mutex> lock(st.m);
+            if (self->cursor_ < st.next || st.closed)
+            {
+              return false;
+            }
+            st.waiting.push_back(h);
+            return true;
+          }
+
+          void await_resume() const noexcept {}
+        };
+
+        message msg;
+        while (!poll(msg))
+        {
+          wait_awaitable op{this};
+          co_await op;
+        }
+        co_return msg;
+      }
+
+      /**
+       * @brief Receive the next message if one is available.
+       *
+       * @return The message, or nullopt if none was sent since the last one.
+       * @throws std::system_error As recv().
+       */
+      std::optional<message> try_recv()
+      {
+        message msg;
+        if (poll(msg))
+        {
+          return msg;
+        }
+        return std::nullopt;
+      }
+
+      /**
+       * @brief Messages lost by falling behind, in total.
+       */
+      [[nodiscard]] std::uint64_t lagged() const noexcept
+      {
+        return lagged_;
+      }
+
+    private:
+      friend class broadcast;
+
+      subscriber(std::shared_ptr<state> st, std::uint64_t cursor) noexcept
+          : st_(std::move(st)), cursor_(cursor), connected_(true)
+      {
+      }
+
+      /**
+       * @brief Take the next message, or report that recv() must wait.
+       *
+       * @param out Set to the message on success.
+       * @return true when out is set; false when nothing is available.
+       * @throws std::system_error errc::overflow or errc::closed.
+       */
+      bool poll(message &out)
+      {
+        if (!st_)
+        {
+          throw std::system_error(make_error_code(errc::closed));
+        }
+        if (!connected_)
+        {
+          throw std::system_error(make_error_code(errc::overflow));
+        }
+
+        state &st = *st_;
+        std::unique_lock<std::mutex> lock(st.m);
+
+        const std::uint64_t oldest = st.next > st.capacity ? st.next - st.capacity : 0;
+        if (cursor_ < oldest)
+        {
+          lagged_ += oldest - cursor_;
+          cursor_ = oldest;
+          if (st.policy == lag_policy::disconnect)
+          {
+            connected_ = false;
+            --st.receivers;
+          }
+          throw std::system_error(make_error_code(errc::overflow));
+        }
+
+        if (cursor_ < st.next)
+        {
+          out = st.ring[cursor_ % st.capacity];
+          ++cursor_;
+          return true;
+        }
+
+        if (st.closed)
+        {
+          throw std::system_error(make_error_code(errc::closed));
+        }
+        return false;
+      }
+
+      void disconnect() noexcept
+      {
+        if (st_ && connected_)
+        {
+          std::lock_guard<std::mutex> lock(st_->m);
+          --st_->receivers;
+        }
+        connected_ = false;
+      }
+
+      std::shared_ptr<state> st_{};
+      std::uint64_t cursor_{0};
+      std::uint64_t lagged_{0};
+      bool connected_{false};
+    };
+
+    /**
+     * @brief Create a channel.
+     *
+     * @param sched Scheduler resuming woken subscribers.
+     * @param capacity Messages retained for slow subscribers (at least 1).
+     * @param policy Handling of subscribers more than capacity behind.
+     */
+    broadcast(scheduler &sched, std::size_t capacity, lag_policy policy = lag_policy::report)
+        : st_(std::make_shared<state>(sched, capacity, policy))
+    {
+    }
+
+    /**
+     * @brief Close the channel; subscribers drain it, then see errc::closed.
+     */
+    ~broadcast()
+    {
+      close();
+    }
+
+    broadcast(const broadcast &) = delete;
+    broadcast &operator=(const broadcast &) = delete;
+
+    /**
+     * @brief Subscribe to the messages sent from now on.
+     *
+     * @return A new subscriber.
+     */
+    [[nodiscard]] subscriber subscribe()
+    {
+      std::lock_guard<std::mutex> lock(st_->m);
+      ++st_->receivers;
+      return subscriber(st_, st_->next);
+    }
+
+    /**
+     * @brief Send a message to every subscriber.
+     *
+     * @param value Message, stored once.
+     * @return Number of connected subscribers.
+     * @throws std::system_error errc::closed after close().
+     */
+    std::size_t send(T value)
+    {
+      return send(std::make_shared<const T>(std::move(value)));
+    }
+
+    /**
+     * @brief Send an already shared message to every subscriber.
+     *
+     * @param msg Message (null is stored as is).
+     * @return Number of connected subscribers.
+     * @throws std::system_error errc::closed after close().
+     */
+    std::size_t send(message msg)
+    {
+      state &st = *st_;
+      std::unique_lock<std::mutex> lock(st.m);
+
+      if (st.closed)
+      {
+        throw std::system_error(make_error_code(errc::closed));
+      }
+
+      // The overwritten message is released outside the lock.
+      message old = std::exchange(st.ring[st.next % st.capacity], std::move(msg));
+      ++st.next;
+
+      const std::size_t receivers = st.receivers;
+      wake_all(st, lock);
+      lock.unlock();
+      return receivers;
+    }
+
+    /**
+     * @brief Stop accepting messages and wake every subscriber.
+     *
+     * Idempotent.
+     */
+    void close() noexcept
+    {
+      state &st = *st_;
+      std::unique_lock<std::mutex> lock(st.m);
+      if (st.closed)
+      {
+        return;
+      }
+      st.closed = true;
+      wake_all(st, lock);
+    }
+
+    /**
+     * @brief Number of connected subscribers.
+     */
+    [[nodiscard]] std::size_t subscriber_count() const
+    {
+      std::lock_guard<std::mutex> lock(st_->m);
+      return st_->receivers;
+    }
+
+    /**
+     * @brief Number of messages retained for slow subscribers.
+     */
+    [[nodiscard]] std::size_t capacity() const noexcept
+    {
+      return st_->capacity;
+    }
+
+  private:
+    std::shared_ptr<state> st_;
+  };
+
+} // namespace vix::async::core
+
+#endif // VIX_ASYNC_BROADCAST_HPP
@@ -0,0 +1,184 @@
+/**
+ *
+ *  @file executor.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_ASYNC_EXECUTOR_HPP
+#define VIX_ASYNC_EXECUTOR_HPP
+
+#include <coroutine>
+
+namespace vix::async::core
+{
+  /**
+   * @brief Where a suspended coroutine is resumed.
+   *
+   * A non-owning handle on a scheduler, a thread_pool, or the inline
+   * executor (resume on whichever thread completes the operation). A
+   * default-constructed executor is empty: awaitables then fall back to
+   * their io_context's scheduler.
+   *
+   * Obtain one from scheduler::get_executor(), thread_pool::get_executor()
+   * or executor::inline_executor().
+   */
+  class executor
+  {
+  public:
+    /**
+     * @brief Function posting a coroutine handle to target.
+     */
+    using post_fn = void (*)(void *target, std::coroutine_handle<> h) noexcept;
+
+    /**
+     * @brief Construct an empty executor.
+     */
+    constexpr executor() noexcept = default;
+
+    /**
+     * @brief Construct an executor posting through fn on target.
+     */
+    constexpr executor(void *target, post_fn fn) noexcept
+        : target_(target), post_(fn)
+    {
+    }
+
+    /**
+     * @brief Resume on the thread completing the operation.
+     *
+     * Awaits made while running inline keep resuming inline, so a
+     * coroutine stays on the completing threads until it moves with
+     * resume_on(). Those are the net and timer threads: keep inline
+     * sections short.
+     */
+    static executor inline_executor() noexcept;
+
+    /**
+     * @brief Whether the executor is empty.
+     */
+    explicit operator bool() const noexcept
+    {
+      return post_ != nullptr;
+    }
+
+    /**
+     * @brief Whether this is the inline executor.
+     */
+    [[nodiscard]] bool is_inline() const noexcept;
+
+    /**
+     * @brief Resume h on this executor.
+     *
+     * @pre The executor is not empty.
+     */
+    void post(std::coroutine_handle<> h) const noexcept
+    {
+      post_(target_, h);
+    }
+
+    friend bool operator==(const executor &, const executor &) noexcept = default;
+
+  private:
+    void *target_{nullptr};
+    post_fn post_{nullptr};
+  };
+
+  /**
+   * @brief Executor running the calling thread's current work.
+   *
+   * The scheduler's run() thread, a thread_pool worker, or the inline
+   * executor while a coroutine resumed inline runs. Empty on other
+   * threads.
+   */
+  [[nodiscard]] executor current_executor() noexcept;
+
+  namespace detail
+  {
+    /**
+     * @brief Replace the calling thread's current executor.
+     *
+     * Set by the scheduler and thread_pool loops before each item.
+     *
+     * @return The previous one.
+     */
+    executor exchange_current_executor(executor e) noexcept;
+
+    /**
+     * @brief The executor to resume on: the current one, or fallback.
+     */
+    inline executor resume_executor(executor fallback) noexcept
+    {
+      const executor e = current_executor();
+      return e ? e : fallback;
+    }
+  } // namespace detail
+
+  /**
+   * @brief Awaitable moving the awaiting coroutine to an executor.
+   */
+  struct resume_on_awaitable
+  {
+    /**
+     * @brief Destination executor.
+     */
+    executor target{};
+
+    /**
+     * @brief Suspension label reported by tracing and the task registry.
+     */
+    static constexpr const char *awaiting_label() noexcept { return "executor hop"; }
+
+    /**
+     * @brief No hop when already there; switching to inline never hops.
+     */
+    bool await_ready() const noexcept
+    {
+      if (!target || target == current_executor())
+      {
+        return true;
+      }
+      if (target.is_inline())
+      {
+        detail::exchange_current_executor(target);
+        return true;
+      }
+      return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> h) const noexcept
+    {
+      target.post(h);
+    }
+
+    void await_resume() const noexcept {}
+  };
+
+  /**
+   * @brief Continue the awaiting coroutine on e.
+   *
+   * Later I/O and timer awaits resume on e as well:
+   *
+   * @code
+   * co_await resume_on(pool.get_executor());
+   * auto n = co_await sock->async_read(buf);   // resumes on a pool worker
+   * @endcode
+   *
+   * @param e Destination executor (empty: no-op).
+   */
+  [[nodiscard]] inline resume_on_awaitable resume_on(executor e) noexcept
+  {
+    return resume_on_awaitable{e};
+  }
+
+} // namespace vix::async::core
+
+#endif // VIX_ASYNC_EXECUTOR_HPP
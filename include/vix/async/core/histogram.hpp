@@ -0,0 +1,312 @@
+/**
+ *
+ *  @file histogram.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_ASYNC_HISTOGRAM_HPP
+#define VIX_ASYNC_HISTOGRAM_HPP
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include <vix/async/detail/config.hpp>
+
+namespace vix::async::core
+{
+  namespace detail
+  {
+    /**
+     * @brief Shard used by the calling thread for histogram recording.
+     *
+     * Threads are assigned round-robin on first use, so up to
+     * ASYNC_HISTOGRAM_SHARDS recording threads never share a shard.
+     *
+     * @return Shard index in [0, ASYNC_HISTOGRAM_SHARDS).
+     */
+    inline std::size_t histogram_shard() noexcept
+    {
+      static std::atomic<std::size_t> next{0};
+      thread_local const std::size_t idx =
+          next.fetch_add(1, std::memory_order_relaxed) % ASYNC_HISTOGRAM_SHARDS;
+      return idx;
+    }
+  } // namespace detail
+
+  /**
+   * @brief Plain copy of a latency_histogram taken at one point in time.
+   *
+   * Log-linear (HDR-style) layout: values below sub_bucket_count are exact,
+   * and every power-of-two range above is split into sub_bucket_count
+   * equal buckets, so a bucket is never wider than 1/sub_bucket_count of
+   * its lower bound. Values of 2^max_exponent nanoseconds and above land
+   * in the last bucket.
+   */
+  struct histogram_snapshot
+  {
+    /** @brief log2 of the number of linear buckets per power of two. */
+    static constexpr std::size_t sub_bucket_bits = 4;
+
+    /** @brief Linear buckets per power of two. */
+    static constexpr std::size_t sub_bucket_count = std::size_t{1} << sub_bucket_bits;
+
+    /** @brief Values at or above 2^max_exponent ns (about 18 minutes) saturate. */
+    static constexpr std::size_t max_exponent = 40;
+
+    /** @brief Number of buckets. */
+    static constexpr std::size_t bucket_count = (max_exponent - sub_bucket_bits + 1) * sub_bucket_count;
+
+    /** @brief Per-bucket sample counts. */
+    std::array<std::uint64_t, bucket_count> buckets{};
+
+    /** @brief Total number of samples. */
+    std::uint64_t count{0};
+
+    /** @brief Sum of all samples, in nanoseconds. */
+    std::uint64_t sum_ns{0};
+
+    /** @brief Smallest sample, in nanoseconds (0 if empty). */
+    std::uint64_t min_ns{0};
+
+    /** @brief Largest sample, in nanoseconds. */
+    std::uint64_t max_ns{0};
+
+    /**
+     * @brief Bucket holding a value.
+     *
+     * @param ns Value in nanoseconds.
+     * @return Bucket index.
+     */
+    static constexpr std::size_t bucket_index(std::uint64_t ns) noexcept
+    {
+      if (ns < sub_bucket_count)
+      {
+        return static_cast<std::size_t>(ns);
+      }
+
+      const auto exp = static_cast<std::size_t>(std::bit_width(ns) - 1);
+      if (exp >= max_exponent)
+      {
+        return bucket_count - 1;
+      }
+
+      const std::size_t shift = exp - sub_bucket_bits;
+      return (shift + 1) * sub_bucket_count +
+             static_cast<std::size_t>((ns >> shift) - sub_bucket_count);
+    }
+
+    /**
+     * @brief Smallest value of a bucket, in nanoseconds.
+     *
+     * @param i Bucket index.
+     * @return Inclusive lower bound.
+     */
+    static constexpr std::uint64_t bucket_lower_bound(std::size_t i) noexcept
+    {
+      const std::size_t group = i / sub_bucket_count;
+      const std::uint64_t sub = i % sub_bucket_count;
+      if (group == 0)
+      {
+        return sub;
+      }
+      return (sub_bucket_count + sub) << (group - 1);
+    }
+
+    /**
+     * @brief Exclusive upper bound of a bucket, in nanoseconds.
+     *
+     * @param i Bucket index.
+     * @return Lower bound of the next bucket.
+     */
+    static constexpr std::uint64_t bucket_upper_bound(std::size_t i) noexcept
+    {
+      const std::size_t group = i / sub_bucket_count;
+      return bucket_lower_bound(i) + (group == 0 ? 1 : std::uint64_t{1} << (group - 1));
+    }
+
+    /**
+     * @brief Value at a quantile.
+     *
+     * Reported as the highest value of the bucket holding that rank, clamped
+     * to [min_ns, max_ns], so the relative error is below 1/sub_bucket_count.
+     *
+     * @param q Quantile in [0, 1].
+     * @return Quantile estimate in nanoseconds, 0 if empty.
+     */
+    std::uint64_t percentile(double q) const noexcept
+    {
+      if (count == 0)
+      {
+        return 0;
+      }
+
+      if (q <= 0.0)
+      {
+        return min_ns;
+      }
+
+      auto rank = static_cast<std::uint64_t>(q * static_cast<double>(count) + 0.5);
+      if (rank == 0)
+      {
+        rank = 1;
+      }
+
+      std::uint64_t seen = 0;
+      for (std::size_t i = 0; i < bucket_count; ++i)
+      {
+        seen += buckets[i];
+        if (seen >= rank)
+        {
+          const std::uint64_t v = bucket_upper_bound(i) - 1;
+          return v < min_ns ? min_ns : (v > max_ns ? max_ns : v);
+        }
+      }
+
+      return max_ns;
+    }
+
+    /**
+     * @brief Arithmetic mean of the samples.
+     *
+     * @return Mean in nanoseconds, 0 if empty.
+     */
+    double mean() const noexcept
+    {
+      return count == 0 ? 0.0 : static_cast<double>(sum_ns) / static_cast<double>(count);
+    }
+
+    /**
+     * @brief Add the samples of another snapshot to this one.
+     *
+     * @param other Snapshot to merge.
+     */
+    void merge(const histogram_snapshot &other) noexcept
+    {
+      if (other.count == 0)
+      {
+        return;
+      }
+
+      for (std::size_t i = 0; i < bucket_count; ++i)
+      {
+        buckets[i] += other.buckets[i];
+      }
+
+      min_ns = count == 0 || other.min_ns < min_ns ? other.min_ns : min_ns;
+      max_ns = other.max_ns > max_ns ? other.max_ns : max_ns;
+      count += other.count;
+      sum_ns += other.sum_ns;
+    }
+  };
+
+  /**
+   * @brief Fixed-memory, lock-free log-linear latency histogram.
+   *
+   * Recording touches only the calling thread's shard: a handful of relaxed
+   * atomic adds on a cache line that other recording threads normally do not
+   * write, and never allocates. snapshot() merges all shards.
+   */
+  class latency_histogram
+  {
+  public:
+    /** @brief Number of buckets. */
+    static constexpr std::size_t bucket_count = histogram_snapshot::bucket_count;
+
+    /** @brief Number of per-thread shards. */
+    static constexpr std::size_t shard_count = ASYNC_HISTOGRAM_SHARDS;
+
+    /**
+     * @brief Record one sample.
+     *
+     * @param ns Sample value in nanoseconds.
+     */
+    void record(std::uint64_t ns) noexcept
+    {
+      shard &s = shards_[detail::histogram_shard()];
+
+      s.buckets[histogram_snapshot::bucket_index(ns)].fetch_add(1, std::memory_order_relaxed);
+      s.count.fetch_add(1, std::memory_order_relaxed);
+      s.sum_ns.fetch_add(ns, std::memory_order_relaxed);
+
+      std::uint64_t cur = s.max_ns.load(std::memory_order_relaxed);
+      while (ns > cur && !s.max_ns.compare_exchange_weak(cur, ns, std::memory_order_relaxed))
+      {
+      }
+
+      cur = s.min_ns.load(std::memory_order_relaxed);
+      while (ns < cur && !s.min_ns.compare_exchange_weak(cur, ns, std::memory_order_relaxed))
+      {
+      }
+    }
+
+    /**
+     * @brief Merge all shards into a plain snapshot.
+     *
+     * Fields are read independently, so a snapshot taken while samples are
+     * recorded may be off by the samples in flight.
+     *
+     * @return Plain snapshot.
+     */
+    histogram_snapshot snapshot() const noexcept
+    {
+      histogram_snapshot out;
+      std::uint64_t min = std::numeric_limits<std::uint64_t>::max();
+
+      for (const shard &s : shards_)
+      {
+        const std::uint64_t n = s.count.load(std::memory_order_relaxed);
+        if (n == 0)
+        {
+          continue;
+        }
+
+        for (std::size_t i = 0; i < bucket_count; ++i)
+        {
+          out.buckets[i] += s.buckets[i].load(std::memory_order_relaxed);
+        }
+
+        out.count += n;
+        out.sum_ns += s.sum_ns.load(std::memory_order_relaxed);
+
+        const std::uint64_t mx = s.max_ns.load(std::memory_order_relaxed);
+        const std::uint64_t mn = s.min_ns.load(std::memory_order_relaxed);
+        out.max_ns = mx > out.max_ns ? mx : out.max_ns;
+        min = mn < min ? mn : min;
+      }
+
+      out.min_ns = out.count == 0 ? 0 : min;
+      return out;
+    }
+
+  private:
+    /**
+     * @brief Counters written by the threads mapped to one shard.
+     */
+    struct alignas(64) shard
+    {
+      std::array<std::atomic<std::uint64_t>, bucket_count> buckets{};
+      std::atomic<std::uint64_t> count{0};
+      std::atomic<std::uint64_t> sum_ns{0};
+      std::atomic<std::uint64_t> max_ns{0};
+      std::atomic<std::uint64_t> min_ns{std::numeric_limits<std::uint64_t>::max()};
+    };
+
+    std::array<shard, shard_count> shards_{};
+  };
+
+} // namespace vix::async::core
+
+#endif // VIX_ASYNC_HISTOGRAM_HPP
@@ -23,6 +23,7 @@
 #include <stdexcept>
 #include <utility>
 
+#include <vix/async/core/metrics.hpp>
 #include <vix/async/core/scheduler.hpp>
 
 namespace vix::async::net::detail
@@ -30,12 +31,30 @@ namespace vix::async::net::detail
   class asio_net_service;
 }
 
+namespace vix::async::fs::detail
+{
+  class file_service;
+}
+
 namespace vix::async::core
 {
   class thread_pool;
   class timer;
   class signal_set;
 
+  /**
+   * @brief Tag selecting the virtual clock (see io_context(virtual_time_t)).
+   */
+  struct virtual_time_t
+  {
+    explicit virtual_time_t() = default;
+  };
+
+  /**
+   * @brief Tag value selecting the virtual clock.
+   */
+  inline constexpr virtual_time_t virtual_time{};
+
   /**
    * @brief Central asynchronous execution context.
    *
@@ -47,6 +66,7 @@ namespace vix::async::core
    * - a timer service for delayed execution
    * - a signal handling service
    * - a networking backend (asio-based)
+   * - a file I/O backend (io_uring or a blocking pool)
    *
    * Services are lazily initialized and owned by the context.
    *
@@ -69,6 +89,29 @@ namespace vix::async::core
      */
     io_context();
 
+    /**
+     * @brief Construct an io_context running on a virtual clock.
+     *
+     * Meant for simulations and tests of timer-driven logic. The timer
+     * service has no thread. When the scheduler runs out of work, the clock
+     * jumps to the next deadline and the timers due then fire, in deadline
+     * then scheduling order. Hours of timeouts run in milliseconds, and a
+     * program driven only by the loop and its timers replays the same
+     * schedule every time.
+     *
+     * @code
+     * io_context ctx{virtual_time};
+     * std::move(simulation(ctx)).start(ctx.get_scheduler());
+     * ctx.run();   // returns when nothing is queued and no timer is pending
+     * @endcode
+     *
+     * run() returns once no work is queued and no timer is pending.
+     * Completions from the network, files and the thread_pool still arrive
+     * in real time from other threads. The clock does not wait for them,
+     * so keep them out of simulations.
+     */
+    explicit io_context(virtual_time_t);
+
     /**
      * @brief Destroy the io_context and release all resources.
      *
@@ -163,6 +206,29 @@ namespace vix::async::core
       return sched_.is_running();
     }
 
+    /**
+     * @brief Whether this context runs on the virtual clock.
+     *
+     * @return true if constructed with virtual_time.
+     */
+    [[nodiscard]] bool uses_virtual_time() const noexcept
+    {
+      return virtual_time_;
+    }
+
+    /**
+     * @brief Whether the scheduler is overloaded (see scheduler::overloaded()).
+     *
+     * Accept loops and other producers of optional work should check this
+     * and turn work away rather than queue it.
+     *
+     * @return true while admission control reports a standing queue.
+     */
+    [[nodiscard]] bool overloaded() const noexcept
+    {
+      return sched_.overloaded();
+    }
+
     /**
      * @brief Access the CPU thread pool.
      *
@@ -207,6 +273,40 @@ namespace vix::async::core
      */
     [[nodiscard]] vix::async::net::detail::asio_net_service &net();
 
+    /**
+     * @brief Access the file I/O backend service.
+     *
+     * Lazily initialized on first access.
+     *
+     * @return Reference to file_service.
+     *
+     * @throws std::runtime_error If the context has already been shut down.
+     */
+    [[nodiscard]] vix::async::fs::detail::file_service &files();
+
+    /**
+     * @brief Take a snapshot of the runtime metrics.
+     *
+     * Reads relaxed atomic counters only: it never takes the scheduler or
+     * service locks and does not create lazy services. Safe to call from any
+     * thread, including after shutdown().
+     *
+     * @return Cumulative counters of the scheduler and all services.
+     */
+    [[nodiscard]] metrics_snapshot metrics() const noexcept;
+
+    /**
+     * @brief Live counters updated by the services of this context.
+     *
+     * Intended for runtime services; users should prefer metrics().
+     *
+     * @return Reference to the service counters.
+     */
+    [[nodiscard]] runtime_metrics &runtime_counters() noexcept
+    {
+      return counters_;
+    }
+
     /**
      * @brief Stop scheduler and destroy all services.
      *
@@ -243,6 +343,9 @@ namespace vix::async::core
     }
 
   private:
+    /** @brief Service counters; declared first so they outlive every service. */
+    runtime_metrics counters_{};
+
     /** @brief Core scheduler. */
     scheduler sched_;
 
@@ -258,6 +361,12 @@ namespace vix::async::core
     /** @brief Networking backend (lazy). */
     std::unique_ptr<vix::async::net::detail::asio_net_service> net_;
 
+    /** @brief File I/O backend (lazy). */
+    std::unique_ptr<vix::async::fs::detail::file_service> files_;
+
+    /** @brief Timers run on the virtual clock. */
+    const bool virtual_time_{false};
+
     /** @brief Ensures shutdown runs once. */
     std::atomic<bool> shutdown_done_{false};
 
@@ -0,0 +1,337 @@
+/**
+ *
+ *  @file metrics.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_ASYNC_METRICS_HPP
+#define VIX_ASYNC_METRICS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string_view>
+
+#include <vix/async/core/histogram.hpp>
+#include <vix/async/detail/config.hpp>
+
+namespace vix::async::core
+{
+  /**
+   * @brief Clock used by all runtime instrumentation.
+   */
+  using metrics_clock = std::chrono::steady_clock;
+
+  namespace detail
+  {
+    /**
+     * @brief Current instrumentation time in nanoseconds.
+     *
+     * @return Nanoseconds on metrics_clock since its epoch.
+     */
+    inline std::uint64_t metrics_now_ns() noexcept
+    {
+      return static_cast<std::uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              metrics_clock::now().time_since_epoch())
+              .count());
+    }
+
+    /**
+     * @brief Raise an atomic high-water mark if @p v exceeds it.
+     *
+     * @param hwm High-water mark to update.
+     * @param v Observed value.
+     */
+    inline void update_max(std::atomic<std::uint64_t> &hwm, std::uint64_t v) noexcept
+    {
+      std::uint64_t cur = hwm.load(std::memory_order_relaxed);
+      while (v > cur &&
+             !hwm.compare_exchange_weak(cur, v, std::memory_order_relaxed))
+      {
+      }
+    }
+  } // namespace detail
+
+  /**
+   * @brief Snapshot of scheduler counters.
+   */
+  struct scheduler_stats
+  {
+    /** @brief Coroutine handles posted on the fast lane. */
+    std::uint64_t handle_posts{0};
+
+    /** @brief Callables posted on the generic lane. */
+    std::uint64_t fn_posts{0};
+
+    /** @brief Coroutine handles resumed by run(). */
+    std::uint64_t handle_runs{0};
+
+    /** @brief Callables executed by run(). */
+    std::uint64_t fn_runs{0};
+
+    /** @brief Iterations of the run() loop. */
+    std::uint64_t loop_iterations{0};
+
+    /** @brief Time spent blocked waiting for work, in nanoseconds. */
+    std::uint64_t idle_ns{0};
+
+    /** @brief Items queued at snapshot time (both lanes). */
+    std::uint64_t queue_depth{0};
+
+    /** @brief Largest queue depth observed. */
+    std::uint64_t queue_depth_hwm{0};
+
+    /** @brief Transitions into the overloaded state (admission control). */
+    std::uint64_t overloads{0};
+
+    /** @brief Work turned away by try_admit() / admit() while overloaded. */
+    std::uint64_t rejected{0};
+
+    /** @brief Delay between post and execution. */
+    histogram_snapshot post_to_resume{};
+  };
+
+  /**
+   * @brief Live scheduler counters, owned by scheduler.
+   */
+  struct scheduler_metrics
+  {
+    std::atomic<std::uint64_t> handle_posts{0};
+    std::atomic<std::uint64_t> fn_posts{0};
+    std::atomic<std::uint64_t> handle_runs{0};
+    std::atomic<std::uint64_t> fn_runs{0};
+    std::atomic<std::uint64_t> loop_iterations{0};
+    std::atomic<std::uint64_t> idle_ns{0};
+    std::atomic<std::uint64_t> queue_depth{0};
+    std::atomic<std::uint64_t> queue_depth_hwm{0};
+    std::atomic<std::uint64_t> overloads{0};
+    std::atomic<std::uint64_t> rejected{0};
+    latency_histogram post_to_resume{};
+
+    /**
+     * @brief Copy the current values.
+     *
+     * @return Plain snapshot.
+     */
+    scheduler_stats snapshot() const noexcept
+    {
+      scheduler_stats s;
+      s.handle_posts = handle_posts.load(std::memory_order_relaxed);
+      s.fn_posts = fn_posts.load(std::memory_order_relaxed);
+      s.handle_runs = handle_runs.load(std::memory_order_relaxed);
+      s.fn_runs = fn_runs.load(std::memory_order_relaxed);
+      s.loop_iterations = loop_iterations.load(std::memory_order_relaxed);
+      s.idle_ns = idle_ns.load(std::memory_order_relaxed);
+      s.queue_depth = queue_depth.load(std::memory_order_relaxed);
+      s.queue_depth_hwm = queue_depth_hwm.load(std::memory_order_relaxed);
+      s.overloads = overloads.load(std::memory_order_relaxed);
+      s.rejected = rejected.load(std::memory_order_relaxed);
+      s.post_to_resume = post_to_resume.snapshot();
+      return s;
+    }
+  };
+
+  /**
+   * @brief Snapshot of CPU thread pool counters.
+   */
+  struct thread_pool_stats
+  {
+    /** @brief Jobs accepted into the queue. */
+    std::uint64_t submitted{0};
+
+    /** @brief Jobs executed (successfully or not). */
+    std::uint64_t completed{0};
+
+    /** @brief Jobs dropped because the pool was stopping. */
+    std::uint64_t rejected{0};
+
+    /** @brief Time between enqueue and start of execution. */
+    histogram_snapshot queue_wait{};
+
+    /** @brief Execution time of each job. */
+    histogram_snapshot run_time{};
+  };
+
+  /**
+   * @brief Live thread pool counters.
+   */
+  struct thread_pool_metrics
+  {
+    std::atomic<std::uint64_t> submitted{0};
+    std::atomic<std::uint64_t> completed{0};
+    std::atomic<std::uint64_t> rejected{0};
+    latency_histogram queue_wait{};
+    latency_histogram run_time{};
+
+    /**
+     * @brief Copy the current values.
+     *
+     * @return Plain snapshot.
+     */
+    thread_pool_stats snapshot() const noexcept
+    {
+      thread_pool_stats s;
+      s.submitted = submitted.load(std::memory_order_relaxed);
+      s.completed = completed.load(std::memory_order_relaxed);
+      s.rejected = rejected.load(std::memory_order_relaxed);
+      s.queue_wait = queue_wait.snapshot();
+      s.run_time = run_time.snapshot();
+      return s;
+    }
+  };
+
+  /**
+   * @brief Snapshot of timer service counters.
+   */
+  struct timer_stats
+  {
+    /** @brief Entries inserted into the timer queue. */
+    std::uint64_t scheduled{0};
+
+    /** @brief Entries whose deadline was reached and job dispatched. */
+    std::uint64_t fired{0};
+
+    /** @brief Entries skipped because their token was cancelled. */
+    std::uint64_t cancelled{0};
+
+    /** @brief Entries currently waiting in the queue. */
+    std::uint64_t queue_size{0};
+
+    /** @brief Delay between deadline and dispatch. */
+    histogram_snapshot lateness{};
+  };
+
+  /**
+   * @brief Live timer counters.
+   */
+  struct timer_metrics
+  {
+    std::atomic<std::uint64_t> scheduled{0};
+    std::atomic<std::uint64_t> fired{0};
+    std::atomic<std::uint64_t> cancelled{0};
+    std::atomic<std::uint64_t> queue_size{0};
+    latency_histogram lateness{};
+
+    /**
+     * @brief Copy the current values.
+     *
+     * @return Plain snapshot.
+     */
+    timer_stats snapshot() const noexcept
+    {
+      timer_stats s;
+      s.scheduled = scheduled.load(std::memory_order_relaxed);
+      s.fired = fired.load(std::memory_order_relaxed);
+      s.cancelled = cancelled.load(std::memory_order_relaxed);
+      s.queue_size = queue_size.load(std::memory_order_relaxed);
+      s.lateness = lateness.snapshot();
+      return s;
+    }
+  };
+
+  /**
+   * @brief Snapshot of networking counters.
+   */
+  struct net_stats
+  {
+    /** @brief Asio operations completed (any outcome). */
+    std::uint64_t completions{0};
+
+    /** @brief Asio operations completed with an error code. */
+    std::uint64_t errors{0};
+
+    /** @brief Time from starting an Asio operation to its completion. */
+    histogram_snapshot op_latency{};
+  };
+
+  /**
+   * @brief Live networking counters.
+   */
+  struct net_metrics
+  {
+    std::atomic<std::uint64_t> completions{0};
+    std::atomic<std::uint64_t> errors{0};
+    latency_histogram op_latency{};
+
+    /**
+     * @brief Copy the current values.
+     *
+     * @return Plain snapshot.
+     */
+    net_stats snapshot() const noexcept
+    {
+      net_stats s;
+      s.completions = completions.load(std::memory_order_relaxed);
+      s.errors = errors.load(std::memory_order_relaxed);
+      s.op_latency = op_latency.snapshot();
+      return s;
+    }
+  };
+
+  /**
+   * @brief Counters of the services owned by one io_context.
+   *
+   * Owned by io_context rather than by the lazily created services, so the
+   * values are cumulative for the lifetime of the context.
+   */
+  struct runtime_metrics
+  {
+    thread_pool_metrics cpu_pool{};
+    timer_metrics timers{};
+    net_metrics net{};
+  };
+
+  /**
+   * @brief Point-in-time view of all runtime metrics of an io_context.
+   *
+   * Counters are cumulative: rates such as posts per second are obtained by
+   * differencing two snapshots over their taken_at interval.
+   */
+  struct metrics_snapshot
+  {
+    /** @brief When the snapshot was taken. */
+    metrics_clock::time_point taken_at{};
+
+    /** @brief Scheduler (event loop) counters. */
+    scheduler_stats scheduler{};
+
+    /** @brief CPU thread pool counters. */
+    thread_pool_stats cpu_pool{};
+
+    /** @brief Timer service counters. */
+    timer_stats timers{};
+
+    /** @brief Networking counters. */
+    net_stats net{};
+  };
+
+  /**
+   * @brief Write a snapshot in the Prometheus text exposition format.
+   *
+   * Counters become `<prefix>_<name>_total`, gauges `<prefix>_<name>`, and
+   * histograms are exported in seconds with cumulative `le` buckets.
+   *
+   * @param os Output stream.
+   * @param s Snapshot to export.
+   * @param prefix Metric name prefix.
+   */
+  void write_prometheus(
+      std::ostream &os,
+      const metrics_snapshot &s,
+      std::string_view prefix = "vix_async");
+
+} // namespace vix::async::core
+
+#endif // VIX_ASYNC_METRICS_HPP
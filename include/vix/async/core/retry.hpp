@@ -0,0 +1,258 @@
+/**
+ *
+ *  @file retry.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_ASYNC_RETRY_HPP
+#define VIX_ASYNC_RETRY_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <vix/async/core/cancel.hpp>
+#include <vix/async/core/error.hpp>
+#include <vix/async/core/io_context.hpp>
+#include <vix/async/core/task.hpp>
+#include <vix/async/core/timer.hpp>
+
+namespace vix::async::core
+{
+  /**
+   * @brief Token bucket limiting retries across many calls.
+   *
+   * Follows the gRPC retry throttling scheme: every failed attempt takes
+   * one token, every success gives back token_ratio, and retries are only
+   * allowed while more than half of max_tokens remain. When an upstream
+   * starts failing for everyone, callers sharing a budget stop retrying
+   * after a few failures instead of multiplying the load by max_attempts.
+   *
+   * Thread-safe; share one instance (through retry_policy::budget) between
+   * all calls to the same upstream.
+   */
+  class retry_budget
+  {
+  public:
+    /**
+     * @brief Construct a full bucket.
+     *
+     * @param max_tokens Bucket size.
+     * @param token_ratio Tokens returned per successful call.
+     */
+    explicit retry_budget(double max_tokens = 10.0, double token_ratio = 0.1) noexcept;
+
+    /**
+     * @brief Whether a retry is allowed right now.
+     */
+    [[nodiscard]] bool allows_retry() const noexcept;
+
+    /**
+     * @brief Record a failed attempt (takes one token).
+     */
+    void record_failure() noexcept;
+
+    /**
+     * @brief Record a successful attempt (returns token_ratio tokens).
+     */
+    void record_success() noexcept;
+
+    /**
+     * @brief Tokens currently in the bucket.
+     */
+    [[nodiscard]] double tokens() const noexcept;
+
+  private:
+    void add(std::int64_t delta) noexcept;
+
+    /** Tokens are kept in thousandths so updates are a single CAS. */
+    std::int64_t max_;
+    std::int64_t ratio_;
+    std::atomic<std::int64_t> tokens_;
+  };
+
+  /**
+   * @brief How retry() spaces and limits attempts.
+   */
+  struct retry_policy
+  {
+    /**
+     * @brief Total attempts, including the first one.
+     */
+    std::uint32_t max_attempts{3};
+
+    /**
+     * @brief Backoff cap before the first retry.
+     */
+    timer::duration initial_backoff{std::chrono::milliseconds(10)};
+
+    /**
+     * @brief Upper bound of the backoff cap.
+     */
+    timer::duration max_backoff{std::chrono::seconds(1)};
+
+    /**
+     * @brief Growth of the backoff cap per retry.
+     */
+    double multiplier{2.0};
+
+    /**
+     * @brief Full jitter: sleep a uniform random time in [0, cap].
+     *
+     * When false, sleep exactly the cap.
+     */
+    bool jitter{true};
+
+    /**
+     * @brief Which errors are worth another attempt.
+     *
+     * Empty means is_transient_error(). errc::canceled is never retried.
+     */
+    std::function<bool(const std::error_code &)> retryable{};
+
+    /**
+     * @brief Optional budget shared with other calls.
+     */
+    std::shared_ptr<retry_budget> budget{};
+  };
+
+  /**
+   * @brief Default retryable predicate.
+   *
+   * True for timeouts, rejected/full queues, refused/reset/aborted
+   * connections, unreachable networks and EAGAIN.
+   */
+  [[nodiscard]] bool is_transient_error(const std::error_code &ec) noexcept;
+
+  /**
+   * @brief Sleep before the given retry.
+   *
+   * cap = min(max_backoff, initial_backoff * multiplier^(retry - 1)); the
+   * result is uniform in [0, cap] with jitter, cap otherwise.
+   *
+   * @param policy Retry policy.
+   * @param retry 1 for the first retry, 2 for the second, ...
+   */
+  [[nodiscard]] timer::duration backoff_delay(const retry_policy &policy, std::uint32_t retry) noexcept;
+
+  namespace detail
+  {
+    inline bool should_retry(const retry_policy &policy, const std::error_code &ec)
+    {
+      if (ec == errc::canceled)
+      {
+        return false;
+      }
+      return policy.retryable ? policy.retryable(ec) : is_transient_error(ec);
+    }
+  } // namespace detail
+
+  /**
+   * @brief Run factory() until it succeeds, with exponential backoff.
+   *
+   * Each attempt awaits a fresh task from factory. An attempt failing with a
+   * std::system_error whose code is retryable is followed by a
+   * backoff_delay() sleep on ctx.timers() and another attempt, as long as
+   * attempts and the shared budget allow. Other exceptions, non-retryable
+   * codes and the last failure are rethrown unchanged.
+   *
+   * ct is checked before every attempt and before and after every
+   * backoff. A cancel does not interrupt a backoff already under way: it
+   * is reported when that backoff ends, so retry() can take up to
+   * max_backoff to throw. Pass ct on to the attempts themselves so that
+   * cancellation also reaches the work in flight. Backoffs are awaited
+   * with timer::wait_for(), without a task frame or an internal exception.
+   *
+   * @code
+   * auto body = co_await retry(ctx, policy, [&] { return client.async_get(ep, "/"); }, ct);
+   * @endcode
+   *
+   * @tparam Factory Callable returning task<T>.
+   * @param ctx Runtime context providing the timer.
+   * @param policy Attempts, backoff, predicate and budget.
+   * @param factory Called once per attempt.
+   * @param ct Cancellation token.
+   * @return task<T> with the result of the first successful attempt.
+   * @throws std::system_error (errc::canceled) if ct is cancelled.
+   */
+  template <typename Factory>
+  auto retry(io_context &ctx, retry_policy policy, Factory factory, cancel_token ct = {})
+      -> task<typename detail::task_result<std::invoke_result_t<Factory &>>::type>
+  {
+    using T = typename detail::task_result<std::invoke_result_t<Factory &>>::type;
+
+    for (std::uint32_t attempt = 1;; ++attempt)
+    {
+      if (ct.is_cancelled())
+      {
+        throw std::system_error(cancelled_ec());
+      }
+
+      std::exception_ptr failure;
+      std::error_code ec;
+      try
+      {
+        if constexpr (std::is_void_v<T>)
+        {
+          co_await factory();
+          if (policy.budget)
+          {
+            policy.budget->record_success();
+          }
+          co_return;
+        }
+        else
+        {
+          T value = co_await factory();
+          if (policy.budget)
+          {
+            policy.budget->record_success();
+          }
+          co_return value;
+        }
+      }
+      catch (const std::system_error &e)
+      {
+        failure = std::current_exception();
+        ec = e.code();
+      }
+
+      if (!detail::should_retry(policy, ec))
+      {
+        std::rethrow_exception(failure);
+      }
+      if (policy.budget)
+      {
+        policy.budget->record_failure();
+      }
+      if (attempt >= policy.max_attempts || (policy.budget && !policy.budget->allows_retry()))
+      {
+        std::rethrow_exception(failure);
+      }
+
+      timer::wait_awaitable pause = ctx.timers().wait_for(backoff_delay(policy, attempt), ct);
+      if (!co_await pause)
+      {
+        throw std::system_error(cancelled_ec());
+      }
+    }
+  }
+
+} // namespace vix::async::core
+
+#endif // VIX_ASYNC_RETRY_HPP
@@ -16,15 +16,25 @@
 #ifndef VIX_ASYNC_SCHEDULER_HPP
 #define VIX_ASYNC_SCHEDULER_HPP
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <coroutine>
 #include <cstdint>
-#include <deque>
 #include <functional>
 #include <mutex>
+#include <span>
+#include <system_error>
 #include <utility>
 
+#include <vix/async/core/error.hpp>
+#include <vix/async/core/executor.hpp>
+#include <vix/async/core/metrics.hpp>
+#include <vix/async/core/trace.hpp>
+#include <vix/async/detail/config.hpp>
+#include <vix/async/detail/ring_queue.hpp>
+
 namespace vix::async::core
 {
   /**
@@ -46,6 +56,19 @@ namespace vix::async::core
    *
    * This is a small building block designed to be embedded into higher-level
    * runtime contexts (e.g. io_context).
+   *
+   * When ASYNC_ENABLE_METRICS is set, each queued item carries its enqueue
+   * time and the loop maintains relaxed atomic counters readable through
+   * metrics() without taking the queue mutex.
+   *
+   * Admission control follows CoDel: the loop tracks the smallest queueing
+   * delay seen in each interval, and when even that minimum exceeds the
+   * target the scheduler reports overloaded() until the delay drops again.
+   * A standing queue means new work only makes everything slower, so
+   * optional work (new connections, background jobs) should be turned away
+   * through try_admit() / admit() instead of being queued. It is off unless
+   * ASYNC_ADMISSION_TARGET_US or set_admission() gives it a target; while
+   * off, post() and the loop skip the clock reads it needs.
    */
   class scheduler
   {
@@ -65,6 +88,62 @@ namespace vix::async::core
      */
     scheduler &operator=(const scheduler &) = delete;
 
+    /**
+     * @brief Kind of work item being executed by run().
+     */
+    enum class work_kind : std::uint8_t
+    {
+      /** @brief No item running (idle, or not watched). */
+      none,
+
+      /** @brief A coroutine continuation. */
+      handle,
+
+      /** @brief A generic callable. */
+      function
+    };
+
+    /**
+     * @brief Snapshot of the item currently executed by run().
+     *
+     * Only maintained while at least one watcher is attached
+     * (see add_watcher()).
+     */
+    struct running_item
+    {
+      /** @brief Sequence number of the item, increasing per watched item. */
+      std::uint64_t seq{0};
+
+      /** @brief Start time on metrics_clock in nanoseconds, 0 when idle. */
+      std::uint64_t started_ns{0};
+
+      /** @brief Kind of the running item. */
+      work_kind kind{work_kind::none};
+
+      /**
+       * @brief Coroutine frame address for handles, null for callables.
+       *
+       * Matches the "handle" id of scheduler events in trace output.
+       */
+      const void *id{nullptr};
+    };
+
+    /**
+     * @brief CoDel-style admission control settings.
+     */
+    struct admission_options
+    {
+      /**
+       * @brief Acceptable standing queue delay; zero disables admission control.
+       */
+      std::chrono::nanoseconds target{std::chrono::microseconds(ASYNC_ADMISSION_TARGET_US)};
+
+      /**
+       * @brief Window over which the minimum queue delay is measured.
+       */
+      std::chrono::nanoseconds interval{std::chrono::milliseconds(ASYNC_ADMISSION_INTERVAL_MS)};
+    };
+
     /**
      * @brief Post a generic callable to be executed by the scheduler loop.
      *
@@ -77,12 +156,22 @@ namespace vix::async::core
     template <typename Fn>
     void post(Fn &&fn)
     {
+      const std::uint64_t now = enqueue_stamp();
+
+      bool wake = false;
       {
         std::lock_guard<std::mutex> lock(m_);
-        fn_q_.emplace_back(std::forward<Fn>(fn));
+        fn_q_.push_back(fn_entry{std::function<void()>(std::forward<Fn>(fn)), now});
+        on_posted(metrics_.fn_posts);
+        wake = sleepers_ != 0;
       }
 
-      cv_.notify_one();
+      ASYNC_TRACE(post_fn, nullptr, nullptr);
+
+      if (wake)
+      {
+        cv_.notify_one();
+      }
     }
 
     /**
@@ -100,12 +189,69 @@ namespace vix::async::core
         return;
       }
 
+      const std::uint64_t now = enqueue_stamp();
+
+      bool wake = false;
       {
         std::lock_guard<std::mutex> lock(m_);
-        handle_q_.emplace_back(h);
+        handle_q_.push_back(handle_entry{h, now});
+        on_posted(metrics_.handle_posts);
+        wake = sleepers_ != 0;
       }
 
-      cv_.notify_one();
+      ASYNC_TRACE(post_handle, h.address(), nullptr);
+
+      // A busy loop finds the item on its next pass; only a sleeping one
+      // needs the futex wake.
+      if (wake)
+      {
+        cv_.notify_one();
+      }
+    }
+
+    /**
+     * @brief Post several coroutine continuations at once.
+     *
+     * Takes the queue lock and wakes the loop once for the whole batch,
+     * which matters when one event releases many waiters. Handles are
+     * resumed in order.
+     *
+     * @param hs Coroutine handles to resume (null handles are skipped).
+     */
+    void post_batch(std::span<const std::coroutine_handle<>> hs) noexcept
+    {
+      if (hs.empty())
+      {
+        return;
+      }
+
+      const std::uint64_t now = enqueue_stamp();
+
+      bool wake = false;
+      {
+        std::lock_guard<std::mutex> lock(m_);
+        for (const std::coroutine_handle<> h : hs)
+        {
+          if (h)
+          {
+            handle_q_.push_back(handle_entry{h, now});
+            on_posted(metrics_.handle_posts);
+          }
+        }
+        wake = sleepers_ != 0;
+      }
+
+#if ASYNC_ENABLE_TRACING
+      for (const std::coroutine_handle<> h : hs)
+      {
+        ASYNC_TRACE(post_handle, h.address(), nullptr);
+      }
+#endif
+
+      if (wake)
+      {
+        cv_.notify_one();
+      }
     }
 
     /**
@@ -136,6 +282,11 @@ namespace vix::async::core
        */
       scheduler *s{};
 
+      /**
+       * @brief Suspension label reported by tracing and the task registry.
+       */
+      static constexpr const char *awaiting_label() noexcept { return "scheduler hop"; }
+
       /**
        * @brief Always suspend to ensure the continuation is enqueued.
        *
@@ -181,60 +332,153 @@ namespace vix::async::core
       return schedule_awaitable{this};
     }
 
+    /**
+     * @brief Executor resuming coroutines on this scheduler's run() thread.
+     */
+    executor get_executor() noexcept
+    {
+      return executor(this, [](void *self, std::coroutine_handle<> h) noexcept
+                      { static_cast<scheduler *>(self)->post(h); });
+    }
+
     /**
      * @brief Run the scheduler event loop on the current thread.
      *
      * This function blocks, waiting for new work. It executes coroutine
      * handles first, then generic callables, until stop() is requested
-     * and both queues are drained.
+     * and both queues are drained, or an idle handler runs out of work.
      */
     void run()
     {
       running_.store(true, std::memory_order_release);
 
+      const executor self = get_executor();
+      const executor outer = detail::exchange_current_executor(self);
+
       while (true)
       {
+        // An item switching to the inline executor must not leak it to the next.
+        detail::exchange_current_executor(self);
+
         std::coroutine_handle<> h{};
         std::function<void()> fn{};
+        std::uint64_t enqueued_ns = 0;
 
         {
           std::unique_lock<std::mutex> lock(m_);
-          cv_.wait(lock, [this]()
-                   { return stop_requested_.load(std::memory_order_acquire) ||
-                            !handle_q_.empty() ||
-                            !fn_q_.empty(); });
+
+          auto ready = [this]()
+          {
+            return stop_requested_.load(std::memory_order_acquire) ||
+                   !handle_q_.empty() ||
+                   !fn_q_.empty();
+          };
+
+          if (!ready())
+          {
+            // An empty queue has no standing delay.
+            leave_overload();
+          }
+
+          if (!ready() && idle_handler_)
+          {
+            lock.unlock();
+            const bool more = idle_handler_();
+            lock.lock();
+
+            if (!more && !ready())
+            {
+              break;
+            }
+            continue;
+          }
+
+          if (!ready())
+          {
+#if ASYNC_ENABLE_METRICS
+            const std::uint64_t idle_from = detail::metrics_now_ns();
+#endif
+            ++sleepers_;
+            cv_.wait(lock, ready);
+            --sleepers_;
+#if ASYNC_ENABLE_METRICS
+            metrics_.idle_ns.fetch_add(
+                detail::metrics_now_ns() - idle_from,
+                std::memory_order_relaxed);
+#endif
+          }
 
           if (stop_requested_.load(std::memory_order_acquire))
           {
             handle_q_.clear();
             fn_q_.clear();
+#if ASYNC_ENABLE_METRICS
+            metrics_.queue_depth.store(0, std::memory_order_relaxed);
+#endif
             break;
           }
 
           if (!handle_q_.empty())
           {
-            h = handle_q_.front();
+            h = handle_q_.front().h;
+            enqueued_ns = handle_q_.front().enqueued_ns;
             handle_q_.pop_front();
           }
           else if (!fn_q_.empty())
           {
-            fn = std::move(fn_q_.front());
+            fn = std::move(fn_q_.front().fn);
+            enqueued_ns = fn_q_.front().enqueued_ns;
             fn_q_.pop_front();
           }
+
+#if ASYNC_ENABLE_METRICS
+          metrics_.queue_depth.store(
+              handle_q_.size() + fn_q_.size(),
+              std::memory_order_relaxed);
+#endif
         }
 
+        on_dequeued(enqueued_ns, h ? metrics_.handle_runs : metrics_.fn_runs);
+
+        const bool watched = watchers_.load(std::memory_order_relaxed) != 0;
+
         if (h)
         {
+          if (watched)
+          {
+            begin_item(work_kind::handle, h.address());
+          }
+
+          ASYNC_TRACE(run_begin, h.address(), "run handle");
           h.resume();
+          ASYNC_TRACE(run_end, nullptr, nullptr);
+
+          if (watched)
+          {
+            end_item();
+          }
           continue;
         }
 
         if (fn)
         {
+          if (watched)
+          {
+            begin_item(work_kind::function, nullptr);
+          }
+
+          ASYNC_TRACE(run_begin, nullptr, "run fn");
           fn();
+          ASYNC_TRACE(run_end, nullptr, nullptr);
+
+          if (watched)
+          {
+            end_item();
+          }
         }
       }
 
+      detail::exchange_current_executor(outer);
       running_.store(false, std::memory_order_release);
     }
 
@@ -246,7 +490,12 @@ namespace vix::async::core
      */
     void stop() noexcept
     {
-      stop_requested_.store(true, std::memory_order_release);
+      {
+        // Under the lock, so a run() between its ready() check and the
+        // wait cannot miss the request.
+        std::lock_guard<std::mutex> lock(m_);
+        stop_requested_.store(true, std::memory_order_release);
+      }
       cv_.notify_all();
     }
 
@@ -314,6 +563,329 @@ namespace vix::async::core
       return handle_q_.size() + fn_q_.size();
     }
 
+    /**
+     * @brief Install a handler run() calls when it runs out of work.
+     *
+     * Called on the run() thread, without the queue lock, whenever both
+     * queues are empty. It returns true after queuing work (or trying to),
+     * and false when it has none to give: run() then returns instead of
+     * sleeping. The io_context uses it to drive its virtual clock.
+     *
+     * Must not be called while run() is active.
+     *
+     * @param fn Idle handler (empty: sleep until work is posted).
+     */
+    void set_idle_handler(std::function<bool()> fn)
+    {
+      idle_handler_ = std::move(fn);
+    }
+
+    /**
+     * @brief Change the admission control settings.
+     *
+     * Safe to call from any thread; takes effect at the next interval.
+     *
+     * @param opts New settings (target == 0 turns admission control off).
+     */
+    void set_admission(admission_options opts) noexcept
+    {
+      admission_interval_ns_.store(static_cast<std::uint64_t>(std::max<std::int64_t>(opts.interval.count(), 1)), std::memory_order_relaxed);
+      admission_target_ns_.store(static_cast<std::uint64_t>(std::max<std::int64_t>(opts.target.count(), 0)), std::memory_order_relaxed);
+      if (opts.target.count() <= 0)
+      {
+        overloaded_.store(false, std::memory_order_relaxed);
+      }
+    }
+
+    /**
+     * @brief Current admission control settings.
+     */
+    admission_options admission() const noexcept
+    {
+      admission_options opts;
+      opts.target = std::chrono::nanoseconds(admission_target_ns_.load(std::memory_order_relaxed));
+      opts.interval = std::chrono::nanoseconds(admission_interval_ns_.load(std::memory_order_relaxed));
+      return opts;
+    }
+
+    /**
+     * @brief Whether queued items have been waiting longer than the target
+     * for a whole interval.
+     *
+     * One relaxed load; safe to call from any thread.
+     */
+    bool overloaded() const noexcept
+    {
+      return overloaded_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Admission check for optional work.
+     *
+     * @return false (and counts a rejection) while overloaded().
+     */
+    bool try_admit() noexcept
+    {
+      if (!overloaded())
+      {
+        return true;
+      }
+#if ASYNC_ENABLE_METRICS
+      metrics_.rejected.fetch_add(1, std::memory_order_relaxed);
+#endif
+      return false;
+    }
+
+    /**
+     * @brief Throwing form of try_admit().
+     *
+     * @throws std::system_error (errc::rejected) while overloaded().
+     */
+    void admit()
+    {
+      if (!try_admit())
+      {
+        throw std::system_error(make_error_code(errc::rejected));
+      }
+    }
+
+    /**
+     * @brief Live scheduler counters.
+     *
+     * Reading never takes the queue mutex. Counters stay at zero when
+     * ASYNC_ENABLE_METRICS is 0.
+     *
+     * @return Reference to the scheduler counters.
+     */
+    const scheduler_metrics &metrics() const noexcept
+    {
+      return metrics_;
+    }
+
+    /**
+     * @brief Start tracking the item executed by run().
+     *
+     * Tracking costs one clock read and a few relaxed stores per item and is
+     * skipped entirely while no watcher is attached. Calls are counted and
+     * must be balanced by remove_watcher().
+     */
+    void add_watcher() noexcept
+    {
+      watchers_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Stop tracking once the last watcher is removed.
+     */
+    void remove_watcher() noexcept
+    {
+      watchers_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Read the item currently executed by run().
+     *
+     * Safe to call from any thread. The fields are read under a seqlock and
+     * retried until a read sees no concurrent begin_item().
+     *
+     * @return Snapshot with started_ns == 0 when idle.
+     */
+    running_item current_item() const noexcept
+    {
+      running_item it;
+
+      for (;;)
+      {
+        const std::uint64_t seq = item_seq_.load(std::memory_order_acquire);
+        if ((seq & 1) != 0)
+        {
+          // begin_item() is writing.
+          continue;
+        }
+
+        it.started_ns = item_start_ns_.load(std::memory_order_relaxed);
+        it.kind = item_kind_.load(std::memory_order_relaxed);
+        it.id = item_id_.load(std::memory_order_relaxed);
+
+        // Orders the reads above before the re-check.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (item_seq_.load(std::memory_order_relaxed) == seq)
+        {
+          it.seq = seq / 2;
+          break;
+        }
+      }
+
+      if (it.started_ns == 0)
+      {
+        it.kind = work_kind::none;
+        it.id = nullptr;
+      }
+
+      return it;
+    }
+
+  private:
+    /**
+     * @brief Publish the item about to run for watchers.
+     *
+     * @param kind Item kind.
+     * @param id Frame address for handles, null for callables.
+     */
+    void begin_item(work_kind kind, const void *id) noexcept
+    {
+      // Seqlock write: odd while the fields change. run() is the only writer.
+      const std::uint64_t seq = item_seq_.load(std::memory_order_relaxed);
+      item_seq_.store(seq + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+
+      item_kind_.store(kind, std::memory_order_relaxed);
+      item_id_.store(id, std::memory_order_relaxed);
+      item_start_ns_.store(detail::metrics_now_ns(), std::memory_order_relaxed);
+
+      item_seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Mark the loop as no longer running an item.
+     */
+    void end_item() noexcept
+    {
+      item_start_ns_.store(0, std::memory_order_release);
+    }
+
+    /**
+     * @brief Queued coroutine continuation.
+     */
+    struct handle_entry
+    {
+      /** @brief Handle to resume. */
+      std::coroutine_handle<> h;
+
+      /** @brief Enqueue time in nanoseconds (0 when histograms are disabled). */
+      std::uint64_t enqueued_ns;
+    };
+
+    /**
+     * @brief Queued generic callable.
+     */
+    struct fn_entry
+    {
+      /** @brief Callable to run. */
+      std::function<void()> fn;
+
+      /** @brief Enqueue time in nanoseconds (0 when histograms are disabled). */
+      std::uint64_t enqueued_ns;
+    };
+
+    /**
+     * @brief Timestamp recorded with a newly posted item.
+     *
+     * @return Current time, or 0 when neither histograms nor admission
+     * control need it.
+     */
+    std::uint64_t enqueue_stamp() const noexcept
+    {
+#if ASYNC_ENABLE_HISTOGRAMS
+      return detail::metrics_now_ns();
+#else
+      return admission_target_ns_.load(std::memory_order_relaxed) != 0 ? detail::metrics_now_ns() : 0;
+#endif
+    }
+
+    /**
+     * @brief Feed one queueing delay to the CoDel estimator. Loop thread only.
+     *
+     * @param sojourn_ns Time the item spent queued.
+     * @param now Current time in nanoseconds.
+     */
+    void update_admission(std::uint64_t sojourn_ns, std::uint64_t now) noexcept
+    {
+      const std::uint64_t target = admission_target_ns_.load(std::memory_order_relaxed);
+      if (target == 0)
+      {
+        return;
+      }
+
+      if (now < window_end_ns_)
+      {
+        window_min_ns_ = std::min(window_min_ns_, sojourn_ns);
+        return;
+      }
+
+      const bool over = window_end_ns_ != 0 && window_min_ns_ > target;
+      if (over != overloaded_.load(std::memory_order_relaxed))
+      {
+        overloaded_.store(over, std::memory_order_relaxed);
+#if ASYNC_ENABLE_METRICS
+        if (over)
+        {
+          metrics_.overloads.fetch_add(1, std::memory_order_relaxed);
+        }
+#endif
+      }
+
+      window_min_ns_ = sojourn_ns;
+      window_end_ns_ = now + admission_interval_ns_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Clear the overload state and restart the window. Loop thread only.
+     */
+    void leave_overload() noexcept
+    {
+      window_end_ns_ = 0;
+      if (overloaded_.load(std::memory_order_relaxed))
+      {
+        overloaded_.store(false, std::memory_order_relaxed);
+      }
+    }
+
+    /**
+     * @brief Account for one post. Called with m_ held.
+     *
+     * @param lane Per-lane post counter.
+     */
+    void on_posted(std::atomic<std::uint64_t> &lane) noexcept
+    {
+#if ASYNC_ENABLE_METRICS
+      const std::uint64_t depth = handle_q_.size() + fn_q_.size();
+      lane.fetch_add(1, std::memory_order_relaxed);
+      metrics_.queue_depth.store(depth, std::memory_order_relaxed);
+      detail::update_max(metrics_.queue_depth_hwm, depth);
+#else
+      (void)lane;
+#endif
+    }
+
+    /**
+     * @brief Account for one dequeued item before it runs.
+     *
+     * @param enqueued_ns Enqueue timestamp of the item.
+     * @param lane Per-lane run counter.
+     */
+    void on_dequeued(std::uint64_t enqueued_ns, std::atomic<std::uint64_t> &lane) noexcept
+    {
+#if ASYNC_ENABLE_METRICS
+      metrics_.loop_iterations.fetch_add(1, std::memory_order_relaxed);
+      lane.fetch_add(1, std::memory_order_relaxed);
+#else
+      (void)lane;
+#endif
+
+      if (enqueued_ns == 0)
+      {
+        return;
+      }
+
+      const std::uint64_t now = detail::metrics_now_ns();
+      const std::uint64_t sojourn = now > enqueued_ns ? now - enqueued_ns : 0;
+#if ASYNC_ENABLE_HISTOGRAMS
+      metrics_.post_to_resume.record(sojourn);
+#endif
+      update_admission(sojourn, now);
+    }
+
   private:
     /**
      * @brief Mutex protecting internal queues.
@@ -325,19 +897,30 @@ namespace vix::async::core
      */
     std::condition_variable cv_;
 
+    /**
+     * @brief run() loops blocked on cv_ (guarded by m_).
+     */
+    std::size_t sleepers_{0};
+
+    /**
+     * @brief Called by run() instead of sleeping (see set_idle_handler()).
+     */
+    std::function<bool()> idle_handler_;
+
     /**
      * @brief FIFO queue dedicated to coroutine continuations.
      *
-     * This is the hot path of the async runtime.
+     * This is the hot path of the async runtime. A ring rather than a
+     * std::deque, so steady-state posting does not allocate.
      */
-    std::deque<std::coroutine_handle<>> handle_q_;
+    vix::async::detail::ring_queue<handle_entry> handle_q_;
 
     /**
      * @brief FIFO queue for generic callbacks.
      *
      * This is the slower fallback path for ordinary callables.
      */
-    std::deque<std::function<void()>> fn_q_;
+    vix::async::detail::ring_queue<fn_entry> fn_q_;
 
     /**
      * @brief Stop request flag observed by run().
@@ -348,6 +931,43 @@ namespace vix::async::core
      * @brief Indicates whether run() is currently active.
      */
     std::atomic<bool> running_{false};
+
+    /**
+     * @brief Hot-path counters, updated with relaxed atomics.
+     */
+    scheduler_metrics metrics_{};
+
+    /**
+     * @brief Number of attached watchers; item tracking is off when 0.
+     */
+    std::atomic<int> watchers_{0};
+
+    /** @brief Seqlock over the item fields: twice the item count, odd while they change. */
+    std::atomic<std::uint64_t> item_seq_{0};
+
+    /** @brief Start time of the running item, 0 when idle. */
+    std::atomic<std::uint64_t> item_start_ns_{0};
+
+    /** @brief Kind of the running item. */
+    std::atomic<work_kind> item_kind_{work_kind::none};
+
+    /** @brief Identity of the running item. */
+    std::atomic<const void *> item_id_{nullptr};
+
+    /** @brief CoDel target in nanoseconds, 0 when disabled. */
+    std::atomic<std::uint64_t> admission_target_ns_{ASYNC_ADMISSION_TARGET_US * 1000ull};
+
+    /** @brief CoDel interval in nanoseconds. */
+    std::atomic<std::uint64_t> admission_interval_ns_{ASYNC_ADMISSION_INTERVAL_MS * 1000000ull};
+
+    /** @brief Result of the last completed interval. */
+    std::atomic<bool> overloaded_{false};
+
+    /** @brief End of the current interval (loop thread only, 0 = not started). */
+    std::uint64_t window_end_ns_{0};
+
+    /** @brief Smallest queueing delay in the current interval (loop thread only). */
+    std::uint64_t window_min_ns_{0};
   };
 
 } // namespace vix::async::core
@@ -0,0 +1,395 @@
+/**
+ *
+ *  @file shared_mutex.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_ASYNC_SHARED_MUTEX_HPP
+#define VIX_ASYNC_SHARED_MUTEX_HPP
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+#include <vix/async/core/executor.hpp>
+
+namespace vix::async::core
+{
+  /**
+   * @brief Reader-writer lock for coroutines.
+   *
+   * Suspends instead of blocking. Meant for read-mostly state such as
+   * routing tables: any number of readers share it, one writer excludes
+   * them all.
+   *
+   * - An uncontended lock_shared() or unlock_shared() is one atomic
+   *   read-modify-write.
+   * - Writer preference: once a writer waits, new readers queue behind it
+   *   and it gets the lock as soon as the current readers leave.
+   * - Readers are admitted in batches: when a writer unlocks, every
+   *   queued reader gets the lock at once, even if more writers wait, so
+   *   a stream of writers cannot starve them.
+   * - Waiters are queued intrusively in their awaiters (no allocation).
+   * - A waiter resumes on the executor it awaited from, or inline on the
+   *   unlocking thread when it had none.
+   *
+   * @code
+   * auto g = co_await routes_mutex.scoped_lock_shared();
+   * const route *r = routes.find(path);
+   * @endcode
+   *
+   * Not recursive. All methods are thread-safe.
+   */
+  class async_shared_mutex
+  {
+  public:
+    class shared_guard;
+    class unique_guard;
+
+    /**
+     * @brief Intrusive queue node living in an awaiter.
+     */
+    struct waiter
+    {
+      /** @brief Next node in the queue. */
+      waiter *next{nullptr};
+
+      /** @brief Suspended coroutine. */
+      std::coroutine_handle<> h{};
+
+      /** @brief Where h resumes. */
+      executor exec{};
+    };
+
+    /**
+     * @brief Awaitable returned by lock_shared().
+     */
+    struct lock_shared_awaitable : waiter
+    {
+      /** @brief Mutex being locked. */
+      async_shared_mutex *m;
+
+      explicit lock_shared_awaitable(async_shared_mutex &mtx) noexcept
+          : m(&mtx)
+      {
+      }
+
+      /** @brief Suspension label reported by tracing and the task registry. */
+      static constexpr const char *awaiting_label() noexcept { return "shared_mutex read"; }
+
+      /**
+       * @brief Fast path: one fetch_add when no writer holds or waits.
+       */
+      bool await_ready() noexcept
+      {
+        return m->fast_lock_shared();
+      }
+
+      bool await_suspend(std::coroutine_handle<> handle) noexcept
+      {
+        h = handle;
+        exec = detail::resume_executor(executor::inline_executor());
+        return m->suspend_shared(*this);
+      }
+
+      void await_resume() const noexcept {}
+    };
+
+    /**
+     * @brief Awaitable returned by lock().
+     */
+    struct lock_awaitable : waiter
+    {
+      /** @brief Mutex being locked. */
+      async_shared_mutex *m;
+
+      explicit lock_awaitable(async_shared_mutex &mtx) noexcept
+          : m(&mtx)
+      {
+      }
+
+      /** @brief Suspension label reported by tracing and the task registry. */
+      static constexpr const char *awaiting_label() noexcept { return "shared_mutex write"; }
+
+      bool await_ready() noexcept
+      {
+        return m->try_lock();
+      }
+
+      bool await_suspend(std::coroutine_handle<> handle) noexcept
+      {
+        h = handle;
+        exec = detail::resume_executor(executor::inline_executor());
+        return m->suspend_unique(*this);
+      }
+
+      void await_resume() const noexcept {}
+    };
+
+    /**
+     * @brief lock_shared() resuming with a guard.
+     */
+    struct scoped_lock_shared_awaitable : lock_shared_awaitable
+    {
+      using lock_shared_awaitable::lock_shared_awaitable;
+
+      shared_guard await_resume() const noexcept
+      {
+        return shared_guard(*m);
+      }
+    };
+
+    /**
+     * @brief lock() resuming with a guard.
+     */
+    struct scoped_lock_awaitable : lock_awaitable
+    {
+      using lock_awaitable::lock_awaitable;
+
+      unique_guard await_resume() const noexcept
+      {
+        return unique_guard(*m);
+      }
+    };
+
+    /**
+     * @brief Holds a shared lock; unlocks it when destroyed.
+     */
+    class [[nodiscard]] shared_guard
+    {
+    public:
+      shared_guard(shared_guard &&other) noexcept
+          : m_(std::exchange(other.m_, nullptr))
+      {
+      }
+
+      shared_guard &operator=(shared_guard &&other) noexcept
+      {
+        if (this != &other)
+        {
+          unlock();
+          m_ = std::exchange(other.m_, nullptr);
+        }
+        return *this;
+      }
+
+      shared_guard(const shared_guard &) = delete;
+      shared_guard &operator=(const shared_guard &) = delete;
+
+      ~shared_guard()
+      {
+        unlock();
+      }
+
+      /**
+       * @brief Release the lock early.
+       */
+      void unlock() noexcept
+      {
+        if (m_)
+        {
+          std::exchange(m_, nullptr)->unlock_shared();
+        }
+      }
+
+    private:
+      friend struct scoped_lock_shared_awaitable;
+
+      explicit shared_guard(async_shared_mutex &m) noexcept
+          : m_(&m)
+      {
+      }
+
+      async_shared_mutex *m_;
+    };
+
+    /**
+     * @brief Holds the exclusive lock; unlocks it when destroyed.
+     */
+    class [[nodiscard]] unique_guard
+    {
+    public:
+      unique_guard(unique_guard &&other) noexcept
+          : m_(std::exchange(other.m_, nullptr))
+      {
+      }
+
+      unique_guard &operator=(unique_guard &&other) noexcept
+      {
+        if (this != &other)
+        {
+          unlock();
+          m_ = std::exchange(other.m_, nullptr);
+        }
+        return *this;
+      }
+
+      unique_guard(const unique_guard &) = delete;
+      unique_guard &operator=(const unique_guard &) = delete;
+
+      ~unique_guard()
+      {
+        unlock();
+      }
+
+      /**
+       * @brief Release the lock early.
+       */
+      void unlock() noexcept
+      {
+        if (m_)
+        {
+          std::exchange(m_, nullptr)->unlock();
+        }
+      }
+
+    private:
+      friend struct scoped_lock_awaitable;
+
+      explicit unique_guard(async_shared_mutex &m) noexcept
+          : m_(&m)
+      {
+      }
+
+      async_shared_mutex *m_;
+    };
+
+    async_shared_mutex() noexcept = default;
+
+    async_shared_mutex(const async_shared_mutex &) = delete;
+    async_shared_mutex &operator=(const async_shared_mutex &) = delete;
+
+    /**
+     * @brief Acquire a shared lock; release it with unlock_shared().
+     */
+    [[nodiscard]] lock_shared_awaitable lock_shared() noexcept
+    {
+      return lock_shared_awaitable(*this);
+    }
+
+    /**
+     * @brief Acquire a shared lock held by the returned guard.
+     */
+    [[nodiscard]] scoped_lock_shared_awaitable scoped_lock_shared() noexcept
+    {
+      return scoped_lock_shared_awaitable(*this);
+    }
+
+    /**
+     * @brief Acquire the exclusive lock; release it with unlock().
+     */
+    [[nodiscard]] lock_awaitable lock() noexcept
+    {
+      return lock_awaitable(*this);
+    }
+
+    /**
+     * @brief Acquire the exclusive lock held by the returned guard.
+     */
+    [[nodiscard]] scoped_lock_awaitable scoped_lock() noexcept
+    {
+      return scoped_lock_awaitable(*this);
+    }
+
+    /**
+     * @brief Take a shared lock if no writer holds or waits for it.
+     */
+    [[nodiscard]] bool try_lock_shared() noexcept
+    {
+      std::uint64_t s = state_.load(std::memory_order_relaxed);
+      while ((s & writer_bit) == 0)
+      {
+        if (state_.compare_exchange_weak(s, s + 1, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /**
+     * @brief Take the exclusive lock if it is free.
+     */
+    [[nodiscard]] bool try_lock() noexcept
+    {
+      std::uint64_t expected = 0;
+      return state_.compare_exchange_strong(expected, writer_bit, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Release a shared lock.
+     */
+    void unlock_shared() noexcept
+    {
+      const std::uint64_t old = state_.fetch_sub(1, std::memory_order_release);
+      if ((old & writer_bit) != 0 && (old & readers_mask) == 1)
+      {
+        // Last reader out while a writer waits for them.
+        wake_drained();
+      }
+    }
+
+    /**
+     * @brief Release the exclusive lock.
+     *
+     * Admits every queued reader if there are any, otherwise hands the lock
+     * to the next queued writer.
+     */
+    void unlock() noexcept;
+
+  private:
+    /** @brief Set while a writer holds the lock or waits for readers to leave. */
+    static constexpr std::uint64_t writer_bit = std::uint64_t{1} << 63;
+
+    /** @brief Readers holding the lock, plus readers about to find out they cannot. */
+    static constexpr std::uint64_t readers_mask = writer_bit - 1;
+
+    bool fast_lock_shared() noexcept
+    {
+      return (state_.fetch_add(1, std::memory_order_acquire) & writer_bit) == 0;
+    }
+
+    bool suspend_shared(waiter &w) noexcept;
+    bool suspend_unique(waiter &w) noexcept;
+    void wake_drained() noexcept;
+
+    /**
+     * @brief Reader count and writer_bit.
+     *
+     * A reader's fast path adds itself first and checks for the writer
+     * after, so a failed attempt leaves a transient count that it removes
+     * under m_. writer_bit is cleared only under m_, but try_lock() sets
+     * it without m_ whenever state_ is 0, so the slow paths test and set
+     * it in single atomic operations rather than load-then-modify.
+     */
+    std::atomic<std::uint64_t> state_{0};
+
+    /** @brief Serializes the slow paths and guards the queues below. */
+    std::mutex m_;
+
+    /** @brief Queued readers (FIFO). */
+    waiter *readers_head_{nullptr};
+    waiter *readers_tail_{nullptr};
+
+    /** @brief Queued writers (FIFO). */
+    waiter *writers_head_{nullptr};
+    waiter *writers_tail_{nullptr};
+
+    /** @brief Writer owning writer_bit, waiting for the readers to leave. */
+    waiter *draining_{nullptr};
+  };
+
+} // namespace vix::async::core
+
+#endif // VIX_ASYNC_SHARED_MUTEX_HPP
@@ -115,6 +115,19 @@ namespace vix::async::core
      */
     void on_signal(std::function<void(int)> fn);
 
+    /**
+     * @brief Subscribe a callback to one signal, alongside other users.
+     *
+     * Unlike on_signal(), which holds a single callback, every watch()
+     * stays in effect. The signal is observed without being add()ed, so
+     * it reaches neither on_signal() nor async_wait() unless it is also
+     * added. Starts the watcher thread. Runs on the scheduler thread.
+     *
+     * @param sig Signal number such as SIGUSR1.
+     * @param fn Callback taking the signal number.
+     */
+    void watch(int sig, std::function<void(int)> fn);
+
     /**
      * @brief Stop signal watching and wake any waiter.
      *
@@ -171,6 +184,17 @@ namespace vix::async::core
      */
     std::function<void(int)> on_signal_{};
 
+    /**
+     * @brief Per-signal subscribers registered with watch().
+     */
+    std::vector<std::pair<int, std::function<void(int)>>> watchers_;
+
+    /**
+     * @brief Signal the worker has blocked and is waiting in sigwait() for;
+     * 0 otherwise. The destructor sends it to wake the worker.
+     */
+    int waiting_sig_{0};
+
     /**
      * @brief Queue of captured signals waiting to be delivered.
      */
@@ -0,0 +1,493 @@
+/**
+ *
+ *  @file spsc_queue.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_ASYNC_SPSC_QUEUE_HPP
+#define VIX_ASYNC_SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <bit>
+#include <coroutine>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <vix/async/core/error.hpp>
+#include <vix/async/core/scheduler.hpp>
+
+namespace vix::async::core
+{
+  /**
+   * @brief Lock-free single-producer, single-consumer ring.
+   *
+   * Hands values from one thread to one coroutine at the lowest cost
+   * possible. The producer is any plain thread (an ingest thread outside
+   * the library, for example) and never blocks: try_push() fails when the
+   * ring is full. The consumer co_awaits pop() and only suspends when the
+   * ring is empty; the push that fills it again resumes it with a single
+   * scheduler post.
+   *
+   * - Head and tail live on separate cache lines, and each side keeps a
+   *   cached copy of the other's index, so an uncontended push or pop
+   *   touches no line written by the other side.
+   * - A push costs one release store plus a fence and a relaxed load to
+   *   check for a suspended consumer.
+   * - try_push_batch() and pop_batch() move several values for one index
+   *   update and at most one wakeup.
+   *
+   * Exactly one thread may push (and close), and one coroutine may pop,
+   * at a time.
+   *
+   * @code
+   * spsc_queue<packet> q(ctx.get_scheduler(), 1024);
+   *
+   * // ingest thread
+   * while (!q.try_push(read_packet())) {}
+   *
+   * // io_context
+   * packet p = co_await q.pop();
+   * @endcode
+   *
+   * @tparam T Value type (must be move-constructible).
+   */
+  template <typename T>
+  class spsc_queue
+  {
+    static_assert(std::is_nothrow_destructible_v<T>, "spsc_queue<T>: T must be nothrow destructible");
+
+  public:
+    /**
+     * @brief Awaitable returned by pop().
+     */
+    struct pop_awaitable
+    {
+      /** @brief Queue being read. */
+      spsc_queue *q;
+
+      /** @brief Suspension label reported by tracing and the task registry. */
+      static constexpr const char *awaiting_label() noexcept { return "spsc_queue pop"; }
+
+      bool await_ready() noexcept
+      {
+        return q->readable();
+      }
+
+      bool await_suspend(std::coroutine_handle<> h) noexcept
+      {
+        return q->suspend(h);
+      }
+
+      /**
+       * @throws std::system_error errc::closed once the queue is closed
+       *         and drained.
+       */
+      T await_resume()
+      {
+        if (!q->readable_now())
+        {
+          throw std::system_error(make_error_code(errc::closed));
+        }
+        return q->take();
+      }
+    };
+
+    /**
+     * @brief Awaitable returned by pop_batch().
+     */
+    struct pop_batch_awaitable
+    {
+      /** @brief Queue being read. */
+      spsc_queue *q;
+
+      /** @brief Destination. */
+      std::span<T> out;
+
+      /** @brief Suspension label reported by tracing and the task registry. */
+      static constexpr const char *awaiting_label() noexcept { return "spsc_queue pop"; }
+
+      bool await_ready() noexcept
+      {
+        return out.empty() || q->readable();
+      }
+
+      bool await_suspend(std::coroutine_handle<> h) noexcept
+      {
+        return q->suspend(h);
+      }
+
+      /**
+       * @return Number of values moved into out (at least 1 unless out is
+       *         empty).
+       * @throws std::system_error errc::closed once the queue is closed
+       *         and drained.
+       */
+      std::size_t await_resume()
+      {
+        const std::size_t n = q->try_pop_batch(out);
+        if (n == 0 && !out.empty())
+        {
+          throw std::system_error(make_error_code(errc::closed));
+        }
+        return n;
+      }
+    };
+
+    /**
+     * @brief Create a queue.
+     *
+     * @param sched Scheduler resuming the consumer after it suspended.
+     * @param capacity Minimum number of slots (rounded up to a power of two).
+     */
+    spsc_queue(scheduler &sched, std::size_t capacity)
+        : sched_(&sched),
+          capacity_(std::bit_ceil(capacity != 0 ? capacity : std::size_t{1})),
+          mask_(capacity_ - 1),
+          slots_(std::allocator<T>{}.allocate(capacity_))
+    {
+    }
+
+    /**
+     * @brief Destroy the values still queued.
+     *
+     * The consumer must not be suspended in pop().
+     */
+    ~spsc_queue()
+    {
+      const std::size_t t = tail_.load(std::memory_order_acquire);
+      for (std::size_t i = head_.load(std::memory_order_relaxed); i != t; ++i)
+      {
+        std::destroy_at(slot(i));
+      }
+      std::allocator<T>{}.deallocate(slots_, capacity_);
+    }
+
+    spsc_queue(const spsc_queue &) = delete;
+    spsc_queue &operator=(const spsc_queue &) = delete;
+
+    // ------------------------------------------------------------------
+    // Producer
+    // ------------------------------------------------------------------
+
+    /**
+     * @brief Push a value if there is room.
+     *
+     * @return false when the ring is full (value is left untouched).
+     */
+    bool try_push(T &&value)
+    {
+      return emplace(std::move(value));
+    }
+
+    /**
+     * @brief Push a copy of value if there is room.
+     *
+     * @return false when the ring is full.
+     */
+    bool try_push(const T &value)
+    {
+      return emplace(value);
+    }
+
+    /**
+     * @brief Move as many values as fit, in order, with one publication.
+     *
+     * @param values Values to push; the first n are moved from.
+     * @return n, the number of values pushed.
+     */
+    std::size_t try_push_batch(std::span<T> values)
+    {
+      const std::size_t t = tail_.load(std::memory_order_relaxed);
+      std::size_t room = capacity_ - (t - cached_head_);
+      if (room < values.size())
+      {
+        cached_head_ = head_.load(std::memory_order_acquire);
+        room = capacity_ - (t - cached_head_);
+      }
+
+      const std::size_t n = values.size() < room ? values.size() : room;
+      std::size_t i = 0;
+      try
+      {
+        for (; i < n; ++i)
+        {
+          std::construct_at(slot(t + i), std::move(values[i]));
+        }
+      }
+      catch (...)
+      {
+        publish(t + i);
+        throw;
+      }
+
+      if (n != 0)
+      {
+        publish(t + n);
+      }
+      return n;
+    }
+
+    /**
+     * @brief Stop the queue: once drained, pop() throws errc::closed.
+     *
+     * Called from the producer side. Idempotent.
+     */
+    void close() noexcept
+    {
+      closed_.store(true, std::memory_order_release);
+      wake(tail_.load(std::memory_order_relaxed));
+    }
+
+    // ------------------------------------------------------------------
+    // Consumer
+    // ------------------------------------------------------------------
+
+    /**
+     * @brief Pop a value, suspending while the queue is empty.
+     */
+    [[nodiscard]] pop_awaitable pop() noexcept
+    {
+      return pop_awaitable{this};
+    }
+
+    /**
+     * @brief Pop up to out.size() values, suspending while the queue is empty.
+     *
+     * Resumes with the number of values moved into out.
+     */
+    [[nodiscard]] pop_batch_awaitable pop_batch(std::span<T> out) noexcept
+    {
+      return pop_batch_awaitable{this, out};
+    }
+
+    /**
+     * @brief Pop a value if one is queued.
+     */
+    std::optional<T> try_pop()
+    {
+      if (!readable_now())
+      {
+        return std::nullopt;
+      }
+      return take();
+    }
+
+    /**
+     * @brief Move up to out.size() queued values into out with one index update.
+     *
+     * @return Number of values moved.
+     */
+    std::size_t try_pop_batch(std::span<T> out)
+    {
+      const std::size_t h = head_.load(std::memory_order_relaxed);
+      if (cached_tail_ - h < out.size())
+      {
+        cached_tail_ = tail_.load(std::memory_order_acquire);
+      }
+
+      const std::size_t avail = cached_tail_ - h;
+      const std::size_t n = out.size() < avail ? out.size() : avail;
+      std::size_t i = 0;
+      try
+      {
+        for (; i < n; ++i)
+        {
+          T *s = slot(h + i);
+          out[i] = std::move(*s);
+          std::destroy_at(s);
+        }
+      }
+      catch (...)
+      {
+        // The value that failed to move stays queued.
+        head_.store(h + i, std::memory_order_release);
+        throw;
+      }
+
+      head_.store(h + n, std::memory_order_release);
+      return n;
+    }
+
+    // ------------------------------------------------------------------
+    // Observers
+    // ------------------------------------------------------------------
+
+    /**
+     * @brief Number of slots.
+     */
+    [[nodiscard]] std::size_t capacity() const noexcept
+    {
+      return capacity_;
+    }
+
+    /**
+     * @brief Number of queued values (a snapshot when called concurrently).
+     */
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+      const std::size_t h = head_.load(std::memory_order_acquire);
+      return tail_.load(std::memory_order_acquire) - h;
+    }
+
+    /**
+     * @brief Whether close() was called.
+     */
+    [[nodiscard]] bool is_closed() const noexcept
+    {
+      return closed_.load(std::memory_order_acquire);
+    }
+
+  private:
+    T *slot(std::size_t i) const noexcept
+    {
+      return slots_ + (i & mask_);
+    }
+
+    template <typename U>
+    bool emplace(U &&value)
+    {
+      const std::size_t t = tail_.load(std::memory_order_relaxed);
+      if (t - cached_head_ == capacity_)
+      {
+        cached_head_ = head_.load(std::memory_order_acquire);
+        if (t - cached_head_ == capacity_)
+        {
+          return false;
+        }
+      }
+
+      std::construct_at(slot(t), std::forward<U>(value));
+      publish(t + 1);
+      return true;
+    }
+
+    void publish(std::size_t t) noexcept
+    {
+      tail_.store(t, std::memory_order_release);
+      wake(t);
+    }
+
+    /**
+     * @brief Resume the consumer if it is suspended with something to read.
+     *
+     * Pairs with the fence in suspend(): either the consumer sees the new
+     * tail (or closed_) or this sees its handle. The handle seen may belong
+     * to a later wait than the one this push was meant for, once the
+     * consumer has already drained up to t; it is put back then, so the
+     * consumer is never resumed on an empty ring.
+     *
+     * @param t Tail just published, or any value after close().
+     */
+    void wake(std::size_t t) noexcept
+    {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (waiter_.load(std::memory_order_relaxed) == nullptr)
+      {
+        return;
+      }
+
+      void *addr = waiter_.exchange(nullptr, std::memory_order_acq_rel);
+      if (addr == nullptr)
+      {
+        return;
+      }
+
+      // head_ cannot move while the handle is registered.
+      if (head_.load(std::memory_order_relaxed) == t && !closed_.load(std::memory_order_relaxed))
+      {
+        waiter_.store(addr, std::memory_order_relaxed);
+        return;
+      }
+      sched_->post(std::coroutine_handle<>::from_address(addr));
+    }
+
+    /**
+     * @brief Whether pop() can complete now: a value is queued or the queue is closed.
+     *
+     * Values pushed before close() are visible once closed_ is seen, so
+     * await_resume() still returns them before reporting errc::closed.
+     */
+    bool readable() noexcept
+    {
+      return readable_now() || closed_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Whether a value is queued, refreshing cached_tail_ only when needed.
+     */
+    bool readable_now() noexcept
+    {
+      const std::size_t h = head_.load(std::memory_order_relaxed);
+      if (h != cached_tail_)
+      {
+        return true;
+      }
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      return h != cached_tail_;
+    }
+
+    bool suspend(std::coroutine_handle<> h) noexcept
+    {
+      waiter_.store(h.address(), std::memory_order_release);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+
+      if (readable())
+      {
+        // Take the handle back, unless a producer already posted it.
+        return waiter_.exchange(nullptr, std::memory_order_acq_rel) == nullptr;
+      }
+      return true;
+    }
+
+    T take()
+    {
+      const std::size_t h = head_.load(std::memory_order_relaxed);
+      T *s = slot(h);
+      T value = std::move(*s);
+      std::destroy_at(s);
+      head_.store(h + 1, std::memory_order_release);
+      return value;
+    }
+
+    scheduler *sched_;
+    const std::size_t capacity_;
+    const std::size_t mask_;
+    T *slots_;
+
+    /** @brief Next slot to pop; written by the consumer. */
+    alignas(64) std::atomic<std::size_t> head_{0};
+
+    /** @brief Consumer's last view of tail_. */
+    std::size_t cached_tail_{0};
+
+    /** @brief Next slot to push; written by the producer. */
+    alignas(64) std::atomic<std::size_t> tail_{0};
+
+    /** @brief Producer's last view of head_. */
+    std::size_t cached_head_{0};
+
+    /** @brief Suspended consumer's handle address, or null. */
+    alignas(64) std::atomic<void *> waiter_{nullptr};
+
+    /** @brief Set by close(). */
+    std::atomic<bool> closed_{false};
+  };
+
+} // namespace vix::async::core
+
+#endif // VIX_ASYNC_SPSC_QUEUE_HPP
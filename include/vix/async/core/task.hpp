@@ -18,12 +18,19 @@
 
 #include <cassert>
 #include <coroutine>
+#include <cstddef>
+#include <cstring>
 #include <exception>
+#include <memory_resource>
+#include <new>
 #include <optional>
 #include <type_traits>
+#include <typeinfo>
 #include <utility>
 
 #include <vix/async/core/scheduler.hpp>
+#include <vix/async/core/task_registry.hpp>
+#include <vix/async/core/trace.hpp>
 
 namespace vix::async::core
 {
@@ -46,6 +53,93 @@ namespace vix::async::core
 
   namespace detail
   {
+#if ASYNC_TASK_HOOKS
+    /**
+     * @brief Obtain the awaiter of an awaitable, as co_await would.
+     *
+     * @param a Awaitable expression.
+     * @return Result of operator co_await, or the awaitable itself.
+     */
+    template <typename A>
+    decltype(auto) get_awaiter(A &&a)
+    {
+      if constexpr (requires { std::forward<A>(a).operator co_await(); })
+      {
+        return std::forward<A>(a).operator co_await();
+      }
+      else if constexpr (requires { operator co_await(std::forward<A>(a)); })
+      {
+        return operator co_await(std::forward<A>(a));
+      }
+      else
+      {
+        return std::forward<A>(a);
+      }
+    }
+
+    struct promise_common;
+
+    template <typename Aw>
+    struct instrumented_awaiter;
+#endif
+
+    /**
+     * @brief The argument as a memory resource, if it is one.
+     */
+    template <typename T>
+    inline std::pmr::memory_resource *frame_resource_of(const T &arg) noexcept
+    {
+      if constexpr (std::is_convertible_v<const T *, const std::pmr::memory_resource *>)
+      {
+        return const_cast<T *>(&arg);
+      }
+      else
+      {
+        return nullptr;
+      }
+    }
+
+    /**
+     * @brief Offset of the resource pointer stored after a frame of n bytes.
+     */
+    constexpr std::size_t frame_tail(std::size_t n) noexcept
+    {
+      return (n + alignof(void *) - 1) & ~(alignof(void *) - 1);
+    }
+
+    /**
+     * @brief Allocate a coroutine frame from mr, or the global heap if null.
+     *
+     * The resource is remembered behind the frame so that deallocation does
+     * not need the coroutine arguments.
+     */
+    inline void *allocate_frame(std::size_t n, std::pmr::memory_resource *mr)
+    {
+      const std::size_t tail = frame_tail(n);
+      const std::size_t total = tail + sizeof(mr);
+      void *p = mr ? mr->allocate(total, __STDCPP_DEFAULT_NEW_ALIGNMENT__) : ::operator new(total);
+      std::memcpy(static_cast<char *>(p) + tail, &mr, sizeof(mr));
+      return p;
+    }
+
+    /**
+     * @brief Release a frame obtained from allocate_frame().
+     */
+    inline void free_frame(void *p, std::size_t n) noexcept
+    {
+      const std::size_t tail = frame_tail(n);
+      std::pmr::memory_resource *mr = nullptr;
+      std::memcpy(&mr, static_cast<const char *>(p) + tail, sizeof(mr));
+      if (mr)
+      {
+        mr->deallocate(p, tail + sizeof(mr), __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+      }
+      else
+      {
+        ::operator delete(p, tail + sizeof(mr));
+      }
+    }
+
     /**
      * @brief Common promise state shared by task<void> and task<T>.
      *
@@ -74,6 +168,108 @@ namespace vix::async::core
        */
       bool detached{false};
 
+      /**
+       * @brief Allocate the frame of a coroutine without arguments.
+       */
+      static void *operator new(std::size_t n)
+      {
+        return allocate_frame(n, nullptr);
+      }
+
+      /**
+       * @brief Allocate the frame from the first memory resource argument.
+       *
+       * A coroutine taking a std::pmr::memory_resource (for instance a
+       * request_arena) by reference gets its frame from that resource;
+       * other coroutines use the plain overload above.
+       */
+      template <typename... Args>
+        requires(std::is_convertible_v<const Args *, const std::pmr::memory_resource *> || ...)
+      static void *operator new(std::size_t n, const Args &...args)
+      {
+        std::pmr::memory_resource *mr = nullptr;
+        ((mr = mr ? mr : frame_resource_of(args)), ...);
+        return allocate_frame(n, mr);
+      }
+
+      /**
+       * @brief Return the frame to where it came from.
+       */
+      static void operator delete(void *p, std::size_t n) noexcept
+      {
+        free_frame(p, n);
+      }
+
+#if ASYNC_ENABLE_TASK_REGISTRY
+      /**
+       * @brief Entry in the live task registry.
+       */
+      task_node registry_node{};
+
+      /**
+       * @brief Link the new frame into the registry.
+       */
+      promise_common() noexcept
+      {
+        registry_link(registry_node);
+      }
+
+      /**
+       * @brief Unlink the frame from the registry.
+       */
+      ~promise_common()
+      {
+        registry_unlink(registry_node);
+      }
+
+      promise_common(const promise_common &) = delete;
+      promise_common &operator=(const promise_common &) = delete;
+#endif
+
+#if ASYNC_TASK_HOOKS
+      /**
+       * @brief Initial awaiter recording the first resumption of the task.
+       */
+      struct initial_awaiter
+      {
+        /** @brief Owning promise. */
+        promise_common *p;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<>) const noexcept {}
+        void await_resume() const noexcept
+        {
+          ASYNC_TRACE(task_start, p, nullptr);
+#if ASYNC_ENABLE_TASK_REGISTRY
+          p->registry_node.started.store(true, std::memory_order_relaxed);
+#endif
+        }
+      };
+
+      /**
+       * @brief Start suspended, recording creation and first resumption.
+       *
+       * @return initial_awaiter
+       */
+      initial_awaiter initial_suspend() noexcept
+      {
+        ASYNC_TRACE(task_create, this, nullptr);
+        return initial_awaiter{this};
+      }
+
+      /**
+       * @brief Wrap every awaited expression to observe suspension points.
+       *
+       * @param a Awaitable expression.
+       * @return instrumented_awaiter around its awaiter.
+       */
+      template <typename A>
+      auto await_transform(A &&a)
+      {
+        using aw_t = decltype(get_awaiter(std::forward<A>(a)));
+        return instrumented_awaiter<aw_t>{get_awaiter(std::forward<A>(a)), this};
+      }
+#else
       /**
        * @brief Start suspended.
        *
@@ -85,6 +281,7 @@ namespace vix::async::core
       {
         return {};
       }
+#endif
 
       /**
        * @brief Final awaiter responsible for resuming continuation or self-destruction.
@@ -139,6 +336,7 @@ namespace vix::async::core
        */
       final_awaiter final_suspend() noexcept
       {
+        ASYNC_TRACE(task_complete, this, nullptr);
         return {};
       }
 
@@ -151,6 +349,62 @@ namespace vix::async::core
       }
     };
 
+#if ASYNC_TASK_HOOKS
+    /**
+     * @brief Awaiter wrapper observing suspension and resumption of a task.
+     *
+     * Installed by promise_common::await_transform when tracing or the task
+     * registry is enabled. The suspension point is labelled with the
+     * awaiter's `awaiting_label()`, or its type name.
+     *
+     * @tparam Aw Wrapped awaiter (value or reference type).
+     */
+    template <typename Aw>
+    struct instrumented_awaiter
+    {
+      /** @brief Wrapped awaiter. */
+      Aw aw;
+
+      /** @brief Promise of the awaiting task. */
+      promise_common *promise;
+
+      /** @brief Whether await_suspend was reached. */
+      bool suspended{false};
+
+      bool await_ready()
+      {
+        return aw.await_ready();
+      }
+
+      template <typename P>
+      decltype(auto) await_suspend(std::coroutine_handle<P> h)
+      {
+        suspended = true;
+        ASYNC_TRACE(task_suspend, promise, awaiting_label<Aw>());
+#if ASYNC_ENABLE_TASK_REGISTRY
+        promise->registry_node.awaiting.store(awaiting_label<Aw>(), std::memory_order_relaxed);
+        if constexpr (requires { aw.adopt(&promise->registry_node); })
+        {
+          aw.adopt(&promise->registry_node);
+        }
+#endif
+        return aw.await_suspend(h);
+      }
+
+      decltype(auto) await_resume()
+      {
+        if (suspended)
+        {
+          ASYNC_TRACE(task_resume, promise, awaiting_label<Aw>());
+#if ASYNC_ENABLE_TASK_REGISTRY
+          promise->registry_node.awaiting.store(nullptr, std::memory_order_relaxed);
+#endif
+        }
+        return aw.await_resume();
+      }
+    };
+#endif
+
     /**
      * @brief Promise type for task<T>.
      *
@@ -228,6 +482,26 @@ namespace vix::async::core
        */
       std::coroutine_handle<Promise> h{};
 
+      /**
+       * @brief Suspension label reported by tracing and the task registry.
+       */
+      static constexpr const char *awaiting_label() noexcept { return "task"; }
+
+#if ASYNC_ENABLE_TASK_REGISTRY
+      /**
+       * @brief Record the awaiting task as the parent of the awaited one.
+       *
+       * @param parent Registry node of the awaiting task.
+       */
+      void adopt(task_node *parent) noexcept
+      {
+        if (h)
+        {
+          h.promise().registry_node.parent.store(parent, std::memory_order_relaxed);
+        }
+      }
+#endif
+
       /**
        * @brief Ready if there is no handle or the coroutine already completed.
        */
@@ -635,7 +909,11 @@ namespace vix::async::core
     inline task<T> promise_value<T>::get_return_object() noexcept
     {
       using handle_t = std::coroutine_handle<promise_value<T>>;
-      return task<T>(handle_t::from_promise(*this));
+      const auto h = handle_t::from_promise(*this);
+#if ASYNC_ENABLE_TASK_REGISTRY
+      registry_node.frame.store(h.address(), std::memory_order_relaxed);
+#endif
+      return task<T>(h);
     }
 
     /**
@@ -646,8 +924,24 @@ namespace vix::async::core
     inline task<void> promise_value<void>::get_return_object() noexcept
     {
       using handle_t = std::coroutine_handle<promise_value<void>>;
-      return task<void>(handle_t::from_promise(*this));
+      const auto h = handle_t::from_promise(*this);
+#if ASYNC_ENABLE_TASK_REGISTRY
+      registry_node.frame.store(h.address(), std::memory_order_relaxed);
+#endif
+      return task<void>(h);
     }
+
+    /**
+     * @brief Result type of a task type (T for task<T>).
+     */
+    template <typename T>
+    struct task_result;
+
+    template <typename T>
+    struct task_result<task<T>>
+    {
+      using type = T;
+    };
   } // namespace detail
 
 } // namespace vix::async::core
@@ -0,0 +1,144 @@
+/**
+ *
+ *  @file task_registry.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_ASYNC_TASK_REGISTRY_HPP
+#define VIX_ASYNC_TASK_REGISTRY_HPP
+
+#include <atomic>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <type_traits>
+#include <typeinfo>
+
+#include <vix/async/detail/config.hpp>
+
+namespace vix::async::core
+{
+  class io_context;
+
+  namespace detail
+  {
+    /**
+     * @brief Intrusive registry entry embedded in every task promise.
+     *
+     * Linked into a process-wide list while the coroutine frame is alive.
+     * Fields written by the task's own thread are atomics so that a dump
+     * running on another thread reads consistent values.
+     */
+    struct task_node
+    {
+      /** @brief Previous live task (guarded by the registry mutex). */
+      task_node *prev{nullptr};
+
+      /** @brief Next live task (guarded by the registry mutex). */
+      task_node *next{nullptr};
+
+      /** @brief Coroutine frame address, set once the handle exists. */
+      std::atomic<void *> frame{nullptr};
+
+      /** @brief Task awaiting this one, if any. */
+      std::atomic<task_node *> parent{nullptr};
+
+      /** @brief Label of the current suspension point, null when not suspended on an awaitable. */
+      std::atomic<const char *> awaiting{nullptr};
+
+      /** @brief Whether the body has started running. */
+      std::atomic<bool> started{false};
+
+      /** @brief Creation order, for stable dump output. */
+      std::uint64_t seq{0};
+    };
+
+    /**
+     * @brief Insert a node into the live task list.
+     *
+     * @param n Node to link.
+     */
+    void registry_link(task_node &n) noexcept;
+
+    /**
+     * @brief Remove a node from the live task list.
+     *
+     * @param n Node to unlink.
+     */
+    void registry_unlink(task_node &n) noexcept;
+
+    /**
+     * @brief Human-readable label of an awaiter type.
+     *
+     * Uses the awaiter's static `awaiting_label()` when it provides one,
+     * otherwise its type name.
+     *
+     * @tparam Aw Awaiter type.
+     * @return Static label string.
+     */
+    template <typename Aw>
+    const char *awaiting_label() noexcept
+    {
+      using A = std::remove_cvref_t<Aw>;
+      if constexpr (requires { A::awaiting_label(); })
+      {
+        return A::awaiting_label();
+      }
+      else
+      {
+        return typeid(A).name();
+      }
+    }
+  } // namespace detail
+
+  /**
+   * @brief Number of task frames currently alive in the process.
+   *
+   * Always 0 when ASYNC_ENABLE_TASK_REGISTRY is 0.
+   *
+   * @return Live task count.
+   */
+  std::size_t live_task_count() noexcept;
+
+  /**
+   * @brief Print the async backtrace of every live task.
+   *
+   * Each chain starts at a task that nothing else is awaiting (the innermost
+   * suspension) and walks up through the tasks awaiting it. Every line shows
+   * the task identity, what it is suspended on, and its coroutine function
+   * when the symbol can be resolved.
+   *
+   * @param os Output stream.
+   */
+  void dump_async_stacks(std::ostream &os);
+
+  /**
+   * @brief Dump async stacks to stderr whenever @p sig is received.
+   *
+   * Subscribes through ctx.signals().watch(), so callbacks set with
+   * on_signal() keep firing and never see @p sig. The dump runs on the
+   * scheduler thread, so it shows everything except a stalled loop.
+   * As with any signal_set signal, the other threads must block @p sig.
+   *
+   * @param ctx Context whose signal service is used.
+   * @param sig Signal number (SIGUSR1 by default).
+   */
+#if defined(SIGUSR1)
+  void install_async_stack_dump(io_context &ctx, int sig = SIGUSR1);
+#else
+  void install_async_stack_dump(io_context &ctx, int sig);
+#endif
+
+} // namespace vix::async::core
+
+#endif // VIX_ASYNC_TASK_REGISTRY_HPP
@@ -20,6 +20,7 @@
 #include <condition_variable>
 #include <coroutine>
 #include <cstddef>
+#include <cstdint>
 #include <deque>
 #include <exception>
 #include <functional>
@@ -33,6 +34,8 @@
 
 #include <vix/async/core/cancel.hpp>
 #include <vix/async/core/error.hpp>
+#include <vix/async/core/executor.hpp>
+#include <vix/async/core/metrics.hpp>
 #include <vix/async/core/task.hpp>
 
 namespace vix::async::core
@@ -176,6 +179,9 @@ namespace vix::async::core
         /** @brief Captured exception, if execution fails. */
         std::exception_ptr ex{};
 
+        /** @brief Suspension label reported by tracing and the task registry. */
+        static constexpr const char *awaiting_label() noexcept { return "thread_pool job"; }
+
         /**
          * @brief Always suspend and dispatch work to the pool.
          *
@@ -248,10 +254,25 @@ namespace vix::async::core
         }
       };
 
-      co_return co_await awaitable{
+      awaitable op{
           this,
           std::move(ct),
           std::forward<Fn>(fn)};
+      co_return co_await op;
+    }
+
+    /**
+     * @brief Executor resuming coroutines on the pool's workers.
+     *
+     * A coroutine moved here with resume_on() keeps resuming on the pool
+     * after its socket and timer awaits, instead of hopping through the
+     * io_context scheduler and back.
+     */
+    executor get_executor() noexcept
+    {
+      return executor(this, [](void *self, std::coroutine_handle<> h) noexcept
+                      { static_cast<thread_pool *>(self)->enqueue([h]()
+                                                                  { h.resume(); }); });
     }
 
     /**
@@ -281,6 +302,18 @@ namespace vix::async::core
     }
 
   private:
+    /**
+     * @brief Queued job with its enqueue timestamp.
+     */
+    struct job_entry
+    {
+      /** @brief Callable to execute. */
+      std::function<void()> fn;
+
+      /** @brief Enqueue time in nanoseconds (0 when histograms are disabled). */
+      std::uint64_t enqueued_ns;
+    };
+
     /**
      * @brief Worker thread main loop.
      *
@@ -314,7 +347,10 @@ namespace vix::async::core
     std::condition_variable cv_;
 
     /** @brief FIFO queue of pending callables. */
-    std::deque<std::function<void()>> q_;
+    std::deque<job_entry> q_;
+
+    /** @brief Counters owned by the io_context (outlive the pool). */
+    thread_pool_metrics &metrics_;
 
     /** @brief Stop flag checked by workers and enqueue logic. */
     bool stop_{false};
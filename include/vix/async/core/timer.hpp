@@ -16,6 +16,7 @@
 #ifndef VIX_ASYNC_TIMER_HPP
 #define VIX_ASYNC_TIMER_HPP
 
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <coroutine>
@@ -29,6 +30,7 @@
 
 #include <vix/async/core/cancel.hpp>
 #include <vix/async/core/error.hpp>
+#include <vix/async/core/metrics.hpp>
 #include <vix/async/core/task.hpp>
 
 namespace vix::async::core
@@ -49,6 +51,10 @@ namespace vix::async::core
    * Cancellation:
    * - A cancel_token can be provided per scheduled entry.
    * - If cancellation is observed before execution, the entry is skipped.
+   *
+   * On an io_context constructed with virtual_time there is no worker
+   * thread: now() is a virtual clock, starting at the clock's epoch, that the
+   * scheduler moves to the next deadline whenever it runs out of work.
    */
   class timer
   {
@@ -106,21 +112,92 @@ namespace vix::async::core
     template <typename Fn>
     void after(duration d, Fn &&fn, cancel_token ct = {})
     {
-      schedule(clock::now() + d, make_job(std::forward<Fn>(fn)), std::move(ct));
+      schedule(now() + d, make_job(std::forward<Fn>(fn)), std::move(ct));
+    }
+
+    /**
+     * @brief Current time on the timer's clock.
+     *
+     * clock::now(), or the virtual time on a virtual_time io_context.
+     * Deadlines computed by the caller should start from here.
+     *
+     * @return Current time.
+     */
+    [[nodiscard]] time_point now() const noexcept
+    {
+      if (virtual_)
+      {
+        return time_point(duration(virtual_now_.load(std::memory_order_acquire)));
+      }
+      return clock::now();
     }
 
     /**
      * @brief Coroutine-friendly sleep for the given duration.
      *
-     * Suspends the awaiting coroutine and resumes it after the duration elapses,
-     * posting the continuation back onto the io_context scheduler thread.
+     * Suspends the awaiting coroutine and resumes it after the duration elapses
+     * on the executor it awaited from: the io_context scheduler, a
+     * thread_pool worker, or inline on the timer thread. Threads without a
+     * current executor resume on the io_context scheduler.
      *
      * @param d Delay duration.
-     * @param ct Cancellation token.
+     * @param ct Cancellation token, checked before suspending and when the
+     *        duration elapses. Cancelling during the sleep does not shorten it.
      * @return task<void> completing after the duration.
+     * @throws std::system_error (errc::canceled) if ct was cancelled.
      */
     task<void> sleep_for(duration d, cancel_token ct = {});
 
+    /**
+     * @brief Awaitable returned by wait_for().
+     */
+    struct wait_awaitable
+    {
+      /** @brief Timer scheduling the wakeup. */
+      timer *self;
+
+      /** @brief Delay duration. */
+      duration d;
+
+      /** @brief Cancellation token. */
+      cancel_token ct;
+
+      /** @brief Suspension label reported by tracing and the task registry. */
+      static constexpr const char *awaiting_label() noexcept { return "timer"; }
+
+      bool await_ready() const noexcept
+      {
+        return d.count() <= 0 || ct.is_cancelled();
+      }
+
+      void await_suspend(std::coroutine_handle<> h)
+      {
+        self->schedule_wakeup(self->now() + d, h);
+      }
+
+      /**
+       * @return false if ct was cancelled.
+       */
+      bool await_resume() const noexcept
+      {
+        return !ct.is_cancelled();
+      }
+    };
+
+    /**
+     * @brief sleep_for() without a task frame or an exception.
+     *
+     * Awaited directly; resumes with false instead of throwing when ct is
+     * cancelled. Same resumption and cancellation rules as sleep_for().
+     *
+     * @param d Delay duration.
+     * @param ct Cancellation token.
+     */
+    [[nodiscard]] wait_awaitable wait_for(duration d, cancel_token ct = {}) noexcept
+    {
+      return wait_awaitable{this, d, std::move(ct)};
+    }
+
     /**
      * @brief Stop the timer service.
      *
@@ -129,6 +206,8 @@ namespace vix::async::core
     void stop() noexcept;
 
   private:
+    friend class io_context;
+
     /**
      * @brief Type-erased timer job.
      */
@@ -194,14 +273,30 @@ namespace vix::async::core
      * @param tp Deadline time.
      * @param j Job to execute.
      * @param ct Cancellation token.
+     * @param on_timer_thread Run j on the timer thread instead of posting it
+     *        to the scheduler (coroutine wakeups that post their own handle).
      */
-    void schedule(time_point tp, std::unique_ptr<job> j, cancel_token ct);
+    void schedule(time_point tp, std::unique_ptr<job> j, cancel_token ct, bool on_timer_thread = false);
+
+    /**
+     * @brief Resume h at tp on the executor current when called.
+     */
+    void schedule_wakeup(time_point tp, std::coroutine_handle<> h);
 
     /**
      * @brief Worker loop waiting for the next deadline and dispatching jobs.
      */
     void timer_loop();
 
+    /**
+     * @brief Virtual clock: jump to the next deadline and fire what is due.
+     *
+     * Called by the io_context scheduler when it runs out of work.
+     *
+     * @return false if no timer is pending.
+     */
+    bool advance();
+
     /**
      * @brief Post a generic function onto the io_context scheduler.
      *
@@ -265,6 +360,11 @@ namespace vix::async::core
        * @brief Job to execute.
        */
       std::unique_ptr<job> j;
+
+      /**
+       * @brief Run j on the timer thread rather than the scheduler.
+       */
+      bool on_timer_thread{false};
     };
 
     /**
@@ -283,6 +383,13 @@ namespace vix::async::core
       }
     };
 
+    /**
+     * @brief Run or post the job of an entry whose deadline has passed.
+     *
+     * @param e Entry removed from the queue.
+     */
+    void fire(entry &e);
+
     /**
      * @brief Ordered timer queue.
      */
@@ -293,6 +400,21 @@ namespace vix::async::core
      */
     bool stop_{false};
 
+    /**
+     * @brief Deadlines are on the virtual clock (no worker thread).
+     */
+    const bool virtual_;
+
+    /**
+     * @brief Virtual time since the clock's epoch (virtual clock only).
+     */
+    std::atomic<duration::rep> virtual_now_{0};
+
+    /**
+     * @brief Counters owned by the io_context (outlive the timer).
+     */
+    timer_metrics &metrics_;
+
     /**
      * @brief Worker thread responsible for sleeping until deadlines.
      */
@@ -0,0 +1,161 @@
+/**
+ *
+ *  @file trace.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_ASYNC_TRACE_HPP
+#define VIX_ASYNC_TRACE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+#include <vix/async/detail/config.hpp>
+
+namespace vix::async::core
+{
+  /**
+   * @brief Kind of a recorded trace event.
+   */
+  enum class trace_event : std::uint8_t
+  {
+    /** @brief A task coroutine frame was created. */
+    task_create,
+
+    /** @brief A task body started running (first resumption). */
+    task_start,
+
+    /** @brief A task suspended on an awaitable. */
+    task_suspend,
+
+    /** @brief A task resumed after a suspension. */
+    task_resume,
+
+    /** @brief A task reached its final suspend point. */
+    task_complete,
+
+    /** @brief A coroutine handle was posted to a scheduler. */
+    post_handle,
+
+    /** @brief A callable was posted to a scheduler. */
+    post_fn,
+
+    /** @brief A scheduler started running one work item. */
+    run_begin,
+
+    /** @brief A scheduler finished running one work item. */
+    run_end
+  };
+
+  /**
+   * @brief One entry of a per-thread trace ring buffer.
+   */
+  struct trace_record
+  {
+    /** @brief Timestamp on the steady clock, in nanoseconds. */
+    std::uint64_t ts_ns;
+
+    /** @brief Task identity (promise address) or posted handle address. */
+    std::uint64_t id;
+
+    /** @brief Static label (e.g. awaitable type name), may be null. */
+    const char *label;
+
+    /** @brief Event kind. */
+    trace_event ev;
+  };
+
+  /**
+   * @brief Write every recorded event as Chrome trace-event JSON.
+   *
+   * The output loads in chrome://tracing and ui.perfetto.dev. Task lifetimes
+   * are async spans keyed by task identity, suspensions and resumptions are
+   * instant events on the thread where they happened, and scheduler work
+   * items are duration slices.
+   *
+   * Ring buffers are read without stopping their writers; dump while the
+   * runtime is quiescent for an exact picture.
+   *
+   * When ASYNC_ENABLE_TRACING is 0 this writes an empty trace.
+   *
+   * @param os Output stream.
+   */
+  void trace_dump_chrome(std::ostream &os);
+
+  /**
+   * @brief Write the Chrome trace JSON to a file.
+   *
+   * @param path Output file path.
+   * @return true on success, false if the file could not be written.
+   */
+  bool trace_dump_chrome(const std::string &path);
+
+  /**
+   * @brief Drop all recorded events.
+   *
+   * Must not race with threads that are still recording.
+   */
+  void trace_clear() noexcept;
+
+  /**
+   * @brief Name the calling thread in trace output.
+   *
+   * @param name Thread name shown by the trace viewer.
+   */
+  void trace_set_thread_name(const std::string &name);
+
+  namespace detail
+  {
+    /**
+     * @brief Append one event to the calling thread's ring buffer.
+     *
+     * Wait-free for the recording thread. The oldest events are overwritten
+     * once the ring (ASYNC_TRACE_BUFFER_SIZE entries) is full.
+     *
+     * @param ev Event kind.
+     * @param id Task or handle identity.
+     * @param label Static label, may be null.
+     */
+    void trace_emit(trace_event ev, std::uint64_t id, const char *label) noexcept;
+
+    /**
+     * @brief Turn an address into a trace identity.
+     *
+     * @param p Address of a promise or coroutine frame.
+     * @return Numeric identity.
+     */
+    inline std::uint64_t trace_id(const void *p) noexcept
+    {
+      return static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(p));
+    }
+  } // namespace detail
+
+} // namespace vix::async::core
+
+/**
+ * @brief Record a trace event when tracing is compiled in.
+ *
+ * Expands to nothing (arguments unevaluated) when ASYNC_ENABLE_TRACING is 0.
+ */
+#if ASYNC_ENABLE_TRACING
+#define ASYNC_TRACE(ev, ptr, label)                        \
+  ::vix::async::core::detail::trace_emit(                  \
+      ::vix::async::core::trace_event::ev,                 \
+      ::vix::async::core::detail::trace_id(ptr),           \
+      (label))
+#else
+#define ASYNC_TRACE(ev, ptr, label) ((void)0)
+#endif
+
+#endif // VIX_ASYNC_TRACE_HPP
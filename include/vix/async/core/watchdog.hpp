@@ -0,0 +1,176 @@
+/**
+ *
+ *  @file watchdog.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_ASYNC_WATCHDOG_HPP
+#define VIX_ASYNC_WATCHDOG_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <vix/async/core/scheduler.hpp>
+
+namespace vix::async::core
+{
+  class io_context;
+
+  /**
+   * @brief Description of one event-loop stall.
+   */
+  struct stall_info
+  {
+    /** @brief How long the item had been running when detected. */
+    std::chrono::nanoseconds duration{0};
+
+    /** @brief Kind of the stalled item. */
+    scheduler::work_kind kind{scheduler::work_kind::none};
+
+    /**
+     * @brief Coroutine frame address of the stalled item, null for callables.
+     *
+     * Matches the "handle" id in trace output and the frame address printed
+     * by dump_async_stacks().
+     */
+    const void *id{nullptr};
+
+    /** @brief Sequence number of the stalled item. */
+    std::uint64_t seq{0};
+  };
+
+  /**
+   * @brief Watchdog reporting scheduler items that run for too long.
+   *
+   * A single blocking call on the scheduler thread stalls every coroutine of
+   * its io_context. stall_watchdog samples the item currently executed by
+   * scheduler::run() from a background thread and invokes a callback once
+   * per item whose run time exceeds the threshold.
+   *
+   * The scheduler only tracks items while a watchdog is attached; the cost is
+   * one clock read and a few relaxed stores per item.
+   *
+   * The callback runs on the watchdog thread, concurrently with the stalled
+   * item. Without a callback, stalls are logged at warn level.
+   */
+  class stall_watchdog
+  {
+  public:
+    /**
+     * @brief Callback invoked for each detected stall.
+     */
+    using callback = std::function<void(const stall_info &)>;
+
+    /**
+     * @brief Watch a scheduler.
+     *
+     * @param sched Scheduler to watch; must outlive the watchdog.
+     * @param threshold Run time above which an item is reported.
+     * @param cb Stall callback (empty: log a warning).
+     * @param poll Sampling period; defaults to threshold / 4.
+     */
+    stall_watchdog(
+        scheduler &sched,
+        std::chrono::nanoseconds threshold,
+        callback cb = {},
+        std::chrono::nanoseconds poll = std::chrono::nanoseconds{0});
+
+    /**
+     * @brief Watch the scheduler of an io_context.
+     *
+     * @param ctx Context to watch; must outlive the watchdog.
+     * @param threshold Run time above which an item is reported.
+     * @param cb Stall callback (empty: log a warning).
+     * @param poll Sampling period; defaults to threshold / 4.
+     */
+    stall_watchdog(
+        io_context &ctx,
+        std::chrono::nanoseconds threshold,
+        callback cb = {},
+        std::chrono::nanoseconds poll = std::chrono::nanoseconds{0});
+
+    /**
+     * @brief Stop the watchdog thread and detach from the scheduler.
+     */
+    ~stall_watchdog() noexcept;
+
+    stall_watchdog(const stall_watchdog &) = delete;
+    stall_watchdog &operator=(const stall_watchdog &) = delete;
+
+    /**
+     * @brief Stop watching. Idempotent.
+     */
+    void stop() noexcept;
+
+    /**
+     * @brief Number of stalls reported so far.
+     *
+     * @return Stall count.
+     */
+    [[nodiscard]] std::uint64_t stalls() const noexcept
+    {
+      return stalls_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    /**
+     * @brief Sampling loop run by the watchdog thread.
+     */
+    void watch_loop();
+
+    /**
+     * @brief Deliver one stall to the callback or the log.
+     *
+     * @param info Stall description.
+     */
+    void report(const stall_info &info) noexcept;
+
+  private:
+    /** @brief Watched scheduler. */
+    scheduler &sched_;
+
+    /** @brief Reporting threshold. */
+    std::chrono::nanoseconds threshold_;
+
+    /** @brief Sampling period. */
+    std::chrono::nanoseconds poll_;
+
+    /** @brief User callback. */
+    callback cb_;
+
+    /** @brief Mutex protecting stop_. */
+    std::mutex m_;
+
+    /** @brief Wakes the watchdog thread on stop. */
+    std::condition_variable cv_;
+
+    /** @brief Stop request flag. */
+    bool stop_{false};
+
+    /** @brief Number of reported stalls. */
+    std::atomic<std::uint64_t> stalls_{0};
+
+    /** @brief Ensures stop() runs once. */
+    std::atomic<bool> stopped_{false};
+
+    /** @brief Sampling thread. */
+    std::thread thread_;
+  };
+
+} // namespace vix::async::core
+
+#endif // VIX_ASYNC_WATCHDOG_HPP
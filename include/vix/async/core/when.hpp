@@ -259,6 +259,28 @@ namespace vix::async::core
       std::tuple<task<Ts>...> tasks;
       std::shared_ptr<when_all_state<Ts...>> st{};
 
+      /**
+       * @brief Suspension label reported by tracing and the task registry.
+       */
+      static constexpr const char *awaiting_label() noexcept { return "when_all"; }
+
+#if ASYNC_ENABLE_TASK_REGISTRY
+      /**
+       * @brief Registry node of the awaiting task, parent of every runner.
+       */
+      task_node *parent{nullptr};
+
+      /**
+       * @brief Record the awaiting task so runners chain up to it.
+       *
+       * @param p Registry node of the awaiting task.
+       */
+      void adopt(task_node *p) noexcept
+      {
+        parent = p;
+      }
+#endif
+
       /**
        * @brief Always suspend to start tasks concurrently.
        */
@@ -317,6 +339,9 @@ namespace vix::async::core
       void start_one(task<T> &t)
       {
         auto runner = when_all_runner<I, T, Ts...>(st, std::move(t));
+#if ASYNC_ENABLE_TASK_REGISTRY
+        runner.handle().promise().registry_node.parent.store(parent, std::memory_order_relaxed);
+#endif
         std::move(runner).start(*sched);
       }
     };
@@ -414,6 +439,28 @@ namespace vix::async::core
       std::tuple<task<Ts>...> tasks;
       std::shared_ptr<when_any_state<Ts...>> st{};
 
+      /**
+       * @brief Suspension label reported by tracing and the task registry.
+       */
+      static constexpr const char *awaiting_label() noexcept { return "when_any"; }
+
+#if ASYNC_ENABLE_TASK_REGISTRY
+      /**
+       * @brief Registry node of the awaiting task, parent of every runner.
+       */
+      task_node *parent{nullptr};
+
+      /**
+       * @brief Record the awaiting task so runners chain up to it.
+       *
+       * @param p Registry node of the awaiting task.
+       */
+      void adopt(task_node *p) noexcept
+      {
+        parent = p;
+      }
+#endif
+
       /**
        * @brief Always suspend to start tasks concurrently.
        */
@@ -472,6 +519,9 @@ namespace vix::async::core
       void start_one(task<T> &t)
       {
         auto runner = when_any_runner<I, T, Ts...>(st, std::move(t));
+#if ASYNC_ENABLE_TASK_REGISTRY
+        runner.handle().promise().registry_node.parent.store(parent, std::memory_order_relaxed);
+#endif
         std::move(runner).start(*sched);
       }
     };
@@ -61,6 +61,227 @@
 #endif
 #endif
 
+/**
+ * @brief Minimum log level compiled into the binary.
+ *
+ * ASYNC_LOG_* macros below this level expand to a no-op, so their
+ * arguments are neither evaluated nor formatted. Values follow
+ * detail::log_level: 0 = trace, 1 = debug, 2 = info, 3 = warn,
+ * 4 = error, 5 = fatal, 6 = off. Fatal messages are always kept.
+ *
+ * Defaults to 0 (everything compiled in, filtered at runtime).
+ */
+#ifndef ASYNC_LOG_MIN_LEVEL
+#define ASYNC_LOG_MIN_LEVEL 0
+#endif
+
+/**
+ * @brief Enable or disable runtime metrics collection.
+ *
+ * When enabled, the scheduler, thread pool, timer and networking layer
+ * maintain relaxed atomic counters and latency histograms readable through
+ * io_context::metrics(). When disabled, the instrumentation compiles out
+ * and the counters stay at zero.
+ *
+ * Defaults to 1.
+ */
+#ifndef ASYNC_ENABLE_METRICS
+#define ASYNC_ENABLE_METRICS 1
+#endif
+
+/**
+ * @brief Enable or disable latency histograms.
+ *
+ * Histograms cost a clock read on each side of every measured operation
+ * (post to resume, pool queue wait and run time, timer lateness, socket
+ * operation latency). When disabled, counters are still maintained but the
+ * histogram fields of metrics snapshots stay empty. Has no effect without
+ * ASYNC_ENABLE_METRICS.
+ *
+ * Defaults to ASYNC_ENABLE_METRICS.
+ */
+#ifndef ASYNC_ENABLE_HISTOGRAMS
+#define ASYNC_ENABLE_HISTOGRAMS ASYNC_ENABLE_METRICS
+#endif
+
+#if !ASYNC_ENABLE_METRICS
+#undef ASYNC_ENABLE_HISTOGRAMS
+#define ASYNC_ENABLE_HISTOGRAMS 0
+#endif
+
+/**
+ * @brief Number of per-thread shards in each latency histogram.
+ *
+ * Recording threads are spread over the shards round-robin; more shards
+ * mean less cache-line sharing and more memory (about 5 KiB per shard).
+ */
+#ifndef ASYNC_HISTOGRAM_SHARDS
+#define ASYNC_HISTOGRAM_SHARDS 4
+#endif
+
+/**
+ * @brief Enable or disable task lifecycle tracing.
+ *
+ * When enabled, task creation, start, suspension, resumption and completion,
+ * as well as scheduler posts and work items, are recorded into per-thread
+ * ring buffers (see core/trace.hpp). When disabled, ASYNC_TRACE expands to
+ * nothing and promises keep their untraced await path.
+ *
+ * Defaults to 0.
+ */
+#ifndef ASYNC_ENABLE_TRACING
+#define ASYNC_ENABLE_TRACING 0
+#endif
+
+/**
+ * @brief Number of trace records kept per thread.
+ *
+ * Older records are overwritten once a thread's ring is full.
+ */
+#ifndef ASYNC_TRACE_BUFFER_SIZE
+#define ASYNC_TRACE_BUFFER_SIZE 65536
+#endif
+
+/**
+ * @brief Enable or disable the live task registry.
+ *
+ * When enabled, every task promise links itself into a process-wide list
+ * recording what it is suspended on and which task awaits it, so that
+ * dump_async_stacks() can print async backtraces (see core/task_registry.hpp).
+ *
+ * Defaults to 0.
+ */
+#ifndef ASYNC_ENABLE_TASK_REGISTRY
+#define ASYNC_ENABLE_TASK_REGISTRY 0
+#endif
+
+/**
+ * @brief Enable or disable the io_uring file I/O backend.
+ *
+ * When enabled on Linux, fs::async_file operations are submitted to an
+ * io_uring instance if the running kernel supports every operation used;
+ * otherwise (or when disabled) they run on a dedicated blocking thread pool.
+ *
+ * Defaults to 1.
+ */
+#ifndef ASYNC_ENABLE_IO_URING
+#define ASYNC_ENABLE_IO_URING 1
+#endif
+
+/**
+ * @brief Submission queue size of the file I/O io_uring instance.
+ *
+ * Also bounds the number of file operations in the kernel at once; further
+ * requests wait in a user-space backlog.
+ */
+#ifndef ASYNC_IO_URING_ENTRIES
+#define ASYNC_IO_URING_ENTRIES 256
+#endif
+
+/**
+ * @brief Number of threads in the blocking file I/O pool.
+ *
+ * Used only when io_uring is unavailable. Bounds the number of file
+ * operations running at once.
+ */
+#ifndef ASYNC_FILE_THREADS
+#define ASYNC_FILE_THREADS 4
+#endif
+
+/**
+ * @brief Default admission control target, in microseconds.
+ *
+ * When non-zero, the scheduler reports overloaded() once queued items have
+ * waited longer than this for a whole ASYNC_ADMISSION_INTERVAL_MS. The
+ * default 0 leaves admission control off, so post() never reads the clock
+ * for it; scheduler::set_admission() enables it at runtime.
+ */
+#ifndef ASYNC_ADMISSION_TARGET_US
+#define ASYNC_ADMISSION_TARGET_US 0
+#endif
+
+/**
+ * @brief Default admission control interval, in milliseconds.
+ */
+#ifndef ASYNC_ADMISSION_INTERVAL_MS
+#define ASYNC_ADMISSION_INTERVAL_MS 100
+#endif
+
+/**
+ * @brief Default chunk size of core::request_arena.
+ *
+ * A request whose frames and containers fit in one chunk costs a single
+ * heap allocation.
+ */
+#ifndef ASYNC_ARENA_CHUNK_SIZE
+#define ASYNC_ARENA_CHUNK_SIZE 4096
+#endif
+
+/**
+ * @brief Enable or disable SIMD byte scanning.
+ *
+ * When enabled, multi-byte delimiter search in the framing and HTTP layers uses
+ * SSE2/AVX2 (picked at runtime) or NEON; when disabled it uses the scalar
+ * memchr/memcmp path on every target.
+ *
+ * Defaults to 1.
+ */
+#ifndef ASYNC_ENABLE_SIMD
+#define ASYNC_ENABLE_SIMD 1
+#endif
+
+/**
+ * @brief Default read buffer size of net::buffered_reader and net::buffer_pool.
+ *
+ * Large enough to take many small frames per read; a reader grows past it
+ * only for frames that do not fit.
+ */
+#ifndef ASYNC_FRAME_BUFFER_SIZE
+#define ASYNC_FRAME_BUFFER_SIZE 16384
+#endif
+
+/**
+ * @brief Default maximum frame size accepted by the framing readers.
+ */
+#ifndef ASYNC_MAX_FRAME_SIZE
+#define ASYNC_MAX_FRAME_SIZE (1u << 20)
+#endif
+
+/**
+ * @brief Bytes reserved per socket direction for Asio operation state.
+ *
+ * Each socket keeps one slot for reads and one for writes; the Asio
+ * operation started on it is allocated there instead of on the heap.
+ * Larger operations fall back to the heap.
+ */
+#ifndef ASYNC_NET_HANDLER_MEMORY
+#define ASYNC_NET_HANDLER_MEMORY 512
+#endif
+
+/**
+ * @brief Concurrency hint of the Asio context behind networking.
+ *
+ * One thread runs it, so the default is 1: Asio then queues completions
+ * posted from its own handlers without taking its scheduler lock. The
+ * value must keep Asio's scheduler and reactor I/O locking enabled (1 or
+ * -1, not the UNSAFE hints): operations are started on the scheduler
+ * thread while the net thread runs the reactor.
+ */
+#ifndef ASYNC_NET_CONCURRENCY_HINT
+#define ASYNC_NET_CONCURRENCY_HINT 1
+#endif
+
+/**
+ * @brief Internal: task promises observe their await points.
+ *
+ * Derived from the diagnostics switches above; not meant to be set directly.
+ */
+#if ASYNC_ENABLE_TRACING || ASYNC_ENABLE_TASK_REGISTRY
+#define ASYNC_TASK_HOOKS 1
+#else
+#define ASYNC_TASK_HOOKS 0
+#endif
+
 /**
  * @brief Symbol visibility macros.
  *
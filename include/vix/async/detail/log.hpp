@@ -18,11 +18,30 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstdlib>
 #include <ctime>
 #include <iostream>
 #include <mutex>
+#include <sstream>
+#include <string>
 #include <string_view>
 
+#include <vix/async/detail/config.hpp>
+
+/**
+ * @brief Numeric log levels usable in preprocessor conditions.
+ *
+ * They mirror vix::async::detail::log_level and are meant to be used
+ * with ASYNC_LOG_MIN_LEVEL (see config.hpp).
+ */
+#define ASYNC_LOG_LEVEL_TRACE 0
+#define ASYNC_LOG_LEVEL_DEBUG 1
+#define ASYNC_LOG_LEVEL_INFO 2
+#define ASYNC_LOG_LEVEL_WARN 3
+#define ASYNC_LOG_LEVEL_ERROR 4
+#define ASYNC_LOG_LEVEL_FATAL 5
+#define ASYNC_LOG_LEVEL_OFF 6
+
 namespace vix::async::detail
 {
   /**
@@ -108,10 +127,23 @@ namespace vix::async::detail
   }
 
   /**
-   * @brief Emit a log message.
+   * @brief Check whether a message of the given level would be emitted.
+   *
+   * This is the cheap test performed by the ASYNC_LOG_* macros before any
+   * of their arguments are evaluated.
+   *
+   * @param lvl Severity level to test.
+   * @return true if messages of this level pass the global filter.
+   */
+  inline bool log_enabled(log_level lvl) noexcept
+  {
+    return lvl >= get_log_level();
+  }
+
+  /**
+   * @brief Write one formatted log line, without level filtering.
    *
    * This function:
-   * - checks the global log level
    * - serializes output using a mutex
    * - prepends a local timestamp and severity tag
    * - writes to stderr
@@ -120,11 +152,8 @@ namespace vix::async::detail
    * @param lvl Severity level of the message.
    * @param msg Message text.
    */
-  inline void log(log_level lvl, std::string_view msg)
+  inline void write_log_line(log_level lvl, std::string_view msg)
   {
-    if (lvl < get_log_level())
-      return;
-
     std::lock_guard<std::mutex> lock(g_log_mutex);
 
     // Timestamp (HH:MM:SS, local time)
@@ -150,40 +179,225 @@ namespace vix::async::detail
   }
 
   /**
-   * @def ASYNC_LOG_TRACE(msg)
+   * @brief Emit a log message.
+   *
+   * Checks the global log level, then writes the message through
+   * write_log_line().
+   *
+   * @param lvl Severity level of the message.
+   * @param msg Message text.
+   */
+  inline void log(log_level lvl, std::string_view msg)
+  {
+    if (!log_enabled(lvl))
+      return;
+
+    write_log_line(lvl, msg);
+  }
+
+  /**
+   * @brief Copy literal text up to the next "{}" placeholder.
+   *
+   * "{{" and "}}" are written as single braces. On return, @p fmt starts
+   * right after the consumed placeholder, or is empty if none was found.
+   *
+   * @param os Output stream.
+   * @param fmt Remaining format string, advanced in place.
+   * @return true if a placeholder was consumed.
+   */
+  inline bool copy_until_placeholder(std::ostream &os, std::string_view &fmt)
+  {
+    while (!fmt.empty())
+    {
+      const std::size_t pos = fmt.find_first_of("{}");
+      if (pos == std::string_view::npos)
+      {
+        os << fmt;
+        fmt = {};
+        return false;
+      }
+
+      os << fmt.substr(0, pos);
+
+      const char c = fmt[pos];
+      const char next = pos + 1 < fmt.size() ? fmt[pos + 1] : '\0';
+      fmt.remove_prefix(pos + 1);
+
+      if (c == '{' && next == '}')
+      {
+        fmt.remove_prefix(1);
+        return true;
+      }
+
+      if (next == c)
+      {
+        fmt.remove_prefix(1);
+      }
+
+      os << c;
+    }
+
+    return false;
+  }
+
+  /**
+   * @brief Format the tail of a message once all arguments are consumed.
+   *
+   * Placeholders left without an argument are dropped.
+   *
+   * @param os Output stream.
+   * @param fmt Remaining format string.
+   */
+  inline void format_into(std::ostream &os, std::string_view fmt)
+  {
+    while (copy_until_placeholder(os, fmt))
+    {
+    }
+  }
+
+  /**
+   * @brief Substitute the next "{}" with @p first and recurse.
+   *
+   * Extra arguments without a matching placeholder are ignored.
+   *
+   * @param os Output stream.
+   * @param fmt Remaining format string.
+   * @param first Argument for the next placeholder.
+   * @param rest Remaining arguments.
+   */
+  template <typename First, typename... Rest>
+  inline void format_into(
+      std::ostream &os,
+      std::string_view fmt,
+      const First &first,
+      const Rest &...rest)
+  {
+    if (!copy_until_placeholder(os, fmt))
+    {
+      return;
+    }
+
+    os << first;
+    format_into(os, fmt, rest...);
+  }
+
+  /**
+   * @brief Emit a log message given as a single string, without level filtering.
+   *
+   * A lone argument is written verbatim, so existing call sites passing
+   * arbitrary runtime strings are never interpreted as format strings.
+   *
+   * @param lvl Severity level of the message.
+   * @param msg Message text.
+   */
+  inline void log_args(log_level lvl, std::string_view msg)
+  {
+    write_log_line(lvl, msg);
+  }
+
+  /**
+   * @brief Format and emit a log message, without level filtering.
+   *
+   * Each "{}" in @p fmt is replaced by the next argument, streamed with
+   * operator<<. The syntax is the subset of std::format used by the
+   * runtime, so call sites stay valid if the implementation moves to
+   * std::format once it is available on all supported toolchains.
+   *
+   * Only called by the ASYNC_LOG_* macros after log_enabled() succeeded,
+   * so formatting cost is paid for enabled messages only.
+   *
+   * @param lvl Severity level of the message.
+   * @param fmt Format string.
+   * @param args Arguments substituted in order.
+   */
+  template <typename... Args>
+  inline void log_args(log_level lvl, std::string_view fmt, const Args &...args)
+  {
+    std::ostringstream os;
+    format_into(os, fmt, args...);
+    write_log_line(lvl, os.str());
+  }
+
+/**
+ * @brief Shared expansion of the ASYNC_LOG_* macros.
+ *
+ * The level is checked before the message arguments are evaluated, so a
+ * disabled message costs one relaxed atomic load and no allocation.
+ */
+#define ASYNC_LOG_AT_(lvl, ...)                                          \
+  (::vix::async::detail::log_enabled(::vix::async::detail::log_level::lvl) \
+       ? ::vix::async::detail::log_args(                                 \
+             ::vix::async::detail::log_level::lvl, __VA_ARGS__)          \
+       : (void)0)
+
+  /**
+   * @def ASYNC_LOG_TRACE(...)
    * @brief Emit a TRACE-level log message.
+   *
+   * Accepts either a single message or a "{}" format string followed by
+   * its arguments. Compiled out when ASYNC_LOG_MIN_LEVEL is above trace.
    */
-#define ASYNC_LOG_TRACE(msg) ::vix::async::detail::log(::vix::async::detail::log_level::trace, msg)
+#if ASYNC_LOG_MIN_LEVEL <= ASYNC_LOG_LEVEL_TRACE
+#define ASYNC_LOG_TRACE(...) ASYNC_LOG_AT_(trace, __VA_ARGS__)
+#else
+#define ASYNC_LOG_TRACE(...) ((void)0)
+#endif
 
   /**
-   * @def ASYNC_LOG_DEBUG(msg)
+   * @def ASYNC_LOG_DEBUG(...)
    * @brief Emit a DEBUG-level log message.
+   *
+   * Compiled out when ASYNC_LOG_MIN_LEVEL is above debug.
    */
-#define ASYNC_LOG_DEBUG(msg) ::vix::async::detail::log(::vix::async::detail::log_level::debug, msg)
+#if ASYNC_LOG_MIN_LEVEL <= ASYNC_LOG_LEVEL_DEBUG
+#define ASYNC_LOG_DEBUG(...) ASYNC_LOG_AT_(debug, __VA_ARGS__)
+#else
+#define ASYNC_LOG_DEBUG(...) ((void)0)
+#endif
 
   /**
-   * @def ASYNC_LOG_INFO(msg)
+   * @def ASYNC_LOG_INFO(...)
    * @brief Emit an INFO-level log message.
+   *
+   * Compiled out when ASYNC_LOG_MIN_LEVEL is above info.
    */
-#define ASYNC_LOG_INFO(msg) ::vix::async::detail::log(::vix::async::detail::log_level::info, msg)
+#if ASYNC_LOG_MIN_LEVEL <= ASYNC_LOG_LEVEL_INFO
+#define ASYNC_LOG_INFO(...) ASYNC_LOG_AT_(info, __VA_ARGS__)
+#else
+#define ASYNC_LOG_INFO(...) ((void)0)
+#endif
 
   /**
-   * @def ASYNC_LOG_WARN(msg)
+   * @def ASYNC_LOG_WARN(...)
    * @brief Emit a WARN-level log message.
+   *
+   * Compiled out when ASYNC_LOG_MIN_LEVEL is above warn.
    */
-#define ASYNC_LOG_WARN(msg) ::vix::async::detail::log(::vix::async::detail::log_level::warn, msg)
+#if ASYNC_LOG_MIN_LEVEL <= ASYNC_LOG_LEVEL_WARN
+#define ASYNC_LOG_WARN(...) ASYNC_LOG_AT_(warn, __VA_ARGS__)
+#else
+#define ASYNC_LOG_WARN(...) ((void)0)
+#endif
 
   /**
-   * @def ASYNC_LOG_ERROR(msg)
+   * @def ASYNC_LOG_ERROR(...)
    * @brief Emit an ERROR-level log message.
+   *
+   * Compiled out when ASYNC_LOG_MIN_LEVEL is above error.
    */
-#define ASYNC_LOG_ERROR(msg) ::vix::async::detail::log(::vix::async::detail::log_level::error, msg)
+#if ASYNC_LOG_MIN_LEVEL <= ASYNC_LOG_LEVEL_ERROR
+#define ASYNC_LOG_ERROR(...) ASYNC_LOG_AT_(error, __VA_ARGS__)
+#else
+#define ASYNC_LOG_ERROR(...) ((void)0)
+#endif
 
   /**
-   * @def ASYNC_LOG_FATAL(msg)
+   * @def ASYNC_LOG_FATAL(...)
    * @brief Emit a FATAL-level log message and abort the process.
+   *
+   * Never compiled out: a fatal condition must not silently continue.
    */
-#define ASYNC_LOG_FATAL(msg) ::vix::async::detail::log(::vix::async::detail::log_level::fatal, msg)
+#define ASYNC_LOG_FATAL(...) ASYNC_LOG_AT_(fatal, __VA_ARGS__)
 
 } // namespace vix::async::detail
 
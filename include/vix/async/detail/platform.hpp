@@ -24,8 +24,15 @@
  * - the target CPU architecture (x86_64, ARM64)
  *
  * All macros expand to either 1 (true) or 0 (false).
+ *
+ * It also provides cpu_features(), the instruction set extensions the
+ * running CPU supports, for code that picks a SIMD path at runtime.
  */
 
+#if (defined(__x86_64__) || defined(_M_X64)) && defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
 // Platform detection
 #if defined(_WIN32)
 #define ASYNC_PLATFORM_WINDOWS 1 /**< Defined as 1 when targeting Windows. */
@@ -64,4 +71,64 @@
 #define ASYNC_ARCH_ARM64 0 /**< Defined as 0 when not targeting ARM64. */
 #endif
 
+// Baseline SIMD (always available on the architecture)
+#define ASYNC_HAS_SSE2 ASYNC_ARCH_X64   /**< SSE2 is part of the x86_64 baseline. */
+#define ASYNC_HAS_NEON ASYNC_ARCH_ARM64 /**< Advanced SIMD is part of the AArch64 baseline. */
+
+namespace vix::async::detail
+{
+  /**
+   * @brief Instruction set extensions available at runtime.
+   */
+  struct cpu_feature_set
+  {
+    /** @brief SSE2 (x86_64 baseline). */
+    bool sse2{false};
+
+    /** @brief AVX2, supported by both the CPU and the OS. */
+    bool avx2{false};
+
+    /** @brief Advanced SIMD (AArch64 baseline). */
+    bool neon{false};
+  };
+
+  /**
+   * @brief Features of the running CPU, detected once.
+   *
+   * Baseline extensions are reported from the build target; optional ones
+   * (AVX2) are queried with cpuid, including the OS check that the wider
+   * registers are saved on context switch.
+   *
+   * @return Detected feature set.
+   */
+  inline const cpu_feature_set &cpu_features() noexcept
+  {
+    static const cpu_feature_set features = []() noexcept
+    {
+      cpu_feature_set f;
+      f.sse2 = ASYNC_HAS_SSE2 != 0;
+      f.neon = ASYNC_HAS_NEON != 0;
+
+#if ASYNC_ARCH_X64
+#if defined(__GNUC__) || defined(__clang__)
+      __builtin_cpu_init();
+      f.avx2 = __builtin_cpu_supports("avx2") != 0;
+#elif defined(_MSC_VER)
+      int regs[4];
+      __cpuid(regs, 1);
+      const bool osxsave = (regs[2] & (1 << 27)) != 0;
+      const bool avx = (regs[2] & (1 << 28)) != 0;
+      if (osxsave && avx && (_xgetbv(0) & 0x6) == 0x6)
+      {
+        __cpuidex(regs, 7, 0);
+        f.avx2 = (regs[1] & (1 << 5)) != 0;
+      }
+#endif
+#endif
+      return f;
+    }();
+    return features;
+  }
+} // namespace vix::async::detail
+
 #endif // VIX_ASYNC_PLATFORM_HPP
@@ -0,0 +1,106 @@
+/**
+ *
+ *  @file ring_queue.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_ASYNC_RING_QUEUE_HPP
+#define VIX_ASYNC_RING_QUEUE_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace vix::async::detail
+{
+  /**
+   * @brief FIFO queue over a growable power-of-two ring.
+   *
+   * Unlike std::deque, which allocates and frees a block every few dozen
+   * elements as the queue moves forward, the ring only allocates when it
+   * has to grow and keeps its capacity afterwards, so a queue that stays
+   * below its high-water mark never touches the heap. Not thread-safe.
+   *
+   * @tparam T Default-constructible, movable element type.
+   */
+  template <typename T>
+  class ring_queue
+  {
+  public:
+    bool empty() const noexcept
+    {
+      return size_ == 0;
+    }
+
+    std::size_t size() const noexcept
+    {
+      return size_;
+    }
+
+    T &front() noexcept
+    {
+      return slots_[head_];
+    }
+
+    void push_back(T value)
+    {
+      if (size_ == slots_.size())
+      {
+        grow();
+      }
+      slots_[(head_ + size_) & (slots_.size() - 1)] = std::move(value);
+      ++size_;
+    }
+
+    /**
+     * @brief Drop the front element, resetting its slot so that it does
+     * not keep resources alive.
+     */
+    void pop_front()
+    {
+      slots_[head_] = T{};
+      head_ = (head_ + 1) & (slots_.size() - 1);
+      --size_;
+    }
+
+    /**
+     * @brief Remove every element, keeping the capacity.
+     */
+    void clear()
+    {
+      while (size_ != 0)
+      {
+        pop_front();
+      }
+      head_ = 0;
+    }
+
+  private:
+    void grow()
+    {
+      std::vector<T> next(slots_.empty() ? 64 : slots_.size() * 2);
+      for (std::size_t i = 0; i < size_; ++i)
+      {
+        next[i] = std::move(slots_[(head_ + i) & (slots_.size() - 1)]);
+      }
+      slots_ = std::move(next);
+      head_ = 0;
+    }
+
+    std::vector<T> slots_;
+    std::size_t head_{0};
+    std::size_t size_{0};
+  };
+
+} // namespace vix::async::detail
+
+#endif // VIX_ASYNC_RING_QUEUE_HPP
@@ -0,0 +1,107 @@
+/**
+ *
+ *  @file scan.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_ASYNC_SCAN_HPP
+#define VIX_ASYNC_SCAN_HPP
+
+#include <cstddef>
+#include <string_view>
+
+namespace vix::async::detail
+{
+  /**
+   * @brief Instruction set used by the multi-byte pattern scanner.
+   */
+  enum class simd_level
+  {
+    scalar, /**< memchr / memcmp. */
+    sse2,   /**< 16 bytes per step (x86_64). */
+    avx2,   /**< 32 bytes per step (x86_64, runtime-detected). */
+    neon    /**< 16 bytes per step (AArch64). */
+  };
+
+  /**
+   * @brief Name of a level ("scalar", "sse2", "avx2", "neon").
+   */
+  const char *to_string(simd_level level) noexcept;
+
+  /**
+   * @brief Level picked for this process.
+   *
+   * The widest level the CPU supports, or scalar when built with
+   * ASYNC_ENABLE_SIMD=0.
+   */
+  simd_level scan_level() noexcept;
+
+  /**
+   * @brief Whether the running CPU can execute the given level.
+   */
+  bool scan_supported(simd_level level) noexcept;
+
+  /**
+   * @brief Position of the first occurrence of c in [data, data + size).
+   *
+   * Always memchr: C libraries already ship vectorized versions of it.
+   *
+   * @return Offset of the byte, or size if absent.
+   */
+  std::size_t scan_byte(const char *data, std::size_t size, char c) noexcept;
+
+  /**
+   * @brief Position of the first occurrence of pattern in [data, data + size).
+   *
+   * Multi-byte patterns are located by comparing the first and last pattern
+   * bytes a whole vector at a time and checking the middle only for
+   * candidate positions, so delimiters like "\r\n\r\n" cost about as much
+   * as a single-byte scan.
+   *
+   * @return Offset of the match, or size if absent (an empty pattern
+   * matches at 0).
+   */
+  std::size_t scan_pattern(const char *data, std::size_t size, std::string_view pattern) noexcept;
+
+  /**
+   * @brief scan_byte() with an explicit level, for tests and benchmarks.
+   *
+   * The level is ignored (see scan_byte()).
+   */
+  std::size_t scan_byte(simd_level level, const char *data, std::size_t size, char c) noexcept;
+
+  /**
+   * @brief scan_pattern() with an explicit level, for tests and benchmarks.
+   *
+   * @pre scan_supported(level).
+   */
+  std::size_t scan_pattern(simd_level level, const char *data, std::size_t size, std::string_view pattern) noexcept;
+
+  /**
+   * @brief string_view convenience form of scan_pattern().
+   *
+   * @return Offset of the match at or after from, or std::string_view::npos.
+   */
+  inline std::size_t find(std::string_view hay, std::string_view pattern, std::size_t from = 0) noexcept
+  {
+    if (from > hay.size())
+    {
+      return std::string_view::npos;
+    }
+    const std::size_t rest = hay.size() - from;
+    const std::size_t pos = scan_pattern(hay.data() + from, rest, pattern);
+    return pos == rest && !pattern.empty() ? std::string_view::npos : from + pos;
+  }
+
+} // namespace vix::async::detail
+
+#endif // VIX_ASYNC_SCAN_HPP
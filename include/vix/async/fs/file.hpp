@@ -0,0 +1,318 @@
+/**
+ *
+ *  @file file.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_ASYNC_FILE_HPP
+#define VIX_ASYNC_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <system_error>
+
+#include <vix/async/core/cancel.hpp>
+#include <vix/async/core/error.hpp>
+#include <vix/async/core/task.hpp>
+
+namespace vix::async::core
+{
+  class io_context;
+}
+
+namespace vix::async::fs::detail
+{
+  class file_service;
+}
+
+namespace vix::async::fs
+{
+  /**
+   * @brief Flags controlling how async_file::open() opens a file.
+   *
+   * Combine with operator|. read | write opens the file read-write.
+   */
+  enum class open_mode : std::uint32_t
+  {
+    /** @brief Open for reading. */
+    read = 1u << 0,
+
+    /** @brief Open for writing. */
+    write = 1u << 1,
+
+    /** @brief Create the file if it does not exist. */
+    create = 1u << 2,
+
+    /** @brief Truncate an existing file to zero length. */
+    truncate = 1u << 3,
+
+    /** @brief Position every write at the end of the file (O_APPEND). */
+    append = 1u << 4,
+
+    /** @brief With create, fail if the file already exists. */
+    exclusive = 1u << 5
+  };
+
+  /**
+   * @brief Combine two open_mode flag sets.
+   */
+  constexpr open_mode operator|(open_mode a, open_mode b) noexcept
+  {
+    return static_cast<open_mode>(static_cast<std::uint32_t>(a) | static_cast<std::uint32_t>(b));
+  }
+
+  /**
+   * @brief Intersect two open_mode flag sets.
+   */
+  constexpr open_mode operator&(open_mode a, open_mode b) noexcept
+  {
+    return static_cast<open_mode>(static_cast<std::uint32_t>(a) & static_cast<std::uint32_t>(b));
+  }
+
+  /**
+   * @brief Check whether a flag set contains a flag.
+   *
+   * @param m Flag set.
+   * @param f Flag to test.
+   * @return true if every bit of f is set in m.
+   */
+  constexpr bool has(open_mode m, open_mode f) noexcept
+  {
+    return (m & f) == f;
+  }
+
+  /**
+   * @brief File handle with coroutine-based positional I/O.
+   *
+   * All operations take an explicit offset and never move a shared file
+   * position, so several operations on one file may be in flight at once.
+   * Requests go to io_context::files(): io_uring where the kernel supports
+   * it, a dedicated blocking thread pool otherwise. Completions resume the
+   * awaiting coroutine on the event loop.
+   *
+   * Cancellation is checked before an operation is submitted; an operation
+   * already handed to the kernel or a pool thread runs to completion and
+   * reports its real result.
+   *
+   * async_file owns its descriptor and closes it on destruction. It is
+   * move-only and must not outlive its io_context.
+   */
+  class async_file
+  {
+  public:
+    /**
+     * @brief Construct a closed file.
+     */
+    async_file() noexcept = default;
+
+    /**
+     * @brief Adopt an open descriptor.
+     *
+     * @param ctx Context whose file service runs the operations.
+     * @param fd Open file descriptor; owned by the async_file from now on.
+     *
+     * @throws std::runtime_error If the context has already been shut down.
+     */
+    async_file(core::io_context &ctx, int fd);
+
+    /**
+     * @brief Close the descriptor if still open.
+     */
+    ~async_file();
+
+    async_file(const async_file &) = delete;
+    async_file &operator=(const async_file &) = delete;
+
+    /**
+     * @brief Move constructor; leaves other closed.
+     */
+    async_file(async_file &&other) noexcept;
+
+    /**
+     * @brief Move assignment; closes the current descriptor first.
+     */
+    async_file &operator=(async_file &&other) noexcept;
+
+    /**
+     * @brief Asynchronously open a file.
+     *
+     * @param ctx Context whose file service runs the operations.
+     * @param path File path.
+     * @param mode Open flags.
+     * @param perms Permission bits used when the file is created.
+     * @param ct Optional cancellation token.
+     *
+     * @return task<async_file> Open file.
+     *
+     * @throws std::system_error on failure or cancellation.
+     */
+    static core::task<async_file> open(
+        core::io_context &ctx,
+        std::string path,
+        open_mode mode,
+        unsigned perms = 0644,
+        core::cancel_token ct = {});
+
+    /**
+     * @brief Read at an offset.
+     *
+     * Issues a single read: the result is short at end of file and may be
+     * short for special files.
+     *
+     * @param offset File offset.
+     * @param buf Destination buffer.
+     * @param ct Optional cancellation token.
+     *
+     * @return task<std::size_t> Number of bytes read (0 at end of file).
+     *
+     * @throws std::system_error on failure or cancellation.
+     */
+    core::task<std::size_t> async_read_at(
+        std::uint64_t offset,
+        std::span<std::byte> buf,
+        core::cancel_token ct = {});
+
+    /**
+     * @brief Write a whole buffer at an offset.
+     *
+     * Short writes are continued until the buffer is written.
+     *
+     * @param offset File offset.
+     * @param buf Source buffer.
+     * @param ct Optional cancellation token.
+     *
+     * @return task<std::size_t> buf.size().
+     *
+     * @throws std::system_error on failure or cancellation.
+     */
+    core::task<std::size_t> async_write_at(
+        std::uint64_t offset,
+        std::span<const std::byte> buf,
+        core::cancel_token ct = {});
+
+    /**
+     * @brief Scatter read at an offset (preadv).
+     *
+     * Fills the buffers in order with a single read; at most IOV_MAX
+     * buffers are used.
+     *
+     * @param offset File offset.
+     * @param bufs Destination buffers.
+     * @param ct Optional cancellation token.
+     *
+     * @return task<std::size_t> Total number of bytes read.
+     *
+     * @throws std::system_error on failure or cancellation.
+     */
+    core::task<std::size_t> async_readv_at(
+        std::uint64_t offset,
+        std::span<const std::span<std::byte>> bufs,
+        core::cancel_token ct = {});
+
+    /**
+     * @brief Gather write at an offset (pwritev).
+     *
+     * Short writes are continued until every buffer is written.
+     *
+     * @param offset File offset.
+     * @param bufs Source buffers.
+     * @param ct Optional cancellation token.
+     *
+     * @return task<std::size_t> Total size of bufs.
+     *
+     * @throws std::system_error on failure or cancellation.
+     */
+    core::task<std::size_t> async_writev_at(
+        std::uint64_t offset,
+        std::span<const std::span<const std::byte>> bufs,
+        core::cancel_token ct = {});
+
+    /**
+     * @brief Flush file data and metadata to stable storage.
+     *
+     * @param ct Optional cancellation token.
+     *
+     * @throws std::system_error on failure or cancellation.
+     */
+    core::task<void> async_fsync(core::cancel_token ct = {});
+
+    /**
+     * @brief Flush file data (and only the metadata needed to read it back).
+     *
+     * @param ct Optional cancellation token.
+     *
+     * @throws std::system_error on failure or cancellation.
+     */
+    core::task<void> async_fdatasync(core::cancel_token ct = {});
+
+    /**
+     * @brief Allocate disk space for a byte range.
+     *
+     * Extends the file if offset + length is past its end.
+     *
+     * @param offset Start of the range.
+     * @param length Length of the range.
+     * @param ct Optional cancellation token.
+     *
+     * @throws std::system_error on failure or cancellation.
+     */
+    core::task<void> async_fallocate(
+        std::uint64_t offset,
+        std::uint64_t length,
+        core::cancel_token ct = {});
+
+    /**
+     * @brief Current file size (fstat, synchronous).
+     *
+     * @return Size in bytes.
+     *
+     * @throws std::system_error on failure.
+     */
+    [[nodiscard]] std::uint64_t size() const;
+
+    /**
+     * @brief Close the descriptor.
+     *
+     * Idempotent. Operations must not be in flight.
+     */
+    void close() noexcept;
+
+    /**
+     * @brief Check whether the file is open.
+     *
+     * @return true if open, false otherwise.
+     */
+    [[nodiscard]] bool is_open() const noexcept { return fd_ >= 0; }
+
+    /**
+     * @brief Return the file descriptor.
+     *
+     * @return Descriptor, or -1 when closed.
+     */
+    [[nodiscard]] int native_handle() const noexcept { return fd_; }
+
+  private:
+    /** @brief Owning context (null when default-constructed). */
+    core::io_context *ctx_{nullptr};
+
+    /** @brief File service of ctx_, cached to skip the lifecycle lock. */
+    detail::file_service *files_{nullptr};
+
+    /** @brief Owned descriptor. */
+    int fd_{-1};
+  };
+
+} // namespace vix::async::fs
+
+#endif // VIX_ASYNC_FILE_HPP
@@ -0,0 +1,162 @@
+/**
+ *
+ *  @file file_service.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_ASYNC_FILE_SERVICE_HPP
+#define VIX_ASYNC_FILE_SERVICE_HPP
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace vix::async::core
+{
+  class io_context;
+}
+
+namespace vix::async::fs::detail
+{
+  /**
+   * @brief Operation carried by a file_request.
+   */
+  enum class file_op : std::uint8_t
+  {
+    read,
+    write,
+    readv,
+    writev,
+    fsync,
+    fdatasync,
+    fallocate,
+    open,
+    prefetch
+  };
+
+  /**
+   * @brief One file operation submitted to the file_service.
+   *
+   * Requests live in the awaiting coroutine frame: the service only keeps a
+   * pointer to them until completion, then posts h on ctx. Nothing may touch
+   * the request after that post.
+   */
+  struct file_request
+  {
+    /** @brief Operation to perform. */
+    file_op op{file_op::read};
+
+    /** @brief Target file descriptor (directory fd for open). */
+    int fd{-1};
+
+    /** @brief File offset for positional and fallocate operations. */
+    std::uint64_t offset{0};
+
+    /** @brief Data buffer, iovec array for vectored operations, or mapped range for prefetch. */
+    void *buf{nullptr};
+
+    /** @brief Byte count, iovec count for vectored operations, or fallocate/prefetch length. */
+    std::uint64_t len{0};
+
+    /** @brief Null-terminated path for open. */
+    const char *path{nullptr};
+
+    /** @brief open(2) flags, or fallocate(2) mode. */
+    int flags{0};
+
+    /** @brief Permission bits for open with O_CREAT. */
+    unsigned perms{0};
+
+    /** @brief Result: byte count or fd on success, -errno on failure. */
+    std::int64_t result{0};
+
+    /** @brief Context the awaiting coroutine is resumed on. */
+    vix::async::core::io_context *ctx{nullptr};
+
+    /** @brief Awaiting coroutine. */
+    std::coroutine_handle<> h{};
+  };
+
+  /**
+   * @brief Internal file I/O backend for the async runtime.
+   *
+   * Uses an io_uring instance serviced by one completion thread where the
+   * kernel supports every ring operation it needs, and a dedicated pool of
+   * blocking threads otherwise (or when ASYNC_ENABLE_IO_URING is 0). The
+   * blocking pool is separate from io_context::cpu_pool() so that slow
+   * disks never starve CPU work.
+   *
+   * prefetch always runs on the blocking pool, which the io_uring backend
+   * creates on first use: populating a mapping has to wait for page reads,
+   * and io_uring's madvise only starts them.
+   *
+   * Lazily created by vix::async::core::io_context::files().
+   */
+  class file_service
+  {
+  public:
+    /**
+     * @brief Construct the service and pick a backend.
+     *
+     * @param ctx Core io_context used by the runtime.
+     */
+    explicit file_service(vix::async::core::io_context &ctx);
+
+    /**
+     * @brief Destroy the service.
+     *
+     * Stops and joins the backend threads. Requests still in flight are
+     * completed by the kernel but their coroutines are not resumed.
+     */
+    ~file_service();
+
+    /**
+     * @brief file_service is non-copyable.
+     */
+    file_service(const file_service &) = delete;
+
+    /**
+     * @brief file_service is non-copyable.
+     */
+    file_service &operator=(const file_service &) = delete;
+
+    /**
+     * @brief Start a request; completion posts req.h on req.ctx.
+     *
+     * @param req Request; must stay alive until its coroutine is resumed.
+     * @throws std::system_error with errc::stopped after stop().
+     */
+    void submit(file_request &req);
+
+    /**
+     * @brief Whether requests go through io_uring.
+     *
+     * @return true for the io_uring backend, false for the blocking pool.
+     */
+    [[nodiscard]] bool uses_io_uring() const noexcept;
+
+    /**
+     * @brief Stop the backend threads.
+     */
+    void stop() noexcept;
+
+  private:
+    struct impl;
+
+    /** @brief Backend state. */
+    std::unique_ptr<impl> impl_;
+  };
+
+} // namespace vix::async::fs::detail
+
+#endif // VIX_ASYNC_FILE_SERVICE_HPP
@@ -0,0 +1,178 @@
+/**
+ *
+ *  @file mapped_file.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_ASYNC_MAPPED_FILE_HPP
+#define VIX_ASYNC_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <system_error>
+
+#include <vix/async/core/cancel.hpp>
+#include <vix/async/core/error.hpp>
+#include <vix/async/core/task.hpp>
+
+namespace vix::async::core
+{
+  class io_context;
+}
+
+namespace vix::async::fs::detail
+{
+  class file_service;
+}
+
+namespace vix::async::fs
+{
+  /**
+   * @brief Read-only memory-mapped view of a whole file.
+   *
+   * Gives coroutines zero-copy access to file contents. Touching a page
+   * that is not resident blocks the calling thread on a page fault, so
+   * code running on the event loop should await prefetch() on a range
+   * before scanning it: the pages are read in on the file service's
+   * blocking pool and the coroutine resumes once they are mapped.
+   *
+   * Prefetched pages are only a hint to the kernel and may be evicted
+   * again under memory pressure.
+   *
+   * The file must not be truncated while mapped. mapped_file is
+   * move-only; the mapping is released on destruction.
+   */
+  class mapped_file
+  {
+  public:
+    /**
+     * @brief Construct an empty view.
+     */
+    mapped_file() noexcept = default;
+
+    /**
+     * @brief Unmap the file if still mapped.
+     */
+    ~mapped_file();
+
+    mapped_file(const mapped_file &) = delete;
+    mapped_file &operator=(const mapped_file &) = delete;
+
+    /**
+     * @brief Move constructor; leaves other empty.
+     */
+    mapped_file(mapped_file &&other) noexcept;
+
+    /**
+     * @brief Move assignment; unmaps the current view first.
+     */
+    mapped_file &operator=(mapped_file &&other) noexcept;
+
+    /**
+     * @brief Asynchronously open and map a file read-only.
+     *
+     * The open goes through the file service; the mapping itself does not
+     * read any page. An empty file yields an open view with no data.
+     *
+     * @param ctx Context whose file service runs prefetches.
+     * @param path File path.
+     * @param ct Optional cancellation token.
+     *
+     * @return task<mapped_file> Mapped view.
+     *
+     * @throws std::system_error on failure or cancellation.
+     */
+    static core::task<mapped_file> open(
+        core::io_context &ctx,
+        std::string path,
+        core::cancel_token ct = {});
+
+    /**
+     * @brief Make a byte range resident without blocking the event loop.
+     *
+     * The range is clamped to the file size.
+     *
+     * @param offset Start of the range.
+     * @param length Length of the range.
+     * @param ct Optional cancellation token.
+     *
+     * @return task<void> that completes once the pages are mapped.
+     *
+     * @throws std::system_error on failure or cancellation.
+     */
+    core::task<void> prefetch(
+        std::uint64_t offset,
+        std::uint64_t length,
+        core::cancel_token ct = {});
+
+    /**
+     * @brief Whole mapped contents.
+     *
+     * @return View of the file (empty for an empty or closed file).
+     */
+    [[nodiscard]] std::span<const std::byte> data() const noexcept
+    {
+      return {data_, size_};
+    }
+
+    /**
+     * @brief Part of the mapped contents.
+     *
+     * @param offset Start of the range.
+     * @param length Length of the range; clamped to the file size.
+     *
+     * @return View of the range.
+     *
+     * @throws std::system_error with errc::invalid_argument if offset is past the end.
+     */
+    [[nodiscard]] std::span<const std::byte> view(std::uint64_t offset, std::uint64_t length) const;
+
+    /**
+     * @brief Size of the mapped file.
+     *
+     * @return Size in bytes.
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+    /**
+     * @brief Check whether a file is mapped.
+     *
+     * @return true if open, false otherwise.
+     */
+    [[nodiscard]] bool is_open() const noexcept { return files_ != nullptr; }
+
+    /**
+     * @brief Release the mapping.
+     *
+     * Idempotent. Prefetches must not be in flight.
+     */
+    void close() noexcept;
+
+  private:
+    /** @brief Owning context (null when closed). */
+    core::io_context *ctx_{nullptr};
+
+    /** @brief File service of ctx_ (null when closed). */
+    detail::file_service *files_{nullptr};
+
+    /** @brief Start of the mapping (null for an empty file). */
+    const std::byte *data_{nullptr};
+
+    /** @brief File size in bytes. */
+    std::size_t size_{0};
+  };
+
+} // namespace vix::async::fs
+
+#endif // VIX_ASYNC_MAPPED_FILE_HPP
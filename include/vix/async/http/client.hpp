@@ -0,0 +1,201 @@
+/**
+ *
+ *  @file client.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_ASYNC_HTTP_CLIENT_HPP
+#define VIX_ASYNC_HTTP_CLIENT_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <vix/async/core/cancel.hpp>
+#include <vix/async/core/task.hpp>
+#include <vix/async/detail/config.hpp>
+#include <vix/async/net/tcp.hpp>
+
+namespace vix::async::core
+{
+  class io_context;
+}
+
+namespace vix::async::http
+{
+  /**
+   * @brief Request sent by a client.
+   */
+  struct client_request
+  {
+    /** @brief Request method. */
+    std::string method{"GET"};
+
+    /** @brief Request target. */
+    std::string target{"/"};
+
+    /**
+     * @brief Header fields.
+     *
+     * Host is added when missing; Content-Length is always set by the client.
+     */
+    std::vector<std::pair<std::string, std::string>> headers{};
+
+    /** @brief Body. */
+    std::string body{};
+  };
+
+  /**
+   * @brief Response received by a client; owns its data.
+   */
+  struct client_response
+  {
+    /** @brief Status code. */
+    int status{0};
+
+    /** @brief Reason phrase. */
+    std::string reason{};
+
+    /** @brief Header fields in arrival order. */
+    std::vector<std::pair<std::string, std::string>> headers{};
+
+    /** @brief Body, decoded from chunked encoding if needed. */
+    std::string body{};
+
+    /**
+     * @brief Value of the first field with the given name.
+     *
+     * @param name Field name, compared case-insensitively.
+     *
+     * @return Value, or an empty view if absent.
+     */
+    [[nodiscard]] std::string_view header(std::string_view name) const noexcept;
+  };
+
+  /**
+   * @brief Client limits and tuning.
+   */
+  struct client_options
+  {
+    /** @brief Idle keep-alive connections kept per endpoint. */
+    std::size_t max_idle_per_host{8};
+
+    /** @brief Largest accepted response head. */
+    std::size_t max_head_size{ASYNC_FRAME_BUFFER_SIZE};
+
+    /** @brief Largest accepted response body. */
+    std::size_t max_body_size{ASYNC_MAX_FRAME_SIZE};
+
+    /** @brief Disable Nagle's algorithm on new connections. */
+    bool nodelay{true};
+  };
+
+  /**
+   * @brief HTTP/1.1 client with a keep-alive connection pool.
+   *
+   * Connections are reused per endpoint; a request that fails on a reused
+   * connection before any response byte arrived (the server closed it
+   * while idle) is retried once on a fresh connection, provided its
+   * method is idempotent or the request could not be written at all. A
+   * POST the server may already have processed is never sent twice.
+   * Requests on one client may run concurrently, each on its own
+   * connection.
+   *
+   * A client must be used from its context's scheduler thread.
+   */
+  class client
+  {
+  public:
+    /**
+     * @brief Construct a client.
+     *
+     * @param ctx Context running the connections.
+     * @param opts Limits and tuning.
+     */
+    explicit client(core::io_context &ctx, client_options opts = {});
+
+    /**
+     * @brief Close all idle connections.
+     */
+    ~client();
+
+    client(const client &) = delete;
+    client &operator=(const client &) = delete;
+
+    /**
+     * @brief Send a request and read the whole response.
+     *
+     * @param ep Server endpoint.
+     * @param req Request to send.
+     * @param ct Optional cancellation token.
+     *
+     * @return task<client_response> Response.
+     *
+     * @throws std::system_error on connection or protocol failure
+     * (errc::invalid_argument for a malformed response, errc::overflow past
+     * the configured limits) or cancellation.
+     */
+    core::task<client_response> async_request(
+        const net::tcp_endpoint &ep,
+        const client_request &req,
+        core::cancel_token ct = {});
+
+    /**
+     * @brief Send a GET request.
+     *
+     * @param ep Server endpoint.
+     * @param target Request target.
+     * @param ct Optional cancellation token.
+     *
+     * @return task<client_response> Response.
+     *
+     * @throws std::system_error as async_request().
+     */
+    core::task<client_response> async_get(
+        const net::tcp_endpoint &ep,
+        std::string_view target,
+        core::cancel_token ct = {});
+
+    /**
+     * @brief Number of pooled idle connections.
+     */
+    [[nodiscard]] std::size_t idle_connections() const noexcept;
+
+    /**
+     * @brief Close and drop all idle connections.
+     */
+    void close_idle() noexcept;
+
+  private:
+    struct connection;
+
+    /**
+     * @brief Read the response to a request sent on conn.
+     */
+    core::task<void> read_response(
+        connection &conn,
+        std::string_view method,
+        client_response &res,
+        core::cancel_token ct);
+
+    core::io_context &ctx_;
+    client_options opts_;
+    std::unordered_map<std::string, std::vector<std::unique_ptr<connection>>> idle_;
+  };
+
+} // namespace vix::async::http
+
+#endif // VIX_ASYNC_HTTP_CLIENT_HPP
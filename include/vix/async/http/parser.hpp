@@ -0,0 +1,264 @@
+/**
+ *
+ *  @file parser.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_ASYNC_HTTP_PARSER_HPP
+#define VIX_ASYNC_HTTP_PARSER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace vix::async::http
+{
+  /**
+   * @brief One header field, as views into the parsed buffer.
+   */
+  struct header_field
+  {
+    /** @brief Field name (case preserved). */
+    std::string_view name;
+
+    /** @brief Field value without surrounding whitespace. */
+    std::string_view value;
+  };
+
+  /**
+   * @brief Parsed request line and header fields.
+   *
+   * All views point into the buffer that was parsed. The headers vector
+   * keeps its capacity across parses, so a connection that reuses one
+   * request_head does not allocate per request.
+   */
+  struct request_head
+  {
+    /** @brief Request method (e.g. "GET"). */
+    std::string_view method;
+
+    /** @brief Request target (e.g. "/index.html?x=1"). */
+    std::string_view target;
+
+    /** @brief Minor version: 1 for HTTP/1.1, 0 for HTTP/1.0. */
+    int version_minor{1};
+
+    /** @brief Header fields in arrival order. */
+    std::vector<header_field> headers;
+
+    /**
+     * @brief Value of the first field with the given name.
+     *
+     * @param name Field name, compared case-insensitively.
+     *
+     * @return Value, or an empty view if absent.
+     */
+    [[nodiscard]] std::string_view header(std::string_view name) const noexcept;
+  };
+
+  /**
+   * @brief Parsed status line and header fields.
+   *
+   * Same view and reuse rules as request_head.
+   */
+  struct response_head
+  {
+    /** @brief Status code. */
+    int status{0};
+
+    /** @brief Reason phrase (may be empty). */
+    std::string_view reason;
+
+    /** @brief Minor version: 1 for HTTP/1.1, 0 for HTTP/1.0. */
+    int version_minor{1};
+
+    /** @brief Header fields in arrival order. */
+    std::vector<header_field> headers;
+
+    /**
+     * @brief Value of the first field with the given name.
+     *
+     * @param name Field name, compared case-insensitively.
+     *
+     * @return Value, or an empty view if absent.
+     */
+    [[nodiscard]] std::string_view header(std::string_view name) const noexcept;
+  };
+
+  /**
+   * @brief Outcome of parsing a message head from a raw buffer.
+   */
+  enum class parse_status
+  {
+    /** @brief A whole head was parsed. */
+    complete,
+
+    /** @brief The buffer does not hold a whole head yet. */
+    incomplete,
+
+    /** @brief The head is malformed. */
+    invalid
+  };
+
+  /**
+   * @brief Result of parse_request() / parse_response().
+   */
+  struct parse_result
+  {
+    /** @brief Outcome. */
+    parse_status status{parse_status::incomplete};
+
+    /** @brief Bytes taken by the head, blank line included (when complete). */
+    std::size_t size{0};
+  };
+
+  /**
+   * @brief Parse a request head without its terminating blank line.
+   *
+   * head is the request line and the header lines separated by CRLF, with
+   * no trailing CRLF, as returned by a delimited_reader on "\r\n\r\n".
+   * Leading empty lines are skipped. Obsolete line folding is rejected.
+   *
+   * @param head Head text.
+   * @param out Receives views into head.
+   *
+   * @return true if the head is well formed.
+   */
+  [[nodiscard]] bool parse_request_head(std::string_view head, request_head &out);
+
+  /**
+   * @brief Parse a response head without its terminating blank line.
+   *
+   * @param head Head text (see parse_request_head()).
+   * @param out Receives views into head.
+   *
+   * @return true if the head is well formed.
+   */
+  [[nodiscard]] bool parse_response_head(std::string_view head, response_head &out);
+
+  /**
+   * @brief Parse a request head from the front of a raw buffer.
+   *
+   * @param buf Received bytes.
+   * @param out Receives views into buf.
+   *
+   * @return Parse outcome and head size.
+   */
+  [[nodiscard]] parse_result parse_request(std::string_view buf, request_head &out);
+
+  /**
+   * @brief Parse a response head from the front of a raw buffer.
+   *
+   * @param buf Received bytes.
+   * @param out Receives views into buf.
+   *
+   * @return Parse outcome and head size.
+   */
+  [[nodiscard]] parse_result parse_response(std::string_view buf, response_head &out);
+
+  /**
+   * @brief How the body following a head is delimited.
+   */
+  enum class body_kind
+  {
+    /** @brief No body. */
+    none,
+
+    /** @brief Content-Length bytes. */
+    length,
+
+    /** @brief Transfer-Encoding: chunked. */
+    chunked,
+
+    /** @brief Everything until the connection closes (responses only). */
+    until_close
+  };
+
+  /**
+   * @brief Body delimitation of a message.
+   */
+  struct body_framing
+  {
+    /** @brief Kind of delimitation. */
+    body_kind kind{body_kind::none};
+
+    /** @brief Body size for body_kind::length. */
+    std::uint64_t length{0};
+  };
+
+  /**
+   * @brief Body delimitation of a request.
+   *
+   * @param head Parsed request head.
+   *
+   * @return Framing, or nullopt if Content-Length / Transfer-Encoding are
+   * malformed or contradictory (a request smuggling vector).
+   */
+  [[nodiscard]] std::optional<body_framing> request_body(const request_head &head);
+
+  /**
+   * @brief Body delimitation of a response.
+   *
+   * @param head Parsed response head.
+   * @param request_method Method of the request it answers ("HEAD"
+   * responses never carry a body).
+   *
+   * @return Framing, or nullopt if Content-Length is malformed.
+   */
+  [[nodiscard]] std::optional<body_framing> response_body(
+      const response_head &head,
+      std::string_view request_method);
+
+  /**
+   * @brief Whether the connection stays open after this request.
+   *
+   * @param head Parsed request head.
+   *
+   * @return true for HTTP/1.1 without "Connection: close" and for HTTP/1.0
+   * with "Connection: keep-alive".
+   */
+  [[nodiscard]] bool keep_alive(const request_head &head) noexcept;
+
+  /**
+   * @brief Whether the connection stays open after this response.
+   *
+   * @param head Parsed response head.
+   *
+   * @return Same rules as for requests.
+   */
+  [[nodiscard]] bool keep_alive(const response_head &head) noexcept;
+
+  /**
+   * @brief Case-insensitive ASCII comparison.
+   */
+  [[nodiscard]] bool iequals(std::string_view a, std::string_view b) noexcept;
+
+  /**
+   * @brief Whether a comma-separated field value lists a token.
+   *
+   * @param list Field value (e.g. "keep-alive, Upgrade").
+   * @param token Token, compared case-insensitively.
+   */
+  [[nodiscard]] bool has_token(std::string_view list, std::string_view token) noexcept;
+
+  /**
+   * @brief Standard reason phrase of a status code.
+   *
+   * @return Phrase, or "Unknown" for unregistered codes.
+   */
+  [[nodiscard]] std::string_view reason_phrase(int status) noexcept;
+
+} // namespace vix::async::http
+
+#endif // VIX_ASYNC_HTTP_PARSER_HPP
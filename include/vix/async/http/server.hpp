@@ -0,0 +1,262 @@
+/**
+ *
+ *  @file server.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_ASYNC_HTTP_SERVER_HPP
+#define VIX_ASYNC_HTTP_SERVER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <vix/async/core/cancel.hpp>
+#include <vix/async/core/task.hpp>
+#include <vix/async/detail/config.hpp>
+#include <vix/async/http/parser.hpp>
+#include <vix/async/net/tcp.hpp>
+
+namespace vix::async::core
+{
+  class io_context;
+}
+
+namespace vix::async::http
+{
+  namespace detail
+  {
+    class connection;
+  }
+
+  /**
+   * @brief Request handed to a handler.
+   *
+   * Views in head and body point into the connection's read buffer (or a
+   * per-connection copy for chunked bodies) and are valid until the
+   * handler's task completes.
+   */
+  struct request
+  {
+    /** @brief Request line and header fields. */
+    request_head head;
+
+    /** @brief Body, decoded from chunked encoding if needed. */
+    std::string_view body;
+
+    /** @brief Whether the connection stays open after the response. */
+    bool keep_alive{true};
+  };
+
+  /**
+   * @brief Response filled in by a handler.
+   *
+   * By default the handler sets status, headers and body, and the server
+   * adds Content-Length once the handler returns. Calling
+   * async_write_chunk() instead streams the body with chunked encoding
+   * (plain streaming until close for HTTP/1.0 clients).
+   *
+   * The server owns Content-Length, Transfer-Encoding and Connection;
+   * handlers must not set them.
+   */
+  class response
+  {
+  public:
+    /** @brief Status code. */
+    int status{200};
+
+    /** @brief Header fields. */
+    std::vector<std::pair<std::string, std::string>> headers;
+
+    /** @brief Body (sent as the first chunk when streaming). */
+    std::string body;
+
+    /**
+     * @brief Append a header field.
+     *
+     * @param name Field name.
+     * @param value Field value.
+     */
+    void add_header(std::string name, std::string value)
+    {
+      headers.emplace_back(std::move(name), std::move(value));
+    }
+
+    /**
+     * @brief Send part of the body right away.
+     *
+     * The first call sends the status line and headers. The terminating
+     * chunk is sent when the handler returns.
+     *
+     * @param data Body bytes; an empty view is ignored.
+     * @param ct Optional cancellation token.
+     *
+     * @throws std::system_error on write failure or cancellation.
+     */
+    core::task<void> async_write_chunk(std::string_view data, core::cancel_token ct = {});
+
+    /**
+     * @brief Whether async_write_chunk() has been called.
+     */
+    [[nodiscard]] bool streaming() const noexcept { return streaming_; }
+
+  private:
+    friend class detail::connection;
+
+    detail::connection *conn_{nullptr};
+    bool streaming_{false};
+  };
+
+  /**
+   * @brief Request handler: fill in the response for one request.
+   *
+   * A throwing handler gets a 500 response (or, once streaming, a closed
+   * connection).
+   */
+  using handler = std::function<core::task<void>(const request &, response &)>;
+
+  /**
+   * @brief Server limits and tuning.
+   */
+  struct server_options
+  {
+    /** @brief Largest request head; larger heads get 431. */
+    std::size_t max_head_size{ASYNC_FRAME_BUFFER_SIZE};
+
+    /** @brief Largest request body; larger bodies get 413. */
+    std::size_t max_body_size{ASYNC_MAX_FRAME_SIZE};
+
+    /**
+     * @brief Buffered response bytes that force a write.
+     *
+     * Responses to pipelined requests are batched into one write until
+     * this many bytes are pending; bodies at least this large are sent
+     * with a gathered write instead of being copied.
+     */
+    std::size_t flush_threshold{64 * 1024};
+
+    /** @brief Disable Nagle's algorithm on accepted connections. */
+    bool nodelay{true};
+
+    /**
+     * @brief Longest wait for a complete request head; zero disables it.
+     *
+     * Runs from the moment the server starts waiting for a head, so it is
+     * also the keep-alive idle timeout. On expiry the connection is closed
+     * without a response.
+     */
+    std::chrono::milliseconds header_timeout{std::chrono::seconds(30)};
+
+    /**
+     * @brief Longest time spent draining the peer after an error response.
+     *
+     * Before closing after a 4xx/5xx or a 503 from load shedding, the
+     * server reads and discards what the peer still sends, so that the
+     * response is not lost to a reset. Zero disables the limit.
+     */
+    std::chrono::milliseconds linger_timeout{std::chrono::seconds(2)};
+
+    /**
+     * @brief Answer new connections with 503 while the context is overloaded.
+     *
+     * Uses the scheduler's admission control (core::scheduler::try_admit()),
+     * which is off until core::scheduler::set_admission() enables it.
+     * Connections that are already open keep being served.
+     */
+    bool shed_when_overloaded{false};
+  };
+
+  /**
+   * @brief HTTP/1.1 server on top of tcp_listener / tcp_stream.
+   *
+   * Each connection runs as one coroutine on the context's scheduler.
+   * Requests are parsed in place in a pooled read buffer; keep-alive and
+   * pipelining are supported, and the responses to requests that arrived
+   * together go out in a single write.
+   *
+   * Connections keep the server state alive, so the server object may be
+   * destroyed while connections are still draining.
+   */
+  class server
+  {
+  public:
+    /**
+     * @brief Construct a server.
+     *
+     * @param ctx Context running the connections.
+     * @param h Request handler.
+     * @param opts Limits and tuning.
+     */
+    server(core::io_context &ctx, handler h, server_options opts = {});
+
+    /**
+     * @brief Destructor.
+     */
+    ~server();
+
+    server(const server &) = delete;
+    server &operator=(const server &) = delete;
+
+    /**
+     * @brief Accept connections and serve each one in its own coroutine.
+     *
+     * With server_options::shed_when_overloaded set, new connections get a
+     * 503 and are closed while the context is overloaded.
+     *
+     * @param listener Listening socket.
+     * @param ct Optional cancellation token (also passed to every connection).
+     *
+     * @return task<void> that completes once the listener is closed.
+     *
+     * @throws std::system_error on accept failure or cancellation.
+     */
+    core::task<void> async_serve(net::tcp_listener &listener, core::cancel_token ct = {});
+
+    /**
+     * @brief Serve one connection until either side closes it.
+     *
+     * I/O errors end the connection and are not rethrown.
+     *
+     * @param stream Connected stream.
+     * @param ct Optional cancellation token.
+     */
+    core::task<void> async_serve_connection(
+        std::unique_ptr<net::tcp_stream> stream,
+        core::cancel_token ct = {});
+
+    /**
+     * @brief Number of connections currently being served.
+     */
+    [[nodiscard]] std::size_t active_connections() const noexcept;
+
+  private:
+    friend class detail::connection;
+
+    struct state;
+
+    static core::task<void> serve(
+        std::shared_ptr<state> st,
+        std::unique_ptr<net::tcp_stream> stream,
+        core::cancel_token ct,
+        bool shed = false);
+
+    std::shared_ptr<state> state_;
+  };
+
+} // namespace vix::async::http
+
+#endif // VIX_ASYNC_HTTP_SERVER_HPP
@@ -16,9 +16,12 @@
 #ifndef VIX_ASYNC_ASIO_NET_SERVICE_HPP
 #define VIX_ASYNC_ASIO_NET_SERVICE_HPP
 
+#include <atomic>
 #include <memory>
 #include <thread>
 
+#include <vix/async/detail/config.hpp>
+
 #if defined(__GNUC__) || defined(__clang__)
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wnull-dereference"
@@ -48,7 +51,8 @@ namespace vix::async::net::detail
    * Lifetime model:
    * - Constructed with a reference to the core io_context (for integration)
    * - Uses a work guard to keep the Asio io_context alive
-   * - Runs ioc_.run() on net_thread_
+   * - Runs ioc_.run() on net_thread_ (the only thread running it, hence
+   *   the single-threaded concurrency hint)
    * - stop() releases the guard and stops the Asio context
    */
   class asio_net_service
@@ -60,8 +64,11 @@ namespace vix::async::net::detail
      * Typically created lazily by vix::async::core::io_context::net().
      *
      * @param ctx Core io_context used by the runtime.
+     * @param concurrency_hint Hint passed to the asio::io_context.
      */
-    explicit asio_net_service(vix::async::core::io_context &ctx);
+    explicit asio_net_service(
+        vix::async::core::io_context &ctx,
+        int concurrency_hint = ASYNC_NET_CONCURRENCY_HINT);
 
     /**
      * @brief Destroy the service.
@@ -95,14 +102,12 @@ namespace vix::async::net::detail
      */
     void stop() noexcept;
 
-    void join() noexcept;
-
-  private:
     /**
-     * @brief Bound core io_context.
+     * @brief Join the network thread (detaches when called from it).
      */
-    vix::async::core::io_context &ctx_;
+    void join() noexcept;
 
+  private:
     /**
      * @brief Asio io_context used for networking operations.
      */
@@ -126,7 +131,7 @@ namespace vix::async::net::detail
     /**
      * @brief Indicates whether stop() has been requested.
      */
-    bool stopped_{false};
+    std::atomic_bool stopped_{false};
   };
 
 } // namespace vix::async::net::detail
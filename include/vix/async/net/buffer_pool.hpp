@@ -0,0 +1,201 @@
+/**
+ *
+ *  @file buffer_pool.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_ASYNC_BUFFER_POOL_HPP
+#define VIX_ASYNC_BUFFER_POOL_HPP
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <vix/async/detail/config.hpp>
+
+namespace vix::async::net
+{
+  /**
+   * @brief Thread-safe cache of fixed-size byte blocks.
+   *
+   * Connection read buffers are acquired from the pool and handed back on
+   * release, so accepting and dropping connections does not allocate once
+   * the pool is warm. At most max_cached blocks are kept; extra blocks are
+   * freed.
+   *
+   * The pool must outlive every buffer acquired from it.
+   */
+  class buffer_pool
+  {
+  public:
+    /**
+     * @brief Block borrowed from a buffer_pool.
+     *
+     * Move-only; returns the block to its pool on destruction.
+     */
+    class buffer
+    {
+    public:
+      /**
+       * @brief Construct an empty buffer.
+       */
+      buffer() noexcept = default;
+
+      /**
+       * @brief Return the block to its pool.
+       */
+      ~buffer() { reset(); }
+
+      buffer(const buffer &) = delete;
+      buffer &operator=(const buffer &) = delete;
+
+      /**
+       * @brief Move constructor; leaves other empty.
+       */
+      buffer(buffer &&other) noexcept
+          : pool_(std::exchange(other.pool_, nullptr)),
+            data_(std::move(other.data_))
+      {
+      }
+
+      /**
+       * @brief Move assignment; returns the current block first.
+       */
+      buffer &operator=(buffer &&other) noexcept
+      {
+        if (this != &other)
+        {
+          reset();
+          pool_ = std::exchange(other.pool_, nullptr);
+          data_ = std::move(other.data_);
+        }
+        return *this;
+      }
+
+      /**
+       * @brief Block contents.
+       *
+       * @return Whole block, or an empty span for an empty buffer.
+       */
+      [[nodiscard]] std::span<std::byte> bytes() const noexcept
+      {
+        return data_ ? std::span<std::byte>(data_.get(), pool_->block_size()) : std::span<std::byte>{};
+      }
+
+      /**
+       * @brief Check whether a block is held.
+       */
+      explicit operator bool() const noexcept { return data_ != nullptr; }
+
+      /**
+       * @brief Return the block to its pool now.
+       */
+      void reset() noexcept
+      {
+        if (data_)
+        {
+          pool_->release(std::move(data_));
+        }
+        pool_ = nullptr;
+      }
+
+    private:
+      friend class buffer_pool;
+
+      buffer(buffer_pool *pool, std::unique_ptr<std::byte[]> data) noexcept
+          : pool_(pool),
+            data_(std::move(data))
+      {
+      }
+
+      buffer_pool *pool_{nullptr};
+      std::unique_ptr<std::byte[]> data_{};
+    };
+
+    /**
+     * @brief Construct a pool.
+     *
+     * @param block_size Size of every block in bytes.
+     * @param max_cached Maximum number of idle blocks kept.
+     */
+    explicit buffer_pool(
+        std::size_t block_size = ASYNC_FRAME_BUFFER_SIZE,
+        std::size_t max_cached = 64)
+        : block_size_(block_size),
+          max_cached_(max_cached)
+    {
+    }
+
+    buffer_pool(const buffer_pool &) = delete;
+    buffer_pool &operator=(const buffer_pool &) = delete;
+
+    /**
+     * @brief Borrow a block, reusing an idle one when available.
+     *
+     * @return Buffer of block_size() bytes (contents unspecified).
+     */
+    [[nodiscard]] buffer acquire()
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!free_.empty())
+        {
+          auto data = std::move(free_.back());
+          free_.pop_back();
+          return buffer(this, std::move(data));
+        }
+      }
+      return buffer(this, std::make_unique_for_overwrite<std::byte[]>(block_size_));
+    }
+
+    /**
+     * @brief Size of every block.
+     */
+    [[nodiscard]] std::size_t block_size() const noexcept { return block_size_; }
+
+    /**
+     * @brief Number of idle blocks currently cached.
+     */
+    [[nodiscard]] std::size_t cached() const
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return free_.size();
+    }
+
+  private:
+    void release(std::unique_ptr<std::byte[]> data) noexcept
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (free_.size() < max_cached_)
+      {
+        try
+        {
+          free_.push_back(std::move(data));
+        }
+        catch (...)
+        {
+        }
+      }
+    }
+
+    std::size_t block_size_;
+    std::size_t max_cached_;
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<std::byte[]>> free_;
+  };
+
+} // namespace vix::async::net
+
+#endif // VIX_ASYNC_BUFFER_POOL_HPP
@@ -0,0 +1,304 @@
+/**
+ *
+ *  @file framing.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_ASYNC_FRAMING_HPP
+#define VIX_ASYNC_FRAMING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include <vix/async/core/cancel.hpp>
+#include <vix/async/core/error.hpp>
+#include <vix/async/core/task.hpp>
+#include <vix/async/detail/config.hpp>
+#include <vix/async/net/buffer_pool.hpp>
+#include <vix/async/net/tcp.hpp>
+
+namespace vix::async::net
+{
+  /**
+   * @brief Read buffer in front of a tcp_stream.
+   *
+   * Each read asks the stream for as much as fits in the free space, so
+   * small frames arriving together cost one read. Consumed bytes are
+   * dropped lazily: the unread tail is moved to the front only when the
+   * next read needs the room, and the buffer grows past its initial
+   * capacity only for data that does not fit.
+   *
+   * Spans returned by buffered() and by the frame readers below point into
+   * this buffer and stay valid until the next async_fill() call.
+   */
+  class buffered_reader
+  {
+  public:
+    /**
+     * @brief Construct a reader with its own buffer.
+     *
+     * @param stream Stream to read from; must outlive the reader.
+     * @param capacity Initial buffer size.
+     */
+    explicit buffered_reader(tcp_stream &stream, std::size_t capacity = ASYNC_FRAME_BUFFER_SIZE);
+
+    /**
+     * @brief Construct a reader whose buffer is borrowed from a pool.
+     *
+     * The block goes back to the pool when the reader is destroyed (or
+     * when it has to grow past the block size).
+     *
+     * @param stream Stream to read from; must outlive the reader.
+     * @param pool Pool to borrow from; must outlive the reader.
+     */
+    buffered_reader(tcp_stream &stream, buffer_pool &pool);
+
+    buffered_reader(const buffered_reader &) = delete;
+    buffered_reader &operator=(const buffered_reader &) = delete;
+
+    /**
+     * @brief Bytes read but not consumed yet.
+     */
+    [[nodiscard]] std::span<const std::byte> buffered() const noexcept
+    {
+      return {data_ + begin_, end_ - begin_};
+    }
+
+    /**
+     * @brief Drop bytes from the front of buffered().
+     *
+     * The bytes stay readable through previously returned spans until the
+     * next async_fill().
+     *
+     * @param n Number of bytes; clamped to buffered().size().
+     */
+    void consume(std::size_t n) noexcept;
+
+    /**
+     * @brief Read until at least n bytes are buffered.
+     *
+     * @param n Required number of buffered bytes.
+     * @param ct Optional cancellation token.
+     *
+     * @return task<bool> true once n bytes are buffered, false if the peer
+     * closed the stream first (buffered() keeps whatever arrived).
+     *
+     * @throws std::system_error on read failure or cancellation.
+     */
+    core::task<bool> async_fill(std::size_t n, core::cancel_token ct = {});
+
+    /**
+     * @brief Whether the peer closed the stream.
+     */
+    [[nodiscard]] bool eof() const noexcept { return eof_; }
+
+    /**
+     * @brief Current buffer size.
+     */
+    [[nodiscard]] std::size_t capacity() const noexcept { return cap_; }
+
+    /**
+     * @brief Underlying stream.
+     */
+    [[nodiscard]] tcp_stream &stream() noexcept { return *stream_; }
+
+  private:
+    /**
+     * @brief Make room for a read with n bytes buffered from begin_.
+     */
+    void make_room(std::size_t n);
+
+    tcp_stream *stream_;
+    buffer_pool::buffer pooled_{};
+    std::unique_ptr<std::byte[]> heap_{};
+    std::byte *data_{nullptr};
+    std::size_t cap_{0};
+    std::size_t begin_{0};
+    std::size_t end_{0};
+    bool eof_{false};
+  };
+
+  /**
+   * @brief Encoding of a frame length prefix.
+   */
+  enum class length_prefix
+  {
+    /** @brief Unsigned LEB128 varint (1 to 10 bytes). */
+    varint,
+
+    /** @brief 16-bit big-endian. */
+    u16_be,
+
+    /** @brief 32-bit big-endian. */
+    u32_be
+  };
+
+  /**
+   * @brief Largest encoded length prefix.
+   */
+  inline constexpr std::size_t max_length_prefix_size = 10;
+
+  /**
+   * @brief Encode a frame length.
+   *
+   * @param prefix Encoding.
+   * @param length Payload length.
+   * @param out Destination.
+   *
+   * @return Number of bytes written to out.
+   *
+   * @throws std::system_error with errc::overflow if length does not fit the encoding.
+   */
+  std::size_t encode_length_prefix(
+      length_prefix prefix,
+      std::uint64_t length,
+      std::span<std::byte, max_length_prefix_size> out);
+
+  /**
+   * @brief Reads length-prefixed frames.
+   */
+  class length_prefixed_reader
+  {
+  public:
+    /**
+     * @brief Construct a frame reader.
+     *
+     * @param in Buffered reader to take frames from; must outlive this object.
+     * @param prefix Encoding of the length prefix.
+     * @param max_frame Largest accepted payload.
+     */
+    explicit length_prefixed_reader(
+        buffered_reader &in,
+        length_prefix prefix = length_prefix::varint,
+        std::size_t max_frame = ASYNC_MAX_FRAME_SIZE) noexcept
+        : in_(&in),
+          prefix_(prefix),
+          max_frame_(max_frame)
+    {
+    }
+
+    /**
+     * @brief Read the next frame.
+     *
+     * @param ct Optional cancellation token.
+     *
+     * @return task<std::optional<std::span<const std::byte>>> Payload as a
+     * view into the read buffer (valid until the next read), or nullopt if
+     * the peer closed the stream between frames.
+     *
+     * @throws std::system_error with errc::overflow for a frame larger than
+     * max_frame or a malformed varint, errc::closed if the stream ends
+     * inside a frame, or on read failure or cancellation.
+     */
+    core::task<std::optional<std::span<const std::byte>>> async_read_frame(
+        core::cancel_token ct = {});
+
+  private:
+    buffered_reader *in_;
+    length_prefix prefix_;
+    std::size_t max_frame_;
+  };
+
+  /**
+   * @brief Reads frames terminated by a delimiter (e.g. newline).
+   */
+  class delimited_reader
+  {
+  public:
+    /**
+     * @brief Construct a frame reader.
+     *
+     * @param in Buffered reader to take frames from; must outlive this object.
+     * @param delimiter Non-empty frame terminator.
+     * @param max_frame Largest accepted frame, delimiter excluded.
+     *
+     * @throws std::system_error with errc::invalid_argument for an empty delimiter.
+     */
+    explicit delimited_reader(
+        buffered_reader &in,
+        std::string delimiter = "\n",
+        std::size_t max_frame = ASYNC_MAX_FRAME_SIZE);
+
+    /**
+     * @brief Read the next frame.
+     *
+     * Only newly arrived bytes are scanned for the delimiter.
+     *
+     * @param ct Optional cancellation token.
+     *
+     * @return task<std::optional<std::span<const std::byte>>> Frame without
+     * its delimiter as a view into the read buffer (valid until the next
+     * read), or nullopt if the peer closed the stream between frames.
+     *
+     * @throws std::system_error with errc::overflow if no delimiter appears
+     * within max_frame bytes, errc::closed if the stream ends inside a
+     * frame, or on read failure or cancellation.
+     */
+    core::task<std::optional<std::span<const std::byte>>> async_read_frame(
+        core::cancel_token ct = {});
+
+  private:
+    buffered_reader *in_;
+    std::string delimiter_;
+    std::size_t max_frame_;
+
+    /** @brief Buffered bytes already known not to start a delimiter. */
+    std::size_t scanned_{0};
+  };
+
+  /**
+   * @brief Write one length-prefixed frame.
+   *
+   * Prefix and payload go out in a single gathered write.
+   *
+   * @param stream Destination stream.
+   * @param payload Frame payload.
+   * @param prefix Encoding of the length prefix.
+   * @param ct Optional cancellation token.
+   *
+   * @throws std::system_error with errc::overflow if the payload length
+   * does not fit the prefix, or on write failure or cancellation.
+   */
+  core::task<void> async_write_frame(
+      tcp_stream &stream,
+      std::span<const std::byte> payload,
+      length_prefix prefix = length_prefix::varint,
+      core::cancel_token ct = {});
+
+  /**
+   * @brief Write one delimiter-terminated frame.
+   *
+   * The payload must not contain the delimiter. Payload and delimiter go
+   * out in a single gathered write.
+   *
+   * @param stream Destination stream.
+   * @param payload Frame payload.
+   * @param delimiter Frame terminator.
+   * @param ct Optional cancellation token.
+   *
+   * @throws std::system_error on write failure or cancellation.
+   */
+  core::task<void> async_write_delimited(
+      tcp_stream &stream,
+      std::span<const std::byte> payload,
+      std::string_view delimiter = "\n",
+      core::cancel_token ct = {});
+
+} // namespace vix::async::net
+
+#endif // VIX_ASYNC_FRAMING_HPP
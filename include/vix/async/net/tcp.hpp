@@ -119,6 +119,32 @@ namespace vix::async::net
         std::span<const std::byte> buf,
         core::cancel_token ct = {}) = 0;
 
+    /**
+     * @brief Asynchronously write several buffers, in order, as one stream write.
+     *
+     * Lets callers send a header and a payload without copying them into
+     * one buffer. The Asio backend gathers them into writev calls; the
+     * default implementation writes them one after the other.
+     *
+     * @param bufs Source buffers.
+     * @param ct Optional cancellation token.
+     *
+     * @return task<std::size_t> Total number of bytes written.
+     *
+     * @throws std::system_error on write failure or cancellation.
+     */
+    virtual core::task<std::size_t> async_write_v(
+        std::span<const std::span<const std::byte>> bufs,
+        core::cancel_token ct = {})
+    {
+      std::size_t total = 0;
+      for (const auto &b : bufs)
+      {
+        total += co_await async_write(b, ct);
+      }
+      co_return total;
+    }
+
     /**
      * @brief Close the TCP stream.
      *
@@ -0,0 +1,282 @@
+/**
+ *
+ *  @file process.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_ASYNC_PROCESS_HPP
+#define VIX_ASYNC_PROCESS_HPP
+
+#include <csignal>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <vix/async/core/cancel.hpp>
+#include <vix/async/core/error.hpp>
+#include <vix/async/core/task.hpp>
+
+namespace vix::async::core
+{
+  class io_context;
+}
+
+namespace vix::async::process
+{
+  /**
+   * @brief What a child's standard stream is connected to.
+   */
+  enum class stdio
+  {
+    /** @brief Share the parent's stream. */
+    inherit,
+
+    /** @brief Connect a pipe exposed as a pipe_stream. */
+    pipe,
+
+    /** @brief Connect /dev/null. */
+    null
+  };
+
+  /**
+   * @brief Description of a child process to spawn.
+   */
+  struct process_options
+  {
+    /**
+     * @brief Program to run; searched in PATH when search_path is set and
+     * it contains no slash.
+     */
+    std::string program;
+
+    /**
+     * @brief Arguments after argv[0] (argv[0] is the program).
+     */
+    std::vector<std::string> args{};
+
+    /**
+     * @brief Environment as "NAME=value" entries; inherited when empty.
+     */
+    std::optional<std::vector<std::string>> env{};
+
+    /**
+     * @brief Working directory of the child; inherited when empty.
+     */
+    std::string cwd{};
+
+    /** @brief Standard input. */
+    stdio in{stdio::inherit};
+
+    /** @brief Standard output. */
+    stdio out{stdio::inherit};
+
+    /** @brief Standard error. */
+    stdio err{stdio::inherit};
+
+    /** @brief Look program up in PATH. */
+    bool search_path{true};
+  };
+
+  /**
+   * @brief How a child process terminated.
+   */
+  struct exit_status
+  {
+    /** @brief Exit code, or -1 if the child was killed by a signal. */
+    int code{-1};
+
+    /** @brief Terminating signal, or 0 if the child exited normally. */
+    int signal{0};
+
+    /**
+     * @brief Whether the child exited normally.
+     *
+     * @return true if it called exit() or returned from main.
+     */
+    [[nodiscard]] bool exited() const noexcept { return signal == 0; }
+
+    /**
+     * @brief Whether the child exited with code 0.
+     *
+     * @return true on success.
+     */
+    [[nodiscard]] bool success() const noexcept { return signal == 0 && code == 0; }
+  };
+
+  /**
+   * @brief Abstract asynchronous pipe connected to a child's stdio.
+   *
+   * Same read/write shape as net::tcp_stream. A pipe is one-way: the
+   * child's stdin only supports async_write, stdout and stderr only
+   * async_read; the other direction throws errc::not_supported.
+   */
+  class pipe_stream
+  {
+  public:
+    /**
+     * @brief Virtual destructor.
+     */
+    virtual ~pipe_stream() = default;
+
+    /**
+     * @brief Asynchronously read data from the pipe.
+     *
+     * Reads up to buf.size() bytes into the provided buffer.
+     *
+     * @param buf Destination buffer.
+     * @param ct Optional cancellation token.
+     *
+     * @return task<std::size_t> Number of bytes read; 0 once the child has
+     * closed its end and all data was consumed.
+     *
+     * @throws std::system_error on read failure or cancellation.
+     */
+    virtual core::task<std::size_t> async_read(
+        std::span<std::byte> buf,
+        core::cancel_token ct = {}) = 0;
+
+    /**
+     * @brief Asynchronously write a whole buffer to the pipe.
+     *
+     * @param buf Source buffer.
+     * @param ct Optional cancellation token.
+     *
+     * @return task<std::size_t> Number of bytes written.
+     *
+     * @throws std::system_error on write failure (EPIPE once the child
+     * closed its stdin) or cancellation.
+     */
+    virtual core::task<std::size_t> async_write(
+        std::span<const std::byte> buf,
+        core::cancel_token ct = {}) = 0;
+
+    /**
+     * @brief Close the parent's end of the pipe.
+     *
+     * Closing stdin is how the child sees end of input. Idempotent.
+     */
+    virtual void close() noexcept = 0;
+
+    /**
+     * @brief Check whether the pipe is currently open.
+     *
+     * @return true if the pipe is open, false otherwise.
+     */
+    virtual bool is_open() const noexcept = 0;
+
+    /**
+     * @brief Return the parent's pipe descriptor.
+     *
+     * @return Descriptor, or -1 when closed.
+     */
+    virtual int native_handle() = 0;
+  };
+
+  /**
+   * @brief Abstract handle to a running child process.
+   *
+   * Exit is observed through a pidfd (Linux 5.3+) registered with the
+   * networking backend, so waiting for any number of children needs no
+   * dedicated thread; without pidfd support the child is polled with
+   * waitpid(WNOHANG) on a backoff timer.
+   *
+   * Destroying the handle before the child was awaited does not kill it:
+   * the child is reaped in the background once it exits.
+   */
+  class async_process
+  {
+  public:
+    /**
+     * @brief Virtual destructor.
+     */
+    virtual ~async_process() = default;
+
+    /**
+     * @brief Child process id.
+     *
+     * @return Process id.
+     */
+    virtual int pid() const noexcept = 0;
+
+    /**
+     * @brief Pipe to the child's stdin.
+     *
+     * @return Pipe, or nullptr unless process_options::in is stdio::pipe.
+     */
+    virtual pipe_stream *stdin_pipe() noexcept = 0;
+
+    /**
+     * @brief Pipe from the child's stdout.
+     *
+     * @return Pipe, or nullptr unless process_options::out is stdio::pipe.
+     */
+    virtual pipe_stream *stdout_pipe() noexcept = 0;
+
+    /**
+     * @brief Pipe from the child's stderr.
+     *
+     * @return Pipe, or nullptr unless process_options::err is stdio::pipe.
+     */
+    virtual pipe_stream *stderr_pipe() noexcept = 0;
+
+    /**
+     * @brief Wait for the child to terminate and reap it.
+     *
+     * Completes immediately once the child has been reaped. Cancellation
+     * abandons the wait, not the child; kill() it first to stop it.
+     *
+     * @param ct Optional cancellation token.
+     *
+     * @return task<exit_status> How the child terminated.
+     *
+     * @throws std::system_error on failure or cancellation.
+     */
+    virtual core::task<exit_status> async_wait(core::cancel_token ct = {}) = 0;
+
+    /**
+     * @brief Send a signal to the child.
+     *
+     * No-op once the child has been reaped, so the signal can never reach
+     * a recycled pid.
+     *
+     * @param sig Signal number.
+     *
+     * @throws std::system_error if the signal cannot be sent.
+     */
+    virtual void kill(int sig = SIGTERM) = 0;
+  };
+
+  /**
+   * @brief Spawn a child process (posix_spawn).
+   *
+   * The first call sets SIGPIPE to ignored in the parent if it still has
+   * its default action, so that writing to a child that closed its stdin
+   * fails with EPIPE instead of killing the process; children get the
+   * default SIGPIPE action and an empty signal mask.
+   *
+   * @param ctx Context whose networking backend drives the pipes and exit
+   * notification.
+   * @param opts What to run and how to connect it.
+   *
+   * @return Handle to the running child.
+   *
+   * @throws std::system_error if the program cannot be started.
+   */
+  std::unique_ptr<async_process> spawn(core::io_context &ctx, const process_options &opts);
+
+} // namespace vix::async::process
+
+#endif // VIX_ASYNC_PROCESS_HPP
@@ -0,0 +1,108 @@
+/**
+ *
+ *  @file arena.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/async/core/arena.hpp>
+
+#include <algorithm>
+#include <new>
+
+namespace vix::async::core
+{
+  namespace
+  {
+    constexpr std::size_t header_size =
+        (sizeof(void *) * 2 + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+  } // namespace
+
+  request_arena::request_arena(std::size_t chunk_size) noexcept
+      : chunk_size_(std::max<std::size_t>(chunk_size, 256))
+  {
+  }
+
+  request_arena::~request_arena()
+  {
+    while (head_ != nullptr)
+    {
+      chunk *next = head_->next;
+      ::operator delete(head_, head_->size);
+      head_ = next;
+    }
+  }
+
+  void request_arena::release() noexcept
+  {
+    if (head_ == nullptr)
+    {
+      return;
+    }
+
+    // Keep the first regular chunk. Dedicated blocks are linked behind the
+    // current chunk, so it is not necessarily the last one in the list.
+    chunk *c = head_;
+    while (c != nullptr)
+    {
+      chunk *next = c->next;
+      if (c != first_)
+      {
+        ::operator delete(c, c->size);
+        --chunks_;
+      }
+      c = next;
+    }
+    head_ = first_;
+    head_->next = nullptr;
+
+    cur_ = reinterpret_cast<char *>(head_) + header_size;
+    end_ = reinterpret_cast<char *>(head_) + head_->size;
+    last_ = nullptr;
+    used_ = 0;
+  }
+
+  void *request_arena::allocate_slow(std::size_t bytes, std::size_t alignment)
+  {
+    const std::size_t need = header_size + bytes + (alignment > alignof(std::max_align_t) ? alignment : 0);
+
+    // Large blocks get a chunk of their own, so the current chunk keeps
+    // serving small requests.
+    const bool dedicated = cur_ != nullptr && bytes > chunk_size_ / 2;
+    const std::size_t size = std::max(need, dedicated ? need : chunk_size_);
+
+    auto *c = static_cast<chunk *>(::operator new(size));
+    c->size = size;
+    ++chunks_;
+
+    char *begin = reinterpret_cast<char *>(c) + header_size;
+    const auto p = reinterpret_cast<std::uintptr_t>(begin);
+    char *aligned = reinterpret_cast<char *>((p + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1));
+    used_ += bytes;
+
+    if (dedicated)
+    {
+      c->next = head_->next;
+      head_->next = c;
+      return aligned;
+    }
+
+    c->next = head_;
+    head_ = c;
+    if (first_ == nullptr)
+    {
+      first_ = c;
+    }
+    last_ = aligned;
+    cur_ = aligned + bytes;
+    end_ = reinterpret_cast<char *>(c) + size;
+    return aligned;
+  }
+
+} // namespace vix::async::core
@@ -0,0 +1,57 @@
+/**
+ *
+ *  @file executor.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/async/core/executor.hpp>
+
+namespace vix::async::core
+{
+  namespace
+  {
+    thread_local executor current{};
+
+    void resume_inline(void *, std::coroutine_handle<> h) noexcept
+    {
+      // The completing thread runs the coroutine until its next suspension;
+      // awaits made meanwhile resume inline too.
+      const executor previous = detail::exchange_current_executor(executor::inline_executor());
+      h.resume();
+      detail::exchange_current_executor(previous);
+    }
+  } // namespace
+
+  executor executor::inline_executor() noexcept
+  {
+    return executor(nullptr, &resume_inline);
+  }
+
+  bool executor::is_inline() const noexcept
+  {
+    return post_ == &resume_inline;
+  }
+
+  executor current_executor() noexcept
+  {
+    return current;
+  }
+
+  namespace detail
+  {
+    executor exchange_current_executor(executor e) noexcept
+    {
+      const executor previous = current;
+      current = e;
+      return previous;
+    }
+  } // namespace detail
+
+} // namespace vix::async::core
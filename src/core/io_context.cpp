@@ -14,8 +14,11 @@
 #include <vix/async/core/io_context.hpp>
 
 #include <vix/async/core/signal.hpp>
+#include <vix/async/core/task_registry.hpp>
 #include <vix/async/core/thread_pool.hpp>
 #include <vix/async/core/timer.hpp>
+#include <vix/async/detail/log.hpp>
+#include <vix/async/fs/file_service.hpp>
 #include <vix/async/net/asio_net_service.hpp>
 
 #include <memory>
@@ -26,6 +29,21 @@ namespace vix::async::core
 {
   io_context::io_context() = default;
 
+  io_context::io_context(virtual_time_t)
+      : virtual_time_(true)
+  {
+    sched_.set_idle_handler(
+        [this]()
+        {
+          timer *t = nullptr;
+          {
+            std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+            t = is_shutdown() ? nullptr : timer_.get();
+          }
+          return t != nullptr && t->advance();
+        });
+  }
+
   io_context::~io_context() noexcept
   {
     shutdown();
@@ -56,6 +74,14 @@ namespace vix::async::core
     {
     }
 
+    try
+    {
+      files_.reset();
+    }
+    catch (...)
+    {
+    }
+
     try
     {
       signals_.reset();
@@ -79,6 +105,33 @@ namespace vix::async::core
     catch (...)
     {
     }
+
+#if ASYNC_ENABLE_TASK_REGISTRY
+    // The registry is process-wide: the count includes frames owned by
+    // other contexts, which is still the useful number when tearing down.
+    try
+    {
+      const std::size_t live = live_task_count();
+      if (live != 0)
+      {
+        ASYNC_LOG_WARN("io_context shutdown with {} live task frame(s); see dump_async_stacks()", live);
+      }
+    }
+    catch (...)
+    {
+    }
+#endif
+  }
+
+  metrics_snapshot io_context::metrics() const noexcept
+  {
+    metrics_snapshot s;
+    s.taken_at = metrics_clock::now();
+    s.scheduler = sched_.metrics().snapshot();
+    s.cpu_pool = counters_.cpu_pool.snapshot();
+    s.timers = counters_.timers.snapshot();
+    s.net = counters_.net.snapshot();
+    return s;
   }
 
   thread_pool &io_context::cpu_pool()
@@ -133,4 +186,17 @@ namespace vix::async::core
     return *net_;
   }
 
+  vix::async::fs::detail::file_service &io_context::files()
+  {
+    std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+    ensure_not_shutdown();
+
+    if (!files_)
+    {
+      files_ = std::make_unique<vix::async::fs::detail::file_service>(*this);
+    }
+
+    return *files_;
+  }
+
 } // namespace vix::async::core
@@ -0,0 +1,145 @@
+/**
+ *
+ *  @file metrics.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/async/core/metrics.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+
+namespace vix::async::core
+{
+  namespace
+  {
+    constexpr double ns_per_second = 1e9;
+
+    void write_header(
+        std::ostream &os,
+        std::string_view prefix,
+        std::string_view name,
+        std::string_view type,
+        std::string_view help)
+    {
+      os << "# HELP " << prefix << '_' << name << ' ' << help << '\n';
+      os << "# TYPE " << prefix << '_' << name << ' ' << type << '\n';
+    }
+
+    template <typename V>
+    void write_counter(
+        std::ostream &os,
+        std::string_view prefix,
+        std::string_view name,
+        std::string_view help,
+        V value)
+    {
+      write_header(os, prefix, name, "counter", help);
+      os << prefix << '_' << name << ' ' << value << '\n';
+    }
+
+    template <typename V>
+    void write_gauge(
+        std::ostream &os,
+        std::string_view prefix,
+        std::string_view name,
+        std::string_view help,
+        V value)
+    {
+      write_header(os, prefix, name, "gauge", help);
+      os << prefix << '_' << name << ' ' << value << '\n';
+    }
+
+    void write_histogram(
+        std::ostream &os,
+        std::string_view prefix,
+        std::string_view name,
+        std::string_view help,
+        const histogram_snapshot &h)
+    {
+      write_header(os, prefix, name, "histogram", help);
+
+      // Export one cumulative bucket per power of two: the log-linear
+      // sub-buckets would make the series long and Prometheus quantiles are
+      // interpolated anyway. Trailing empty ranges carry no information;
+      // stop after the last populated one and let +Inf close the series.
+      constexpr std::size_t sub = histogram_snapshot::sub_bucket_count;
+
+      std::size_t last = 0;
+      for (std::size_t i = 0; i < histogram_snapshot::bucket_count; ++i)
+      {
+        if (h.buckets[i] != 0)
+        {
+          last = i;
+        }
+      }
+
+      // The saturating last bucket has no finite bound and is left to +Inf.
+      const std::size_t end = std::min(last - last % sub + sub, histogram_snapshot::bucket_count - 1);
+
+      std::uint64_t cumulative = 0;
+      for (std::size_t i = 0; i < end; ++i)
+      {
+        cumulative += h.buckets[i];
+        if ((i + 1) % sub == 0)
+        {
+          const double le =
+              static_cast<double>(histogram_snapshot::bucket_upper_bound(i)) / ns_per_second;
+          os << prefix << '_' << name << "_bucket{le=\"" << le << "\"} " << cumulative << '\n';
+        }
+      }
+
+      os << prefix << '_' << name << "_bucket{le=\"+Inf\"} " << h.count << '\n';
+      os << prefix << '_' << name << "_sum " << static_cast<double>(h.sum_ns) / ns_per_second << '\n';
+      os << prefix << '_' << name << "_count " << h.count << '\n';
+    }
+  } // namespace
+
+  void write_prometheus(
+      std::ostream &os,
+      const metrics_snapshot &s,
+      std::string_view prefix)
+  {
+    const auto &sc = s.scheduler;
+    write_counter(os, prefix, "scheduler_handle_posts_total", "Coroutine handles posted to the scheduler.", sc.handle_posts);
+    write_counter(os, prefix, "scheduler_fn_posts_total", "Callables posted to the scheduler.", sc.fn_posts);
+    write_counter(os, prefix, "scheduler_handle_runs_total", "Coroutine handles resumed by the scheduler.", sc.handle_runs);
+    write_counter(os, prefix, "scheduler_fn_runs_total", "Callables executed by the scheduler.", sc.fn_runs);
+    write_counter(os, prefix, "scheduler_loop_iterations_total", "Scheduler loop iterations.", sc.loop_iterations);
+    write_counter(os, prefix, "scheduler_idle_seconds_total", "Time the scheduler spent waiting for work.", static_cast<double>(sc.idle_ns) / ns_per_second);
+    write_gauge(os, prefix, "scheduler_queue_depth", "Items currently queued on the scheduler.", sc.queue_depth);
+    write_gauge(os, prefix, "scheduler_queue_depth_max", "Largest scheduler queue depth observed.", sc.queue_depth_hwm);
+    write_counter(os, prefix, "scheduler_overloads_total", "Times the scheduler entered the overloaded state.", sc.overloads);
+    write_counter(os, prefix, "scheduler_rejected_total", "Work rejected by admission control.", sc.rejected);
+    write_histogram(os, prefix, "scheduler_post_to_resume_seconds", "Delay between post and execution.", sc.post_to_resume);
+
+    const auto &cp = s.cpu_pool;
+    write_counter(os, prefix, "cpu_pool_submitted_total", "Jobs submitted to the CPU pool.", cp.submitted);
+    write_counter(os, prefix, "cpu_pool_completed_total", "Jobs executed by the CPU pool.", cp.completed);
+    write_counter(os, prefix, "cpu_pool_rejected_total", "Jobs dropped by a stopping CPU pool.", cp.rejected);
+    write_histogram(os, prefix, "cpu_pool_queue_wait_seconds", "Time jobs waited in the CPU pool queue.", cp.queue_wait);
+    write_histogram(os, prefix, "cpu_pool_run_seconds", "Execution time of CPU pool jobs.", cp.run_time);
+
+    const auto &tm = s.timers;
+    write_counter(os, prefix, "timer_scheduled_total", "Timer entries scheduled.", tm.scheduled);
+    write_counter(os, prefix, "timer_fired_total", "Timer entries fired.", tm.fired);
+    write_counter(os, prefix, "timer_cancelled_total", "Timer entries skipped after cancellation.", tm.cancelled);
+    write_gauge(os, prefix, "timer_queue_size", "Timer entries pending.", tm.queue_size);
+    write_histogram(os, prefix, "timer_lateness_seconds", "Delay between timer deadline and dispatch.", tm.lateness);
+
+    write_counter(os, prefix, "net_completions_total", "Asio operations completed.", s.net.completions);
+    write_counter(os, prefix, "net_errors_total", "Asio operations completed with an error.", s.net.errors);
+    write_histogram(os, prefix, "net_op_latency_seconds", "Time from starting an Asio operation to its completion.", s.net.op_latency);
+  }
+
+} // namespace vix::async::core
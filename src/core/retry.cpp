@@ -0,0 +1,112 @@
+/**
+ *
+ *  @file retry.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/async/core/retry.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace vix::async::core
+{
+  namespace
+  {
+    constexpr double scale = 1000.0;
+
+    std::int64_t to_milli(double tokens) noexcept
+    {
+      return static_cast<std::int64_t>(std::llround(std::max(0.0, tokens) * scale));
+    }
+
+    std::minstd_rand &jitter_rng() noexcept
+    {
+      thread_local std::minstd_rand rng(std::random_device{}());
+      return rng;
+    }
+  } // namespace
+
+  retry_budget::retry_budget(double max_tokens, double token_ratio) noexcept
+      : max_(to_milli(max_tokens)),
+        ratio_(to_milli(token_ratio)),
+        tokens_(max_)
+  {
+  }
+
+  bool retry_budget::allows_retry() const noexcept
+  {
+    return tokens_.load(std::memory_order_relaxed) * 2 > max_;
+  }
+
+  void retry_budget::record_failure() noexcept
+  {
+    add(-static_cast<std::int64_t>(scale));
+  }
+
+  void retry_budget::record_success() noexcept
+  {
+    add(ratio_);
+  }
+
+  double retry_budget::tokens() const noexcept
+  {
+    return static_cast<double>(tokens_.load(std::memory_order_relaxed)) / scale;
+  }
+
+  void retry_budget::add(std::int64_t delta) noexcept
+  {
+    std::int64_t cur = tokens_.load(std::memory_order_relaxed);
+    while (true)
+    {
+      const std::int64_t next = std::clamp<std::int64_t>(cur + delta, 0, max_);
+      if (next == cur || tokens_.compare_exchange_weak(cur, next, std::memory_order_relaxed))
+      {
+        return;
+      }
+    }
+  }
+
+  bool is_transient_error(const std::error_code &ec) noexcept
+  {
+    if (ec.category() == category())
+    {
+      const auto e = static_cast<errc>(ec.value());
+      return e == errc::timeout || e == errc::queue_full || e == errc::rejected;
+    }
+
+    return ec == std::errc::timed_out ||
+           ec == std::errc::connection_refused ||
+           ec == std::errc::connection_reset ||
+           ec == std::errc::connection_aborted ||
+           ec == std::errc::network_unreachable ||
+           ec == std::errc::network_down ||
+           ec == std::errc::host_unreachable ||
+           ec == std::errc::resource_unavailable_try_again;
+  }
+
+  timer::duration backoff_delay(const retry_policy &policy, std::uint32_t retry) noexcept
+  {
+    const double initial = static_cast<double>(policy.initial_backoff.count());
+    const double limit = static_cast<double>(policy.max_backoff.count());
+    const double growth = std::pow(std::max(1.0, policy.multiplier), static_cast<double>(retry > 0 ? retry - 1 : 0));
+    const double cap = std::clamp(initial * growth, 0.0, std::max(0.0, limit));
+
+    if (!policy.jitter || cap <= 0.0)
+    {
+      return timer::duration(static_cast<timer::duration::rep>(cap));
+    }
+
+    std::uniform_real_distribution<double> dist(0.0, cap);
+    return timer::duration(static_cast<timer::duration::rep>(dist(jitter_rng())));
+  }
+
+} // namespace vix::async::core
@@ -0,0 +1,205 @@
+/**
+ *
+ *  @file shared_mutex.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/async/core/shared_mutex.hpp>
+
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+namespace vix::async::core
+{
+  namespace
+  {
+    using waiter = async_shared_mutex::waiter;
+
+    void push(waiter *&head, waiter *&tail, waiter &w) noexcept
+    {
+      w.next = nullptr;
+      if (tail)
+      {
+        tail->next = &w;
+      }
+      else
+      {
+        head = &w;
+      }
+      tail = &w;
+    }
+
+    waiter *pop(waiter *&head, waiter *&tail) noexcept
+    {
+      waiter *w = head;
+      if (w)
+      {
+        head = w->next;
+        if (!head)
+        {
+          tail = nullptr;
+        }
+        w->next = nullptr;
+      }
+      return w;
+    }
+
+    void resume(waiter *w) noexcept
+    {
+      // Read before posting: the node lives in the coroutine frame.
+      const executor exec = w->exec;
+      const std::coroutine_handle<> h = w->h;
+      exec.post(h);
+    }
+
+    void resume_all(waiter *w) noexcept
+    {
+      while (w)
+      {
+        waiter *next = w->next;
+        resume(w);
+        w = next;
+      }
+    }
+  } // namespace
+
+  bool async_shared_mutex::suspend_shared(waiter &w) noexcept
+  {
+    waiter *drained = nullptr;
+    bool queued = true;
+
+    {
+      std::lock_guard<std::mutex> lock(m_);
+
+      // Remove the count the fast path added.
+      const std::uint64_t old = state_.fetch_sub(1, std::memory_order_relaxed);
+      if ((old & writer_bit) != 0 && (old & readers_mask) == 1)
+      {
+        drained = std::exchange(draining_, nullptr);
+      }
+
+      // The writer may have left meanwhile. try_lock() can set writer_bit
+      // again without m_, so only count in while it is clear.
+      std::uint64_t s = state_.load(std::memory_order_relaxed);
+      while (queued && (s & writer_bit) == 0)
+      {
+        queued = !state_.compare_exchange_weak(s, s + 1, std::memory_order_acquire, std::memory_order_relaxed);
+      }
+
+      if (queued)
+      {
+        push(readers_head_, readers_tail_, w);
+      }
+    }
+
+    if (drained)
+    {
+      resume(drained);
+    }
+    return queued;
+  }
+
+  bool async_shared_mutex::suspend_unique(waiter &w) noexcept
+  {
+    std::lock_guard<std::mutex> lock(m_);
+
+    // Claim the lock now so new readers queue, then wait for the current
+    // ones. A single fetch_or, since try_lock() may take writer_bit at any
+    // moment without m_.
+    const std::uint64_t old = state_.fetch_or(writer_bit, std::memory_order_acquire);
+    if ((old & writer_bit) != 0)
+    {
+      push(writers_head_, writers_tail_, w);
+      return true;
+    }
+
+    if ((old & readers_mask) == 0)
+    {
+      return false;
+    }
+
+    draining_ = &w;
+    return true;
+  }
+
+  void async_shared_mutex::wake_drained() noexcept
+  {
+    waiter *w = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(m_);
+      w = std::exchange(draining_, nullptr);
+    }
+
+    if (w)
+    {
+      resume(w);
+    }
+  }
+
+  void async_shared_mutex::unlock() noexcept
+  {
+    waiter *readers = nullptr;
+    waiter *writer = nullptr;
+
+    {
+      std::lock_guard<std::mutex> lock(m_);
+
+      std::uint64_t batch = 0;
+      for (waiter *r = readers_head_; r; r = r->next)
+      {
+        ++batch;
+      }
+      readers = std::exchange(readers_head_, nullptr);
+      readers_tail_ = nullptr;
+
+      if (readers)
+      {
+        if (writers_head_)
+        {
+          // The batch goes first; the next writer keeps writer_bit so no
+          // newer reader overtakes it, and gets the lock when they leave.
+          state_.fetch_add(batch, std::memory_order_release);
+          draining_ = pop(writers_head_, writers_tail_);
+        }
+        else
+        {
+          // Clears writer_bit and admits the batch in one step.
+          state_.fetch_add(batch - writer_bit, std::memory_order_release);
+        }
+      }
+      else if (writers_head_)
+      {
+        // Hand over: writer_bit stays set. Only readers that failed their
+        // fast path can still be counted; the last of them wakes the writer.
+        waiter *next = pop(writers_head_, writers_tail_);
+        if ((state_.load(std::memory_order_relaxed) & readers_mask) == 0)
+        {
+          writer = next;
+        }
+        else
+        {
+          draining_ = next;
+        }
+      }
+      else
+      {
+        state_.fetch_and(~writer_bit, std::memory_order_release);
+      }
+    }
+
+    resume_all(readers);
+    if (writer)
+    {
+      resume(writer);
+    }
+  }
+
+} // namespace vix::async::core
@@ -14,6 +14,7 @@
 #include <vix/async/core/signal.hpp>
 #include <vix/async/core/io_context.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <coroutine>
 #include <functional>
@@ -37,13 +38,29 @@ namespace vix::async::core
 
   signal_set::~signal_set()
   {
-    stop();
+    int wake = 0;
+    {
+      std::lock_guard<std::mutex> lock(m_);
+      stop_ = true;
+      wake = waiting_sig_;
+    }
 
     if (!worker_.joinable())
     {
       return;
     }
 
+#if defined(__unix__) || defined(__APPLE__)
+    // The worker may be blocked in sigwait(): send it the signal it waits
+    // for (blocked in that thread, so it is consumed there).
+    if (wake != 0)
+    {
+      ::pthread_kill(worker_.native_handle(), wake);
+    }
+#else
+    (void)wake;
+#endif
+
     const auto self_id = std::this_thread::get_id();
 
     if (worker_.get_id() == self_id)
@@ -97,6 +114,15 @@ namespace vix::async::core
     on_signal_ = std::move(fn);
   }
 
+  void signal_set::watch(int sig, std::function<void(int)> fn)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_);
+      watchers_.emplace_back(sig, std::move(fn));
+    }
+    start_if_needed();
+  }
+
   void signal_set::stop() noexcept
   {
     std::lock_guard<std::mutex> lock(m_);
@@ -144,6 +170,8 @@ namespace vix::async::core
       cancel_token ct{};
       int sig{0};
 
+      static constexpr const char *awaiting_label() noexcept { return "signal"; }
+
       bool await_ready()
       {
         std::lock_guard<std::mutex> lock(self->m_);
@@ -192,7 +220,8 @@ namespace vix::async::core
       }
     };
 
-    co_return co_await awaitable{this, std::move(ct)};
+    awaitable op{this, std::move(ct)};
+    co_return co_await op;
 #endif
   }
 
@@ -214,6 +243,10 @@ namespace vix::async::core
         }
 
         sigs_copy = signals_;
+        for (const auto &w : watchers_)
+        {
+          sigs_copy.push_back(w.first);
+        }
       }
 
       if (sigs_copy.empty())
@@ -232,24 +265,71 @@ namespace vix::async::core
 
       pthread_sigmask(SIG_BLOCK, &set, nullptr);
 
+      {
+        std::lock_guard<std::mutex> lock(m_);
+
+        if (stop_)
+        {
+          return;
+        }
+
+        waiting_sig_ = sigs_copy.front();
+      }
+
       int received = 0;
       const int rc = sigwait(&set, &received);
 
-      if (rc != 0)
-      {
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
-        continue;
-      }
+      std::vector<std::function<void(int)>> watchers;
+      bool observed = false;
 
       {
         std::lock_guard<std::mutex> lock(m_);
 
+        waiting_sig_ = 0;
         if (stop_)
         {
           return;
         }
 
-        pending_.push(received);
+        if (rc == 0)
+        {
+          for (const auto &w : watchers_)
+          {
+            if (w.first == received)
+            {
+              watchers.push_back(w.second);
+            }
+          }
+
+          observed = std::find(signals_.begin(), signals_.end(), received) != signals_.end();
+          if (observed)
+          {
+            pending_.push(received);
+          }
+        }
+      }
+
+      if (rc != 0)
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        continue;
+      }
+
+      if (!watchers.empty())
+      {
+        ctx_post(
+            [watchers = std::move(watchers), received]()
+            {
+              for (const auto &fn : watchers)
+              {
+                fn(received);
+              }
+            });
+      }
+
+      if (!observed)
+      {
+        continue;
       }
 
       ctx_post(
@@ -0,0 +1,269 @@
+/**
+ *
+ *  @file task_registry.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/async/core/task_registry.hpp>
+
+#include <vix/async/core/io_context.hpp>
+#include <vix/async/core/signal.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#if defined(__GNUC__)
+#include <cxxabi.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <dlfcn.h>
+#endif
+
+namespace vix::async::core
+{
+  namespace
+  {
+    struct registry
+    {
+      std::mutex m;
+      detail::task_node *head{nullptr};
+      std::size_t count{0};
+      std::uint64_t next_seq{1};
+    };
+
+    registry &reg()
+    {
+      // Leaked on purpose: detached frames may be destroyed during static destruction.
+      static registry *r = new registry();
+      return *r;
+    }
+
+#if ASYNC_ENABLE_TASK_REGISTRY
+    std::string demangle(const char *name)
+    {
+      if (!name)
+      {
+        return "?";
+      }
+
+#if defined(__GNUC__)
+      int status = 0;
+      char *out = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+      if (status == 0 && out)
+      {
+        std::string s(out);
+        std::free(out);
+        return s;
+      }
+#endif
+
+      return name;
+    }
+
+    /**
+     * GCC and Clang both lay out a coroutine frame with the resume function
+     * pointer first; resolving it names the coroutine ("foo() [clone .actor]").
+     * Symbols of executables need -rdynamic; otherwise the raw address is
+     * printed for addr2line.
+     */
+    std::string coroutine_name(void *frame)
+    {
+      if (!frame)
+      {
+        return {};
+      }
+
+      void *resume = nullptr;
+      std::memcpy(&resume, frame, sizeof(resume));
+
+#if defined(__unix__) || defined(__APPLE__)
+      Dl_info info{};
+      if (resume && dladdr(resume, &info) != 0 && info.dli_sname)
+      {
+        return demangle(info.dli_sname);
+      }
+#endif
+
+      char tmp[32];
+      std::snprintf(tmp, sizeof(tmp), "resume=%p", resume);
+      return tmp;
+    }
+
+    void write_node(std::ostream &os, const detail::task_node &n)
+    {
+      char id[32];
+      std::snprintf(id, sizeof(id), "%p", n.frame.load(std::memory_order_relaxed));
+
+      os << "task#" << n.seq << " frame=" << id;
+
+      const char *aw = n.awaiting.load(std::memory_order_relaxed);
+      if (aw)
+      {
+        os << " awaiting=" << demangle(aw);
+      }
+      else if (n.started.load(std::memory_order_relaxed))
+      {
+        os << " running";
+      }
+      else
+      {
+        os << " not started";
+      }
+
+      const std::string name = coroutine_name(n.frame.load(std::memory_order_relaxed));
+      if (!name.empty())
+      {
+        os << " " << name;
+      }
+    }
+#endif
+  } // namespace
+
+  namespace detail
+  {
+    void registry_link(task_node &n) noexcept
+    {
+#if ASYNC_ENABLE_TASK_REGISTRY
+      auto &r = reg();
+      std::lock_guard<std::mutex> lock(r.m);
+
+      n.seq = r.next_seq++;
+      n.prev = nullptr;
+      n.next = r.head;
+      if (r.head)
+      {
+        r.head->prev = &n;
+      }
+      r.head = &n;
+      ++r.count;
+#else
+      (void)n;
+#endif
+    }
+
+    void registry_unlink(task_node &n) noexcept
+    {
+#if ASYNC_ENABLE_TASK_REGISTRY
+      auto &r = reg();
+      std::lock_guard<std::mutex> lock(r.m);
+
+      if (n.prev)
+      {
+        n.prev->next = n.next;
+      }
+      else
+      {
+        r.head = n.next;
+      }
+
+      if (n.next)
+      {
+        n.next->prev = n.prev;
+      }
+
+      n.prev = nullptr;
+      n.next = nullptr;
+      --r.count;
+#else
+      (void)n;
+#endif
+    }
+  } // namespace detail
+
+  std::size_t live_task_count() noexcept
+  {
+    auto &r = reg();
+    std::lock_guard<std::mutex> lock(r.m);
+    return r.count;
+  }
+
+  void dump_async_stacks(std::ostream &os)
+  {
+    auto &r = reg();
+    std::lock_guard<std::mutex> lock(r.m);
+
+#if !ASYNC_ENABLE_TASK_REGISTRY
+    os << "async stacks: task registry disabled (ASYNC_ENABLE_TASK_REGISTRY=0)\n";
+    return;
+#else
+    std::vector<const detail::task_node *> nodes;
+    std::unordered_set<const detail::task_node *> live;
+    std::unordered_set<const detail::task_node *> awaited;
+
+    for (auto *n = r.head; n; n = n->next)
+    {
+      nodes.push_back(n);
+      live.insert(n);
+    }
+
+    for (const auto *n : nodes)
+    {
+      const auto *p = n->parent.load(std::memory_order_relaxed);
+      if (p)
+      {
+        awaited.insert(p);
+      }
+    }
+
+    std::sort(
+        nodes.begin(),
+        nodes.end(),
+        [](const detail::task_node *a, const detail::task_node *b)
+        {
+          return a->seq < b->seq;
+        });
+
+    os << "async stacks: " << nodes.size() << " live task(s)\n";
+
+    std::size_t chain = 0;
+    for (const auto *leaf : nodes)
+    {
+      if (awaited.count(leaf) != 0)
+      {
+        continue;
+      }
+
+      os << "#" << chain++ << "\n";
+
+      std::unordered_set<const detail::task_node *> seen;
+      std::size_t depth = 0;
+
+      for (const auto *n = leaf; n && live.count(n) != 0 && seen.insert(n).second;
+           n = n->parent.load(std::memory_order_relaxed))
+      {
+        os << "  " << (depth++ == 0 ? "at " : "<- ");
+        write_node(os, *n);
+        os << "\n";
+      }
+    }
+#endif
+  }
+
+  void install_async_stack_dump(io_context &ctx, int sig)
+  {
+    ctx.signals().watch(
+        sig,
+        [](int)
+        {
+          dump_async_stacks(std::cerr);
+        });
+  }
+
+} // namespace vix::async::core
@@ -15,6 +15,7 @@
 #include <vix/async/core/io_context.hpp>
 
 #include <coroutine>
+#include <cstdint>
 #include <functional>
 #include <mutex>
 #include <thread>
@@ -24,7 +25,8 @@ namespace vix::async::core
 {
 
   thread_pool::thread_pool(io_context &ctx, std::size_t threads)
-      : ctx_(ctx)
+      : ctx_(ctx),
+        metrics_(ctx.runtime_counters().cpu_pool)
   {
     if (threads == 0)
     {
@@ -123,25 +125,41 @@ namespace vix::async::core
 
   void thread_pool::enqueue(std::function<void()> fn)
   {
+#if ASYNC_ENABLE_HISTOGRAMS
+    const std::uint64_t now = detail::metrics_now_ns();
+#else
+    const std::uint64_t now = 0;
+#endif
+
     {
       std::lock_guard<std::mutex> lock(m_);
 
       if (stop_)
       {
+#if ASYNC_ENABLE_METRICS
+        metrics_.rejected.fetch_add(1, std::memory_order_relaxed);
+#endif
         return;
       }
 
-      q_.emplace_back(std::move(fn));
+      q_.push_back(job_entry{std::move(fn), now});
     }
 
+#if ASYNC_ENABLE_METRICS
+    metrics_.submitted.fetch_add(1, std::memory_order_relaxed);
+#endif
+
     cv_.notify_one();
   }
 
   void thread_pool::worker_loop()
   {
+    const executor self = get_executor();
+
     while (true)
     {
       std::function<void()> fn;
+      std::uint64_t enqueued_ns = 0;
 
       {
         std::unique_lock<std::mutex> lock(m_);
@@ -154,7 +172,8 @@ namespace vix::async::core
 
         if (!q_.empty())
         {
-          fn = std::move(q_.front());
+          fn = std::move(q_.front().fn);
+          enqueued_ns = q_.front().enqueued_ns;
           q_.pop_front();
         }
         else if (stop_)
@@ -168,6 +187,16 @@ namespace vix::async::core
         continue;
       }
 
+#if ASYNC_ENABLE_HISTOGRAMS
+      const std::uint64_t started = detail::metrics_now_ns();
+      metrics_.queue_wait.record(started > enqueued_ns ? started - enqueued_ns : 0);
+#else
+      (void)enqueued_ns;
+#endif
+
+      // Reset per job: one resumed inline must not leak it to the next.
+      detail::exchange_current_executor(self);
+
       try
       {
         fn();
@@ -175,6 +204,13 @@ namespace vix::async::core
       catch (...)
       {
       }
+
+#if ASYNC_ENABLE_HISTOGRAMS
+      metrics_.run_time.record(detail::metrics_now_ns() - started);
+#endif
+#if ASYNC_ENABLE_METRICS
+      metrics_.completed.fetch_add(1, std::memory_order_relaxed);
+#endif
     }
   }
 
@@ -12,25 +12,34 @@
  *
  */
 #include <vix/async/core/timer.hpp>
+#include <vix/async/core/executor.hpp>
 #include <vix/async/core/io_context.hpp>
 
+#include <chrono>
 #include <coroutine>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <system_error>
 #include <thread>
 #include <utility>
+#include <vector>
 
 namespace vix::async::core
 {
   timer::timer(io_context &ctx)
       : ctx_(ctx),
-        worker_(
-            [this]()
-            {
-              timer_loop();
-            })
+        virtual_(ctx.uses_virtual_time()),
+        metrics_(ctx.runtime_counters().timers)
   {
+    if (!virtual_)
+    {
+      worker_ = std::thread(
+          [this]()
+          {
+            timer_loop();
+          });
+    }
   }
 
   timer::~timer()
@@ -72,12 +81,15 @@ namespace vix::async::core
       std::lock_guard<std::mutex> lock(m_);
       stop_ = true;
       q_.clear();
+#if ASYNC_ENABLE_METRICS
+      metrics_.queue_size.store(0, std::memory_order_relaxed);
+#endif
     }
 
     cv_.notify_all();
   }
 
-  void timer::schedule(time_point tp, std::unique_ptr<job> j, cancel_token ct)
+  void timer::schedule(time_point tp, std::unique_ptr<job> j, cancel_token ct, bool on_timer_thread)
   {
     if (!j)
     {
@@ -97,8 +109,14 @@ namespace vix::async::core
       e.id = ++seq_;
       e.ct = std::move(ct);
       e.j = std::move(j);
+      e.on_timer_thread = on_timer_thread;
 
       q_.insert(std::move(e));
+
+#if ASYNC_ENABLE_METRICS
+      metrics_.scheduled.fetch_add(1, std::memory_order_relaxed);
+      metrics_.queue_size.fetch_add(1, std::memory_order_relaxed);
+#endif
     }
 
     cv_.notify_all();
@@ -106,41 +124,34 @@ namespace vix::async::core
 
   task<void> timer::sleep_for(duration d, cancel_token ct)
   {
-    struct awaitable
+    wait_awaitable op = wait_for(d, std::move(ct));
+    if (!co_await op)
     {
-      timer *self{};
-      duration d{};
-      cancel_token ct{};
-
-      bool await_ready() const noexcept
-      {
-        return d.count() == 0;
-      }
+      throw std::system_error(cancelled_ec());
+    }
+  }
 
-      void await_suspend(std::coroutine_handle<> h)
-      {
-        self->after(
-            d,
-            [self = self, h]() mutable
+  void timer::schedule_wakeup(time_point tp, std::coroutine_handle<> h)
+  {
+    // Not tied to a cancel_token: a skipped entry would never resume h.
+    // The wakeup runs on the timer thread and posts h straight to its
+    // executor.
+    schedule(
+        tp,
+        make_job(
+            [self = this, h, exec = current_executor()]() mutable
             {
-              if (self && h)
+              if (exec)
+              {
+                exec.post(h);
+              }
+              else
               {
                 self->ctx_post_handle(h);
               }
-            },
-            ct);
-      }
-
-      void await_resume()
-      {
-        if (ct.is_cancelled())
-        {
-          throw std::system_error(cancelled_ec());
-        }
-      }
-    };
-
-    co_return co_await awaitable{this, d, std::move(ct)};
+            }),
+        cancel_token{},
+        true);
   }
 
   void timer::ctx_post(std::function<void()> fn)
@@ -176,7 +187,7 @@ namespace vix::async::core
         }
 
         auto it = q_.begin();
-        next = entry{it->when, it->id, it->ct, nullptr};
+        next = entry{it->when, it->id, it->ct, nullptr, it->on_timer_thread};
         next.j = std::move(const_cast<entry &>(*it).j);
         q_.erase(it);
         has_next = true;
@@ -211,21 +222,24 @@ namespace vix::async::core
                 next.when,
                 next.id,
                 next.ct,
-                std::move(next.j)});
+                std::move(next.j),
+                next.on_timer_thread});
 
-            next = entry{it->when, it->id, it->ct, nullptr};
+            next = entry{it->when, it->id, it->ct, nullptr, it->on_timer_thread};
             next.j = std::move(const_cast<entry &>(*it).j);
             q_.erase(it);
             continue;
           }
         }
 
+        // Also wake for an entry scheduled earlier than next meanwhile;
+        // the loop above then swaps it in.
         cv_.wait_until(
             lock,
             next.when,
-            [this]()
+            [this, &next]()
             {
-              return stop_;
+              return stop_ || (!q_.empty() && q_.begin()->when < next.when);
             });
 
         if (stop_)
@@ -234,25 +248,92 @@ namespace vix::async::core
         }
       }
 
-      if (next.ct.is_cancelled())
+      fire(next);
+    }
+  }
+
+  bool timer::advance()
+  {
+    std::vector<entry> due;
+
+    {
+      std::lock_guard<std::mutex> lock(m_);
+
+      if (stop_ || q_.empty())
       {
-        continue;
+        return false;
       }
 
-      if (next.j)
+      // Jump to the earliest deadline, then take every entry due by then
+      // in (deadline, sequence) order.
+      const time_point next = q_.begin()->when;
+      if (next > now())
       {
-        std::shared_ptr<job> j(next.j.release());
+        virtual_now_.store(next.time_since_epoch().count(), std::memory_order_release);
+      }
 
-        ctx_post(
-            [j = std::move(j)]() mutable
-            {
-              if (j)
-              {
-                j->run();
-              }
-            });
+      while (!q_.empty() && q_.begin()->when <= next)
+      {
+        auto it = q_.begin();
+        due.push_back(entry{it->when, it->id, it->ct, nullptr, it->on_timer_thread});
+        due.back().j = std::move(const_cast<entry &>(*it).j);
+        q_.erase(it);
       }
     }
+
+    for (auto &e : due)
+    {
+      fire(e);
+    }
+
+    return true;
+  }
+
+  void timer::fire(entry &e)
+  {
+#if ASYNC_ENABLE_METRICS
+    if (metrics_.queue_size.load(std::memory_order_relaxed) > 0)
+    {
+      metrics_.queue_size.fetch_sub(1, std::memory_order_relaxed);
+    }
+#endif
+
+    if (e.ct.is_cancelled())
+    {
+#if ASYNC_ENABLE_METRICS
+      metrics_.cancelled.fetch_add(1, std::memory_order_relaxed);
+#endif
+      return;
+    }
+
+#if ASYNC_ENABLE_HISTOGRAMS
+    {
+      const auto late = now() - e.when;
+      metrics_.lateness.record(static_cast<std::uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(late).count()));
+    }
+#endif
+#if ASYNC_ENABLE_METRICS
+    metrics_.fired.fetch_add(1, std::memory_order_relaxed);
+#endif
+
+    if (e.j && e.on_timer_thread)
+    {
+      e.j->run();
+    }
+    else if (e.j)
+    {
+      std::shared_ptr<job> j(e.j.release());
+
+      ctx_post(
+          [j = std::move(j)]() mutable
+          {
+            if (j)
+            {
+              j->run();
+            }
+          });
+    }
   }
 
 } // namespace vix::async::core
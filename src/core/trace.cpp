@@ -0,0 +1,379 @@
+/**
+ *
+ *  @file trace.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/async/core/trace.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__GNUC__)
+#include <cxxabi.h>
+#endif
+
+namespace vix::async::core
+{
+  namespace
+  {
+    constexpr std::size_t ring_capacity = ASYNC_TRACE_BUFFER_SIZE;
+
+    /**
+     * Single-writer ring owned by one thread. Kept alive by the registry
+     * after the thread exits so its events still show up in dumps.
+     */
+    struct thread_ring
+    {
+      std::uint32_t tid{0};
+      std::string name{};
+      std::unique_ptr<trace_record[]> buf{};
+      std::atomic<std::uint64_t> head{0};
+    };
+
+    struct registry
+    {
+      std::mutex m;
+      std::vector<std::shared_ptr<thread_ring>> rings;
+      std::uint32_t next_tid{1};
+    };
+
+    registry &reg()
+    {
+      // Leaked on purpose: threads may still record during static destruction.
+      static registry *r = new registry();
+      return *r;
+    }
+
+#if ASYNC_ENABLE_TRACING
+    std::shared_ptr<thread_ring> make_ring()
+    {
+      auto ring = std::make_shared<thread_ring>();
+      ring->buf = std::make_unique<trace_record[]>(ring_capacity);
+
+      auto &r = reg();
+      std::lock_guard<std::mutex> lock(r.m);
+      ring->tid = r.next_tid++;
+      r.rings.push_back(ring);
+      return ring;
+    }
+
+    thread_ring *local_ring() noexcept
+    {
+      thread_local std::shared_ptr<thread_ring> ring;
+      if (!ring)
+      {
+        try
+        {
+          ring = make_ring();
+        }
+        catch (...)
+        {
+          return nullptr;
+        }
+      }
+      return ring.get();
+    }
+
+    std::uint64_t now_ns() noexcept
+    {
+      return static_cast<std::uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::steady_clock::now().time_since_epoch())
+              .count());
+    }
+#endif
+
+    void write_escaped(std::ostream &os, const std::string &s)
+    {
+      for (const char c : s)
+      {
+        switch (c)
+        {
+        case '"':
+          os << "\\\"";
+          break;
+        case '\\':
+          os << "\\\\";
+          break;
+        case '\n':
+          os << "\\n";
+          break;
+        default:
+          if (static_cast<unsigned char>(c) < 0x20)
+          {
+            char tmp[8];
+            std::snprintf(tmp, sizeof(tmp), "\\u%04x", static_cast<unsigned>(c));
+            os << tmp;
+          }
+          else
+          {
+            os << c;
+          }
+        }
+      }
+    }
+
+    std::string demangle(const char *label)
+    {
+      if (!label)
+      {
+        return {};
+      }
+
+#if defined(__GNUC__)
+      int status = 0;
+      char *out = abi::__cxa_demangle(label, nullptr, nullptr, &status);
+      if (status == 0 && out)
+      {
+        std::string s(out);
+        std::free(out);
+        return s;
+      }
+#endif
+
+      return label;
+    }
+
+    void write_id(std::ostream &os, std::uint64_t id)
+    {
+      char tmp[24];
+      std::snprintf(tmp, sizeof(tmp), "0x%llx", static_cast<unsigned long long>(id));
+      os << tmp;
+    }
+
+    struct dump_entry
+    {
+      trace_record rec;
+      std::uint32_t tid;
+    };
+  } // namespace
+
+  namespace detail
+  {
+    void trace_emit(trace_event ev, std::uint64_t id, const char *label) noexcept
+    {
+#if ASYNC_ENABLE_TRACING
+      thread_ring *ring = local_ring();
+      if (!ring)
+      {
+        return;
+      }
+
+      const std::uint64_t n = ring->head.load(std::memory_order_relaxed);
+      ring->buf[n % ring_capacity] = trace_record{now_ns(), id, label, ev};
+      ring->head.store(n + 1, std::memory_order_release);
+#else
+      (void)ev;
+      (void)id;
+      (void)label;
+#endif
+    }
+  } // namespace detail
+
+  void trace_set_thread_name(const std::string &name)
+  {
+#if ASYNC_ENABLE_TRACING
+    thread_ring *ring = local_ring();
+    if (!ring)
+    {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(reg().m);
+    ring->name = name;
+#else
+    (void)name;
+#endif
+  }
+
+  void trace_clear() noexcept
+  {
+    auto &r = reg();
+    std::lock_guard<std::mutex> lock(r.m);
+    for (auto &ring : r.rings)
+    {
+      ring->head.store(0, std::memory_order_release);
+    }
+  }
+
+  void trace_dump_chrome(std::ostream &os)
+  {
+    std::vector<dump_entry> events;
+    std::vector<std::pair<std::uint32_t, std::string>> names;
+
+    {
+      auto &r = reg();
+      std::lock_guard<std::mutex> lock(r.m);
+
+      for (const auto &ring : r.rings)
+      {
+        names.emplace_back(ring->tid, ring->name);
+
+        const std::uint64_t head = ring->head.load(std::memory_order_acquire);
+        const std::uint64_t first = head > ring_capacity ? head - ring_capacity : 0;
+
+        for (std::uint64_t i = first; i < head; ++i)
+        {
+          events.push_back(dump_entry{ring->buf[i % ring_capacity], ring->tid});
+        }
+      }
+    }
+
+    std::stable_sort(
+        events.begin(),
+        events.end(),
+        [](const dump_entry &a, const dump_entry &b)
+        {
+          return a.rec.ts_ns < b.rec.ts_ns;
+        });
+
+    const std::uint64_t t0 = events.empty() ? 0 : events.front().rec.ts_ns;
+    std::unordered_map<const char *, std::string> labels;
+
+    os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+    bool first = true;
+    auto sep = [&]()
+    {
+      if (!first)
+      {
+        os << ",";
+      }
+      first = false;
+      os << "\n";
+    };
+
+    for (const auto &[tid, name] : names)
+    {
+      sep();
+      os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+         << ",\"args\":{\"name\":\"";
+      write_escaped(os, name.empty() ? "thread " + std::to_string(tid) : name);
+      os << "\"}}";
+    }
+
+    char ts[32];
+
+    for (const auto &e : events)
+    {
+      const trace_record &r = e.rec;
+      std::snprintf(ts, sizeof(ts), "%.3f", static_cast<double>(r.ts_ns - t0) / 1000.0);
+
+      const char *name = "";
+      const char *ph = "i";
+      bool async_span = false;
+
+      switch (r.ev)
+      {
+      case trace_event::task_create:
+        name = "task";
+        ph = "b";
+        async_span = true;
+        break;
+      case trace_event::task_complete:
+        name = "task";
+        ph = "e";
+        async_span = true;
+        break;
+      case trace_event::task_start:
+        name = "start";
+        break;
+      case trace_event::task_suspend:
+        name = "suspend";
+        break;
+      case trace_event::task_resume:
+        name = "resume";
+        break;
+      case trace_event::post_handle:
+        name = "post handle";
+        break;
+      case trace_event::post_fn:
+        name = "post fn";
+        break;
+      case trace_event::run_begin:
+        name = r.label ? r.label : "run";
+        ph = "B";
+        break;
+      case trace_event::run_end:
+        ph = "E";
+        break;
+      }
+
+      sep();
+      os << "{\"name\":\"" << name << "\",\"cat\":\"vix.async\",\"ph\":\"" << ph
+         << "\",\"ts\":" << ts << ",\"pid\":1,\"tid\":" << e.tid;
+
+      if (async_span)
+      {
+        os << ",\"id\":\"";
+        write_id(os, r.id);
+        os << "\"";
+      }
+      else if (ph[0] == 'i')
+      {
+        os << ",\"s\":\"t\"";
+      }
+
+      if (r.ev != trace_event::run_end)
+      {
+        // Task events carry the promise address, scheduler events the
+        // coroutine frame address of the posted handle.
+        const bool task_event = r.ev <= trace_event::task_complete;
+        os << ",\"args\":{\"" << (task_event ? "task" : "handle") << "\":\"";
+        write_id(os, r.id);
+        os << "\"";
+
+        if (r.label && r.ev != trace_event::run_begin)
+        {
+          auto it = labels.find(r.label);
+          if (it == labels.end())
+          {
+            it = labels.emplace(r.label, demangle(r.label)).first;
+          }
+
+          os << ",\"at\":\"";
+          write_escaped(os, it->second);
+          os << "\"";
+        }
+
+        os << "}";
+      }
+
+      os << "}";
+    }
+
+    os << "\n]}\n";
+  }
+
+  bool trace_dump_chrome(const std::string &path)
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+      return false;
+    }
+
+    trace_dump_chrome(out);
+    return static_cast<bool>(out);
+  }
+
+} // namespace vix::async::core
@@ -0,0 +1,187 @@
+/**
+ *
+ *  @file watchdog.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/async/core/watchdog.hpp>
+
+#include <vix/async/core/io_context.hpp>
+#include <vix/async/detail/log.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace vix::async::core
+{
+  namespace
+  {
+    [[maybe_unused]] const char *kind_name(scheduler::work_kind k) noexcept
+    {
+      switch (k)
+      {
+      case scheduler::work_kind::handle:
+        return "coroutine";
+      case scheduler::work_kind::function:
+        return "callable";
+      case scheduler::work_kind::none:
+        break;
+      }
+      return "none";
+    }
+  } // namespace
+
+  stall_watchdog::stall_watchdog(
+      scheduler &sched,
+      std::chrono::nanoseconds threshold,
+      callback cb,
+      std::chrono::nanoseconds poll)
+      : sched_(sched),
+        threshold_(threshold.count() > 0 ? threshold : std::chrono::milliseconds(100)),
+        poll_(poll.count() > 0 ? poll : threshold_ / 4),
+        cb_(std::move(cb))
+  {
+    if (poll_.count() <= 0)
+    {
+      poll_ = std::chrono::microseconds(100);
+    }
+
+    sched_.add_watcher();
+
+    thread_ = std::thread(
+        [this]()
+        {
+          watch_loop();
+        });
+  }
+
+  stall_watchdog::stall_watchdog(
+      io_context &ctx,
+      std::chrono::nanoseconds threshold,
+      callback cb,
+      std::chrono::nanoseconds poll)
+      : stall_watchdog(ctx.get_scheduler(), threshold, std::move(cb), poll)
+  {
+  }
+
+  stall_watchdog::~stall_watchdog() noexcept
+  {
+    stop();
+  }
+
+  void stall_watchdog::stop() noexcept
+  {
+    if (stopped_.exchange(true, std::memory_order_acq_rel))
+    {
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_);
+      stop_ = true;
+    }
+
+    cv_.notify_all();
+
+    if (thread_.joinable())
+    {
+      if (thread_.get_id() == std::this_thread::get_id())
+      {
+        thread_.detach();
+      }
+      else
+      {
+        try
+        {
+          thread_.join();
+        }
+        catch (...)
+        {
+        }
+      }
+    }
+
+    sched_.remove_watcher();
+  }
+
+  void stall_watchdog::watch_loop()
+  {
+    std::uint64_t reported_seq = 0;
+    bool reported_any = false;
+
+    while (true)
+    {
+      {
+        std::unique_lock<std::mutex> lock(m_);
+        if (cv_.wait_for(lock, poll_, [this]()
+                         { return stop_; }))
+        {
+          return;
+        }
+      }
+
+      const scheduler::running_item it = sched_.current_item();
+      if (it.started_ns == 0)
+      {
+        continue;
+      }
+
+      if (reported_any && it.seq == reported_seq)
+      {
+        continue;
+      }
+
+      const std::uint64_t now = detail::metrics_now_ns();
+      if (now <= it.started_ns)
+      {
+        continue;
+      }
+
+      const auto elapsed = std::chrono::nanoseconds(
+          static_cast<std::chrono::nanoseconds::rep>(now - it.started_ns));
+
+      if (elapsed < threshold_)
+      {
+        continue;
+      }
+
+      reported_seq = it.seq;
+      reported_any = true;
+      stalls_.fetch_add(1, std::memory_order_relaxed);
+
+      report(stall_info{elapsed, it.kind, it.id, it.seq});
+    }
+  }
+
+  void stall_watchdog::report(const stall_info &info) noexcept
+  {
+    try
+    {
+      if (cb_)
+      {
+        cb_(info);
+        return;
+      }
+
+      ASYNC_LOG_WARN(
+          "scheduler stalled: {} item {} running for {} us",
+          kind_name(info.kind),
+          info.id,
+          std::chrono::duration_cast<std::chrono::microseconds>(info.duration).count());
+    }
+    catch (...)
+    {
+    }
+  }
+
+} // namespace vix::async::core
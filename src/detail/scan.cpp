@@ -0,0 +1,348 @@
+/**
+ *
+ *  @file scan.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/async/detail/scan.hpp>
+
+#include <vix/async/detail/config.hpp>
+#include <vix/async/detail/platform.hpp>
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#if ASYNC_ENABLE_SIMD && ASYNC_HAS_SSE2
+#include <immintrin.h>
+#endif
+
+#if ASYNC_ENABLE_SIMD && ASYNC_HAS_NEON
+#include <arm_neon.h>
+#endif
+
+// AVX2 code is compiled for that target only, so the library itself keeps
+// the baseline ISA and picks the path at runtime.
+#if ASYNC_ENABLE_SIMD && ASYNC_HAS_SSE2 && (defined(__GNUC__) || defined(__clang__))
+#define ASYNC_SCAN_AVX2 1
+#define ASYNC_TARGET_AVX2 __attribute__((target("avx2")))
+#elif ASYNC_ENABLE_SIMD && ASYNC_HAS_SSE2 && defined(_MSC_VER)
+#define ASYNC_SCAN_AVX2 1
+#define ASYNC_TARGET_AVX2
+#else
+#define ASYNC_SCAN_AVX2 0
+#endif
+
+namespace vix::async::detail
+{
+  namespace
+  {
+    // ------------------------------------------------------------------
+    // scalar
+    // ------------------------------------------------------------------
+
+    std::size_t byte_scalar(const char *data, std::size_t size, char c) noexcept
+    {
+      const void *p = std::memchr(data, static_cast<unsigned char>(c), size);
+      return p ? static_cast<std::size_t>(static_cast<const char *>(p) - data) : size;
+    }
+
+    /**
+     * @brief Check the pattern at the candidate positions of a match mask.
+     *
+     * @param bits One bit per candidate, bit i for position base + i.
+     * @return Offset of the first full match, or size.
+     */
+    inline std::size_t verify(
+        std::uint32_t bits,
+        const char *data,
+        std::size_t base,
+        std::string_view pattern,
+        std::size_t size) noexcept
+    {
+      // First and last bytes already matched.
+      const std::size_t middle = pattern.size() - 2;
+      while (bits != 0)
+      {
+        const std::size_t at = base + static_cast<std::size_t>(std::countr_zero(bits));
+        if (middle == 0 || std::memcmp(data + at + 1, pattern.data() + 1, middle) == 0)
+        {
+          return at;
+        }
+        bits &= bits - 1;
+      }
+      return size;
+    }
+
+    /**
+     * @brief Scalar tail of a pattern scan, starting at from.
+     */
+    std::size_t pattern_scalar_from(
+        const char *data,
+        std::size_t size,
+        std::string_view pattern,
+        std::size_t from) noexcept
+    {
+      const std::size_t k = pattern.size();
+      while (from + k <= size)
+      {
+        const std::size_t hit = byte_scalar(data + from, size - k + 1 - from, pattern[0]);
+        if (from + hit > size - k)
+        {
+          break;
+        }
+        from += hit;
+        if (std::memcmp(data + from + 1, pattern.data() + 1, k - 1) == 0)
+        {
+          return from;
+        }
+        ++from;
+      }
+      return size;
+    }
+
+    std::size_t pattern_scalar(const char *data, std::size_t size, std::string_view pattern) noexcept
+    {
+      return pattern_scalar_from(data, size, pattern, 0);
+    }
+
+#if ASYNC_ENABLE_SIMD && ASYNC_HAS_SSE2
+    // ------------------------------------------------------------------
+    // SSE2
+    // ------------------------------------------------------------------
+
+    std::size_t pattern_sse2(const char *data, std::size_t size, std::string_view pattern) noexcept
+    {
+      const std::size_t k = pattern.size();
+      const __m128i first = _mm_set1_epi8(pattern.front());
+      const __m128i last = _mm_set1_epi8(pattern.back());
+
+      std::size_t i = 0;
+      for (; i + k - 1 + 16 <= size; i += 16)
+      {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + k - 1));
+        const __m128i eq = _mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last));
+        const auto bits = static_cast<std::uint32_t>(_mm_movemask_epi8(eq));
+        if (bits != 0)
+        {
+          const std::size_t at = verify(bits, data, i, pattern, size);
+          if (at != size)
+          {
+            return at;
+          }
+        }
+      }
+      return pattern_scalar_from(data, size, pattern, i);
+    }
+#endif
+
+#if ASYNC_SCAN_AVX2
+    // ------------------------------------------------------------------
+    // AVX2
+    // ------------------------------------------------------------------
+
+    ASYNC_TARGET_AVX2 std::size_t pattern_avx2(const char *data, std::size_t size, std::string_view pattern) noexcept
+    {
+      const std::size_t k = pattern.size();
+      const __m256i first = _mm256_set1_epi8(pattern.front());
+      const __m256i last = _mm256_set1_epi8(pattern.back());
+
+      std::size_t i = 0;
+      for (; i + k - 1 + 32 <= size; i += 32)
+      {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i + k - 1));
+        const __m256i eq = _mm256_and_si256(_mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last));
+        const auto bits = static_cast<std::uint32_t>(_mm256_movemask_epi8(eq));
+        if (bits != 0)
+        {
+          const std::size_t at = verify(bits, data, i, pattern, size);
+          if (at != size)
+          {
+            return at;
+          }
+        }
+      }
+      return i + pattern_sse2(data + i, size - i, pattern);
+    }
+#endif
+
+#if ASYNC_ENABLE_SIMD && ASYNC_HAS_NEON
+    // ------------------------------------------------------------------
+    // NEON
+    // ------------------------------------------------------------------
+
+    /**
+     * @brief Compress a byte mask (0x00/0xff lanes) to 4 bits per lane.
+     */
+    inline std::uint64_t neon_mask(uint8x16_t eq) noexcept
+    {
+      const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+      return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+    }
+
+    std::size_t pattern_neon(const char *data, std::size_t size, std::string_view pattern) noexcept
+    {
+      const std::size_t k = pattern.size();
+      const uint8x16_t first = vdupq_n_u8(static_cast<std::uint8_t>(pattern.front()));
+      const uint8x16_t last = vdupq_n_u8(static_cast<std::uint8_t>(pattern.back()));
+
+      std::size_t i = 0;
+      for (; i + k - 1 + 16 <= size; i += 16)
+      {
+        const uint8x16_t a = vld1q_u8(reinterpret_cast<const std::uint8_t *>(data + i));
+        const uint8x16_t b = vld1q_u8(reinterpret_cast<const std::uint8_t *>(data + i + k - 1));
+        std::uint64_t nibbles = neon_mask(vandq_u8(vceqq_u8(a, first), vceqq_u8(b, last)));
+        if (nibbles == 0)
+        {
+          continue;
+        }
+
+        // One bit per lane for verify().
+        std::uint32_t bits = 0;
+        while (nibbles != 0)
+        {
+          const int lane = std::countr_zero(nibbles) >> 2;
+          bits |= 1u << lane;
+          nibbles &= ~(std::uint64_t{0xf} << (lane * 4));
+        }
+
+        const std::size_t at = verify(bits, data, i, pattern, size);
+        if (at != size)
+        {
+          return at;
+        }
+      }
+      return pattern_scalar_from(data, size, pattern, i);
+    }
+#endif
+
+    simd_level detect() noexcept
+    {
+#if ASYNC_ENABLE_SIMD
+      const auto &cpu = cpu_features();
+#if ASYNC_SCAN_AVX2
+      if (cpu.avx2)
+      {
+        return simd_level::avx2;
+      }
+#endif
+      if (cpu.sse2)
+      {
+        return simd_level::sse2;
+      }
+      if (cpu.neon)
+      {
+        return simd_level::neon;
+      }
+#endif
+      return simd_level::scalar;
+    }
+
+    const simd_level active = detect();
+  } // namespace
+
+  const char *to_string(simd_level level) noexcept
+  {
+    switch (level)
+    {
+    case simd_level::sse2:
+      return "sse2";
+    case simd_level::avx2:
+      return "avx2";
+    case simd_level::neon:
+      return "neon";
+    case simd_level::scalar:
+      break;
+    }
+    return "scalar";
+  }
+
+  simd_level scan_level() noexcept
+  {
+    return active;
+  }
+
+  bool scan_supported(simd_level level) noexcept
+  {
+    switch (level)
+    {
+    case simd_level::scalar:
+      return true;
+#if ASYNC_ENABLE_SIMD && ASYNC_HAS_SSE2
+    case simd_level::sse2:
+      return true;
+#endif
+#if ASYNC_SCAN_AVX2
+    case simd_level::avx2:
+      return cpu_features().avx2;
+#endif
+#if ASYNC_ENABLE_SIMD && ASYNC_HAS_NEON
+    case simd_level::neon:
+      return true;
+#endif
+    default:
+      return false;
+    }
+  }
+
+  std::size_t scan_byte(simd_level, const char *data, std::size_t size, char c) noexcept
+  {
+    // libc memchr is already vectorized (glibc picks an AVX2/EVEX variant at
+    // load time) and outran hand-written loops in scan.log / scan.long.
+    return byte_scalar(data, size, c);
+  }
+
+  std::size_t scan_pattern(simd_level level, const char *data, std::size_t size, std::string_view pattern) noexcept
+  {
+    if (pattern.empty())
+    {
+      return 0;
+    }
+    if (pattern.size() > size)
+    {
+      return size;
+    }
+    if (pattern.size() == 1)
+    {
+      return scan_byte(level, data, size, pattern[0]);
+    }
+
+    switch (level)
+    {
+#if ASYNC_ENABLE_SIMD && ASYNC_HAS_SSE2
+    case simd_level::sse2:
+      return pattern_sse2(data, size, pattern);
+#endif
+#if ASYNC_SCAN_AVX2
+    case simd_level::avx2:
+      return pattern_avx2(data, size, pattern);
+#endif
+#if ASYNC_ENABLE_SIMD && ASYNC_HAS_NEON
+    case simd_level::neon:
+      return pattern_neon(data, size, pattern);
+#endif
+    default:
+      return pattern_scalar(data, size, pattern);
+    }
+  }
+
+  std::size_t scan_byte(const char *data, std::size_t size, char c) noexcept
+  {
+    return scan_byte(active, data, size, c);
+  }
+
+  std::size_t scan_pattern(const char *data, std::size_t size, std::string_view pattern) noexcept
+  {
+    return scan_pattern(active, data, size, pattern);
+  }
+
+} // namespace vix::async::detail
@@ -0,0 +1,322 @@
+/**
+ *
+ *  @file file.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/async/fs/file.hpp>
+
+#include <vix/async/core/io_context.hpp>
+#include <vix/async/detail/platform.hpp>
+#include <vix/async/fs/file_service.hpp>
+
+#include "file_await.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <utility>
+#include <vector>
+
+#if ASYNC_PLATFORM_UNIX
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace vix::async::fs
+{
+  namespace
+  {
+#if defined(IOV_MAX)
+    constexpr std::size_t max_iov = IOV_MAX;
+#else
+    constexpr std::size_t max_iov = 1024;
+#endif
+
+    /**
+     * @brief Build an awaitable for one operation on an open descriptor.
+     *
+     * @throws std::system_error with errc::closed if the file is not open.
+     */
+    detail::file_awaitable make_op(
+        core::io_context *ctx,
+        detail::file_service *files,
+        detail::file_op op,
+        int fd,
+        core::cancel_token ct)
+    {
+      if (fd < 0)
+      {
+        throw std::system_error(core::make_error_code(core::errc::closed));
+      }
+
+      auto aw = detail::make_op(ctx, files, op, std::move(ct));
+      aw.req.fd = fd;
+      return aw;
+    }
+
+    /**
+     * @brief Translate open_mode into open(2) flags.
+     */
+    int to_open_flags(open_mode mode)
+    {
+#if ASYNC_PLATFORM_UNIX
+      const bool rd = has(mode, open_mode::read);
+      const bool wr = has(mode, open_mode::write);
+      if (!rd && !wr)
+      {
+        throw std::system_error(core::make_error_code(core::errc::invalid_argument));
+      }
+
+      int flags = O_CLOEXEC;
+      flags |= rd && wr ? O_RDWR : (wr ? O_WRONLY : O_RDONLY);
+      flags |= has(mode, open_mode::create) ? O_CREAT : 0;
+      flags |= has(mode, open_mode::truncate) ? O_TRUNC : 0;
+      flags |= has(mode, open_mode::append) ? O_APPEND : 0;
+      flags |= has(mode, open_mode::exclusive) ? O_EXCL : 0;
+      return flags;
+#else
+      (void)mode;
+      throw std::system_error(core::make_error_code(core::errc::not_supported));
+#endif
+    }
+  } // namespace
+
+  async_file::async_file(core::io_context &ctx, int fd)
+      : ctx_(&ctx), files_(&ctx.files()), fd_(fd)
+  {
+  }
+
+  async_file::~async_file()
+  {
+    close();
+  }
+
+  async_file::async_file(async_file &&other) noexcept
+      : ctx_(std::exchange(other.ctx_, nullptr)),
+        files_(std::exchange(other.files_, nullptr)),
+        fd_(std::exchange(other.fd_, -1))
+  {
+  }
+
+  async_file &async_file::operator=(async_file &&other) noexcept
+  {
+    if (this != &other)
+    {
+      close();
+      ctx_ = std::exchange(other.ctx_, nullptr);
+      files_ = std::exchange(other.files_, nullptr);
+      fd_ = std::exchange(other.fd_, -1);
+    }
+    return *this;
+  }
+
+  void async_file::close() noexcept
+  {
+#if ASYNC_PLATFORM_UNIX
+    if (fd_ >= 0)
+    {
+      ::close(fd_);
+    }
+#endif
+    fd_ = -1;
+  }
+
+  std::uint64_t async_file::size() const
+  {
+#if ASYNC_PLATFORM_UNIX
+    struct stat st{};
+    if (::fstat(fd_, &st) != 0)
+    {
+      throw std::system_error(errno, std::system_category());
+    }
+    return static_cast<std::uint64_t>(st.st_size);
+#else
+    throw std::system_error(core::make_error_code(core::errc::not_supported));
+#endif
+  }
+
+  core::task<async_file> async_file::open(
+      core::io_context &ctx,
+      std::string path,
+      open_mode mode,
+      unsigned perms,
+      core::cancel_token ct)
+  {
+#if ASYNC_PLATFORM_UNIX
+    detail::file_service *files = &ctx.files();
+
+    auto op = detail::make_op(&ctx, files, detail::file_op::open, std::move(ct));
+    op.req.fd = AT_FDCWD;
+    op.req.path = path.c_str();
+    op.req.flags = to_open_flags(mode);
+    op.req.perms = perms;
+
+    const auto fd = static_cast<int>(co_await op);
+    co_return async_file(ctx, fd);
+#else
+    (void)ctx;
+    (void)path;
+    (void)mode;
+    (void)perms;
+    (void)ct;
+    throw std::system_error(core::make_error_code(core::errc::not_supported));
+#endif
+  }
+
+  core::task<std::size_t> async_file::async_read_at(
+      std::uint64_t offset,
+      std::span<std::byte> buf,
+      core::cancel_token ct)
+  {
+    auto op = make_op(ctx_, files_, detail::file_op::read, fd_, std::move(ct));
+    op.req.offset = offset;
+    op.req.buf = buf.data();
+    op.req.len = buf.size();
+
+    co_return static_cast<std::size_t>(co_await op);
+  }
+
+  core::task<std::size_t> async_file::async_write_at(
+      std::uint64_t offset,
+      std::span<const std::byte> buf,
+      core::cancel_token ct)
+  {
+    std::size_t done = 0;
+
+    while (done < buf.size())
+    {
+      auto op = make_op(ctx_, files_, detail::file_op::write, fd_, ct);
+      op.req.offset = offset + done;
+      op.req.buf = const_cast<std::byte *>(buf.data() + done);
+      op.req.len = buf.size() - done;
+
+      const auto n = static_cast<std::size_t>(co_await op);
+      if (n == 0)
+      {
+        throw std::system_error(EIO, std::system_category());
+      }
+      done += n;
+    }
+
+    co_return done;
+  }
+
+  core::task<std::size_t> async_file::async_readv_at(
+      std::uint64_t offset,
+      std::span<const std::span<std::byte>> bufs,
+      core::cancel_token ct)
+  {
+#if ASYNC_PLATFORM_UNIX
+    std::vector<iovec> iov(std::min(bufs.size(), max_iov));
+    for (std::size_t i = 0; i < iov.size(); ++i)
+    {
+      iov[i].iov_base = bufs[i].data();
+      iov[i].iov_len = bufs[i].size();
+    }
+
+    auto op = make_op(ctx_, files_, detail::file_op::readv, fd_, std::move(ct));
+    op.req.offset = offset;
+    op.req.buf = iov.data();
+    op.req.len = iov.size();
+
+    co_return static_cast<std::size_t>(co_await op);
+#else
+    (void)offset;
+    (void)bufs;
+    (void)ct;
+    throw std::system_error(core::make_error_code(core::errc::not_supported));
+#endif
+  }
+
+  core::task<std::size_t> async_file::async_writev_at(
+      std::uint64_t offset,
+      std::span<const std::span<const std::byte>> bufs,
+      core::cancel_token ct)
+  {
+#if ASYNC_PLATFORM_UNIX
+    std::vector<iovec> iov;
+    iov.reserve(bufs.size());
+    std::size_t total = 0;
+    for (const auto &b : bufs)
+    {
+      if (!b.empty())
+      {
+        iov.push_back(iovec{const_cast<std::byte *>(b.data()), b.size()});
+        total += b.size();
+      }
+    }
+
+    std::size_t done = 0;
+    std::size_t first = 0;
+
+    while (first < iov.size())
+    {
+      auto op = make_op(ctx_, files_, detail::file_op::writev, fd_, ct);
+      op.req.offset = offset + done;
+      op.req.buf = iov.data() + first;
+      op.req.len = std::min(iov.size() - first, max_iov);
+
+      auto n = static_cast<std::size_t>(co_await op);
+      if (n == 0)
+      {
+        throw std::system_error(EIO, std::system_category());
+      }
+      done += n;
+
+      // Drop fully written buffers and trim a partially written one.
+      while (first < iov.size() && n >= iov[first].iov_len)
+      {
+        n -= iov[first].iov_len;
+        ++first;
+      }
+      if (n > 0)
+      {
+        iov[first].iov_base = static_cast<std::byte *>(iov[first].iov_base) + n;
+        iov[first].iov_len -= n;
+      }
+    }
+
+    co_return total;
+#else
+    (void)offset;
+    (void)bufs;
+    (void)ct;
+    throw std::system_error(core::make_error_code(core::errc::not_supported));
+#endif
+  }
+
+  core::task<void> async_file::async_fsync(core::cancel_token ct)
+  {
+    auto op = make_op(ctx_, files_, detail::file_op::fsync, fd_, std::move(ct));
+    (void)co_await op;
+  }
+
+  core::task<void> async_file::async_fdatasync(core::cancel_token ct)
+  {
+    auto op = make_op(ctx_, files_, detail::file_op::fdatasync, fd_, std::move(ct));
+    (void)co_await op;
+  }
+
+  core::task<void> async_file::async_fallocate(
+      std::uint64_t offset,
+      std::uint64_t length,
+      core::cancel_token ct)
+  {
+    auto op = make_op(ctx_, files_, detail::file_op::fallocate, fd_, std::move(ct));
+    op.req.offset = offset;
+    op.req.len = length;
+
+    (void)co_await op;
+  }
+
+} // namespace vix::async::fs
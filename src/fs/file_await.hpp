@@ -0,0 +1,133 @@
+/**
+ *
+ *  @file file_await.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_ASYNC_FILE_AWAIT_HPP
+#define VIX_ASYNC_FILE_AWAIT_HPP
+
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <system_error>
+#include <utility>
+
+#include <vix/async/core/cancel.hpp>
+#include <vix/async/core/error.hpp>
+#include <vix/async/core/io_context.hpp>
+#include <vix/async/fs/file_service.hpp>
+
+namespace vix::async::fs::detail
+{
+  /**
+   * @brief Awaitable submitting one file_request to the file service.
+   *
+   * Cancellation is checked in await_ready, so a cancelled operation is
+   * never submitted and never suspends.
+   */
+  struct file_awaitable
+  {
+    /** @brief Service the request is submitted to. */
+    file_service *files{};
+
+    /** @brief Request; lives in the coroutine frame while suspended. */
+    file_request req{};
+
+    /** @brief Optional cancellation token. */
+    vix::async::core::cancel_token ct{};
+
+    /** @brief Set when ct was cancelled before submission. */
+    bool cancelled{false};
+
+    /** @brief Stored exception thrown by submit(). */
+    std::exception_ptr ex{};
+
+    /**
+     * @brief Suspension label reported by tracing and the task registry.
+     */
+    static constexpr const char *awaiting_label() noexcept { return "file i/o"; }
+
+    bool await_ready() noexcept
+    {
+      cancelled = ct.is_cancelled();
+      return cancelled;
+    }
+
+    void await_suspend(std::coroutine_handle<> h)
+    {
+      req.h = h;
+
+      try
+      {
+        files->submit(req);
+      }
+      catch (...)
+      {
+        ex = std::current_exception();
+        req.ctx->post(h);
+      }
+    }
+
+    /**
+     * @brief Return the non-negative result of the request.
+     *
+     * @throws std::system_error on cancellation or when the call failed.
+     */
+    std::uint64_t await_resume()
+    {
+      if (cancelled)
+      {
+        throw std::system_error(vix::async::core::cancelled_ec());
+      }
+
+      if (ex)
+      {
+        std::rethrow_exception(ex);
+      }
+
+      if (req.result < 0)
+      {
+        throw std::system_error(static_cast<int>(-req.result), std::system_category());
+      }
+
+      return static_cast<std::uint64_t>(req.result);
+    }
+  };
+
+  /**
+   * @brief Build an awaitable for one operation.
+   *
+   * The caller fills in the remaining request fields before awaiting it.
+   *
+   * @throws std::system_error with errc::closed if ctx or files is null.
+   */
+  inline file_awaitable make_op(
+      vix::async::core::io_context *ctx,
+      file_service *files,
+      file_op op,
+      vix::async::core::cancel_token ct)
+  {
+    if (!ctx || !files)
+    {
+      throw std::system_error(vix::async::core::make_error_code(vix::async::core::errc::closed));
+    }
+
+    file_awaitable aw{};
+    aw.files = files;
+    aw.req.op = op;
+    aw.req.ctx = ctx;
+    aw.ct = std::move(ct);
+    return aw;
+  }
+
+} // namespace vix::async::fs::detail
+
+#endif // VIX_ASYNC_FILE_AWAIT_HPP
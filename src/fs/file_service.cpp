@@ -0,0 +1,781 @@
+/**
+ *
+ *  @file file_service.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/async/fs/file_service.hpp>
+
+#include <vix/async/core/error.hpp>
+#include <vix/async/core/io_context.hpp>
+#include <vix/async/detail/config.hpp>
+#include <vix/async/detail/platform.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if ASYNC_PLATFORM_UNIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#if ASYNC_PLATFORM_LINUX && ASYNC_ENABLE_IO_URING && __has_include(<linux/io_uring.h>)
+#define VIX_ASYNC_FS_URING 1
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#else
+#define VIX_ASYNC_FS_URING 0
+#endif
+
+namespace vix::async::fs::detail
+{
+  namespace
+  {
+    /** @brief Largest byte count the kernel transfers in one read or write. */
+    constexpr std::uint64_t max_io_bytes = 0x7ffff000u;
+
+    /**
+     * @brief Resume the awaiting coroutine; the request is dead afterwards.
+     */
+    void complete(file_request &r) noexcept
+    {
+      vix::async::core::io_context *ctx = r.ctx;
+      const std::coroutine_handle<> h = r.h;
+      if (ctx && h)
+      {
+        ctx->post(h);
+      }
+    }
+
+    /**
+     * @brief Join a backend thread, detaching when called from it.
+     */
+    void join_thread(std::thread &t) noexcept
+    {
+      if (!t.joinable())
+      {
+        return;
+      }
+
+      try
+      {
+        if (t.get_id() == std::this_thread::get_id())
+        {
+          t.detach();
+        }
+        else
+        {
+          t.join();
+        }
+      }
+      catch (...)
+      {
+      }
+    }
+
+#if ASYNC_PLATFORM_UNIX
+    /**
+     * @brief Make a mapped range resident.
+     *
+     * WILLNEED starts readahead for the whole range at once; POPULATE_READ
+     * (Linux 5.14+) then waits for it and maps the pages. Older kernels get
+     * one read per page instead.
+     */
+    std::int64_t prefetch_range(void *addr, std::uint64_t len) noexcept
+    {
+      const auto page = static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+      const auto begin = reinterpret_cast<std::uintptr_t>(addr) & ~(page - 1);
+      const auto end = reinterpret_cast<std::uintptr_t>(addr) + len;
+      if (len == 0)
+      {
+        return 0;
+      }
+
+      void *start = reinterpret_cast<void *>(begin);
+      const std::size_t span = end - begin;
+
+      if (::madvise(start, span, MADV_WILLNEED) != 0)
+      {
+        return -errno;
+      }
+
+#if defined(MADV_POPULATE_READ)
+      if (::madvise(start, span, MADV_POPULATE_READ) == 0)
+      {
+        return 0;
+      }
+      if (errno != EINVAL)
+      {
+        return -errno;
+      }
+#endif
+
+      unsigned char sink = 0;
+      for (std::uintptr_t p = begin; p < end; p += page)
+      {
+        sink = static_cast<unsigned char>(sink ^ *reinterpret_cast<const volatile unsigned char *>(p));
+      }
+      (void)sink;
+      return 0;
+    }
+#endif
+
+    /**
+     * @brief Run a request with blocking system calls.
+     *
+     * @return Byte count or fd on success, -errno on failure.
+     */
+    std::int64_t run_blocking(const file_request &r) noexcept
+    {
+#if ASYNC_PLATFORM_UNIX
+      for (;;)
+      {
+        std::int64_t rc = -1;
+        const auto off = static_cast<off_t>(r.offset);
+
+        switch (r.op)
+        {
+        case file_op::read:
+          rc = ::pread(r.fd, r.buf, static_cast<std::size_t>(std::min(r.len, max_io_bytes)), off);
+          break;
+        case file_op::write:
+          rc = ::pwrite(r.fd, r.buf, static_cast<std::size_t>(std::min(r.len, max_io_bytes)), off);
+          break;
+        case file_op::readv:
+          rc = ::preadv(r.fd, static_cast<const iovec *>(r.buf), static_cast<int>(r.len), off);
+          break;
+        case file_op::writev:
+          rc = ::pwritev(r.fd, static_cast<const iovec *>(r.buf), static_cast<int>(r.len), off);
+          break;
+        case file_op::fsync:
+          rc = ::fsync(r.fd);
+          break;
+        case file_op::fdatasync:
+#if ASYNC_PLATFORM_APPLE
+          rc = ::fsync(r.fd);
+#else
+          rc = ::fdatasync(r.fd);
+#endif
+          break;
+        case file_op::fallocate:
+#if ASYNC_PLATFORM_LINUX
+          rc = ::fallocate(r.fd, r.flags, off, static_cast<off_t>(r.len));
+#elif !ASYNC_PLATFORM_APPLE
+          // posix_fallocate reports the error instead of setting errno.
+          if (const int err = ::posix_fallocate(r.fd, off, static_cast<off_t>(r.len)); err != 0)
+          {
+            return -err;
+          }
+          rc = 0;
+#else
+          return -ENOTSUP;
+#endif
+          break;
+        case file_op::open:
+          rc = ::openat(r.fd, r.path, r.flags, static_cast<mode_t>(r.perms));
+          break;
+        case file_op::prefetch:
+          return prefetch_range(r.buf, r.len);
+        }
+
+        if (rc >= 0)
+        {
+          return rc;
+        }
+
+        if (errno != EINTR)
+        {
+          return -errno;
+        }
+      }
+#else
+      (void)r;
+      return -ENOSYS;
+#endif
+    }
+
+    /**
+     * @brief Dedicated pool of threads running blocking file system calls.
+     */
+    class blocking_backend
+    {
+    public:
+      explicit blocking_backend(std::size_t threads)
+      {
+        threads_.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i)
+        {
+          threads_.emplace_back([this]()
+                                { worker(); });
+        }
+      }
+
+      ~blocking_backend()
+      {
+        stop();
+      }
+
+      blocking_backend(const blocking_backend &) = delete;
+      blocking_backend &operator=(const blocking_backend &) = delete;
+
+      void submit(file_request &r)
+      {
+        {
+          std::lock_guard<std::mutex> lock(m_);
+          if (stop_)
+          {
+            throw std::system_error(vix::async::core::make_error_code(vix::async::core::errc::stopped));
+          }
+          q_.push_back(&r);
+        }
+        cv_.notify_one();
+      }
+
+      void stop() noexcept
+      {
+        {
+          std::lock_guard<std::mutex> lock(m_);
+          if (stop_)
+          {
+            return;
+          }
+          stop_ = true;
+          q_.clear();
+        }
+        cv_.notify_all();
+
+        for (std::thread &t : threads_)
+        {
+          join_thread(t);
+        }
+      }
+
+    private:
+      void worker() noexcept
+      {
+        for (;;)
+        {
+          file_request *r = nullptr;
+          {
+            std::unique_lock<std::mutex> lock(m_);
+            cv_.wait(lock, [this]()
+                     { return stop_ || !q_.empty(); });
+            if (stop_)
+            {
+              return;
+            }
+            r = q_.front();
+            q_.pop_front();
+          }
+
+          r->result = run_blocking(*r);
+          complete(*r);
+        }
+      }
+
+      std::mutex m_;
+      std::condition_variable cv_;
+      std::deque<file_request *> q_;
+      bool stop_{false};
+      std::vector<std::thread> threads_;
+    };
+
+#if VIX_ASYNC_FS_URING
+    int uring_setup(unsigned entries, io_uring_params *p) noexcept
+    {
+      return static_cast<int>(::syscall(__NR_io_uring_setup, entries, p));
+    }
+
+    int uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) noexcept
+    {
+      return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+    }
+
+    int uring_register(int fd, unsigned opcode, void *arg, unsigned nr_args) noexcept
+    {
+      return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+    }
+
+    /**
+     * @brief io_uring instance driven through raw system calls.
+     *
+     * Submissions are serialized by a mutex; one thread blocks in
+     * io_uring_enter() for completions and resumes the awaiting coroutines.
+     * At most cq_entries requests are in the kernel at once so the
+     * completion queue never overflows; the rest wait in a backlog that the
+     * completion thread refills from.
+     */
+    class uring_backend
+    {
+    public:
+      uring_backend() = default;
+
+      ~uring_backend()
+      {
+        stop();
+        unmap();
+      }
+
+      uring_backend(const uring_backend &) = delete;
+      uring_backend &operator=(const uring_backend &) = delete;
+
+      /**
+       * @brief Create the ring and start the completion thread.
+       *
+       * @return false if io_uring is unavailable or lacks an operation.
+       */
+      bool init(unsigned entries)
+      {
+        io_uring_params p{};
+        fd_ = uring_setup(entries, &p);
+        if (fd_ < 0)
+        {
+          return false;
+        }
+
+        if (!map(p) || !probe())
+        {
+          unmap();
+          return false;
+        }
+
+        reaper_ = std::thread([this]()
+                              { reap_loop(); });
+        return true;
+      }
+
+      void submit(file_request &r)
+      {
+        std::lock_guard<std::mutex> lock(m_);
+        if (stopping_)
+        {
+          throw std::system_error(vix::async::core::make_error_code(vix::async::core::errc::stopped));
+        }
+
+        if (inflight_ >= cq_entries_ || sq_full_locked() || !backlog_.empty())
+        {
+          backlog_.push_back(&r);
+          return;
+        }
+
+        push_locked(r);
+        ++inflight_;
+        flush_locked();
+      }
+
+      void stop() noexcept
+      {
+        {
+          std::lock_guard<std::mutex> lock(m_);
+          if (stopping_ || fd_ < 0)
+          {
+            return;
+          }
+          stopping_ = true;
+          backlog_.clear();
+
+          // A NOP with user_data 0 tells the completion thread to exit.
+          io_uring_sqe &sqe = next_sqe_locked();
+          sqe.opcode = IORING_OP_NOP;
+          commit_sqe_locked();
+          flush_locked();
+        }
+
+        join_thread(reaper_);
+      }
+
+    private:
+      bool map(const io_uring_params &p) noexcept
+      {
+        sq_entries_ = p.sq_entries;
+        cq_entries_ = p.cq_entries;
+
+        sq_len_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        cq_len_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+        sqes_len_ = p.sq_entries * sizeof(io_uring_sqe);
+
+        sq_ring_ = ::mmap(nullptr, sq_len_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_,
+                          static_cast<off_t>(IORING_OFF_SQ_RING));
+        cq_ring_ = ::mmap(nullptr, cq_len_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_,
+                          static_cast<off_t>(IORING_OFF_CQ_RING));
+        void *sqes = ::mmap(nullptr, sqes_len_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_,
+                            static_cast<off_t>(IORING_OFF_SQES));
+        if (sq_ring_ == MAP_FAILED || cq_ring_ == MAP_FAILED || sqes == MAP_FAILED)
+        {
+          if (sqes != MAP_FAILED)
+          {
+            ::munmap(sqes, sqes_len_);
+          }
+          return false;
+        }
+
+        auto *sq = static_cast<char *>(sq_ring_);
+        auto *cq = static_cast<char *>(cq_ring_);
+
+        sq_head_ = reinterpret_cast<unsigned *>(sq + p.sq_off.head);
+        sq_tail_ = reinterpret_cast<unsigned *>(sq + p.sq_off.tail);
+        sq_mask_ = *reinterpret_cast<unsigned *>(sq + p.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<unsigned *>(sq + p.sq_off.array);
+        sqes_ = static_cast<io_uring_sqe *>(sqes);
+
+        cq_head_ = reinterpret_cast<unsigned *>(cq + p.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned *>(cq + p.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned *>(cq + p.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe *>(cq + p.cq_off.cqes);
+
+        sq_tail_local_ = *sq_tail_;
+        return true;
+      }
+
+      bool probe() noexcept
+      {
+        constexpr unsigned nr_ops = 256;
+        std::vector<std::uint64_t> storage(
+            (sizeof(io_uring_probe) + nr_ops * sizeof(io_uring_probe_op)) / sizeof(std::uint64_t) + 1);
+        auto *pr = reinterpret_cast<io_uring_probe *>(storage.data());
+
+        if (uring_register(fd_, IORING_REGISTER_PROBE, pr, nr_ops) < 0)
+        {
+          return false;
+        }
+
+        const unsigned needed[] = {
+            IORING_OP_NOP, IORING_OP_READ, IORING_OP_WRITE, IORING_OP_READV, IORING_OP_WRITEV,
+            IORING_OP_FSYNC, IORING_OP_FALLOCATE, IORING_OP_OPENAT};
+
+        for (unsigned op : needed)
+        {
+          if (op > pr->last_op || (pr->ops[op].flags & IO_URING_OP_SUPPORTED) == 0)
+          {
+            return false;
+          }
+        }
+
+        return true;
+      }
+
+      void unmap() noexcept
+      {
+        if (sqes_)
+        {
+          ::munmap(sqes_, sqes_len_);
+          sqes_ = nullptr;
+        }
+        if (cq_ring_ && cq_ring_ != MAP_FAILED)
+        {
+          ::munmap(cq_ring_, cq_len_);
+        }
+        if (sq_ring_ && sq_ring_ != MAP_FAILED)
+        {
+          ::munmap(sq_ring_, sq_len_);
+        }
+        cq_ring_ = nullptr;
+        sq_ring_ = nullptr;
+
+        if (fd_ >= 0)
+        {
+          ::close(fd_);
+          fd_ = -1;
+        }
+      }
+
+      bool sq_full_locked() const noexcept
+      {
+        const unsigned head = std::atomic_ref<unsigned>(*sq_head_).load(std::memory_order_acquire);
+        return sq_tail_local_ - head >= sq_entries_;
+      }
+
+      io_uring_sqe &next_sqe_locked() noexcept
+      {
+        const unsigned idx = sq_tail_local_ & sq_mask_;
+        io_uring_sqe &sqe = sqes_[idx];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sq_array_[idx] = idx;
+        return sqe;
+      }
+
+      void commit_sqe_locked() noexcept
+      {
+        ++sq_tail_local_;
+        std::atomic_ref<unsigned>(*sq_tail_).store(sq_tail_local_, std::memory_order_release);
+        ++unsubmitted_;
+      }
+
+      void push_locked(file_request &r) noexcept
+      {
+        io_uring_sqe &sqe = next_sqe_locked();
+        sqe.fd = r.fd;
+        sqe.off = r.offset;
+        sqe.addr = reinterpret_cast<std::uint64_t>(r.buf);
+        sqe.user_data = reinterpret_cast<std::uint64_t>(&r);
+
+        switch (r.op)
+        {
+        case file_op::read:
+          sqe.opcode = IORING_OP_READ;
+          sqe.len = static_cast<std::uint32_t>(std::min(r.len, max_io_bytes));
+          break;
+        case file_op::write:
+          sqe.opcode = IORING_OP_WRITE;
+          sqe.len = static_cast<std::uint32_t>(std::min(r.len, max_io_bytes));
+          break;
+        case file_op::readv:
+          sqe.opcode = IORING_OP_READV;
+          sqe.len = static_cast<std::uint32_t>(r.len);
+          break;
+        case file_op::writev:
+          sqe.opcode = IORING_OP_WRITEV;
+          sqe.len = static_cast<std::uint32_t>(r.len);
+          break;
+        case file_op::fsync:
+          sqe.opcode = IORING_OP_FSYNC;
+          break;
+        case file_op::fdatasync:
+          sqe.opcode = IORING_OP_FSYNC;
+          sqe.fsync_flags = IORING_FSYNC_DATASYNC;
+          break;
+        case file_op::fallocate:
+          // The length travels in addr and the mode in len.
+          sqe.opcode = IORING_OP_FALLOCATE;
+          sqe.addr = r.len;
+          sqe.len = static_cast<std::uint32_t>(r.flags);
+          break;
+        case file_op::prefetch:
+          // Routed to the blocking pool by file_service::submit().
+          sqe.opcode = IORING_OP_NOP;
+          break;
+        case file_op::open:
+          sqe.opcode = IORING_OP_OPENAT;
+          sqe.off = 0;
+          sqe.addr = reinterpret_cast<std::uint64_t>(r.path);
+          sqe.len = r.perms;
+          sqe.open_flags = static_cast<std::uint32_t>(r.flags);
+          break;
+        }
+
+        commit_sqe_locked();
+      }
+
+      /**
+       * @brief Hand queued SQEs to the kernel.
+       *
+       * On EAGAIN/EBUSY the entries stay queued and are retried by the next
+       * submission or by the completion thread once it has reaped.
+       */
+      void flush_locked() noexcept
+      {
+        while (unsubmitted_ > 0)
+        {
+          const int n = uring_enter(fd_, unsubmitted_, 0, 0);
+          if (n < 0)
+          {
+            if (errno == EINTR)
+            {
+              continue;
+            }
+            return;
+          }
+          if (n == 0)
+          {
+            return;
+          }
+          unsubmitted_ -= static_cast<unsigned>(n);
+        }
+      }
+
+      void reap_loop() noexcept
+      {
+        std::vector<file_request *> done;
+        done.reserve(cq_entries_);
+
+        for (;;)
+        {
+          (void)uring_enter(fd_, 0, 1, IORING_ENTER_GETEVENTS);
+
+          bool stop_seen = false;
+          std::atomic_ref<unsigned> head_ref(*cq_head_);
+          unsigned head = head_ref.load(std::memory_order_relaxed);
+          const unsigned tail = std::atomic_ref<unsigned>(*cq_tail_).load(std::memory_order_acquire);
+
+          for (; head != tail; ++head)
+          {
+            const io_uring_cqe &cqe = cqes_[head & cq_mask_];
+            if (cqe.user_data == 0)
+            {
+              stop_seen = true;
+              continue;
+            }
+
+            auto *r = reinterpret_cast<file_request *>(cqe.user_data);
+            r->result = cqe.res;
+            done.push_back(r);
+          }
+          head_ref.store(head, std::memory_order_release);
+
+          {
+            std::lock_guard<std::mutex> lock(m_);
+            inflight_ -= static_cast<unsigned>(done.size());
+
+            while (!stopping_ && !backlog_.empty() && inflight_ < cq_entries_ && !sq_full_locked())
+            {
+              push_locked(*backlog_.front());
+              backlog_.pop_front();
+              ++inflight_;
+            }
+            flush_locked();
+          }
+
+          for (file_request *r : done)
+          {
+            complete(*r);
+          }
+          done.clear();
+
+          if (stop_seen)
+          {
+            return;
+          }
+        }
+      }
+
+      int fd_{-1};
+
+      void *sq_ring_{nullptr};
+      void *cq_ring_{nullptr};
+      std::size_t sq_len_{0};
+      std::size_t cq_len_{0};
+      std::size_t sqes_len_{0};
+
+      unsigned sq_entries_{0};
+      unsigned cq_entries_{0};
+
+      unsigned *sq_head_{nullptr};
+      unsigned *sq_tail_{nullptr};
+      unsigned sq_mask_{0};
+      unsigned *sq_array_{nullptr};
+      io_uring_sqe *sqes_{nullptr};
+
+      unsigned *cq_head_{nullptr};
+      unsigned *cq_tail_{nullptr};
+      unsigned cq_mask_{0};
+      io_uring_cqe *cqes_{nullptr};
+
+      std::mutex m_;
+      unsigned sq_tail_local_{0};
+      unsigned unsubmitted_{0};
+      unsigned inflight_{0};
+      std::deque<file_request *> backlog_;
+      bool stopping_{false};
+
+      std::thread reaper_;
+    };
+#endif
+  } // namespace
+
+  struct file_service::impl
+  {
+#if VIX_ASYNC_FS_URING
+    std::unique_ptr<uring_backend> uring;
+#endif
+
+    /** @brief Guards lazy creation of blocking and stopped. */
+    std::mutex m;
+    std::unique_ptr<blocking_backend> blocking;
+    bool stopped{false};
+
+    blocking_backend &pool()
+    {
+      std::lock_guard<std::mutex> lock(m);
+      if (stopped)
+      {
+        throw std::system_error(vix::async::core::make_error_code(vix::async::core::errc::stopped));
+      }
+      if (!blocking)
+      {
+        blocking = std::make_unique<blocking_backend>(ASYNC_FILE_THREADS);
+      }
+      return *blocking;
+    }
+  };
+
+  file_service::file_service(vix::async::core::io_context &)
+      : impl_(std::make_unique<impl>())
+  {
+#if VIX_ASYNC_FS_URING
+    auto ring = std::make_unique<uring_backend>();
+    if (ring->init(ASYNC_IO_URING_ENTRIES))
+    {
+      impl_->uring = std::move(ring);
+      return;
+    }
+#endif
+    (void)impl_->pool();
+  }
+
+  file_service::~file_service()
+  {
+    stop();
+  }
+
+  void file_service::submit(file_request &req)
+  {
+#if VIX_ASYNC_FS_URING
+    if (impl_->uring && req.op != file_op::prefetch)
+    {
+      impl_->uring->submit(req);
+      return;
+    }
+#endif
+    impl_->pool().submit(req);
+  }
+
+  bool file_service::uses_io_uring() const noexcept
+  {
+#if VIX_ASYNC_FS_URING
+    return impl_->uring != nullptr;
+#else
+    return false;
+#endif
+  }
+
+  void file_service::stop() noexcept
+  {
+#if VIX_ASYNC_FS_URING
+    if (impl_->uring)
+    {
+      impl_->uring->stop();
+    }
+#endif
+
+    blocking_backend *pool = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(impl_->m);
+      impl_->stopped = true;
+      pool = impl_->blocking.get();
+    }
+
+    if (pool)
+    {
+      pool->stop();
+    }
+  }
+
+} // namespace vix::async::fs::detail
@@ -0,0 +1,137 @@
+/**
+ *
+ *  @file mapped_file.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/async/fs/mapped_file.hpp>
+
+#include <vix/async/core/io_context.hpp>
+#include <vix/async/detail/platform.hpp>
+#include <vix/async/fs/file.hpp>
+#include <vix/async/fs/file_service.hpp>
+
+#include "file_await.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <utility>
+
+#if ASYNC_PLATFORM_UNIX
+#include <sys/mman.h>
+#endif
+
+namespace vix::async::fs
+{
+  mapped_file::~mapped_file()
+  {
+    close();
+  }
+
+  mapped_file::mapped_file(mapped_file &&other) noexcept
+      : ctx_(std::exchange(other.ctx_, nullptr)),
+        files_(std::exchange(other.files_, nullptr)),
+        data_(std::exchange(other.data_, nullptr)),
+        size_(std::exchange(other.size_, 0))
+  {
+  }
+
+  mapped_file &mapped_file::operator=(mapped_file &&other) noexcept
+  {
+    if (this != &other)
+    {
+      close();
+      ctx_ = std::exchange(other.ctx_, nullptr);
+      files_ = std::exchange(other.files_, nullptr);
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+
+  void mapped_file::close() noexcept
+  {
+#if ASYNC_PLATFORM_UNIX
+    if (data_)
+    {
+      ::munmap(const_cast<std::byte *>(data_), size_);
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    files_ = nullptr;
+    ctx_ = nullptr;
+  }
+
+  std::span<const std::byte> mapped_file::view(std::uint64_t offset, std::uint64_t length) const
+  {
+    if (offset > size_)
+    {
+      throw std::system_error(core::make_error_code(core::errc::invalid_argument));
+    }
+
+    const auto len = static_cast<std::size_t>(std::min<std::uint64_t>(length, size_ - offset));
+    return {data_ + offset, len};
+  }
+
+  core::task<mapped_file> mapped_file::open(
+      core::io_context &ctx,
+      std::string path,
+      core::cancel_token ct)
+  {
+#if ASYNC_PLATFORM_UNIX
+    async_file f = co_await async_file::open(ctx, std::move(path), open_mode::read, 0, std::move(ct));
+    const std::uint64_t size = f.size();
+
+    mapped_file m;
+    m.ctx_ = &ctx;
+    m.files_ = &ctx.files();
+
+    // Empty files cannot be mapped; the view stays open with no data.
+    if (size > 0)
+    {
+      void *p = ::mmap(nullptr, static_cast<std::size_t>(size), PROT_READ, MAP_SHARED, f.native_handle(), 0);
+      if (p == MAP_FAILED)
+      {
+        throw std::system_error(errno, std::system_category());
+      }
+      m.data_ = static_cast<const std::byte *>(p);
+      m.size_ = static_cast<std::size_t>(size);
+    }
+
+    // The mapping keeps the file referenced; the descriptor is closed with f.
+    co_return m;
+#else
+    (void)ctx;
+    (void)path;
+    (void)ct;
+    throw std::system_error(core::make_error_code(core::errc::not_supported));
+#endif
+  }
+
+  core::task<void> mapped_file::prefetch(
+      std::uint64_t offset,
+      std::uint64_t length,
+      core::cancel_token ct)
+  {
+    const std::span<const std::byte> range = view(offset, length);
+    if (range.empty())
+    {
+      co_return;
+    }
+
+    auto op = detail::make_op(ctx_, files_, detail::file_op::prefetch, std::move(ct));
+    op.req.buf = const_cast<std::byte *>(range.data());
+    op.req.len = range.size();
+
+    (void)co_await op;
+  }
+
+} // namespace vix::async::fs
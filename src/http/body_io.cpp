@@ -0,0 +1,167 @@
+/**
+ *
+ *  @file body_io.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include "body_io.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace vix::async::http::detail
+{
+  namespace
+  {
+    /** @brief Longest accepted chunk-size line (size, extensions) or trailer line. */
+    constexpr std::size_t max_chunk_line = 4096;
+
+    /**
+     * @brief Parse "1a2b[;ext]" into a chunk size.
+     */
+    bool parse_chunk_size(std::string_view line, std::uint64_t &size) noexcept
+    {
+      const std::size_t semi = line.find(';');
+      if (semi != std::string_view::npos)
+      {
+        line = line.substr(0, semi);
+      }
+      while (!line.empty() && (line.back() == ' ' || line.back() == '\t'))
+      {
+        line.remove_suffix(1);
+      }
+
+      if (line.empty() || line.size() > 15)
+      {
+        return false;
+      }
+
+      std::uint64_t v = 0;
+      for (const char c : line)
+      {
+        std::uint64_t d = 0;
+        if (c >= '0' && c <= '9')
+        {
+          d = static_cast<std::uint64_t>(c - '0');
+        }
+        else if (c >= 'a' && c <= 'f')
+        {
+          d = static_cast<std::uint64_t>(c - 'a' + 10);
+        }
+        else if (c >= 'A' && c <= 'F')
+        {
+          d = static_cast<std::uint64_t>(c - 'A' + 10);
+        }
+        else
+        {
+          return false;
+        }
+        v = (v << 4) | d;
+      }
+      size = v;
+      return true;
+    }
+  } // namespace
+
+  core::task<void> read_chunked_body(
+      net::buffered_reader &in,
+      std::string &body,
+      std::size_t max_body,
+      core::cancel_token ct)
+  {
+    net::delimited_reader lines(in, "\r\n", max_chunk_line);
+
+    for (;;)
+    {
+      const auto line = co_await lines.async_read_frame(ct);
+      if (!line)
+      {
+        throw_errc(core::errc::closed);
+      }
+
+      std::uint64_t size = 0;
+      if (!parse_chunk_size(as_text(*line), size))
+      {
+        throw_errc(core::errc::invalid_argument);
+      }
+
+      if (size == 0)
+      {
+        // Trailer fields are not exposed; skip to the blank line.
+        for (;;)
+        {
+          const auto trailer = co_await lines.async_read_frame(ct);
+          if (!trailer)
+          {
+            throw_errc(core::errc::closed);
+          }
+          if (trailer->empty())
+          {
+            co_return;
+          }
+        }
+      }
+
+      if (size > max_body - body.size())
+      {
+        throw_errc(core::errc::overflow);
+      }
+
+      // Copy the chunk as it arrives instead of growing the read buffer.
+      auto remaining = static_cast<std::size_t>(size);
+      while (remaining > 0)
+      {
+        if (in.buffered().empty() && !co_await in.async_fill(1, ct))
+        {
+          throw_errc(core::errc::closed);
+        }
+
+        const auto part = in.buffered().first(std::min(remaining, in.buffered().size()));
+        body.append(as_text(part));
+        in.consume(part.size());
+        remaining -= part.size();
+      }
+
+      if (!co_await in.async_fill(2, ct))
+      {
+        throw_errc(core::errc::closed);
+      }
+      if (as_text(in.buffered().first(2)) != "\r\n")
+      {
+        throw_errc(core::errc::invalid_argument);
+      }
+      in.consume(2);
+    }
+  }
+
+  core::task<void> read_until_close(
+      net::buffered_reader &in,
+      std::string &body,
+      std::size_t max_body,
+      core::cancel_token ct)
+  {
+    for (;;)
+    {
+      if (in.buffered().empty() && !co_await in.async_fill(1, ct))
+      {
+        co_return;
+      }
+
+      const auto part = in.buffered();
+      if (part.size() > max_body - body.size())
+      {
+        throw_errc(core::errc::overflow);
+      }
+      body.append(as_text(part));
+      in.consume(part.size());
+    }
+  }
+
+} // namespace vix::async::http::detail
@@ -0,0 +1,77 @@
+/**
+ *
+ *  @file body_io.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_ASYNC_HTTP_BODY_IO_HPP
+#define VIX_ASYNC_HTTP_BODY_IO_HPP
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include <vix/async/core/cancel.hpp>
+#include <vix/async/core/error.hpp>
+#include <vix/async/core/task.hpp>
+#include <vix/async/net/framing.hpp>
+
+namespace vix::async::http::detail
+{
+  /**
+   * @brief View bytes as text.
+   */
+  inline std::string_view as_text(std::span<const std::byte> b) noexcept
+  {
+    return {reinterpret_cast<const char *>(b.data()), b.size()};
+  }
+
+  /**
+   * @brief View text as bytes.
+   */
+  inline std::span<const std::byte> as_bytes(std::string_view s) noexcept
+  {
+    return std::as_bytes(std::span<const char>(s.data(), s.size()));
+  }
+
+  [[noreturn]] inline void throw_errc(core::errc e)
+  {
+    throw std::system_error(core::make_error_code(e));
+  }
+
+  /**
+   * @brief Read a chunked body (trailers are skipped), appending it to body.
+   *
+   * @throws std::system_error with errc::invalid_argument for malformed
+   * chunk framing, errc::overflow past max_body, errc::closed if the
+   * stream ends first.
+   */
+  core::task<void> read_chunked_body(
+      net::buffered_reader &in,
+      std::string &body,
+      std::size_t max_body,
+      core::cancel_token ct);
+
+  /**
+   * @brief Read everything until the peer closes, appending it to body.
+   *
+   * @throws std::system_error with errc::overflow past max_body.
+   */
+  core::task<void> read_until_close(
+      net::buffered_reader &in,
+      std::string &body,
+      std::size_t max_body,
+      core::cancel_token ct);
+
+} // namespace vix::async::http::detail
+
+#endif // VIX_ASYNC_HTTP_BODY_IO_HPP
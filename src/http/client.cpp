@@ -0,0 +1,349 @@
+/**
+ *
+ *  @file client.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/async/http/client.hpp>
+
+#include <vix/async/core/io_context.hpp>
+#include <vix/async/detail/platform.hpp>
+#include <vix/async/http/parser.hpp>
+#include <vix/async/net/framing.hpp>
+
+#include "body_io.hpp"
+
+#include <algorithm>
+#include <array>
+#include <optional>
+
+#if ASYNC_PLATFORM_UNIX
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#endif
+
+namespace vix::async::http
+{
+  struct client::connection
+  {
+    std::unique_ptr<net::tcp_stream> stream;
+    net::buffered_reader in;
+    std::string out{};
+    bool reusable{false};
+    bool received{false};
+
+    explicit connection(std::unique_ptr<net::tcp_stream> s)
+        : stream(std::move(s)),
+          in(*stream)
+    {
+    }
+  };
+
+  namespace
+  {
+    using detail::as_bytes;
+    using detail::as_text;
+    using detail::throw_errc;
+
+    std::string endpoint_key(const net::tcp_endpoint &ep)
+    {
+      return ep.host + ":" + std::to_string(ep.port);
+    }
+
+    /**
+     * @brief Whether repeating the method is safe (RFC 9110 section 9.2.2).
+     */
+    bool idempotent(std::string_view method) noexcept
+    {
+      return method == "GET" || method == "HEAD" || method == "PUT" ||
+             method == "DELETE" || method == "OPTIONS" || method == "TRACE";
+    }
+
+    void set_nodelay(net::tcp_stream &s) noexcept
+    {
+#if ASYNC_PLATFORM_UNIX
+      try
+      {
+        const int one = 1;
+        ::setsockopt(s.native_handle(), IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+      }
+      catch (...)
+      {
+      }
+#else
+      (void)s;
+#endif
+    }
+
+    bool has_header(const client_request &req, std::string_view name) noexcept
+    {
+      for (const auto &[n, v] : req.headers)
+      {
+        if (iequals(n, name))
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    void serialize(std::string &out, const net::tcp_endpoint &ep, const client_request &req)
+    {
+      out.clear();
+      out.append(req.method);
+      out.push_back(' ');
+      out.append(req.target);
+      out.append(" HTTP/1.1\r\n");
+
+      if (!has_header(req, "host"))
+      {
+        out.append("Host: ");
+        out.append(ep.host);
+        out.push_back(':');
+        out.append(std::to_string(ep.port));
+        out.append("\r\n");
+      }
+
+      for (const auto &[name, value] : req.headers)
+      {
+        out.append(name);
+        out.append(": ");
+        out.append(value);
+        out.append("\r\n");
+      }
+
+      if (!req.body.empty() || req.method == "POST" || req.method == "PUT" || req.method == "PATCH")
+      {
+        out.append("Content-Length: ");
+        out.append(std::to_string(req.body.size()));
+        out.append("\r\n");
+      }
+      out.append("\r\n");
+    }
+  } // namespace
+
+  std::string_view client_response::header(std::string_view name) const noexcept
+  {
+    for (const auto &[n, v] : headers)
+    {
+      if (iequals(n, name))
+      {
+        return v;
+      }
+    }
+    return {};
+  }
+
+  client::client(core::io_context &ctx, client_options opts)
+      : ctx_(ctx),
+        opts_(opts)
+  {
+  }
+
+  client::~client()
+  {
+    close_idle();
+  }
+
+  std::size_t client::idle_connections() const noexcept
+  {
+    std::size_t n = 0;
+    for (const auto &[key, conns] : idle_)
+    {
+      n += conns.size();
+    }
+    return n;
+  }
+
+  void client::close_idle() noexcept
+  {
+    for (auto &[key, conns] : idle_)
+    {
+      for (auto &c : conns)
+      {
+        c->stream->close();
+      }
+    }
+    idle_.clear();
+  }
+
+  core::task<client_response> client::async_get(
+      const net::tcp_endpoint &ep,
+      std::string_view target,
+      core::cancel_token ct)
+  {
+    client_request req;
+    req.target.assign(target);
+    co_return co_await async_request(ep, req, std::move(ct));
+  }
+
+  core::task<client_response> client::async_request(
+      const net::tcp_endpoint &ep,
+      const client_request &req,
+      core::cancel_token ct)
+  {
+    const std::string key = endpoint_key(ep);
+
+    for (;;)
+    {
+      std::unique_ptr<connection> conn;
+      bool reused = false;
+
+      if (auto it = idle_.find(key); it != idle_.end() && !it->second.empty())
+      {
+        conn = std::move(it->second.back());
+        it->second.pop_back();
+        reused = true;
+      }
+      else
+      {
+        conn = std::make_unique<connection>(net::make_tcp_stream(ctx_));
+        co_await conn->stream->async_connect(ep, ct);
+        if (opts_.nodelay)
+        {
+          set_nodelay(*conn->stream);
+        }
+      }
+
+      conn->reusable = false;
+      conn->received = false;
+
+      std::optional<client_response> res;
+      bool written = false;
+      bool stale = false;
+      try
+      {
+        // Request head and body go out in one gathered write.
+        serialize(conn->out, ep, req);
+        const std::array<std::span<const std::byte>, 2> parts{as_bytes(conn->out), as_bytes(req.body)};
+        (void)co_await conn->stream->async_write_v(parts, ct);
+        written = true;
+
+        res.emplace();
+        co_await read_response(*conn, req.method, *res, ct);
+      }
+      catch (const std::system_error &)
+      {
+        // An idle connection the server already closed fails before any
+        // response byte arrives: retry on a fresh connection. Once the
+        // request went out, the server may have acted on it, so only
+        // idempotent methods are sent again.
+        if (!reused || conn->received || ct.is_cancelled() ||
+            (written && !idempotent(req.method)))
+        {
+          throw;
+        }
+        stale = true;
+      }
+
+      if (stale)
+      {
+        continue;
+      }
+
+      if (conn->reusable)
+      {
+        auto &pool = idle_[key];
+        if (pool.size() < opts_.max_idle_per_host)
+        {
+          pool.push_back(std::move(conn));
+        }
+      }
+
+      co_return std::move(*res);
+    }
+  }
+
+  core::task<void> client::read_response(
+      connection &conn,
+      std::string_view method,
+      client_response &res,
+      core::cancel_token ct)
+  {
+    net::delimited_reader heads(conn.in, "\r\n\r\n", opts_.max_head_size);
+    response_head head;
+
+    for (;;)
+    {
+      const auto frame = co_await heads.async_read_frame(ct);
+      if (!frame)
+      {
+        throw_errc(core::errc::closed);
+      }
+      conn.received = true;
+
+      if (!parse_response_head(as_text(*frame), head))
+      {
+        throw_errc(core::errc::invalid_argument);
+      }
+
+      // Skip interim responses (100 Continue, 103 Early Hints).
+      if (head.status >= 200 || head.status == 101)
+      {
+        break;
+      }
+    }
+
+    const auto framing = response_body(head, method);
+    if (!framing)
+    {
+      throw_errc(core::errc::invalid_argument);
+    }
+
+    res.status = head.status;
+    res.reason.assign(head.reason);
+    res.headers.clear();
+    res.headers.reserve(head.headers.size());
+    for (const auto &h : head.headers)
+    {
+      res.headers.emplace_back(std::string(h.name), std::string(h.value));
+    }
+    res.body.clear();
+
+    switch (framing->kind)
+    {
+    case body_kind::none:
+      break;
+
+    case body_kind::length:
+    {
+      if (framing->length > opts_.max_body_size)
+      {
+        throw_errc(core::errc::overflow);
+      }
+      const auto length = static_cast<std::size_t>(framing->length);
+      res.body.reserve(length);
+      while (res.body.size() < length)
+      {
+        if (conn.in.buffered().empty() && !co_await conn.in.async_fill(1, ct))
+        {
+          throw_errc(core::errc::closed);
+        }
+        const auto part = conn.in.buffered().first(std::min(length - res.body.size(), conn.in.buffered().size()));
+        res.body.append(as_text(part));
+        conn.in.consume(part.size());
+      }
+      break;
+    }
+
+    case body_kind::chunked:
+      co_await detail::read_chunked_body(conn.in, res.body, opts_.max_body_size, ct);
+      break;
+
+    case body_kind::until_close:
+      co_await detail::read_until_close(conn.in, res.body, opts_.max_body_size, ct);
+      co_return;
+    }
+
+    conn.reusable = keep_alive(head) && head.status != 101;
+  }
+
+} // namespace vix::async::http
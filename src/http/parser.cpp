@@ -0,0 +1,542 @@
+/**
+ *
+ *  @file parser.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/async/http/parser.hpp>
+
+#include <vix/async/detail/scan.hpp>
+
+#include <array>
+
+namespace vix::async::http
+{
+  namespace
+  {
+    constexpr std::string_view crlf = "\r\n";
+    constexpr std::string_view head_end = "\r\n\r\n";
+
+    /**
+     * @brief RFC 9110 tchar lookup table.
+     */
+    constexpr std::array<bool, 256> make_tchar_table() noexcept
+    {
+      std::array<bool, 256> t{};
+      for (int c = '0'; c <= '9'; ++c)
+      {
+        t[static_cast<std::size_t>(c)] = true;
+      }
+      for (int c = 'a'; c <= 'z'; ++c)
+      {
+        t[static_cast<std::size_t>(c)] = true;
+        t[static_cast<std::size_t>(c - 'a' + 'A')] = true;
+      }
+      for (const char c : std::string_view("!#$%&'*+-.^_`|~"))
+      {
+        t[static_cast<unsigned char>(c)] = true;
+      }
+      return t;
+    }
+
+    constexpr std::array<bool, 256> tchar_table = make_tchar_table();
+
+    bool is_token(std::string_view s) noexcept
+    {
+      if (s.empty())
+      {
+        return false;
+      }
+      for (const char c : s)
+      {
+        if (!tchar_table[static_cast<unsigned char>(c)])
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    /**
+     * @brief Field values and reason phrases: no control bytes but HTAB.
+     */
+    bool is_field_text(std::string_view s) noexcept
+    {
+      for (const char c : s)
+      {
+        const auto u = static_cast<unsigned char>(c);
+        if ((u < 0x20 && u != '\t') || u == 0x7f)
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    bool is_target(std::string_view s) noexcept
+    {
+      if (s.empty())
+      {
+        return false;
+      }
+      for (const char c : s)
+      {
+        const auto u = static_cast<unsigned char>(c);
+        if (u <= 0x20 || u == 0x7f)
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    std::string_view trim(std::string_view s) noexcept
+    {
+      while (!s.empty() && (s.front() == ' ' || s.front() == '\t'))
+      {
+        s.remove_prefix(1);
+      }
+      while (!s.empty() && (s.back() == ' ' || s.back() == '\t'))
+      {
+        s.remove_suffix(1);
+      }
+      return s;
+    }
+
+    char lower(char c) noexcept
+    {
+      return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    /**
+     * @brief Split off the next line of a head.
+     */
+    std::string_view next_line(std::string_view &rest) noexcept
+    {
+      const std::size_t pos = detail::find(rest, crlf);
+      if (pos == std::string_view::npos)
+      {
+        const std::string_view line = rest;
+        rest = {};
+        return line;
+      }
+      const std::string_view line = rest.substr(0, pos);
+      rest.remove_prefix(pos + crlf.size());
+      return line;
+    }
+
+    std::string_view skip_empty_lines(std::string_view head) noexcept
+    {
+      while (head.starts_with(crlf))
+      {
+        head.remove_prefix(crlf.size());
+      }
+      return head;
+    }
+
+    /**
+     * @brief "HTTP/1.0" or "HTTP/1.1" to the minor version.
+     */
+    bool parse_version(std::string_view v, int &minor) noexcept
+    {
+      if (v.size() != 8 || !v.starts_with("HTTP/1.") || (v[7] != '0' && v[7] != '1'))
+      {
+        return false;
+      }
+      minor = v[7] - '0';
+      return true;
+    }
+
+    bool parse_fields(std::string_view rest, std::vector<header_field> &out)
+    {
+      out.clear();
+      while (!rest.empty())
+      {
+        const std::string_view line = next_line(rest);
+
+        // Obsolete line folding and whitespace before the colon are rejected.
+        const std::size_t colon = line.find(':');
+        if (colon == std::string_view::npos)
+        {
+          return false;
+        }
+
+        const std::string_view name = line.substr(0, colon);
+        const std::string_view value = trim(line.substr(colon + 1));
+        if (!is_token(name) || !is_field_text(value))
+        {
+          return false;
+        }
+
+        out.push_back(header_field{name, value});
+      }
+      return true;
+    }
+
+    std::string_view find_header(const std::vector<header_field> &headers, std::string_view name) noexcept
+    {
+      for (const auto &h : headers)
+      {
+        if (iequals(h.name, name))
+        {
+          return h.value;
+        }
+      }
+      return {};
+    }
+
+    bool parse_decimal(std::string_view s, std::uint64_t &out) noexcept
+    {
+      if (s.empty() || s.size() > 19)
+      {
+        return false;
+      }
+      std::uint64_t v = 0;
+      for (const char c : s)
+      {
+        if (c < '0' || c > '9')
+        {
+          return false;
+        }
+        v = v * 10 + static_cast<std::uint64_t>(c - '0');
+      }
+      out = v;
+      return true;
+    }
+
+    /**
+     * @brief Content-Length of a message; every occurrence must agree.
+     *
+     * @return false if malformed; present is set when at least one was found.
+     */
+    bool content_length(const std::vector<header_field> &headers, bool &present, std::uint64_t &length) noexcept
+    {
+      present = false;
+      for (const auto &h : headers)
+      {
+        if (!iequals(h.name, "content-length"))
+        {
+          continue;
+        }
+
+        std::uint64_t v = 0;
+        if (!parse_decimal(h.value, v) || (present && v != length))
+        {
+          return false;
+        }
+        present = true;
+        length = v;
+      }
+      return true;
+    }
+
+    /**
+     * @brief Whether the last transfer coding of a message is chunked.
+     */
+    bool last_coding_is_chunked(std::string_view te) noexcept
+    {
+      const std::size_t comma = te.rfind(',');
+      const std::string_view last = trim(comma == std::string_view::npos ? te : te.substr(comma + 1));
+      return iequals(last, "chunked");
+    }
+
+    template <typename Head>
+    bool connection_keep_alive(const Head &head) noexcept
+    {
+      const std::string_view conn = head.header("connection");
+      if (head.version_minor >= 1)
+      {
+        return !has_token(conn, "close");
+      }
+      return has_token(conn, "keep-alive");
+    }
+
+    template <typename Head, typename ParseHead>
+    parse_result parse_buffer(std::string_view buf, Head &out, ParseHead parse_head)
+    {
+      // Leading empty lines do not start the head; skip them before looking
+      // for the blank line that ends it.
+      std::size_t skip = 0;
+      while (buf.substr(skip).starts_with(crlf))
+      {
+        skip += crlf.size();
+      }
+
+      const std::size_t pos = detail::find(buf, head_end, skip);
+      if (pos == std::string_view::npos)
+      {
+        return {parse_status::incomplete, 0};
+      }
+
+      if (!parse_head(buf.substr(skip, pos - skip), out))
+      {
+        return {parse_status::invalid, 0};
+      }
+      return {parse_status::complete, pos + head_end.size()};
+    }
+  } // namespace
+
+  std::string_view request_head::header(std::string_view name) const noexcept
+  {
+    return find_header(headers, name);
+  }
+
+  std::string_view response_head::header(std::string_view name) const noexcept
+  {
+    return find_header(headers, name);
+  }
+
+  bool iequals(std::string_view a, std::string_view b) noexcept
+  {
+    if (a.size() != b.size())
+    {
+      return false;
+    }
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+      if (lower(a[i]) != lower(b[i]))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool has_token(std::string_view list, std::string_view token) noexcept
+  {
+    while (!list.empty())
+    {
+      const std::size_t comma = list.find(',');
+      const std::string_view item = trim(list.substr(0, comma));
+      if (iequals(item, token))
+      {
+        return true;
+      }
+      if (comma == std::string_view::npos)
+      {
+        break;
+      }
+      list.remove_prefix(comma + 1);
+    }
+    return false;
+  }
+
+  bool parse_request_head(std::string_view head, request_head &out)
+  {
+    std::string_view rest = skip_empty_lines(head);
+    const std::string_view line = next_line(rest);
+
+    const std::size_t sp1 = line.find(' ');
+    const std::size_t sp2 = sp1 == std::string_view::npos ? sp1 : line.find(' ', sp1 + 1);
+    if (sp2 == std::string_view::npos)
+    {
+      return false;
+    }
+
+    out.method = line.substr(0, sp1);
+    out.target = line.substr(sp1 + 1, sp2 - sp1 - 1);
+    if (!is_token(out.method) || !is_target(out.target) ||
+        !parse_version(line.substr(sp2 + 1), out.version_minor))
+    {
+      return false;
+    }
+
+    return parse_fields(rest, out.headers);
+  }
+
+  bool parse_response_head(std::string_view head, response_head &out)
+  {
+    std::string_view rest = skip_empty_lines(head);
+    const std::string_view line = next_line(rest);
+
+    // "HTTP/1.1 200 OK"; the space and reason after the code are optional.
+    if (line.size() < 12 || line[8] != ' ' || !parse_version(line.substr(0, 8), out.version_minor))
+    {
+      return false;
+    }
+
+    int status = 0;
+    for (std::size_t i = 9; i < 12; ++i)
+    {
+      if (line[i] < '0' || line[i] > '9')
+      {
+        return false;
+      }
+      status = status * 10 + (line[i] - '0');
+    }
+    if (status < 100 || (line.size() > 12 && line[12] != ' '))
+    {
+      return false;
+    }
+
+    out.status = status;
+    out.reason = line.size() > 13 ? line.substr(13) : std::string_view{};
+    if (!is_field_text(out.reason))
+    {
+      return false;
+    }
+
+    return parse_fields(rest, out.headers);
+  }
+
+  parse_result parse_request(std::string_view buf, request_head &out)
+  {
+    return parse_buffer(buf, out, [](std::string_view h, request_head &o)
+                        { return parse_request_head(h, o); });
+  }
+
+  parse_result parse_response(std::string_view buf, response_head &out)
+  {
+    return parse_buffer(buf, out, [](std::string_view h, response_head &o)
+                        { return parse_response_head(h, o); });
+  }
+
+  std::optional<body_framing> request_body(const request_head &head)
+  {
+    bool has_length = false;
+    std::uint64_t length = 0;
+    if (!content_length(head.headers, has_length, length))
+    {
+      return std::nullopt;
+    }
+
+    const std::string_view te = head.header("transfer-encoding");
+    if (!te.empty())
+    {
+      // Both headers, or a final coding other than chunked, leave the
+      // body length ambiguous: refuse rather than guess.
+      if (has_length || !last_coding_is_chunked(te))
+      {
+        return std::nullopt;
+      }
+      return body_framing{body_kind::chunked, 0};
+    }
+
+    if (has_length && length > 0)
+    {
+      return body_framing{body_kind::length, length};
+    }
+    return body_framing{};
+  }
+
+  std::optional<body_framing> response_body(
+      const response_head &head,
+      std::string_view request_method)
+  {
+    if (request_method == "HEAD" || head.status < 200 || head.status == 204 || head.status == 304)
+    {
+      return body_framing{};
+    }
+
+    const std::string_view te = head.header("transfer-encoding");
+    if (!te.empty())
+    {
+      if (last_coding_is_chunked(te))
+      {
+        return body_framing{body_kind::chunked, 0};
+      }
+      return body_framing{body_kind::until_close, 0};
+    }
+
+    bool has_length = false;
+    std::uint64_t length = 0;
+    if (!content_length(head.headers, has_length, length))
+    {
+      return std::nullopt;
+    }
+    if (has_length)
+    {
+      return length > 0 ? body_framing{body_kind::length, length} : body_framing{};
+    }
+    return body_framing{body_kind::until_close, 0};
+  }
+
+  bool keep_alive(const request_head &head) noexcept
+  {
+    return connection_keep_alive(head);
+  }
+
+  bool keep_alive(const response_head &head) noexcept
+  {
+    return connection_keep_alive(head);
+  }
+
+  std::string_view reason_phrase(int status) noexcept
+  {
+    switch (status)
+    {
+    case 100:
+      return "Continue";
+    case 101:
+      return "Switching Protocols";
+    case 200:
+      return "OK";
+    case 201:
+      return "Created";
+    case 202:
+      return "Accepted";
+    case 204:
+      return "No Content";
+    case 206:
+      return "Partial Content";
+    case 301:
+      return "Moved Permanently";
+    case 302:
+      return "Found";
+    case 303:
+      return "See Other";
+    case 304:
+      return "Not Modified";
+    case 307:
+      return "Temporary Redirect";
+    case 308:
+      return "Permanent Redirect";
+    case 400:
+      return "Bad Request";
+    case 401:
+      return "Unauthorized";
+    case 403:
+      return "Forbidden";
+    case 404:
+      return "Not Found";
+    case 405:
+      return "Method Not Allowed";
+    case 408:
+      return "Request Timeout";
+    case 409:
+      return "Conflict";
+    case 411:
+      return "Length Required";
+    case 413:
+      return "Content Too Large";
+    case 414:
+      return "URI Too Long";
+    case 415:
+      return "Unsupported Media Type";
+    case 429:
+      return "Too Many Requests";
+    case 431:
+      return "Request Header Fields Too Large";
+    case 500:
+      return "Internal Server Error";
+    case 501:
+      return "Not Implemented";
+    case 502:
+      return "Bad Gateway";
+    case 503:
+      return "Service Unavailable";
+    case 504:
+      return "Gateway Timeout";
+    default:
+      return "Unknown";
+    }
+  }
+
+} // namespace vix::async::http
@@ -0,0 +1,708 @@
+/**
+ *
+ *  @file server.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/async/http/server.hpp>
+
+#include <vix/async/core/io_context.hpp>
+#include <vix/async/core/spawn.hpp>
+#include <vix/async/core/timer.hpp>
+#include <vix/async/detail/platform.hpp>
+#include <vix/async/detail/scan.hpp>
+#include <vix/async/net/buffer_pool.hpp>
+#include <vix/async/net/framing.hpp>
+
+#include "body_io.hpp"
+
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+#if ASYNC_PLATFORM_UNIX
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#endif
+
+namespace vix::async::http
+{
+  struct server::state
+  {
+    core::io_context &ctx;
+    handler on_request;
+    server_options opts;
+    net::buffer_pool pool;
+    std::atomic<std::size_t> active{0};
+
+    state(core::io_context &c, handler h, server_options o)
+        : ctx(c),
+          on_request(std::move(h)),
+          opts(o)
+    {
+    }
+  };
+
+  namespace detail
+  {
+    namespace
+    {
+      constexpr std::string_view crlf = "\r\n";
+      constexpr std::string_view head_end = "\r\n\r\n";
+
+      void append_number(std::string &out, std::uint64_t v)
+      {
+        std::array<char, 24> buf;
+        const auto r = std::to_chars(buf.data(), buf.data() + buf.size(), v);
+        out.append(buf.data(), r.ptr);
+      }
+
+      void append_hex(std::string &out, std::uint64_t v)
+      {
+        std::array<char, 24> buf;
+        const auto r = std::to_chars(buf.data(), buf.data() + buf.size(), v, 16);
+        out.append(buf.data(), r.ptr);
+      }
+
+      void set_nodelay(net::tcp_stream &s) noexcept
+      {
+#if ASYNC_PLATFORM_UNIX
+        try
+        {
+          const int one = 1;
+          ::setsockopt(s.native_handle(), IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        }
+        catch (...)
+        {
+        }
+#else
+        (void)s;
+#endif
+      }
+
+      /**
+       * @brief Read deadline of one connection.
+       *
+       * Arming only stores an expiry time. A single timer entry per
+       * connection checks it when due and schedules itself again if the
+       * deadline moved, so keep-alive requests re-arm with a clock read
+       * and two atomic operations instead of a timer entry each.
+       *
+       * On expiry the socket is shut down: pending reads then complete as
+       * if the peer had closed, which ends the connection. The connection
+       * calls close() before closing the socket, so a late check never
+       * touches a reused descriptor. Unix only; elsewhere the deadline is
+       * not enforced.
+       */
+      class read_deadline : public std::enable_shared_from_this<read_deadline>
+      {
+      public:
+        read_deadline(core::timer &t, int fd) noexcept
+            : timer_(t),
+              fd_(fd)
+        {
+        }
+
+        /**
+         * @brief Expire d from now, replacing any earlier deadline; zero
+         * leaves the deadline disarmed.
+         */
+        void arm(std::chrono::milliseconds d)
+        {
+          if (d.count() <= 0 || fd_ < 0)
+          {
+            return;
+          }
+
+          const core::timer::time_point at = timer_.now() + d;
+          expires_.store(at.time_since_epoch().count());
+          if (!pending_.exchange(true))
+          {
+            schedule(at);
+          }
+        }
+
+        void disarm() noexcept
+        {
+          expires_.store(0);
+        }
+
+        /**
+         * @brief Disarm for good; the socket is about to be closed.
+         */
+        void close() noexcept
+        {
+          disarm();
+          std::lock_guard<std::mutex> lock(m_);
+          fd_ = -1;
+        }
+
+      private:
+        void schedule(core::timer::time_point at)
+        {
+          timer_.after(
+              at - timer_.now(),
+              [self = shared_from_this()]()
+              {
+                self->check();
+              });
+        }
+
+        void check()
+        {
+          // Clear pending before reading the expiry: an arm() racing with
+          // this check either is seen here or schedules its own entry.
+          pending_.store(false);
+          const auto expires = expires_.load();
+          if (expires == 0)
+          {
+            return;
+          }
+
+          const core::timer::time_point at{core::timer::duration(expires)};
+          if (at > timer_.now())
+          {
+            if (!pending_.exchange(true))
+            {
+              schedule(at);
+            }
+            return;
+          }
+
+#if ASYNC_PLATFORM_UNIX
+          std::lock_guard<std::mutex> lock(m_);
+          if (fd_ >= 0)
+          {
+            ::shutdown(fd_, SHUT_RDWR);
+          }
+#endif
+        }
+
+        core::timer &timer_;
+
+        /** @brief Guards fd_ against close() while check() uses it. */
+        std::mutex m_;
+        int fd_;
+
+        /** @brief Expiry in timer clock ticks; 0 while disarmed. */
+        std::atomic<core::timer::duration::rep> expires_{0};
+
+        /** @brief Whether a timer entry for check() is outstanding. */
+        std::atomic<bool> pending_{false};
+      };
+    } // namespace
+
+    /**
+     * @brief One served connection.
+     */
+    class connection
+    {
+    public:
+      connection(std::shared_ptr<server::state> st, std::unique_ptr<net::tcp_stream> stream)
+          : st_(std::move(st)),
+            stream_(std::move(stream)),
+            in_(*stream_, st_->pool)
+      {
+        st_->active.fetch_add(1, std::memory_order_relaxed);
+        int fd = -1;
+#if ASYNC_PLATFORM_UNIX
+        try
+        {
+          fd = stream_->native_handle();
+        }
+        catch (...)
+        {
+        }
+#endif
+        deadline_ = std::make_shared<read_deadline>(st_->ctx.timers(), fd);
+      }
+
+      ~connection()
+      {
+        deadline_->close();
+        stream_->close();
+        st_->active.fetch_sub(1, std::memory_order_relaxed);
+      }
+
+      connection(const connection &) = delete;
+      connection &operator=(const connection &) = delete;
+
+      /**
+       * @brief Refuse the connection without reading a request.
+       */
+      core::task<void> shed(core::cancel_token ct)
+      {
+        co_await send_error(503, std::move(ct));
+      }
+
+      core::task<void> run(core::cancel_token ct)
+      {
+        if (st_->opts.nodelay)
+        {
+          set_nodelay(*stream_);
+        }
+
+        net::delimited_reader heads(in_, std::string(head_end), st_->opts.max_head_size);
+
+        for (;;)
+        {
+          std::optional<std::span<const std::byte>> head;
+          int error_status = 0;
+          try
+          {
+            // Pipelined heads that are already buffered need no deadline.
+            if (async::detail::find(as_text(in_.buffered()), head_end) == std::string_view::npos)
+            {
+              deadline_->arm(st_->opts.header_timeout);
+            }
+            head = co_await heads.async_read_frame(ct);
+            deadline_->disarm();
+          }
+          catch (const std::system_error &e)
+          {
+            deadline_->disarm();
+            if (e.code() != core::make_error_code(core::errc::overflow))
+            {
+              throw;
+            }
+            error_status = 431;
+          }
+
+          if (error_status == 0 && head)
+          {
+            error_status = co_await read_request(as_text(*head), ct);
+          }
+          if (error_status != 0)
+          {
+            co_await send_error(error_status, ct);
+            co_return;
+          }
+          if (!head)
+          {
+            break;
+          }
+
+          co_await respond(ct);
+
+          if (!keep_alive_)
+          {
+            break;
+          }
+
+          // Batch the responses to requests that are already here.
+          if (out_.size() >= st_->opts.flush_threshold ||
+              async::detail::find(as_text(in_.buffered()), head_end) == std::string_view::npos)
+          {
+            co_await flush(ct);
+          }
+        }
+
+        co_await flush(ct);
+      }
+
+      core::task<void> write_chunk(response &res, std::string_view data, core::cancel_token ct)
+      {
+        if (!res.streaming_)
+        {
+          res.streaming_ = true;
+
+          // HTTP/1.0 has no chunked encoding: stream raw and close.
+          chunked_ = req_.head.version_minor >= 1;
+          if (!chunked_)
+          {
+            keep_alive_ = false;
+          }
+          append_head(res.status, res.headers, chunked_ ? "Transfer-Encoding: chunked\r\n" : std::string_view{}, std::nullopt);
+
+          if (!res.body.empty())
+          {
+            const std::string first = std::move(res.body);
+            res.body.clear();
+            co_await send_chunk(first, ct);
+          }
+        }
+
+        co_await send_chunk(data, ct);
+      }
+
+    private:
+      /**
+       * @brief Parse the head and read the body of the current request.
+       *
+       * @return 0, or the status of the error response to send.
+       */
+      core::task<int> read_request(std::string_view head, core::cancel_token ct)
+      {
+        if (!parse_request_head(head, req_.head))
+        {
+          co_return 400;
+        }
+
+        const auto framing = request_body(req_.head);
+        if (!framing)
+        {
+          co_return 400;
+        }
+
+        req_.keep_alive = keep_alive(req_.head);
+        req_.body = {};
+
+        if (framing->kind == body_kind::none)
+        {
+          co_return 0;
+        }
+
+        if (framing->kind == body_kind::length && framing->length > st_->opts.max_body_size)
+        {
+          co_return 413;
+        }
+
+        const auto length = static_cast<std::size_t>(framing->length);
+        if (framing->kind == body_kind::length && in_.buffered().size() >= length)
+        {
+          // Common case: the whole body arrived with the head.
+          req_.body = as_text(in_.buffered().first(length));
+          in_.consume(length);
+          co_return 0;
+        }
+
+        // Reading more may move the buffered head: keep a copy of it.
+        head_copy_.assign(head);
+        (void)parse_request_head(head_copy_, req_.head);
+
+        if (has_token(req_.head.header("expect"), "100-continue") && req_.head.version_minor >= 1)
+        {
+          out_.append("HTTP/1.1 100 Continue\r\n\r\n");
+          co_await flush(ct);
+        }
+
+        if (framing->kind == body_kind::length)
+        {
+          if (!co_await in_.async_fill(length, ct))
+          {
+            throw std::system_error(core::make_error_code(core::errc::closed));
+          }
+          req_.body = as_text(in_.buffered().first(length));
+          in_.consume(length);
+          co_return 0;
+        }
+
+        int status = 0;
+        body_.clear();
+        try
+        {
+          co_await read_chunked_body(in_, body_, st_->opts.max_body_size, ct);
+        }
+        catch (const std::system_error &e)
+        {
+          if (e.code() == core::make_error_code(core::errc::overflow))
+          {
+            status = 413;
+          }
+          else if (e.code() == core::make_error_code(core::errc::invalid_argument))
+          {
+            status = 400;
+          }
+          else
+          {
+            throw;
+          }
+        }
+        req_.body = body_;
+        co_return status;
+      }
+
+      core::task<void> respond(core::cancel_token ct)
+      {
+        res_.status = 200;
+        res_.headers.clear();
+        res_.body.clear();
+        res_.conn_ = this;
+        res_.streaming_ = false;
+
+        keep_alive_ = req_.keep_alive;
+        head_only_ = req_.head.method == "HEAD";
+
+        bool failed = false;
+        try
+        {
+          co_await st_->on_request(req_, res_);
+        }
+        catch (...)
+        {
+          failed = true;
+        }
+
+        if (failed)
+        {
+          keep_alive_ = false;
+          if (!res_.streaming_)
+          {
+            res_.status = 500;
+            res_.headers.clear();
+            res_.body.clear();
+            append_head(500, res_.headers, {}, 0);
+          }
+          co_return;
+        }
+
+        if (res_.streaming_)
+        {
+          if (chunked_ && !head_only_)
+          {
+            out_.append("0\r\n\r\n");
+          }
+          co_return;
+        }
+
+        append_head(res_.status, res_.headers, {}, res_.body.size());
+        if (head_only_)
+        {
+          co_return;
+        }
+
+        if (res_.body.size() >= st_->opts.flush_threshold)
+        {
+          // Large bodies go out straight from the response, not copied.
+          const std::array<std::span<const std::byte>, 2> parts{as_bytes(out_), as_bytes(res_.body)};
+          (void)co_await stream_->async_write_v(parts, ct);
+          out_.clear();
+          co_return;
+        }
+
+        out_.append(res_.body);
+      }
+
+      /**
+       * @brief Serialize a status line and header block into out_.
+       *
+       * @param extra Preformatted header lines added by the server.
+       * @param content_length Content-Length to announce, if any.
+       */
+      void append_head(
+          int status,
+          const std::vector<std::pair<std::string, std::string>> &headers,
+          std::string_view extra,
+          std::optional<std::size_t> content_length)
+      {
+        out_.append("HTTP/1.1 ");
+        append_number(out_, static_cast<std::uint64_t>(status));
+        out_.push_back(' ');
+        out_.append(reason_phrase(status));
+        out_.append(crlf);
+
+        for (const auto &[name, value] : headers)
+        {
+          out_.append(name);
+          out_.append(": ");
+          out_.append(value);
+          out_.append(crlf);
+        }
+
+        out_.append(extra);
+        if (content_length)
+        {
+          out_.append("Content-Length: ");
+          append_number(out_, *content_length);
+          out_.append(crlf);
+        }
+
+        if (!keep_alive_)
+        {
+          out_.append("Connection: close\r\n");
+        }
+        else if (req_.head.version_minor == 0)
+        {
+          out_.append("Connection: keep-alive\r\n");
+        }
+        out_.append(crlf);
+      }
+
+      core::task<void> send_chunk(std::string_view data, core::cancel_token ct)
+      {
+        if (data.empty() || head_only_)
+        {
+          co_return;
+        }
+
+        if (chunked_)
+        {
+          append_hex(out_, data.size());
+          out_.append(crlf);
+        }
+
+        const std::array<std::span<const std::byte>, 3> parts{
+            as_bytes(out_),
+            as_bytes(data),
+            as_bytes(chunked_ ? crlf : std::string_view{})};
+        (void)co_await stream_->async_write_v(parts, ct);
+        out_.clear();
+      }
+
+      core::task<void> send_error(int status, core::cancel_token ct)
+      {
+        keep_alive_ = false;
+        append_head(status, {}, {}, 0);
+        co_await flush(ct);
+        co_await linger(ct);
+      }
+
+      /**
+       * @brief Half-close and drain what the peer still sends.
+       *
+       * Closing with unread request bytes resets the connection, which can
+       * discard the error response before the peer reads it. Bounded by
+       * server_options::linger_timeout so a silent peer cannot hold the
+       * connection.
+       */
+      core::task<void> linger(core::cancel_token ct)
+      {
+        std::array<std::byte, 4096> sink;
+        std::size_t drained = 0;
+        deadline_->arm(st_->opts.linger_timeout);
+        try
+        {
+#if ASYNC_PLATFORM_UNIX
+          ::shutdown(stream_->native_handle(), SHUT_WR);
+#endif
+          while (drained < 4 * st_->opts.max_head_size)
+          {
+            const std::size_t n = co_await stream_->async_read(sink, ct);
+            if (n == 0)
+            {
+              break;
+            }
+            drained += n;
+          }
+        }
+        catch (const std::system_error &)
+        {
+        }
+      }
+
+      core::task<void> flush(core::cancel_token ct)
+      {
+        if (out_.empty())
+        {
+          co_return;
+        }
+        (void)co_await stream_->async_write(as_bytes(out_), ct);
+        out_.clear();
+      }
+
+      std::shared_ptr<server::state> st_;
+      std::unique_ptr<net::tcp_stream> stream_;
+      net::buffered_reader in_;
+
+      /** @brief Header and linger deadline, shared with its timer entry. */
+      std::shared_ptr<read_deadline> deadline_;
+
+      /** @brief Pending response bytes. */
+      std::string out_;
+
+      /** @brief Copy of the current head when the body had to be read. */
+      std::string head_copy_;
+
+      /** @brief Decoded chunked request body. */
+      std::string body_;
+
+      request req_;
+      response res_;
+      bool keep_alive_{true};
+      bool head_only_{false};
+      bool chunked_{true};
+    };
+  } // namespace detail
+
+  core::task<void> server::serve(
+      std::shared_ptr<state> st,
+      std::unique_ptr<net::tcp_stream> stream,
+      core::cancel_token ct,
+      bool shed)
+  {
+    auto conn = std::make_unique<detail::connection>(std::move(st), std::move(stream));
+    try
+    {
+      if (shed)
+      {
+        co_await conn->shed(std::move(ct));
+      }
+      else
+      {
+        co_await conn->run(std::move(ct));
+      }
+    }
+    catch (...)
+    {
+      // Peer resets, cancellation and truncated requests end the connection.
+    }
+  }
+
+  core::task<void> response::async_write_chunk(std::string_view data, core::cancel_token ct)
+  {
+    if (!conn_)
+    {
+      throw std::system_error(core::make_error_code(core::errc::closed));
+    }
+    co_await conn_->write_chunk(*this, data, std::move(ct));
+  }
+
+  server::server(core::io_context &ctx, handler h, server_options opts)
+      : state_(std::make_shared<state>(ctx, std::move(h), opts))
+  {
+  }
+
+  server::~server() = default;
+
+  core::task<void> server::async_serve(net::tcp_listener &listener, core::cancel_token ct)
+  {
+    while (listener.is_open())
+    {
+      std::unique_ptr<net::tcp_stream> stream;
+      try
+      {
+        stream = co_await listener.async_accept(ct);
+      }
+      catch (const std::system_error &e)
+      {
+        if (!listener.is_open() && !ct.is_cancelled())
+        {
+          co_return;
+        }
+        if (e.code() != std::errc::connection_aborted)
+        {
+          throw;
+        }
+        continue;
+      }
+
+      const bool shed = state_->opts.shed_when_overloaded && !state_->ctx.get_scheduler().try_admit();
+      core::spawn_detached(state_->ctx, serve(state_, std::move(stream), ct, shed));
+    }
+  }
+
+  core::task<void> server::async_serve_connection(
+      std::unique_ptr<net::tcp_stream> stream,
+      core::cancel_token ct)
+  {
+    co_await serve(state_, std::move(stream), std::move(ct));
+  }
+
+  std::size_t server::active_connections() const noexcept
+  {
+    return state_->active.load(std::memory_order_relaxed);
+  }
+
+} // namespace vix::async::http
@@ -14,8 +14,13 @@
 #ifndef VIX_ASYNC_ASIO_AWAIT_HPP
 #define VIX_ASYNC_ASIO_AWAIT_HPP
 
+#include <atomic>
 #include <coroutine>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
+#include <memory>
+#include <new>
 #include <optional>
 #include <system_error>
 #include <type_traits>
@@ -23,7 +28,10 @@
 
 #include <vix/async/core/cancel.hpp>
 #include <vix/async/core/error.hpp>
+#include <vix/async/core/executor.hpp>
 #include <vix/async/core/io_context.hpp>
+#include <vix/async/core/metrics.hpp>
+#include <vix/async/detail/config.hpp>
 
 namespace vix::async::net::detail
 {
@@ -72,21 +80,178 @@ namespace vix::async::net::detail
   }
 
   /**
-   * @brief Resume a coroutine through the owning Vix async scheduler fast path.
+   * @brief Count one completed Asio operation in the context metrics.
    *
    * @param ctx Owning io_context.
-   * @param h Coroutine handle to resume.
+   * @param ec Completion error code.
+   * @param started_ns Start time of the operation (0 when histograms are disabled).
    */
-  inline void resume_on_ctx(
+  inline void note_completion(
       vix::async::core::io_context *ctx,
-      std::coroutine_handle<> h) noexcept
+      const std::error_code &ec,
+      std::uint64_t started_ns) noexcept
   {
-    if (!ctx || !h)
+#if ASYNC_ENABLE_METRICS
+    if (!ctx)
     {
       return;
     }
 
-    ctx->post(h);
+    auto &net = ctx->runtime_counters().net;
+    net.completions.fetch_add(1, std::memory_order_relaxed);
+    if (ec)
+    {
+      net.errors.fetch_add(1, std::memory_order_relaxed);
+    }
+#else
+    (void)ctx;
+    (void)ec;
+#endif
+
+#if ASYNC_ENABLE_HISTOGRAMS
+    if (ctx)
+    {
+      const std::uint64_t now = vix::async::core::detail::metrics_now_ns();
+      ctx->runtime_counters().net.op_latency.record(now > started_ns ? now - started_ns : 0);
+    }
+#else
+    (void)started_ns;
+#endif
+  }
+
+  /**
+   * @brief Memory for the state of one outstanding Asio operation.
+   *
+   * Asio's default allocator recycles through a per-thread cache, but our
+   * operations are started on the scheduler thread and freed on the net
+   * thread, so that cache never hits. A slot owned by the socket does not
+   * care which thread frees it. When the slot is busy (two operations in
+   * the same direction) or too small, the heap is used instead.
+   *
+   * Sockets hold their slots through shared_ptr and so do the handlers
+   * allocated from them: an operation destroyed by the Asio context after
+   * its socket is gone still has somewhere to return its memory.
+   */
+  class handler_memory
+  {
+  public:
+    handler_memory() = default;
+    handler_memory(const handler_memory &) = delete;
+    handler_memory &operator=(const handler_memory &) = delete;
+
+    void *allocate(std::size_t n)
+    {
+      if (n <= sizeof(storage_) && !in_use_.exchange(true, std::memory_order_acquire))
+      {
+        return storage_;
+      }
+      return ::operator new(n);
+    }
+
+    void deallocate(void *p) noexcept
+    {
+      if (p == storage_)
+      {
+        in_use_.store(false, std::memory_order_release);
+        return;
+      }
+      ::operator delete(p);
+    }
+
+  private:
+    alignas(std::max_align_t) unsigned char storage_[ASYNC_NET_HANDLER_MEMORY];
+    std::atomic<bool> in_use_{false};
+  };
+
+  /**
+   * @brief Allocator handing out a handler_memory slot.
+   */
+  template <typename T>
+  class handler_allocator
+  {
+  public:
+    using value_type = T;
+
+    explicit handler_allocator(std::shared_ptr<handler_memory> mem) noexcept
+        : mem_(std::move(mem))
+    {
+    }
+
+    template <typename U>
+    handler_allocator(const handler_allocator<U> &other) noexcept
+        : mem_(other.mem_)
+    {
+    }
+
+    T *allocate(std::size_t n)
+    {
+      return static_cast<T *>(mem_->allocate(sizeof(T) * n));
+    }
+
+    void deallocate(T *p, std::size_t) noexcept
+    {
+      mem_->deallocate(p);
+    }
+
+    template <typename U>
+    bool operator==(const handler_allocator<U> &other) const noexcept
+    {
+      return mem_ == other.mem_;
+    }
+
+  private:
+    template <typename>
+    friend class handler_allocator;
+
+    std::shared_ptr<handler_memory> mem_;
+  };
+
+  /**
+   * @brief Completion handler whose associated allocator is a handler_memory.
+   *
+   * @tparam Handler Wrapped completion handler.
+   */
+  template <typename Handler>
+  class memory_bound_handler
+  {
+  public:
+    using allocator_type = handler_allocator<std::byte>;
+
+    memory_bound_handler(const std::shared_ptr<handler_memory> &mem, Handler h)
+        : alloc_(mem),
+          handler_(std::move(h))
+    {
+    }
+
+    allocator_type get_allocator() const noexcept
+    {
+      return alloc_;
+    }
+
+    template <typename... Args>
+    void operator()(Args &&...args)
+    {
+      handler_(std::forward<Args>(args)...);
+    }
+
+  private:
+    allocator_type alloc_;
+    Handler handler_;
+  };
+
+  /**
+   * @brief Allocate the state of the operation completing with h from mem.
+   *
+   * @param mem Slot owned by the socket.
+   * @param h Completion handler.
+   * @return Handler to pass to the Asio initiating function.
+   */
+  template <typename Handler>
+  memory_bound_handler<std::decay_t<Handler>> bind_memory(
+      const std::shared_ptr<handler_memory> &mem,
+      Handler &&h)
+  {
+    return memory_bound_handler<std::decay_t<Handler>>(mem, std::forward<Handler>(h));
   }
 
   /**
@@ -98,7 +263,8 @@ namespace vix::async::net::detail
    *
    * Behavior:
    * - captures completion result or exception
-   * - resumes awaiting coroutine through io_context fast coroutine path
+   * - resumes the awaiting coroutine on the executor it awaited from
+   *   (the io_context scheduler when it has none)
    * - checks cancellation before and after suspension
    *
    * @tparam Starter Callable that starts the underlying Asio operation.
@@ -132,6 +298,21 @@ namespace vix::async::net::detail
      */
     std::exception_ptr ex{};
 
+    /**
+     * @brief Start time of the operation (0 when histograms are disabled).
+     */
+    std::uint64_t started_ns{0};
+
+    /**
+     * @brief Executor resuming the awaiting coroutine.
+     */
+    vix::async::core::executor exec{};
+
+    /**
+     * @brief Suspension label reported by tracing and the task registry.
+     */
+    static constexpr const char *awaiting_label() noexcept { return "net i/o"; }
+
     /**
      * @brief Always suspend to let Asio complete asynchronously.
      *
@@ -146,15 +327,21 @@ namespace vix::async::net::detail
      * @brief Start the Asio operation and arrange coroutine resumption.
      *
      * @param h Awaiting coroutine handle.
+     * @return false to resume at once (cancelled, or the start threw).
      */
-    void await_suspend(std::coroutine_handle<> h)
+    bool await_suspend(std::coroutine_handle<> h)
     {
       if (ct.is_cancelled())
       {
-        resume_on_ctx(ctx, h);
-        return;
+        return false;
       }
 
+      exec = vix::async::core::detail::resume_executor(ctx->get_scheduler().get_executor());
+
+#if ASYNC_ENABLE_HISTOGRAMS
+      started_ns = vix::async::core::detail::metrics_now_ns();
+#endif
+
       try
       {
         if constexpr (std::is_void_v<T>)
@@ -163,7 +350,8 @@ namespace vix::async::net::detail
               [this, h](std::error_code ec) mutable
               {
                 res.ec = ec;
-                resume_on_ctx(ctx, h);
+                note_completion(ctx, ec, started_ns);
+                exec.post(h);
               });
         }
         else
@@ -172,21 +360,24 @@ namespace vix::async::net::detail
               [this, h](std::error_code ec, T value) mutable
               {
                 res.ec = ec;
+                note_completion(ctx, ec, started_ns);
 
                 if (!ec)
                 {
                   res.value.emplace(std::move(value));
                 }
 
-                resume_on_ctx(ctx, h);
+                exec.post(h);
               });
         }
       }
       catch (...)
       {
         ex = std::current_exception();
-        resume_on_ctx(ctx, h);
+        return false;
       }
+
+      return true;
     }
 
     /**
@@ -224,6 +415,33 @@ namespace vix::async::net::detail
     }
   };
 
+  /**
+   * @brief Awaitable for one Asio operation.
+   *
+   * Awaited directly from the I/O method, so an operation costs that
+   * method's coroutine frame and nothing more. Bind the result to a named
+   * local before co_await: GCC 12 destroys a braced temporary in a
+   * co_await expression twice.
+   *
+   * @code
+   * auto op = detail::asio_op<std::size_t>(ctx_, ct, [&](auto done) { ... });
+   * co_return co_await op;
+   * @endcode
+   *
+   * @tparam T Result type of the operation.
+   * @param ctx Owning io_context.
+   * @param ct Cancellation token.
+   * @param starter Starts the Asio operation with the completion callback.
+   */
+  template <typename T, typename Starter>
+  asio_awaitable<std::decay_t<Starter>, T> asio_op(
+      vix::async::core::io_context &ctx,
+      vix::async::core::cancel_token ct,
+      Starter &&starter)
+  {
+    return {&ctx, std::move(ct), std::forward<Starter>(starter)};
+  }
+
 } // namespace vix::async::net::detail
 
 #endif // VIX_ASYNC_ASIO_AWAIT_HPP
@@ -14,7 +14,7 @@
 #include <vix/async/net/dns.hpp>
 #include <vix/async/core/io_context.hpp>
 
-#include "asio_net_service.hpp"
+#include <vix/async/net/asio_net_service.hpp>
 #include "asio_await.hpp"
 
 #if defined(__GNUC__) || defined(__clang__)
@@ -36,33 +36,6 @@
 
 namespace vix::async::net
 {
-  namespace detail
-  {
-    template <typename Starter>
-    inline vix::async::core::task<void> co_asio_void(
-        core::io_context &ctx,
-        core::cancel_token ct,
-        Starter &&starter)
-    {
-      co_await asio_awaitable<std::decay_t<Starter>, void>{
-          &ctx,
-          std::move(ct),
-          std::forward<Starter>(starter)};
-    }
-
-    template <typename T, typename Starter>
-    inline vix::async::core::task<T> co_asio_value(
-        core::io_context &ctx,
-        core::cancel_token ct,
-        Starter &&starter)
-    {
-      co_return co_await asio_awaitable<std::decay_t<Starter>, T>{
-          &ctx,
-          std::move(ct),
-          std::forward<Starter>(starter)};
-    }
-  } // namespace detail
-
   class dns_resolver_asio final : public dns_resolver
   {
   public:
@@ -77,22 +50,24 @@ namespace vix::async::net
         std::uint16_t port,
         core::cancel_token ct) override
     {
-      const auto results =
-          co_await detail::co_asio_value<asio::ip::tcp::resolver::results_type>(
-              ctx_,
-              ct,
-              [&](auto done)
-              {
-                res_.async_resolve(
-                    host,
-                    std::to_string(port),
+      auto op = detail::asio_op<asio::ip::tcp::resolver::results_type>(
+          ctx_,
+          ct,
+          [&](auto done)
+          {
+            res_.async_resolve(
+                host,
+                std::to_string(port),
+                detail::bind_memory(
+                    mem_,
                     [done = std::move(done)](
                         std::error_code ec,
                         asio::ip::tcp::resolver::results_type r) mutable
                     {
                       done(ec, std::move(r));
-                    });
-              });
+                    }));
+          });
+      const auto results = co_await op;
 
       std::vector<resolved_address> out;
       out.reserve(results.size());
@@ -111,6 +86,7 @@ namespace vix::async::net
   private:
     core::io_context &ctx_;
     asio::ip::tcp::resolver res_;
+    std::shared_ptr<detail::handler_memory> mem_{std::make_shared<detail::handler_memory>()};
   };
 
   std::unique_ptr<dns_resolver> make_dns_resolver(core::io_context &ctx)
@@ -13,14 +13,15 @@
  *  Vix.cpp
  *
  */
-#include "asio_net_service.hpp"
+#include <vix/async/net/asio_net_service.hpp>
 
 #include <vix/async/core/io_context.hpp>
 
 namespace vix::async::net::detail
 {
 
-  asio_net_service::asio_net_service(vix::async::core::io_context &)
+  asio_net_service::asio_net_service(vix::async::core::io_context &, int concurrency_hint)
+      : ioc_(concurrency_hint)
   {
     guard_ = std::make_unique<guard_t>(asio::make_work_guard(ioc_));
 
@@ -77,11 +78,9 @@ namespace vix::async::net::detail
 
   void asio_net_service::stop() noexcept
   {
-    if (stopped_)
+    if (stopped_.exchange(true))
       return;
 
-    stopped_ = true;
-
     try
     {
       if (guard_)
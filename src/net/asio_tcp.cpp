@@ -14,7 +14,7 @@
 #include <vix/async/net/tcp.hpp>
 #include <vix/async/core/io_context.hpp>
 
-#include "asio_net_service.hpp"
+#include <vix/async/net/asio_net_service.hpp>
 #include "asio_await.hpp"
 
 #include <asio/connect.hpp>
@@ -22,43 +22,18 @@
 #include <asio/read.hpp>
 #include <asio/write.hpp>
 
+#include <array>
 #include <memory>
 #include <span>
 #include <string>
 #include <system_error>
 #include <utility>
+#include <vector>
 
 namespace vix::async::net
 {
   using tcp = asio::ip::tcp;
 
-  namespace detail
-  {
-    template <typename Starter>
-    inline vix::async::core::task<void> co_asio_void(
-        core::io_context &ctx,
-        core::cancel_token ct,
-        Starter &&starter)
-    {
-      co_await asio_awaitable<std::decay_t<Starter>, void>{
-          &ctx,
-          std::move(ct),
-          std::forward<Starter>(starter)};
-    }
-
-    template <typename T, typename Starter>
-    inline vix::async::core::task<T> co_asio_value(
-        core::io_context &ctx,
-        core::cancel_token ct,
-        Starter &&starter)
-    {
-      co_return co_await asio_awaitable<std::decay_t<Starter>, T>{
-          &ctx,
-          std::move(ct),
-          std::forward<Starter>(starter)};
-    }
-  } // namespace detail
-
   class tcp_stream_asio final : public tcp_stream
   {
   public:
@@ -74,24 +49,26 @@ namespace vix::async::net
     {
       tcp::resolver resolver(ctx_.net().asio_ctx());
 
-      auto results =
-          co_await detail::co_asio_value<tcp::resolver::results_type>(
-              ctx_,
-              ct,
-              [&](auto done)
-              {
-                resolver.async_resolve(
-                    ep.host,
-                    std::to_string(ep.port),
+      auto resolve = detail::asio_op<tcp::resolver::results_type>(
+          ctx_,
+          ct,
+          [&](auto done)
+          {
+            resolver.async_resolve(
+                ep.host,
+                std::to_string(ep.port),
+                detail::bind_memory(
+                    write_mem_,
                     [done = std::move(done)](
                         std::error_code ec,
                         tcp::resolver::results_type r) mutable
                     {
                       done(ec, std::move(r));
-                    });
-              });
+                    }));
+          });
+      auto results = co_await resolve;
 
-      co_await detail::co_asio_void(
+      auto connect = detail::asio_op<void>(
           ctx_,
           ct,
           [&](auto done)
@@ -99,13 +76,16 @@ namespace vix::async::net
             asio::async_connect(
                 sock_,
                 results,
-                [done = std::move(done)](
-                    std::error_code ec,
-                    const tcp::endpoint &) mutable
-                {
-                  done(ec);
-                });
+                detail::bind_memory(
+                    write_mem_,
+                    [done = std::move(done)](
+                        std::error_code ec,
+                        const tcp::endpoint &) mutable
+                    {
+                      done(ec);
+                    }));
           });
+      co_await connect;
 
       co_return;
     }
@@ -114,27 +94,30 @@ namespace vix::async::net
         std::span<std::byte> buf,
         vix::async::core::cancel_token ct) override
     {
-      co_return co_await detail::co_asio_value<std::size_t>(
+      auto op = detail::asio_op<std::size_t>(
           ctx_,
           ct,
           [&](auto done)
           {
             sock_.async_read_some(
                 asio::buffer(buf.data(), buf.size()),
-                [done = std::move(done)](
-                    std::error_code ec,
-                    std::size_t bytes) mutable
-                {
-                  done(ec, bytes);
-                });
+                detail::bind_memory(
+                    read_mem_,
+                    [done = std::move(done)](
+                        std::error_code ec,
+                        std::size_t bytes) mutable
+                    {
+                      done(ec, bytes);
+                    }));
           });
+      co_return co_await op;
     }
 
     vix::async::core::task<std::size_t> async_write(
         std::span<const std::byte> buf,
         vix::async::core::cancel_token ct) override
     {
-      co_return co_await detail::co_asio_value<std::size_t>(
+      auto op = detail::asio_op<std::size_t>(
           ctx_,
           ct,
           [&](auto done)
@@ -142,13 +125,63 @@ namespace vix::async::net
             asio::async_write(
                 sock_,
                 asio::buffer(buf.data(), buf.size()),
-                [done = std::move(done)](
-                    std::error_code ec,
-                    std::size_t bytes) mutable
-                {
-                  done(ec, bytes);
-                });
+                detail::bind_memory(
+                    write_mem_,
+                    [done = std::move(done)](
+                        std::error_code ec,
+                        std::size_t bytes) mutable
+                    {
+                      done(ec, bytes);
+                    }));
           });
+      co_return co_await op;
+    }
+
+    vix::async::core::task<std::size_t> async_write_v(
+        std::span<const std::span<const std::byte>> bufs,
+        vix::async::core::cancel_token ct) override
+    {
+      // Small sequences (header + payload) stay in the coroutine frame.
+      std::array<asio::const_buffer, inline_write_buffers> small;
+      std::vector<asio::const_buffer> large;
+      std::span<const asio::const_buffer> seq;
+
+      if (bufs.size() <= small.size())
+      {
+        for (std::size_t i = 0; i < bufs.size(); ++i)
+        {
+          small[i] = asio::buffer(bufs[i].data(), bufs[i].size());
+        }
+        seq = std::span<const asio::const_buffer>(small.data(), bufs.size());
+      }
+      else
+      {
+        large.reserve(bufs.size());
+        for (const auto &b : bufs)
+        {
+          large.push_back(asio::buffer(b.data(), b.size()));
+        }
+        seq = large;
+      }
+
+      auto op = detail::asio_op<std::size_t>(
+          ctx_,
+          ct,
+          [&](auto done)
+          {
+            asio::async_write(
+                sock_,
+                seq,
+                detail::bind_memory(
+                    write_mem_,
+                    [done = std::move(done)](
+                        std::error_code ec,
+                        std::size_t bytes) mutable
+                    {
+                      done(ec, bytes);
+                    }));
+          });
+      co_return co_await op;
     }
 
     void close() noexcept override
@@ -173,8 +206,13 @@ namespace vix::async::net
     }
 
   private:
+    /** @brief Buffers gathered without a heap allocation. */
+    static constexpr std::size_t inline_write_buffers = 8;
+
     core::io_context &ctx_;
     tcp::socket sock_;
+    std::shared_ptr<detail::handler_memory> read_mem_{std::make_shared<detail::handler_memory>()};
+    std::shared_ptr<detail::handler_memory> write_mem_{std::make_shared<detail::handler_memory>()};
   };
 
   class tcp_listener_asio final : public tcp_listener
@@ -226,18 +264,21 @@ namespace vix::async::net
     {
       auto client = std::make_unique<tcp_stream_asio>(ctx_);
 
-      co_await detail::co_asio_void(
+      auto op = detail::asio_op<void>(
           ctx_,
           ct,
           [&](auto done)
           {
             acc_.async_accept(
                 client->native(),
-                [done = std::move(done)](std::error_code ec) mutable
-                {
-                  done(ec);
-                });
+                detail::bind_memory(
+                    accept_mem_,
+                    [done = std::move(done)](std::error_code ec) mutable
+                    {
+                      done(ec);
+                    }));
           });
+      co_await op;
 
       co_return std::unique_ptr<tcp_stream>(client.release());
     }
@@ -256,6 +297,7 @@ namespace vix::async::net
   private:
     vix::async::core::io_context &ctx_;
     tcp::acceptor acc_;
+    std::shared_ptr<detail::handler_memory> accept_mem_{std::make_shared<detail::handler_memory>()};
   };
 
   std::unique_ptr<tcp_stream> make_tcp_stream(vix::async::core::io_context &ctx)
@@ -14,7 +14,7 @@
 #include <vix/async/net/udp.hpp>
 #include <vix/async/core/io_context.hpp>
 
-#include "asio_net_service.hpp"
+#include <vix/async/net/asio_net_service.hpp>
 #include "asio_await.hpp"
 
 #include <asio/ip/udp.hpp>
@@ -29,33 +29,6 @@ namespace vix::async::net
 {
   using udp = asio::ip::udp;
 
-  namespace detail
-  {
-    template <typename Starter>
-    inline vix::async::core::task<void> co_asio_void(
-        core::io_context &ctx,
-        core::cancel_token ct,
-        Starter &&starter)
-    {
-      co_await asio_awaitable<std::decay_t<Starter>, void>{
-          &ctx,
-          std::move(ct),
-          std::forward<Starter>(starter)};
-    }
-
-    template <typename T, typename Starter>
-    inline vix::async::core::task<T> co_asio_value(
-        core::io_context &ctx,
-        core::cancel_token ct,
-        Starter &&starter)
-    {
-      co_return co_await asio_awaitable<std::decay_t<Starter>, T>{
-          &ctx,
-          std::move(ct),
-          std::forward<Starter>(starter)};
-    }
-  } // namespace detail
-
   class udp_socket_asio final : public udp_socket
   {
   public:
@@ -93,7 +66,7 @@ namespace vix::async::net
     {
       udp::endpoint dst(asio::ip::make_address(to.host), to.port);
 
-      co_return co_await detail::co_asio_value<std::size_t>(
+      auto op = detail::asio_op<std::size_t>(
           ctx_,
           ct,
           [&](auto done)
@@ -101,13 +74,16 @@ namespace vix::async::net
             sock_.async_send_to(
                 asio::buffer(buf.data(), buf.size()),
                 dst,
-                [done = std::move(done)](
-                    std::error_code ec,
-                    std::size_t bytes) mutable
-                {
-                  done(ec, bytes);
-                });
+                detail::bind_memory(
+                    send_mem_,
+                    [done = std::move(done)](
+                        std::error_code ec,
+                        std::size_t bytes) mutable
+                    {
+                      done(ec, bytes);
+                    }));
           });
+      co_return co_await op;
     }
 
     vix::async::core::task<udp_datagram> async_recv_from(
@@ -116,7 +92,7 @@ namespace vix::async::net
     {
       udp::endpoint src;
 
-      const auto received = co_await detail::co_asio_value<std::size_t>(
+      auto op = detail::asio_op<std::size_t>(
           ctx_,
           ct,
           [&](auto done)
@@ -124,13 +100,16 @@ namespace vix::async::net
             sock_.async_receive_from(
                 asio::buffer(buf.data(), buf.size()),
                 src,
-                [done = std::move(done)](
-                    std::error_code ec,
-                    std::size_t bytes) mutable
-                {
-                  done(ec, bytes);
-                });
+                detail::bind_memory(
+                    recv_mem_,
+                    [done = std::move(done)](
+                        std::error_code ec,
+                        std::size_t bytes) mutable
+                    {
+                      done(ec, bytes);
+                    }));
           });
+      const auto received = co_await op;
 
       udp_datagram d;
       d.from.host = src.address().to_string();
@@ -154,6 +133,8 @@ namespace vix::async::net
   private:
     vix::async::core::io_context &ctx_;
     udp::socket sock_;
+    std::shared_ptr<detail::handler_memory> recv_mem_{std::make_shared<detail::handler_memory>()};
+    std::shared_ptr<detail::handler_memory> send_mem_{std::make_shared<detail::handler_memory>()};
   };
 
   std::unique_ptr<udp_socket> make_udp_socket(vix::async::core::io_context &ctx)
@@ -0,0 +1,359 @@
+/**
+ *
+ *  @file framing.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/async/net/framing.hpp>
+
+#include <vix/async/detail/scan.hpp>
+
+#include <asio/error.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <utility>
+
+namespace vix::async::net
+{
+  namespace
+  {
+    [[noreturn]] void throw_errc(core::errc e)
+    {
+      throw std::system_error(core::make_error_code(e));
+    }
+
+    /**
+     * @brief Decode a length prefix from the front of buf.
+     *
+     * @return false if buf does not hold a whole prefix yet.
+     */
+    bool decode_length_prefix(
+        length_prefix prefix,
+        std::span<const std::byte> buf,
+        std::size_t &header,
+        std::uint64_t &length)
+    {
+      switch (prefix)
+      {
+      case length_prefix::u16_be:
+        if (buf.size() < 2)
+        {
+          return false;
+        }
+        header = 2;
+        length = (std::to_integer<std::uint64_t>(buf[0]) << 8) |
+                 std::to_integer<std::uint64_t>(buf[1]);
+        return true;
+
+      case length_prefix::u32_be:
+        if (buf.size() < 4)
+        {
+          return false;
+        }
+        header = 4;
+        length = (std::to_integer<std::uint64_t>(buf[0]) << 24) |
+                 (std::to_integer<std::uint64_t>(buf[1]) << 16) |
+                 (std::to_integer<std::uint64_t>(buf[2]) << 8) |
+                 std::to_integer<std::uint64_t>(buf[3]);
+        return true;
+
+      case length_prefix::varint:
+        break;
+      }
+
+      std::uint64_t value = 0;
+      const std::size_t limit = std::min(buf.size(), max_length_prefix_size);
+      for (std::size_t i = 0; i < limit; ++i)
+      {
+        const auto b = std::to_integer<std::uint64_t>(buf[i]);
+
+        // The tenth byte may only carry the top bit of a 64-bit value.
+        if (i == max_length_prefix_size - 1 && b > 1)
+        {
+          throw_errc(core::errc::overflow);
+        }
+
+        value |= (b & 0x7f) << (7 * i);
+        if ((b & 0x80) == 0)
+        {
+          header = i + 1;
+          length = value;
+          return true;
+        }
+      }
+
+      if (buf.size() >= max_length_prefix_size)
+      {
+        throw_errc(core::errc::overflow);
+      }
+      return false;
+    }
+
+    /**
+     * @brief Position of needle in hay, or hay.size() if absent.
+     */
+    std::size_t find(std::span<const std::byte> hay, std::string_view needle) noexcept
+    {
+      return detail::scan_pattern(reinterpret_cast<const char *>(hay.data()), hay.size(), needle);
+    }
+  } // namespace
+
+  buffered_reader::buffered_reader(tcp_stream &stream, std::size_t capacity)
+      : stream_(&stream),
+        heap_(std::make_unique_for_overwrite<std::byte[]>(std::max<std::size_t>(capacity, 1))),
+        data_(heap_.get()),
+        cap_(std::max<std::size_t>(capacity, 1))
+  {
+  }
+
+  buffered_reader::buffered_reader(tcp_stream &stream, buffer_pool &pool)
+      : stream_(&stream),
+        pooled_(pool.acquire()),
+        data_(pooled_.bytes().data()),
+        cap_(pooled_.bytes().size())
+  {
+  }
+
+  void buffered_reader::consume(std::size_t n) noexcept
+  {
+    begin_ += std::min(n, end_ - begin_);
+    if (begin_ == end_)
+    {
+      begin_ = 0;
+      end_ = 0;
+    }
+  }
+
+  void buffered_reader::make_room(std::size_t n)
+  {
+    const std::size_t live = end_ - begin_;
+
+    if (cap_ - begin_ >= n && end_ < cap_)
+    {
+      return;
+    }
+
+    if (cap_ >= n && cap_ > live)
+    {
+      std::memmove(data_, data_ + begin_, live);
+      begin_ = 0;
+      end_ = live;
+      return;
+    }
+
+    const std::size_t grown = std::max(n, cap_ * 2);
+    auto bigger = std::make_unique_for_overwrite<std::byte[]>(grown);
+    std::memcpy(bigger.get(), data_ + begin_, live);
+
+    heap_ = std::move(bigger);
+    pooled_.reset();
+    data_ = heap_.get();
+    cap_ = grown;
+    begin_ = 0;
+    end_ = live;
+  }
+
+  core::task<bool> buffered_reader::async_fill(std::size_t n, core::cancel_token ct)
+  {
+    while (end_ - begin_ < n)
+    {
+      if (eof_)
+      {
+        co_return false;
+      }
+
+      make_room(n);
+
+      std::size_t got = 0;
+      try
+      {
+        got = co_await stream_->async_read(std::span<std::byte>(data_ + end_, cap_ - end_), ct);
+      }
+      catch (const std::system_error &e)
+      {
+        if (e.code() != asio::error::eof)
+        {
+          throw;
+        }
+      }
+
+      if (got == 0)
+      {
+        eof_ = true;
+        co_return false;
+      }
+      end_ += got;
+    }
+
+    co_return true;
+  }
+
+  std::size_t encode_length_prefix(
+      length_prefix prefix,
+      std::uint64_t length,
+      std::span<std::byte, max_length_prefix_size> out)
+  {
+    switch (prefix)
+    {
+    case length_prefix::u16_be:
+      if (length > 0xffffu)
+      {
+        throw_errc(core::errc::overflow);
+      }
+      out[0] = static_cast<std::byte>(length >> 8);
+      out[1] = static_cast<std::byte>(length & 0xff);
+      return 2;
+
+    case length_prefix::u32_be:
+      if (length > 0xffffffffu)
+      {
+        throw_errc(core::errc::overflow);
+      }
+      out[0] = static_cast<std::byte>(length >> 24);
+      out[1] = static_cast<std::byte>((length >> 16) & 0xff);
+      out[2] = static_cast<std::byte>((length >> 8) & 0xff);
+      out[3] = static_cast<std::byte>(length & 0xff);
+      return 4;
+
+    case length_prefix::varint:
+      break;
+    }
+
+    std::size_t n = 0;
+    while (length >= 0x80)
+    {
+      out[n++] = static_cast<std::byte>((length & 0x7f) | 0x80);
+      length >>= 7;
+    }
+    out[n++] = static_cast<std::byte>(length);
+    return n;
+  }
+
+  core::task<std::optional<std::span<const std::byte>>> length_prefixed_reader::async_read_frame(
+      core::cancel_token ct)
+  {
+    std::size_t header = 0;
+    std::uint64_t length = 0;
+
+    while (!decode_length_prefix(prefix_, in_->buffered(), header, length))
+    {
+      const std::size_t have = in_->buffered().size();
+      if (!co_await in_->async_fill(have + 1, ct))
+      {
+        if (in_->buffered().empty())
+        {
+          co_return std::nullopt;
+        }
+        throw_errc(core::errc::closed);
+      }
+    }
+
+    if (length > max_frame_)
+    {
+      throw_errc(core::errc::overflow);
+    }
+
+    const std::size_t total = header + static_cast<std::size_t>(length);
+    if (!co_await in_->async_fill(total, ct))
+    {
+      throw_errc(core::errc::closed);
+    }
+
+    const auto frame = in_->buffered().subspan(header, static_cast<std::size_t>(length));
+    in_->consume(total);
+    co_return frame;
+  }
+
+  delimited_reader::delimited_reader(
+      buffered_reader &in,
+      std::string delimiter,
+      std::size_t max_frame)
+      : in_(&in),
+        delimiter_(std::move(delimiter)),
+        max_frame_(max_frame)
+  {
+    if (delimiter_.empty())
+    {
+      throw_errc(core::errc::invalid_argument);
+    }
+  }
+
+  core::task<std::optional<std::span<const std::byte>>> delimited_reader::async_read_frame(
+      core::cancel_token ct)
+  {
+    const std::size_t overlap = delimiter_.size() - 1;
+
+    for (;;)
+    {
+      const auto buf = in_->buffered();
+      const std::size_t from = std::min(scanned_, buf.size());
+      const std::size_t pos = from + find(buf.subspan(from), delimiter_);
+
+      if (pos < buf.size())
+      {
+        if (pos > max_frame_)
+        {
+          throw_errc(core::errc::overflow);
+        }
+
+        scanned_ = 0;
+        in_->consume(pos + delimiter_.size());
+        co_return buf.first(pos);
+      }
+
+      // A delimiter may straddle the end of what has arrived so far.
+      scanned_ = buf.size() > overlap ? buf.size() - overlap : 0;
+
+      if (buf.size() >= max_frame_ + delimiter_.size())
+      {
+        throw_errc(core::errc::overflow);
+      }
+
+      if (!co_await in_->async_fill(buf.size() + 1, ct))
+      {
+        if (in_->buffered().empty())
+        {
+          co_return std::nullopt;
+        }
+        throw_errc(core::errc::closed);
+      }
+    }
+  }
+
+  core::task<void> async_write_frame(
+      tcp_stream &stream,
+      std::span<const std::byte> payload,
+      length_prefix prefix,
+      core::cancel_token ct)
+  {
+    std::array<std::byte, max_length_prefix_size> header;
+    const std::size_t n = encode_length_prefix(prefix, payload.size(), header);
+
+    const std::array<std::span<const std::byte>, 2> parts{
+        std::span<const std::byte>(header.data(), n),
+        payload};
+    (void)co_await stream.async_write_v(parts, std::move(ct));
+  }
+
+  core::task<void> async_write_delimited(
+      tcp_stream &stream,
+      std::span<const std::byte> payload,
+      std::string_view delimiter,
+      core::cancel_token ct)
+  {
+    const std::array<std::span<const std::byte>, 2> parts{
+        payload,
+        std::as_bytes(std::span<const char>(delimiter.data(), delimiter.size()))};
+    (void)co_await stream.async_write_v(parts, std::move(ct));
+  }
+
+} // namespace vix::async::net
@@ -0,0 +1,637 @@
+/**
+ *
+ *  @file asio_process.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/async/process/process.hpp>
+
+#include <vix/async/core/io_context.hpp>
+#include <vix/async/detail/platform.hpp>
+
+#if ASYNC_PLATFORM_UNIX
+
+#include <vix/async/net/asio_net_service.hpp>
+#include "../net/asio_await.hpp"
+
+#include <asio/posix/stream_descriptor.hpp>
+#include <asio/steady_timer.hpp>
+#include <asio/write.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <mutex>
+#include <utility>
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern "C" char **environ;
+
+namespace vix::async::process
+{
+  namespace
+  {
+    using descriptor = asio::posix::stream_descriptor;
+
+    /** @brief First and last polling intervals without pidfd. */
+    constexpr auto poll_min = std::chrono::milliseconds(1);
+    constexpr auto poll_max = std::chrono::milliseconds(100);
+
+    /**
+     * @brief Owned file descriptor, closed unless released.
+     */
+    struct fd_guard
+    {
+      int fd{-1};
+
+      fd_guard() = default;
+      fd_guard(const fd_guard &) = delete;
+      fd_guard &operator=(const fd_guard &) = delete;
+
+      ~fd_guard()
+      {
+        if (fd >= 0)
+        {
+          ::close(fd);
+        }
+      }
+
+      int release() noexcept
+      {
+        return std::exchange(fd, -1);
+      }
+    };
+
+    [[noreturn]] void throw_errno(int err)
+    {
+      throw std::system_error(err, std::system_category());
+    }
+
+    void ignore_sigpipe_once()
+    {
+      static std::once_flag once;
+      std::call_once(once, []()
+                     {
+                       struct sigaction old{};
+                       if (::sigaction(SIGPIPE, nullptr, &old) == 0 && old.sa_handler == SIG_DFL)
+                       {
+                         struct sigaction ign{};
+                         ign.sa_handler = SIG_IGN;
+                         sigemptyset(&ign.sa_mask);
+                         ::sigaction(SIGPIPE, &ign, nullptr);
+                       } });
+    }
+
+    /**
+     * @brief Reap pid if it has terminated.
+     *
+     * @return Status if reaped, nullopt if still running.
+     * @throws std::system_error if waitpid fails (e.g. ECHILD when SIGCHLD is ignored).
+     */
+    std::optional<exit_status> try_reap(pid_t pid)
+    {
+      int st = 0;
+      pid_t r = 0;
+      do
+      {
+        r = ::waitpid(pid, &st, WNOHANG);
+      } while (r < 0 && errno == EINTR);
+
+      if (r < 0)
+      {
+        throw_errno(errno);
+      }
+      if (r == 0)
+      {
+        return std::nullopt;
+      }
+
+      exit_status s;
+      if (WIFEXITED(st))
+      {
+        s.code = WEXITSTATUS(st);
+      }
+      else if (WIFSIGNALED(st))
+      {
+        s.signal = WTERMSIG(st);
+      }
+      return s;
+    }
+
+    /**
+     * @brief Reaps a detached child without pidfd by polling.
+     */
+    struct background_reaper : std::enable_shared_from_this<background_reaper>
+    {
+      asio::steady_timer timer;
+      pid_t pid;
+
+      background_reaper(asio::io_context &ioc, pid_t p)
+          : timer(ioc), pid(p)
+      {
+      }
+
+      void arm()
+      {
+        timer.expires_after(poll_max);
+        timer.async_wait([self = shared_from_this()](std::error_code ec)
+                         {
+                           int st = 0;
+                           if (!ec && ::waitpid(self->pid, &st, WNOHANG) == 0)
+                           {
+                             self->arm();
+                           } });
+      }
+    };
+
+    class pipe_stream_asio final : public pipe_stream
+    {
+    public:
+      pipe_stream_asio(core::io_context &ctx, int fd, bool readable)
+          : ctx_(ctx),
+            desc_(ctx.net().asio_ctx(), fd),
+            readable_(readable)
+      {
+      }
+
+      core::task<std::size_t> async_read(
+          std::span<std::byte> buf,
+          core::cancel_token ct) override
+      {
+        if (!readable_)
+        {
+          throw std::system_error(core::make_error_code(core::errc::not_supported));
+        }
+
+        auto op = net::detail::asio_op<std::size_t>(
+            ctx_,
+            std::move(ct),
+            [&](auto done)
+            {
+              desc_.async_read_some(
+                  asio::buffer(buf.data(), buf.size()),
+                  [done = std::move(done)](std::error_code ec, std::size_t n) mutable
+                  {
+                    // End of stream is a 0-byte read, not an error.
+                    if (ec == asio::error::eof)
+                    {
+                      ec = {};
+                      n = 0;
+                    }
+                    done(ec, n);
+                  });
+            });
+
+        co_return co_await op;
+      }
+
+      core::task<std::size_t> async_write(
+          std::span<const std::byte> buf,
+          core::cancel_token ct) override
+      {
+        if (readable_)
+        {
+          throw std::system_error(core::make_error_code(core::errc::not_supported));
+        }
+
+        auto op = net::detail::asio_op<std::size_t>(
+            ctx_,
+            std::move(ct),
+            [&](auto done)
+            {
+              asio::async_write(
+                  desc_,
+                  asio::buffer(buf.data(), buf.size()),
+                  [done = std::move(done)](std::error_code ec, std::size_t n) mutable
+                  {
+                    done(ec, n);
+                  });
+            });
+
+        co_return co_await op;
+      }
+
+      void close() noexcept override
+      {
+        std::error_code ec;
+        desc_.close(ec);
+      }
+
+      bool is_open() const noexcept override
+      {
+        return desc_.is_open();
+      }
+
+      int native_handle() override
+      {
+        return desc_.is_open() ? desc_.native_handle() : -1;
+      }
+
+    private:
+      core::io_context &ctx_;
+      descriptor desc_;
+      bool readable_;
+    };
+
+    class async_process_asio final : public async_process
+    {
+    public:
+      async_process_asio(core::io_context &ctx, pid_t pid, int pidfd)
+          : ctx_(ctx),
+            pid_(pid)
+      {
+        if (pidfd >= 0)
+        {
+          pidfd_ = std::make_unique<descriptor>(ctx.net().asio_ctx(), pidfd);
+        }
+      }
+
+      ~async_process_asio() override
+      {
+        if (status_)
+        {
+          return;
+        }
+
+        try
+        {
+          if (try_reap(pid_))
+          {
+            return;
+          }
+
+          // Still running: reap it in the background once it exits.
+          if (pidfd_)
+          {
+            auto d = std::shared_ptr<descriptor>(std::move(pidfd_));
+            const pid_t pid = pid_;
+            d->async_wait(
+                descriptor::wait_read,
+                [d, pid](std::error_code)
+                {
+                  int st = 0;
+                  ::waitpid(pid, &st, WNOHANG);
+                });
+          }
+          else
+          {
+            std::make_shared<background_reaper>(ctx_.net().asio_ctx(), pid_)->arm();
+          }
+        }
+        catch (...)
+        {
+        }
+      }
+
+      int pid() const noexcept override
+      {
+        return pid_;
+      }
+
+      pipe_stream *stdin_pipe() noexcept override
+      {
+        return in_.get();
+      }
+
+      pipe_stream *stdout_pipe() noexcept override
+      {
+        return out_.get();
+      }
+
+      pipe_stream *stderr_pipe() noexcept override
+      {
+        return err_.get();
+      }
+
+      core::task<exit_status> async_wait(core::cancel_token ct) override
+      {
+        if (status_)
+        {
+          co_return *status_;
+        }
+
+        if (pidfd_)
+        {
+          auto op = net::detail::asio_op<void>(
+              ctx_,
+              ct,
+              [&](auto done)
+              {
+                pidfd_->async_wait(
+                    descriptor::wait_read,
+                    [done = std::move(done)](std::error_code ec) mutable
+                    {
+                      done(ec);
+                    });
+              });
+          co_await op;
+        }
+
+        auto delay = std::chrono::steady_clock::duration(poll_min);
+
+        for (;;)
+        {
+          // Another waiter may have reaped the child while we were suspended.
+          if (status_)
+          {
+            co_return *status_;
+          }
+
+          if (auto s = try_reap(pid_))
+          {
+            status_ = s;
+            if (pidfd_)
+            {
+              std::error_code ec;
+              pidfd_->close(ec);
+            }
+            co_return *s;
+          }
+
+          asio::steady_timer timer(ctx_.net().asio_ctx(), delay);
+          auto op = net::detail::asio_op<void>(
+              ctx_,
+              ct,
+              [&](auto done)
+              {
+                timer.async_wait(
+                    [done = std::move(done)](std::error_code ec) mutable
+                    {
+                      done(ec);
+                    });
+              });
+          co_await op;
+
+          delay = std::min<std::chrono::steady_clock::duration>(delay * 2, poll_max);
+        }
+      }
+
+      void kill(int sig) override
+      {
+        if (status_)
+        {
+          return;
+        }
+
+#if defined(SYS_pidfd_send_signal)
+        if (pidfd_ && pidfd_->is_open())
+        {
+          if (::syscall(SYS_pidfd_send_signal, pidfd_->native_handle(), sig, nullptr, 0) == 0)
+          {
+            return;
+          }
+          if (errno != ENOSYS)
+          {
+            throw_errno(errno);
+          }
+        }
+#endif
+
+        if (::kill(pid_, sig) != 0)
+        {
+          throw_errno(errno);
+        }
+      }
+
+      void set_pipes(
+          std::unique_ptr<pipe_stream_asio> in,
+          std::unique_ptr<pipe_stream_asio> out,
+          std::unique_ptr<pipe_stream_asio> err) noexcept
+      {
+        in_ = std::move(in);
+        out_ = std::move(out);
+        err_ = std::move(err);
+      }
+
+    private:
+      core::io_context &ctx_;
+      pid_t pid_;
+      std::unique_ptr<descriptor> pidfd_;
+      std::optional<exit_status> status_;
+      std::unique_ptr<pipe_stream_asio> in_;
+      std::unique_ptr<pipe_stream_asio> out_;
+      std::unique_ptr<pipe_stream_asio> err_;
+    };
+
+    /**
+     * @brief posix_spawn file actions and attributes, destroyed on scope exit.
+     */
+    struct spawn_setup
+    {
+      posix_spawn_file_actions_t actions{};
+      posix_spawnattr_t attr{};
+
+      spawn_setup()
+      {
+        if (const int rc = ::posix_spawn_file_actions_init(&actions); rc != 0)
+        {
+          throw_errno(rc);
+        }
+        if (const int rc = ::posix_spawnattr_init(&attr); rc != 0)
+        {
+          ::posix_spawn_file_actions_destroy(&actions);
+          throw_errno(rc);
+        }
+      }
+
+      ~spawn_setup()
+      {
+        ::posix_spawnattr_destroy(&attr);
+        ::posix_spawn_file_actions_destroy(&actions);
+      }
+
+      spawn_setup(const spawn_setup &) = delete;
+      spawn_setup &operator=(const spawn_setup &) = delete;
+    };
+
+    void check(int rc)
+    {
+      if (rc != 0)
+      {
+        throw_errno(rc);
+      }
+    }
+
+    /**
+     * @brief Connect child descriptor target according to mode.
+     *
+     * @param parent_end Receives the parent's end of a pipe.
+     * @param child_end Receives the child's end; closed after spawning.
+     */
+    void setup_stdio(spawn_setup &s, int target, stdio mode, fd_guard &parent_end, fd_guard &child_end)
+    {
+      switch (mode)
+      {
+      case stdio::inherit:
+        return;
+
+      case stdio::null:
+        check(::posix_spawn_file_actions_addopen(
+            &s.actions, target, "/dev/null", target == STDIN_FILENO ? O_RDONLY : O_WRONLY, 0));
+        return;
+
+      case stdio::pipe:
+      {
+        int p[2];
+        if (::pipe2(p, O_CLOEXEC) != 0)
+        {
+          throw_errno(errno);
+        }
+
+        // stdin: the child reads p[0]; stdout/stderr: the child writes p[1].
+        const bool child_reads = target == STDIN_FILENO;
+        child_end.fd = child_reads ? p[0] : p[1];
+        parent_end.fd = child_reads ? p[1] : p[0];
+
+        // dup2 clears FD_CLOEXEC on the target descriptor only.
+        check(::posix_spawn_file_actions_adddup2(&s.actions, child_end.fd, target));
+        return;
+      }
+      }
+    }
+
+    int open_pidfd(pid_t pid) noexcept
+    {
+#if defined(SYS_pidfd_open)
+      return static_cast<int>(::syscall(SYS_pidfd_open, pid, 0));
+#else
+      (void)pid;
+      return -1;
+#endif
+    }
+  } // namespace
+
+  std::unique_ptr<async_process> spawn(core::io_context &ctx, const process_options &opts)
+  {
+    if (opts.program.empty())
+    {
+      throw std::system_error(core::make_error_code(core::errc::invalid_argument));
+    }
+
+    ignore_sigpipe_once();
+
+    spawn_setup s;
+
+    fd_guard parent[3];
+    fd_guard child[3];
+    setup_stdio(s, STDIN_FILENO, opts.in, parent[0], child[0]);
+    setup_stdio(s, STDOUT_FILENO, opts.out, parent[1], child[1]);
+    setup_stdio(s, STDERR_FILENO, opts.err, parent[2], child[2]);
+
+    if (!opts.cwd.empty())
+    {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 29))
+      check(::posix_spawn_file_actions_addchdir_np(&s.actions, opts.cwd.c_str()));
+#else
+      throw std::system_error(core::make_error_code(core::errc::not_supported));
+#endif
+    }
+
+    // The parent may block or ignore signals (signal_set, SIGPIPE above);
+    // the child starts from a clean slate.
+    sigset_t mask;
+    sigemptyset(&mask);
+    check(::posix_spawnattr_setsigmask(&s.attr, &mask));
+
+    sigset_t defaults;
+    sigemptyset(&defaults);
+    sigaddset(&defaults, SIGPIPE);
+    check(::posix_spawnattr_setsigdefault(&s.attr, &defaults));
+    check(::posix_spawnattr_setflags(&s.attr, POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF));
+
+    std::vector<char *> argv;
+    argv.reserve(opts.args.size() + 2);
+    argv.push_back(const_cast<char *>(opts.program.c_str()));
+    for (const auto &a : opts.args)
+    {
+      argv.push_back(const_cast<char *>(a.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    std::vector<char *> envp;
+    if (opts.env)
+    {
+      envp.reserve(opts.env->size() + 1);
+      for (const auto &e : *opts.env)
+      {
+        envp.push_back(const_cast<char *>(e.c_str()));
+      }
+      envp.push_back(nullptr);
+    }
+
+    pid_t pid = -1;
+    const int rc = opts.search_path
+                       ? ::posix_spawnp(&pid, opts.program.c_str(), &s.actions, &s.attr, argv.data(),
+                                        opts.env ? envp.data() : environ)
+                       : ::posix_spawn(&pid, opts.program.c_str(), &s.actions, &s.attr, argv.data(),
+                                       opts.env ? envp.data() : environ);
+    if (rc != 0)
+    {
+      throw std::system_error(rc, std::system_category(), "spawn " + opts.program);
+    }
+
+    // The child holds its own copies now.
+    for (auto &c : child)
+    {
+      if (c.fd >= 0)
+      {
+        ::close(c.release());
+      }
+    }
+
+    try
+    {
+      auto proc = std::make_unique<async_process_asio>(ctx, pid, open_pidfd(pid));
+
+      auto make_pipe = [&](fd_guard &fd, bool readable) -> std::unique_ptr<pipe_stream_asio>
+      {
+        if (fd.fd < 0)
+        {
+          return nullptr;
+        }
+        auto p = std::make_unique<pipe_stream_asio>(ctx, fd.fd, readable);
+        fd.release();
+        return p;
+      };
+
+      auto in = make_pipe(parent[0], false);
+      auto out = make_pipe(parent[1], true);
+      auto err = make_pipe(parent[2], true);
+      proc->set_pipes(std::move(in), std::move(out), std::move(err));
+      return proc;
+    }
+    catch (...)
+    {
+      ::kill(pid, SIGKILL);
+      int st = 0;
+      ::waitpid(pid, &st, 0);
+      throw;
+    }
+  }
+
+} // namespace vix::async::process
+
+#else
+
+namespace vix::async::process
+{
+  std::unique_ptr<async_process> spawn(core::io_context &, const process_options &)
+  {
+    throw std::system_error(core::make_error_code(core::errc::not_supported));
+  }
+
+} // namespace vix::async::process
+
+#endif
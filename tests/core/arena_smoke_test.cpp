@@ -0,0 +1,200 @@
+/**
+ *
+ *  @file arena_smoke_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <cstdint>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+#include <vix/async/core/arena.hpp>
+#include <vix/async/core/io_context.hpp>
+#include <vix/async/core/task.hpp>
+
+// GCC 12 pairs the frame's operator delete with the wrong operator new at
+// -O0 for coroutines taking the arena (GCC bug 109224, fixed in 13).
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ < 13
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+using namespace vix::async::core;
+
+static void test_bump()
+{
+  request_arena a(1024);
+  assert(a.bytes_used() == 0 && a.chunk_count() == 0);
+
+  void *p1 = a.allocate(10, 1);
+  void *p2 = a.allocate(16, 16);
+  assert(a.chunk_count() == 1);
+  assert(reinterpret_cast<std::uintptr_t>(p2) % 16 == 0);
+  assert(static_cast<char *>(p2) >= static_cast<char *>(p1) + 10);
+  assert(a.bytes_used() == 26);
+
+  // Freeing the latest allocation rolls back; older ones stay until release().
+  a.deallocate(p2, 16, 16);
+  assert(a.bytes_used() == 10);
+  [[maybe_unused]] void *p3 = a.allocate(16, 16);
+  assert(p3 == p2);
+  a.deallocate(p1, 10, 1);
+  assert(a.bytes_used() == 26);
+
+  // Large blocks get their own chunk without abandoning the current one.
+  void *big = a.allocate(4000, 8);
+  assert(a.chunk_count() == 2);
+  [[maybe_unused]] void *small = a.allocate(8, 8);
+  assert(static_cast<char *>(small) < static_cast<char *>(p3) + 64);
+  a.deallocate(big, 4000, 8);
+
+  // Filling a chunk takes another one.
+  for (int i = 0; i < 100; ++i)
+  {
+    (void)a.allocate(64, 8);
+  }
+  assert(a.chunk_count() > 2);
+
+  a.release();
+  assert(a.bytes_used() == 0 && a.chunk_count() == 1);
+}
+
+// release() keeps the first regular chunk, not a dedicated block linked
+// behind it.
+static void test_release_dedicated()
+{
+  request_arena a(1024);
+  [[maybe_unused]] void *p1 = a.allocate(8, 8);
+  (void)a.allocate(4000, 8);
+  assert(a.chunk_count() == 2);
+
+  a.release();
+  assert(a.chunk_count() == 1);
+  [[maybe_unused]] void *p2 = a.allocate(8, 8);
+  assert(p2 == p1);
+  for (int i = 0; i < 8; ++i)
+  {
+    (void)a.allocate(64, 8);
+  }
+  assert(a.chunk_count() == 1);
+}
+
+static void test_pmr()
+{
+  request_arena a;
+  std::pmr::vector<int> v(&a);
+  for (int i = 0; i < 1000; ++i)
+  {
+    v.push_back(i);
+  }
+  assert(v.size() == 1000 && v[999] == 999);
+  assert(a.bytes_used() >= 1000 * sizeof(int));
+}
+
+static task<int> child(request_arena &, int x)
+{
+  co_return x * 2;
+}
+
+static task<int> plain(int x)
+{
+  co_return x + 1;
+}
+
+static task<int> handle(request_arena &a, int x)
+{
+  std::pmr::vector<int> scratch(&a);
+  scratch.push_back(x);
+
+  int sum = 0;
+  for (int i = 0; i < 3; ++i)
+  {
+    sum += co_await child(a, scratch.back());
+  }
+  co_return sum;
+}
+
+static task<void> run()
+{
+  // The child frame comes from the arena and rolls back when destroyed.
+  {
+    request_arena a;
+    [[maybe_unused]] const std::size_t before = a.bytes_used();
+    {
+      task<int> t = child(a, 21);
+      assert(a.bytes_used() > before);
+      [[maybe_unused]] const int v = co_await t;
+      assert(v == 42);
+    }
+    assert(a.bytes_used() == before);
+
+    // Coroutines without a resource argument use the heap.
+    [[maybe_unused]] const int p = co_await plain(1);
+    assert(p == 2 && a.bytes_used() == before);
+  }
+
+  // with_arena owns the arena for the lifetime of the root task.
+  {
+    std::size_t used = 0;
+    [[maybe_unused]] const int v = co_await with_arena([&](request_arena &a)
+                                                       {
+                                                         auto root = handle(a, 5);
+                                                         used = a.bytes_used();
+                                                         return root; });
+    assert(v == 30);
+    assert(used > 0);
+
+    bool ran = false;
+    co_await with_arena([&](request_arena &a) -> task<void>
+                        {
+                          ran = co_await child(a, 1) == 2; });
+    assert(ran);
+  }
+}
+
+int main()
+{
+  test_bump();
+  test_release_dedicated();
+  test_pmr();
+
+  io_context ctx;
+  std::thread loop([&]()
+                   { ctx.run(); });
+
+  auto done = std::make_shared<std::promise<void>>();
+  auto fut = done->get_future();
+
+  auto wrapper = [done]() -> task<void>
+  {
+    try
+    {
+      co_await run();
+      done->set_value();
+    }
+    catch (...)
+    {
+      done->set_exception(std::current_exception());
+    }
+  };
+  std::move(wrapper()).start(ctx.get_scheduler());
+
+  fut.get();
+
+  ctx.stop();
+  loop.join();
+
+  std::cout << "async_arena_smoke: OK\n";
+  return 0;
+}
@@ -0,0 +1,214 @@
+/**
+ *
+ *  @file broadcast_smoke_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <cstddef>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <vix/async/core/broadcast.hpp>
+#include <vix/async/core/error.hpp>
+#include <vix/async/core/io_context.hpp>
+#include <vix/async/core/task.hpp>
+#include <vix/async/core/when.hpp>
+
+using namespace vix::async::core;
+
+using channel = broadcast<std::string>;
+
+static bool throws(std::error_code want, channel::subscriber &sub)
+{
+  try
+  {
+    (void)sub.try_recv();
+  }
+  catch (const std::system_error &e)
+  {
+    return e.code() == want;
+  }
+  return false;
+}
+
+// Reads count messages and records which objects it was handed.
+static task<void> reader(channel::subscriber sub, int count, std::vector<const std::string *> &seen,
+                         int &finished)
+{
+  for (int i = 0; i < count; ++i)
+  {
+    channel::message m = co_await sub.recv();
+    seen.push_back(m.get());
+  }
+  ++finished;
+}
+
+static task<void> fan_out(io_context &ctx)
+{
+  constexpr int subscribers = 200;
+  constexpr int messages = 3;
+
+  channel ch(ctx.get_scheduler(), 8);
+  std::vector<std::vector<const std::string *>> seen(subscribers);
+  int finished = 0;
+
+  for (int i = 0; i < subscribers; ++i)
+  {
+    std::move(reader(ch.subscribe(), messages, seen[static_cast<std::size_t>(i)], finished))
+        .start(ctx.get_scheduler());
+  }
+  assert(ch.subscriber_count() == subscribers);
+
+  // Yielding lets the readers suspend first, so every send wakes all of
+  // them at once.
+  std::vector<std::shared_ptr<const std::string>> sent;
+  for (int i = 0; i < messages; ++i)
+  {
+    co_await ctx.get_scheduler().schedule();
+    sent.push_back(std::make_shared<const std::string>("update " + std::to_string(i)));
+    [[maybe_unused]] const std::size_t n = ch.send(sent.back());
+    assert(n == subscribers);
+  }
+
+  while (finished < subscribers)
+  {
+    co_await ctx.get_scheduler().schedule();
+  }
+
+  // Each message exists once; every subscriber got that same object.
+  for ([[maybe_unused]] const auto &s : seen)
+  {
+    assert(s.size() == messages);
+    for (std::size_t i = 0; i < s.size(); ++i)
+    {
+      assert(s[i] == sent[i].get());
+    }
+  }
+  assert(ch.subscriber_count() == 0);
+}
+
+static void test_lag_report(io_context &ctx)
+{
+  channel ch(ctx.get_scheduler(), 4);
+  auto sub = ch.subscribe();
+
+  for (int i = 0; i < 10; ++i)
+  {
+    ch.send(std::to_string(i));
+  }
+
+  // Six were overwritten; the next four are still there.
+  [[maybe_unused]] const bool lost = throws(make_error_code(errc::overflow), sub);
+  assert(lost);
+  assert(sub.lagged() == 6);
+  for (int i = 6; i < 10; ++i)
+  {
+    [[maybe_unused]] auto m = sub.try_recv();
+    assert(m && **m == std::to_string(i));
+  }
+  [[maybe_unused]] const auto none = sub.try_recv();
+  assert(!none);
+  assert(ch.subscriber_count() == 1);
+}
+
+static void test_lag_disconnect(io_context &ctx)
+{
+  channel ch(ctx.get_scheduler(), 2, lag_policy::disconnect);
+  auto slow = ch.subscribe();
+  auto fast = ch.subscribe();
+
+  for (int i = 0; i < 3; ++i)
+  {
+    ch.send(std::to_string(i));
+    [[maybe_unused]] const auto got = fast.try_recv();
+    assert(got);
+  }
+
+  [[maybe_unused]] const bool dropped = throws(make_error_code(errc::overflow), slow);
+  [[maybe_unused]] const bool still_dropped = throws(make_error_code(errc::overflow), slow);
+  assert(dropped && still_dropped);
+  assert(ch.subscriber_count() == 1);
+  [[maybe_unused]] const std::size_t receivers = ch.send("3");
+  assert(receivers == 1);
+}
+
+static task<void> test_close(io_context &ctx)
+{
+  auto ch = std::make_unique<channel>(ctx.get_scheduler(), 4);
+  auto sub = ch->subscribe();
+  ch->send("last");
+
+  auto closer = [&]() -> task<int>
+  {
+    co_await ctx.get_scheduler().schedule();
+    ch.reset();
+    co_return 0;
+  };
+  auto waiter = [&]() -> task<bool>
+  {
+    [[maybe_unused]] channel::message m = co_await sub.recv();
+    assert(*m == "last");
+    try
+    {
+      (void)co_await sub.recv();
+    }
+    catch (const std::system_error &e)
+    {
+      co_return e.code() == make_error_code(errc::closed);
+    }
+    co_return false;
+  };
+
+  auto both = when_all(ctx.get_scheduler(), waiter(), closer());
+  [[maybe_unused]] auto [closed, ignored] = co_await std::move(both);
+  assert(closed);
+}
+
+int main()
+{
+  io_context ctx;
+  std::thread loop([&]()
+                   { ctx.run(); });
+
+  test_lag_report(ctx);
+  test_lag_disconnect(ctx);
+
+  auto done = std::make_shared<std::promise<void>>();
+  auto fut = done->get_future();
+
+  auto wrapper = [done, &ctx]() -> task<void>
+  {
+    try
+    {
+      co_await fan_out(ctx);
+      co_await test_close(ctx);
+      done->set_value();
+    }
+    catch (...)
+    {
+      done->set_exception(std::current_exception());
+    }
+  };
+  std::move(wrapper()).start(ctx.get_scheduler());
+
+  fut.get();
+
+  ctx.stop();
+  loop.join();
+
+  std::cout << "async_broadcast_smoke: OK\n";
+  return 0;
+}
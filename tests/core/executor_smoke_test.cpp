@@ -0,0 +1,163 @@
+/**
+ *
+ *  @file executor_smoke_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <system_error>
+#include <thread>
+
+#include <unistd.h>
+
+#include <vix/async/core/executor.hpp>
+#include <vix/async/core/io_context.hpp>
+#include <vix/async/core/task.hpp>
+#include <vix/async/core/thread_pool.hpp>
+#include <vix/async/core/timer.hpp>
+#include <vix/async/core/when.hpp>
+#include <vix/async/net/tcp.hpp>
+
+using namespace vix::async::core;
+using namespace vix::async::net;
+using namespace std::chrono_literals;
+
+static task<std::unique_ptr<tcp_stream>> accept_one(tcp_listener &listener)
+{
+  co_return co_await listener.async_accept();
+}
+
+static task<std::unique_ptr<tcp_stream>> connect_to(io_context &ctx, std::uint16_t port)
+{
+  auto s = make_tcp_stream(ctx);
+  const tcp_endpoint ep{"127.0.0.1", port};
+  co_await s->async_connect(ep);
+  co_return s;
+}
+
+static task<void> run(io_context &ctx, thread_pool &pool, [[maybe_unused]] std::thread::id loop_id)
+{
+  const executor on_loop = ctx.get_scheduler().get_executor();
+  const executor on_pool = pool.get_executor();
+
+  // Started on the scheduler: timers resume there, as before.
+  assert(current_executor() == on_loop);
+  co_await ctx.timers().sleep_for(1ms);
+  assert(std::this_thread::get_id() == loop_id);
+
+  // Moved to the pool, timers and sockets resume on a worker.
+  co_await resume_on(on_pool);
+  assert(current_executor() == on_pool);
+  assert(std::this_thread::get_id() != loop_id);
+
+  co_await ctx.timers().sleep_for(1ms);
+  assert(current_executor() == on_pool);
+  assert(std::this_thread::get_id() != loop_id);
+
+  auto listener = make_tcp_listener(ctx);
+  const auto base = static_cast<std::uint16_t>(30000 + (::getpid() + 7919) % 20000);
+  std::uint16_t port = 0;
+  for (std::uint16_t i = 0; i < 16 && port == 0; ++i)
+  {
+    const tcp_endpoint bind_ep{"127.0.0.1", static_cast<std::uint16_t>(base + i)};
+    try
+    {
+      co_await listener->async_listen(bind_ep);
+      port = bind_ep.port;
+    }
+    catch (const std::system_error &)
+    {
+      listener = make_tcp_listener(ctx);
+    }
+  }
+  assert(port != 0);
+  assert(current_executor() == on_pool);
+
+  auto pair = when_all(ctx.get_scheduler(), accept_one(*listener), connect_to(ctx, port));
+  auto [server, client] = co_await std::move(pair);
+
+  // when_all completes on the scheduler it was given.
+  co_await resume_on(on_pool);
+
+  std::array<std::byte, 16> out{};
+  out[0] = std::byte{42};
+  std::array<std::byte, 16> in{};
+
+  [[maybe_unused]] const std::size_t sent = co_await client->async_write(out);
+  assert(current_executor() == on_pool);
+  assert(std::this_thread::get_id() != loop_id);
+
+  std::size_t got = 0;
+  while (got < sent)
+  {
+    got += co_await server->async_read(std::span<std::byte>(in).subspan(got));
+    assert(current_executor() == on_pool);
+    assert(std::this_thread::get_id() != loop_id);
+  }
+  assert(in[0] == std::byte{42});
+
+  // Inline: the timer thread resumes the coroutine and it stays inline.
+  co_await resume_on(executor::inline_executor());
+  co_await ctx.timers().sleep_for(1ms);
+  assert(current_executor().is_inline());
+  assert(std::this_thread::get_id() != loop_id);
+
+  // And back.
+  co_await resume_on(on_loop);
+  assert(std::this_thread::get_id() == loop_id);
+  assert(current_executor() == on_loop);
+
+  client->close();
+  server->close();
+  listener->close();
+}
+
+int main()
+{
+  io_context ctx;
+  std::thread loop([&]()
+                   { ctx.run(); });
+
+  thread_pool pool(ctx, 2);
+
+  auto done = std::make_shared<std::promise<void>>();
+  auto fut = done->get_future();
+
+  auto wrapper = [done, &ctx, &pool, loop_id = loop.get_id()]() -> task<void>
+  {
+    try
+    {
+      co_await run(ctx, pool, loop_id);
+      done->set_value();
+    }
+    catch (...)
+    {
+      done->set_exception(std::current_exception());
+    }
+  };
+  std::move(wrapper()).start(ctx.get_scheduler());
+
+  fut.get();
+
+  pool.shutdown();
+  ctx.stop();
+  loop.join();
+
+  std::cout << "async_executor_smoke: OK\n";
+  return 0;
+}
@@ -0,0 +1,68 @@
+/**
+ *
+ *  @file log_smoke_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <vix/async/detail/log.hpp>
+
+namespace detail = vix::async::detail;
+
+[[maybe_unused]] static std::string fmt(std::string_view f, int a, const char *b)
+{
+  std::ostringstream os;
+  detail::format_into(os, f, a, b);
+  return os.str();
+}
+
+static void test_format()
+{
+  assert(fmt("posted {} items to {}", 3, "sched") == "posted 3 items to sched");
+  assert(fmt("{{literal}} {}", 1, "x") == "{literal} 1");
+  assert(fmt("no placeholders", 1, "x") == "no placeholders");
+  assert(fmt("{} {} {}", 1, "x") == "1 x ");
+}
+
+static int g_evaluated = 0;
+
+static std::string expensive()
+{
+  ++g_evaluated;
+  return "expensive";
+}
+
+static void test_lazy_arguments()
+{
+  detail::set_log_level(detail::log_level::error);
+
+  ASYNC_LOG_DEBUG("value={}", expensive());
+  ASYNC_LOG_INFO(expensive());
+  assert(g_evaluated == 0);
+
+  detail::set_log_level(detail::log_level::off);
+  ASYNC_LOG_ERROR("err {}", expensive());
+  assert(g_evaluated == 0);
+
+  detail::set_log_level(detail::log_level::info);
+}
+
+int main()
+{
+  test_format();
+  test_lazy_arguments();
+
+  std::cout << "async_log_smoke: OK\n";
+  return 0;
+}
@@ -0,0 +1,170 @@
+/**
+ *
+ *  @file metrics_smoke_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <vix/async/core/io_context.hpp>
+#include <vix/async/core/metrics.hpp>
+#include <vix/async/core/thread_pool.hpp>
+#include <vix/async/core/timer.hpp>
+
+using namespace vix::async::core;
+
+static void test_histogram()
+{
+  latency_histogram h;
+  h.record(0);
+  h.record(1000);
+  h.record(1000);
+  h.record(1u << 20);
+
+  [[maybe_unused]] const auto s = h.snapshot();
+  assert(s.count == 4);
+  assert(s.min_ns == 0);
+  assert(s.max_ns == (1u << 20));
+  assert(s.sum_ns == 2000 + (1u << 20));
+  assert(s.percentile(0.5) >= 1000 && s.percentile(0.5) <= 1000 + 1000 / 16);
+  assert(s.percentile(1.0) == (1u << 20));
+}
+
+static void test_histogram_layout()
+{
+  using hs = histogram_snapshot;
+
+  // Small values are exact, larger ones keep a bounded relative error.
+  for (std::uint64_t v = 0; v < hs::sub_bucket_count; ++v)
+  {
+    assert(hs::bucket_lower_bound(hs::bucket_index(v)) == v);
+  }
+
+  for (std::uint64_t v = 1; v < (std::uint64_t{1} << 39); v = v * 3 + 7)
+  {
+    [[maybe_unused]] const std::size_t i = hs::bucket_index(v);
+    assert(hs::bucket_lower_bound(i) <= v && v < hs::bucket_upper_bound(i));
+    assert((hs::bucket_upper_bound(i) - hs::bucket_lower_bound(i)) * hs::sub_bucket_count <= (v < hs::sub_bucket_count ? hs::sub_bucket_count : v));
+  }
+
+  assert(hs::bucket_index(~std::uint64_t{0}) == hs::bucket_count - 1);
+}
+
+static void test_histogram_threads()
+{
+  latency_histogram h;
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < 8; ++t)
+  {
+    threads.emplace_back([&h, t]()
+                         {
+                           for (std::uint64_t i = 1; i <= 10000; ++i)
+                           {
+                             h.record(i * static_cast<std::uint64_t>(t + 1));
+                           } });
+  }
+
+  for (auto &t : threads)
+  {
+    t.join();
+  }
+
+  [[maybe_unused]] const auto s = h.snapshot();
+  assert(s.count == 80000);
+  assert(s.min_ns == 1);
+  assert(s.max_ns == 80000);
+
+  // Exact p50 over the union is 17465; allow the bucket width.
+  [[maybe_unused]] const std::uint64_t p50 = s.percentile(0.5);
+  assert(p50 >= 17465 * 15 / 16 && p50 <= 17465 * 17 / 16);
+
+  histogram_snapshot twice = s;
+  twice.merge(s);
+  assert(twice.count == 2 * s.count);
+  assert(twice.percentile(0.5) == p50);
+}
+
+static void test_runtime()
+{
+  io_context ctx;
+  std::atomic<int> done{0};
+
+  std::thread loop([&]()
+                   { ctx.run(); });
+
+  for (int i = 0; i < 10; ++i)
+  {
+    ctx.post([&]()
+             { done.fetch_add(1); });
+  }
+
+  ctx.cpu_pool().submit(std::function<void()>([&]()
+                                              { done.fetch_add(1); }));
+  ctx.timers().after(std::chrono::milliseconds(1), [&]()
+                     { done.fetch_add(1); });
+
+  for (int i = 0; i < 200 && done.load() < 12; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  assert(done.load() == 12);
+
+  const auto m = ctx.metrics();
+
+#if ASYNC_ENABLE_METRICS
+  // 10 direct posts plus the timer dispatch.
+  assert(m.scheduler.fn_posts >= 11);
+  assert(m.scheduler.fn_runs >= 11);
+  assert(m.scheduler.loop_iterations >= 11);
+  assert(m.scheduler.queue_depth_hwm >= 1);
+  assert(m.cpu_pool.submitted == 1);
+  assert(m.cpu_pool.completed == 1);
+  assert(m.timers.scheduled == 1);
+  assert(m.timers.fired == 1);
+  assert(m.timers.queue_size == 0);
+#endif
+
+#if ASYNC_ENABLE_HISTOGRAMS
+  assert(m.scheduler.post_to_resume.count >= 11);
+  assert(m.cpu_pool.run_time.count == 1);
+  assert(m.timers.lateness.count == 1);
+#else
+  assert(m.scheduler.post_to_resume.count == 0);
+#endif
+
+  std::ostringstream os;
+  write_prometheus(os, m);
+  const std::string text = os.str();
+  assert(text.find("# TYPE vix_async_scheduler_fn_posts_total counter") != std::string::npos);
+  assert(text.find("vix_async_scheduler_post_to_resume_seconds_bucket{le=\"+Inf\"}") != std::string::npos);
+
+  ctx.stop();
+  loop.join();
+}
+
+int main()
+{
+  test_histogram();
+  test_histogram_layout();
+  test_histogram_threads();
+  test_runtime();
+
+  std::cout << "async_metrics_smoke: OK\n";
+  return 0;
+}
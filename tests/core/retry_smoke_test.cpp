@@ -0,0 +1,255 @@
+/**
+ *
+ *  @file retry_smoke_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <system_error>
+#include <thread>
+
+#include <vix/async/core/cancel.hpp>
+#include <vix/async/core/error.hpp>
+#include <vix/async/core/io_context.hpp>
+#include <vix/async/core/retry.hpp>
+#include <vix/async/core/task.hpp>
+
+using namespace vix::async::core;
+using namespace std::chrono_literals;
+
+static void test_backoff()
+{
+  retry_policy p;
+  p.initial_backoff = 10ms;
+  p.max_backoff = 35ms;
+  p.jitter = false;
+
+  assert(backoff_delay(p, 1) == 10ms);
+  assert(backoff_delay(p, 2) == 20ms);
+  assert(backoff_delay(p, 3) == 35ms);
+  assert(backoff_delay(p, 60) == 35ms);
+
+  p.jitter = true;
+  for (std::uint32_t r = 1; r < 200; ++r)
+  {
+    [[maybe_unused]] const auto d = backoff_delay(p, r % 5 + 1);
+    assert(d >= timer::duration::zero() && d <= 35ms);
+  }
+}
+
+static void test_budget()
+{
+  retry_budget b(4.0, 0.5);
+  assert(b.allows_retry());
+
+  b.record_failure();
+  assert(b.allows_retry());
+  b.record_failure();
+  assert(!b.allows_retry()); // 2 of 4: not more than half
+
+  b.record_success();
+  assert(b.allows_retry());
+  assert(b.tokens() == 2.5);
+
+  for (int i = 0; i < 10; ++i)
+  {
+    b.record_success();
+  }
+  assert(b.tokens() == 4.0);
+}
+
+static task<int> fail_until(int *calls, int ok_at, errc e)
+{
+  ++*calls;
+  if (*calls < ok_at)
+  {
+    throw std::system_error(make_error_code(e));
+  }
+  co_return *calls;
+}
+
+template <typename Fn>
+static task<std::error_code> error_of(Fn fn)
+{
+  try
+  {
+    co_await fn();
+  }
+  catch (const std::system_error &e)
+  {
+    co_return e.code();
+  }
+  co_return std::error_code{};
+}
+
+static task<void> run(io_context &ctx)
+{
+  retry_policy p;
+  p.initial_backoff = 1ms;
+  p.max_backoff = 2ms;
+  p.max_attempts = 4;
+
+  // Transient failures, then success.
+  {
+    int calls = 0;
+    [[maybe_unused]] const int v = co_await retry(ctx, p, [&]
+                                 { return fail_until(&calls, 3, errc::timeout); });
+    assert(v == 3 && calls == 3);
+  }
+
+  // Attempts exhausted: the last error comes through.
+  {
+    int calls = 0;
+    [[maybe_unused]] const auto ec = co_await error_of([&]() -> task<void>
+                                      { co_await retry(ctx, p, [&]
+                                                       { return fail_until(&calls, 100, errc::queue_full); }); });
+    assert(ec == errc::queue_full && calls == 4);
+  }
+
+  // Not retryable by default.
+  {
+    int calls = 0;
+    [[maybe_unused]] const auto ec = co_await error_of([&]() -> task<void>
+                                      { co_await retry(ctx, p, [&]
+                                                       { return fail_until(&calls, 100, errc::invalid_argument); }); });
+    assert(ec == errc::invalid_argument && calls == 1);
+  }
+
+  // Custom predicate.
+  {
+    retry_policy custom = p;
+    custom.retryable = [](const std::error_code &ec)
+    {
+      return ec == errc::closed;
+    };
+    int calls = 0;
+    [[maybe_unused]] const int v = co_await retry(ctx, custom, [&]
+                                 { return fail_until(&calls, 2, errc::closed); });
+    assert(v == 2 && calls == 2);
+  }
+
+  // void tasks.
+  {
+    int calls = 0;
+    auto once = [&]() -> task<void>
+    {
+      co_await fail_until(&calls, 2, errc::rejected);
+    };
+    co_await retry(ctx, p, once);
+    assert(calls == 2);
+  }
+
+  // A shared budget stops retries once half of it is spent.
+  {
+    retry_policy budgeted = p;
+    budgeted.budget = std::make_shared<retry_budget>(4.0, 0.1);
+
+    int calls = 0;
+    [[maybe_unused]] const auto first = co_await error_of([&]() -> task<void>
+                                         { co_await retry(ctx, budgeted, [&]
+                                                          { return fail_until(&calls, 100, errc::timeout); }); });
+    assert(first == errc::timeout && calls == 2);
+
+    calls = 0;
+    [[maybe_unused]] const auto second = co_await error_of([&]() -> task<void>
+                                          { co_await retry(ctx, budgeted, [&]
+                                                           { return fail_until(&calls, 100, errc::timeout); }); });
+    assert(second == errc::timeout && calls == 1);
+  }
+
+  // Cancelled before the backoff: errc::canceled without sleeping.
+  {
+    retry_policy slow = p;
+    slow.initial_backoff = 1s;
+    slow.max_backoff = 1s;
+    slow.jitter = false;
+
+    cancel_source cs;
+    int calls = 0;
+    auto failing = [&]()
+    {
+      cs.request_cancel();
+      return fail_until(&calls, 100, errc::timeout);
+    };
+    const auto start = std::chrono::steady_clock::now();
+    [[maybe_unused]] const auto ec = co_await error_of([&]() -> task<void>
+                                      { co_await retry(ctx, slow, failing, cs.token()); });
+    [[maybe_unused]] const auto elapsed = std::chrono::steady_clock::now() - start;
+    assert(ec == errc::canceled && calls == 1);
+    assert(elapsed < 500ms);
+  }
+
+  // Cancelled during the backoff: reported when the backoff ends, with no
+  // further attempt.
+  {
+    retry_policy slow = p;
+    slow.initial_backoff = 100ms;
+    slow.max_backoff = 100ms;
+    slow.jitter = false;
+
+    cancel_source cs;
+    auto canceller = [&]() -> task<void>
+    {
+      auto pause = ctx.timers().sleep_for(10ms);
+      co_await std::move(pause);
+      cs.request_cancel();
+    };
+    std::move(canceller()).start(ctx.get_scheduler());
+
+    int calls = 0;
+    const auto start = std::chrono::steady_clock::now();
+    [[maybe_unused]] const auto ec = co_await error_of([&]() -> task<void>
+                                      { co_await retry(ctx, slow, [&]
+                                                       { return fail_until(&calls, 100, errc::timeout); },
+                                                       cs.token()); });
+    [[maybe_unused]] const auto elapsed = std::chrono::steady_clock::now() - start;
+    assert(ec == errc::canceled && calls == 1);
+    assert(elapsed >= 100ms && elapsed < 100ms + 2s);
+  }
+}
+
+int main()
+{
+  test_backoff();
+  test_budget();
+
+  io_context ctx;
+  std::thread loop([&]()
+                   { ctx.run(); });
+
+  auto done = std::make_shared<std::promise<void>>();
+  auto fut = done->get_future();
+
+  auto wrapper = [done, &ctx]() -> task<void>
+  {
+    try
+    {
+      co_await run(ctx);
+      done->set_value();
+    }
+    catch (...)
+    {
+      done->set_exception(std::current_exception());
+    }
+  };
+  std::move(wrapper()).start(ctx.get_scheduler());
+
+  fut.get();
+
+  ctx.stop();
+  loop.join();
+
+  std::cout << "async_retry_smoke: OK\n";
+  return 0;
+}
@@ -16,11 +16,69 @@
 #include <iostream>
 #include <thread>
 #include <chrono>
+#include <system_error>
 
+#include <vix/async/core/error.hpp>
 #include <vix/async/core/scheduler.hpp>
 
 using vix::async::core::scheduler;
 
+// Items that each run for 3ms keep the queue delay above a 1ms target, so
+// admission control must kick in within one 10ms interval and clear once
+// the loop goes idle.
+static void test_admission()
+{
+  using namespace std::chrono_literals;
+
+  scheduler sched;
+  sched.set_admission({1ms, 10ms});
+
+  std::atomic<int> done{0};
+  std::atomic<bool> saw_overload{false};
+  std::atomic<bool> rejected{false};
+
+  for (int i = 0; i < 20; ++i)
+  {
+    sched.post([&]()
+               {
+                 std::this_thread::sleep_for(3ms);
+                 if (sched.overloaded())
+                 {
+                   saw_overload = true;
+                   try
+                   {
+                     sched.admit();
+                   }
+                   catch (const std::system_error &e)
+                   {
+                     rejected = e.code() == vix::async::core::errc::rejected;
+                   }
+                 }
+                 done.fetch_add(1); });
+  }
+
+  std::thread loop([&]()
+                   { sched.run(); });
+
+  while (done.load() < 20)
+  {
+    std::this_thread::sleep_for(1ms);
+  }
+  std::this_thread::sleep_for(5ms);
+
+  assert(saw_overload.load());
+  assert(rejected.load());
+  assert(!sched.overloaded());
+  assert(sched.try_admit());
+#if ASYNC_ENABLE_METRICS
+  assert(sched.metrics().snapshot().overloads >= 1);
+  assert(sched.metrics().snapshot().rejected >= 1);
+#endif
+
+  sched.stop();
+  loop.join();
+}
+
 int main()
 {
   scheduler sched;
@@ -56,6 +114,8 @@ int main()
   // It can never be less if run() started correctly and we waited a bit.
   assert(counter.load() >= 12);
 
+  test_admission();
+
   std::cout << "async_scheduler_smoke: OK\n";
   return 0;
 }
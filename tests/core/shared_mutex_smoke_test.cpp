@@ -0,0 +1,309 @@
+/**
+ *
+ *  @file shared_mutex_smoke_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <vix/async/core/executor.hpp>
+#include <vix/async/core/io_context.hpp>
+#include <vix/async/core/shared_mutex.hpp>
+#include <vix/async/core/task.hpp>
+#include <vix/async/core/thread_pool.hpp>
+
+using namespace vix::async::core;
+
+static void test_try()
+{
+  async_shared_mutex m;
+
+  [[maybe_unused]] bool ok = m.try_lock_shared();
+  assert(ok);
+  ok = m.try_lock_shared();
+  assert(ok);
+  ok = m.try_lock();
+  assert(!ok);
+  m.unlock_shared();
+  m.unlock_shared();
+
+  ok = m.try_lock();
+  assert(ok);
+  ok = m.try_lock_shared();
+  assert(!ok);
+  m.unlock();
+
+  ok = m.try_lock_shared();
+  assert(ok);
+  m.unlock_shared();
+}
+
+static task<void> reader(async_shared_mutex &m, std::vector<std::string> &log, std::string name)
+{
+  auto g = co_await m.scoped_lock_shared();
+  log.push_back(name);
+}
+
+static task<void> writer(async_shared_mutex &m, std::vector<std::string> &log, std::string name)
+{
+  auto g = co_await m.scoped_lock();
+  log.push_back(name);
+}
+
+// Everything runs on the scheduler thread, so the order is exact.
+static task<void> test_order(io_context &ctx)
+{
+  scheduler &s = ctx.get_scheduler();
+  async_shared_mutex m;
+  std::vector<std::string> log;
+
+  // A waiting writer stops new readers; they go in one batch after it.
+  co_await m.lock_shared();
+  std::move(writer(m, log, "w1")).start(s);
+  std::move(reader(m, log, "r1")).start(s);
+  std::move(reader(m, log, "r2")).start(s);
+  std::move(writer(m, log, "w2")).start(s);
+  std::move(reader(m, log, "r3")).start(s);
+  co_await s.schedule();
+  assert(log.empty());
+  [[maybe_unused]] bool ok = m.try_lock_shared();
+  assert(!ok);
+
+  m.unlock_shared();
+  for (int i = 0; i < 10; ++i)
+  {
+    co_await s.schedule();
+  }
+
+  // w1 first; its unlock admits r1, r2 and r3 together although w2 waits,
+  // then w2.
+  const std::vector<std::string> expected{"w1", "r1", "r2", "r3", "w2"};
+  assert(log == expected);
+
+  ok = m.try_lock();
+  assert(ok);
+  m.unlock();
+}
+
+// Writers keep two counters equal; readers on pool threads must never see
+// them differ.
+static task<void> stress_worker(io_context &ctx, thread_pool &pool, async_shared_mutex &m,
+                                std::uint64_t (&pair)[2], std::atomic<int> &torn, int id)
+{
+  co_await resume_on(pool.get_executor());
+  for (int i = 0; i < 2000; ++i)
+  {
+    if ((i + id) % 10 == 0)
+    {
+      auto g = co_await m.scoped_lock();
+      ++pair[0];
+      ++pair[1];
+    }
+    else
+    {
+      auto g = co_await m.scoped_lock_shared();
+      if (pair[0] != pair[1])
+      {
+        torn.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  }
+  co_await resume_on(ctx.get_scheduler().get_executor());
+}
+
+static task<void> test_stress(io_context &ctx)
+{
+  thread_pool pool(ctx, 4);
+  async_shared_mutex m;
+  std::uint64_t pair[2] = {0, 0};
+  std::atomic<int> torn{0};
+
+  std::vector<task<void>> workers;
+  for (int id = 0; id < 8; ++id)
+  {
+    workers.push_back(stress_worker(ctx, pool, m, pair, torn, id));
+  }
+  for (auto &w : workers)
+  {
+    co_await w;
+  }
+
+  assert(torn.load() == 0);
+  assert(pair[0] == 8 * 200 && pair[1] == pair[0]);
+  pool.shutdown();
+}
+
+// Occupancy of the lock, checked on every entry.
+struct occupancy
+{
+  std::atomic<int> readers{0};
+  std::atomic<int> writers{0};
+  std::atomic<int> violations{0};
+
+  void enter_shared()
+  {
+    readers.fetch_add(1);
+    if (writers.load() != 0)
+    {
+      violations.fetch_add(1);
+    }
+  }
+
+  void leave_shared()
+  {
+    readers.fetch_sub(1);
+  }
+
+  void enter_unique()
+  {
+    if (writers.fetch_add(1) != 0 || readers.load() != 0)
+    {
+      violations.fetch_add(1);
+    }
+  }
+
+  void leave_unique()
+  {
+    writers.fetch_sub(1);
+  }
+};
+
+// Coroutines mix lock(), try_lock() and lock_shared() while plain threads
+// take the lock with try_lock(), which sets writer_bit without the mutex's
+// internal lock, racing readers in their slow path. Readers and writers
+// must never overlap.
+static task<void> exclusion_worker(io_context &ctx, thread_pool &pool, async_shared_mutex &m,
+                                   occupancy &occ, int id)
+{
+  co_await resume_on(pool.get_executor());
+  for (int i = 0; i < 3000; ++i)
+  {
+    const int mode = (i + id) % 8;
+    if (mode == 0)
+    {
+      co_await m.lock();
+      occ.enter_unique();
+      occ.leave_unique();
+      m.unlock();
+    }
+    else if (mode == 1 && m.try_lock())
+    {
+      occ.enter_unique();
+      occ.leave_unique();
+      m.unlock();
+    }
+    else
+    {
+      co_await m.lock_shared();
+      occ.enter_shared();
+      occ.leave_shared();
+      m.unlock_shared();
+    }
+  }
+  co_await resume_on(ctx.get_scheduler().get_executor());
+}
+
+static task<void> test_exclusion(io_context &ctx)
+{
+  thread_pool pool(ctx, 4);
+  async_shared_mutex m;
+  occupancy occ;
+  std::atomic<bool> stop{false};
+
+  std::vector<std::thread> grabbers;
+  for (int t = 0; t < 2; ++t)
+  {
+    grabbers.emplace_back([&]()
+                          {
+      while (!stop.load())
+      {
+        if (m.try_lock())
+        {
+          // Hold it for a while so readers take the slow path.
+          occ.enter_unique();
+          std::this_thread::yield();
+          occ.leave_unique();
+          m.unlock();
+        }
+        else if (m.try_lock_shared())
+        {
+          occ.enter_shared();
+          occ.leave_shared();
+          m.unlock_shared();
+        }
+      } });
+  }
+
+  std::vector<task<void>> workers;
+  for (int id = 0; id < 8; ++id)
+  {
+    workers.push_back(exclusion_worker(ctx, pool, m, occ, id));
+  }
+  for (auto &w : workers)
+  {
+    co_await w;
+  }
+
+  stop = true;
+  for (auto &g : grabbers)
+  {
+    g.join();
+  }
+  pool.shutdown();
+
+  assert(occ.violations.load() == 0);
+  [[maybe_unused]] const bool free = m.try_lock();
+  assert(free);
+  m.unlock();
+}
+
+int main()
+{
+  test_try();
+
+  io_context ctx;
+  std::thread loop([&]()
+                   { ctx.run(); });
+
+  auto done = std::make_shared<std::promise<void>>();
+  auto fut = done->get_future();
+
+  auto wrapper = [done, &ctx]() -> task<void>
+  {
+    try
+    {
+      co_await test_order(ctx);
+      co_await test_stress(ctx);
+      co_await test_exclusion(ctx);
+      done->set_value();
+    }
+    catch (...)
+    {
+      done->set_exception(std::current_exception());
+    }
+  };
+  std::move(wrapper()).start(ctx.get_scheduler());
+
+  fut.get();
+
+  ctx.stop();
+  loop.join();
+
+  std::cout << "async_shared_mutex_smoke: OK\n";
+  return 0;
+}
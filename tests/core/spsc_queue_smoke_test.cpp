@@ -0,0 +1,190 @@
+/**
+ *
+ *  @file spsc_queue_smoke_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <vix/async/core/error.hpp>
+#include <vix/async/core/io_context.hpp>
+#include <vix/async/core/spsc_queue.hpp>
+#include <vix/async/core/task.hpp>
+
+using namespace vix::async::core;
+
+static void test_ring(io_context &ctx)
+{
+  spsc_queue<std::string> q(ctx.get_scheduler(), 3);
+  assert(q.capacity() == 4);
+
+  for (int i = 0; i < 4; ++i)
+  {
+    [[maybe_unused]] const bool ok = q.try_push(std::to_string(i));
+    assert(ok);
+  }
+  [[maybe_unused]] bool full = !q.try_push(std::string("x"));
+  assert(full);
+  assert(q.size() == 4);
+
+  std::array<std::string, 3> out;
+  [[maybe_unused]] std::size_t n = q.try_pop_batch(out);
+  assert(n == 3 && out[0] == "0" && out[2] == "2");
+
+  // Wraps around the end of the ring.
+  std::vector<std::string> more{"4", "5", "6", "7"};
+  n = q.try_push_batch(more);
+  assert(n == 3);
+  full = !q.try_push(more[3]);
+  assert(full);
+
+  for (int i = 3; i < 7; ++i)
+  {
+    [[maybe_unused]] const auto v = q.try_pop();
+    assert(v && *v == std::to_string(i));
+  }
+  [[maybe_unused]] const auto none = q.try_pop();
+  assert(!none);
+}
+
+// One plain thread pushes, a coroutine on the io_context pops; values must
+// arrive complete and in order, then the close.
+static task<void> test_threads(io_context &ctx)
+{
+  constexpr std::uint64_t count = 200'000;
+  spsc_queue<std::uint64_t> q(ctx.get_scheduler(), 256);
+
+  std::thread producer([&q]()
+                       {
+    std::vector<std::uint64_t> batch;
+    std::uint64_t next = 0;
+    while (next < count)
+    {
+      if (next % 3 == 0)
+      {
+        batch.clear();
+        for (std::uint64_t i = next; i < count && i < next + 16; ++i)
+        {
+          batch.push_back(i);
+        }
+        next += q.try_push_batch(batch);
+      }
+      else if (q.try_push(next))
+      {
+        ++next;
+      }
+      else
+      {
+        std::this_thread::yield();
+      }
+    }
+    q.close(); });
+
+  std::uint64_t expected = 0;
+  [[maybe_unused]] bool ordered = true;
+  std::array<std::uint64_t, 32> buf{};
+  try
+  {
+    for (;;)
+    {
+      if (expected % 2 == 0)
+      {
+        const std::size_t n = co_await q.pop_batch(buf);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+          ordered = ordered && buf[i] == expected++;
+        }
+      }
+      else
+      {
+        const std::uint64_t v = co_await q.pop();
+        ordered = ordered && v == expected++;
+      }
+    }
+  }
+  catch (const std::system_error &e)
+  {
+    assert(e.code() == make_error_code(errc::closed));
+  }
+
+  producer.join();
+  assert(ordered);
+  assert(expected == count);
+}
+
+// Values pushed before close() are still delivered.
+static task<void> test_close(io_context &ctx)
+{
+  spsc_queue<int> q(ctx.get_scheduler(), 8);
+  q.try_push(1);
+  q.try_push(2);
+  q.close();
+  assert(q.is_closed());
+
+  [[maybe_unused]] const int a = co_await q.pop();
+  [[maybe_unused]] const int b = co_await q.pop();
+  assert(a == 1 && b == 2);
+
+  [[maybe_unused]] bool closed = false;
+  try
+  {
+    (void)co_await q.pop();
+  }
+  catch (const std::system_error &e)
+  {
+    closed = e.code() == make_error_code(errc::closed);
+  }
+  assert(closed);
+}
+
+int main()
+{
+  io_context ctx;
+  std::thread loop([&]()
+                   { ctx.run(); });
+
+  test_ring(ctx);
+
+  auto done = std::make_shared<std::promise<void>>();
+  auto fut = done->get_future();
+
+  auto wrapper = [done, &ctx]() -> task<void>
+  {
+    try
+    {
+      co_await test_threads(ctx);
+      co_await test_close(ctx);
+      done->set_value();
+    }
+    catch (...)
+    {
+      done->set_exception(std::current_exception());
+    }
+  };
+  std::move(wrapper()).start(ctx.get_scheduler());
+
+  fut.get();
+
+  ctx.stop();
+  loop.join();
+
+  std::cout << "async_spsc_queue_smoke: OK\n";
+  return 0;
+}
@@ -0,0 +1,162 @@
+/**
+ *
+ *  @file task_registry_smoke_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+#include <vix/async/core/io_context.hpp>
+#include <vix/async/core/signal.hpp>
+#include <vix/async/core/task.hpp>
+#include <vix/async/core/task_registry.hpp>
+#include <vix/async/core/timer.hpp>
+
+using namespace vix::async::core;
+
+static task<void> leaf(io_context &ctx, std::atomic<bool> &suspended)
+{
+  suspended.store(true);
+  co_await ctx.timers().sleep_for(std::chrono::milliseconds(150));
+}
+
+static task<void> middle(io_context &ctx, std::atomic<bool> &suspended)
+{
+  co_await leaf(ctx, suspended);
+}
+
+static task<void> root(io_context &ctx, std::atomic<bool> &suspended, std::atomic<bool> &done)
+{
+  co_await middle(ctx, suspended);
+  done.store(true);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+// The dump subscribes next to an app's stop handler instead of replacing
+// it: each signal reaches its own callback only.
+static void test_signal_dump()
+{
+  io_context ctx;
+  std::thread loop([&]()
+                   { ctx.run(); });
+
+  std::atomic<int> app_calls{0};
+  std::atomic<bool> stopped{false};
+  auto &signals = ctx.signals();
+  signals.add(SIGTERM);
+  signals.on_signal([&](int s)
+                    {
+    app_calls.fetch_add(1);
+    stopped = s == SIGTERM; });
+
+  std::ostringstream dump;
+  std::streambuf *const saved = std::cerr.rdbuf(dump.rdbuf());
+  install_async_stack_dump(ctx, SIGUSR1);
+
+  // SIGTERM only once SIGUSR1 was taken, so the dump is posted first.
+  ::kill(::getpid(), SIGUSR1);
+  for (int i = 0; i < 400; ++i)
+  {
+    sigset_t pending;
+    sigpending(&pending);
+    if (sigismember(&pending, SIGUSR1) == 0)
+    {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  ::kill(::getpid(), SIGTERM);
+
+  for (int i = 0; i < 400 && !stopped.load(); ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  ctx.stop();
+  loop.join();
+  std::cerr.rdbuf(saved);
+
+  assert(stopped.load());
+  assert(app_calls.load() == 1);
+  assert(!dump.str().empty());
+}
+#endif
+
+int main()
+{
+#if defined(__unix__) || defined(__APPLE__)
+  // signal_set receives signals with sigwait(): every thread blocks them.
+  sigset_t set;
+  sigemptyset(&set);
+  sigaddset(&set, SIGUSR1);
+  sigaddset(&set, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &set, nullptr);
+
+  test_signal_dump();
+#endif
+
+  [[maybe_unused]] const std::size_t before = live_task_count();
+
+  io_context ctx;
+  std::atomic<bool> suspended{false};
+  std::atomic<bool> done{false};
+
+  std::thread loop([&]()
+                   { ctx.run(); });
+
+  root(ctx, suspended, done).start(ctx.get_scheduler());
+
+  for (int i = 0; i < 100 && !suspended.load(); ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+  std::ostringstream os;
+  dump_async_stacks(os);
+  const std::string dump = os.str();
+
+#if ASYNC_ENABLE_TASK_REGISTRY
+  // root, middle, leaf and the sleep_for task itself.
+  assert(live_task_count() >= before + 4);
+  assert(dump.find("awaiting=timer") != std::string::npos);
+  assert(dump.find("awaiting=task") != std::string::npos);
+  assert(dump.find("<- ") != std::string::npos);
+#else
+  assert(live_task_count() == 0);
+  assert(dump.find("disabled") != std::string::npos);
+#endif
+
+  for (int i = 0; i < 200 && !done.load(); ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  assert(done.load());
+
+  ctx.stop();
+  loop.join();
+
+  assert(live_task_count() == before);
+
+  std::cout << "async_task_registry_smoke: OK\n";
+  return 0;
+}
@@ -0,0 +1,96 @@
+/**
+ *
+ *  @file trace_smoke_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <vix/async/core/scheduler.hpp>
+#include <vix/async/core/task.hpp>
+#include <vix/async/core/trace.hpp>
+
+using namespace vix::async::core;
+
+static task<int> inner(scheduler &sched)
+{
+  co_await sched.schedule();
+  co_return 21;
+}
+
+static task<void> outer(scheduler &sched, std::atomic<int> &out)
+{
+  const int v = co_await inner(sched);
+  out.store(v * 2);
+}
+
+[[maybe_unused]] static std::size_t count(const std::string &s, const std::string &needle)
+{
+  std::size_t n = 0;
+  for (auto pos = s.find(needle); pos != std::string::npos; pos = s.find(needle, pos + 1))
+  {
+    ++n;
+  }
+  return n;
+}
+
+int main()
+{
+  trace_set_thread_name("main");
+
+  scheduler sched;
+  std::atomic<int> out{0};
+
+  std::thread loop([&]()
+                   {
+                     trace_set_thread_name("scheduler");
+                     sched.run(); });
+
+  outer(sched, out).start(sched);
+
+  for (int i = 0; i < 200 && out.load() == 0; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  assert(out.load() == 42);
+
+  sched.stop();
+  loop.join();
+
+  std::ostringstream os;
+  trace_dump_chrome(os);
+  const std::string json = os.str();
+
+  assert(json.rfind("{\"displayTimeUnit\"", 0) == 0);
+  assert(json.find("]}") != std::string::npos);
+
+#if ASYNC_ENABLE_TRACING
+  // Two tasks, each opened and closed once.
+  assert(count(json, "\"ph\":\"b\"") == 2);
+  assert(count(json, "\"ph\":\"e\"") == 2);
+  assert(json.find("\"name\":\"suspend\"") != std::string::npos);
+  assert(json.find("scheduler hop") != std::string::npos);
+  assert(json.find("\"name\":\"scheduler\"") != std::string::npos);
+  assert(count(json, "\"ph\":\"B\"") == count(json, "\"ph\":\"E\""));
+#else
+  assert(count(json, "\"ph\":\"b\"") == 0);
+#endif
+
+  trace_clear();
+
+  std::cout << "async_trace_smoke: OK\n";
+  return 0;
+}
@@ -0,0 +1,112 @@
+/**
+ *
+ *  @file virtual_time_smoke_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <vix/async/core/cancel.hpp>
+#include <vix/async/core/io_context.hpp>
+#include <vix/async/core/task.hpp>
+#include <vix/async/core/timer.hpp>
+
+using namespace vix::async::core;
+using namespace std::chrono_literals;
+
+static task<void> ticker(io_context &ctx, std::vector<std::string> &log, std::string name,
+                         timer::duration period, int count)
+{
+  for (int i = 0; i < count; ++i)
+  {
+    co_await ctx.timers().sleep_for(period);
+    log.push_back(name + std::to_string(i));
+  }
+}
+
+// Two days of hourly sleeps finish without waiting.
+static void test_long_simulation()
+{
+  io_context ctx{virtual_time};
+  assert(ctx.uses_virtual_time());
+
+  [[maybe_unused]] const timer::time_point start = ctx.timers().now();
+  std::vector<std::string> log;
+  std::move(ticker(ctx, log, "h", 1h, 48)).start(ctx.get_scheduler());
+
+  [[maybe_unused]] const auto wall = std::chrono::steady_clock::now();
+  ctx.run();
+  assert(std::chrono::steady_clock::now() - wall < 10s);
+
+  assert(log.size() == 48);
+  assert(ctx.timers().now() - start == 48h);
+}
+
+// Interleaving follows deadlines; equal deadlines keep scheduling order.
+static std::vector<std::string> interleave()
+{
+  io_context ctx{virtual_time};
+  std::vector<std::string> log;
+
+  std::move(ticker(ctx, log, "a", 3s, 3)).start(ctx.get_scheduler());
+  std::move(ticker(ctx, log, "b", 2s, 4)).start(ctx.get_scheduler());
+  std::move(ticker(ctx, log, "c", 6s, 1)).start(ctx.get_scheduler());
+
+  cancel_source cs;
+  bool fired = false;
+  bool skipped = true;
+  ctx.timers().after(5s, [&]()
+                     { fired = true; log.push_back("cb"); });
+  ctx.timers().after(4s, [&]()
+                     { skipped = false; }, cs.token());
+  cs.request_cancel();
+
+  ctx.run();
+  assert(fired && skipped);
+  return log;
+}
+
+static void test_deterministic_order()
+{
+  [[maybe_unused]] const std::vector<std::string> expected{
+      "b0", "a0", "b1", "cb", "c0", "a1", "b2", "b3", "a2"};
+
+  [[maybe_unused]] const std::vector<std::string> first = interleave();
+  [[maybe_unused]] const std::vector<std::string> second = interleave();
+  assert(first == expected);
+  assert(second == expected);
+}
+
+// run() with nothing queued and no timer returns at once.
+static void test_idle_return()
+{
+  io_context ctx{virtual_time};
+  ctx.run();
+
+  int n = 0;
+  ctx.post([&]()
+           { ++n; });
+  ctx.run();
+  assert(n == 1);
+}
+
+int main()
+{
+  test_long_simulation();
+  test_deterministic_order();
+  test_idle_return();
+
+  std::cout << "async_virtual_time_smoke: OK\n";
+  return 0;
+}
@@ -0,0 +1,85 @@
+/**
+ *
+ *  @file watchdog_smoke_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <vix/async/core/scheduler.hpp>
+#include <vix/async/core/watchdog.hpp>
+
+using namespace vix::async::core;
+using namespace std::chrono_literals;
+
+int main()
+{
+  scheduler sched;
+
+  std::mutex m;
+  std::vector<stall_info> stalls;
+
+  stall_watchdog wd(
+      sched,
+      20ms,
+      [&](const stall_info &info)
+      {
+        std::lock_guard<std::mutex> lock(m);
+        stalls.push_back(info);
+      },
+      2ms);
+
+  std::atomic<int> done{0};
+
+  std::thread loop([&]()
+                   { sched.run(); });
+
+  // Fast items must not be reported.
+  for (int i = 0; i < 100; ++i)
+  {
+    sched.post([&]()
+               { done.fetch_add(1); });
+  }
+
+  // One blocking item: reported exactly once, however long it runs.
+  sched.post([&]()
+             {
+               std::this_thread::sleep_for(80ms);
+               done.fetch_add(1); });
+
+  for (int i = 0; i < 200 && done.load() < 101; ++i)
+  {
+    std::this_thread::sleep_for(5ms);
+  }
+  assert(done.load() == 101);
+
+  // Idle loop is not a stall.
+  std::this_thread::sleep_for(50ms);
+
+  sched.stop();
+  loop.join();
+  wd.stop();
+
+  std::lock_guard<std::mutex> lock(m);
+  assert(stalls.size() == 1);
+  assert(wd.stalls() == 1);
+  assert(stalls[0].kind == scheduler::work_kind::function);
+  assert(stalls[0].duration >= 20ms);
+  assert(sched.current_item().started_ns == 0);
+
+  std::cout << "async_watchdog_smoke: OK\n";
+  return 0;
+}
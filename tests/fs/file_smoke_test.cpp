@@ -0,0 +1,216 @@
+/**
+ *
+ *  @file file_smoke_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include <vix/async/core/cancel.hpp>
+#include <vix/async/core/error.hpp>
+#include <vix/async/core/io_context.hpp>
+#include <vix/async/core/task.hpp>
+#include <vix/async/core/when.hpp>
+#include <vix/async/fs/file.hpp>
+#include <vix/async/fs/file_service.hpp>
+
+using namespace vix::async::core;
+using vix::async::fs::async_file;
+using vix::async::fs::open_mode;
+
+static std::span<const std::byte> bytes(const std::string &s)
+{
+  return std::as_bytes(std::span<const char>(s.data(), s.size()));
+}
+
+[[maybe_unused]] static std::string text(std::span<const std::byte> b)
+{
+  return std::string(reinterpret_cast<const char *>(b.data()), b.size());
+}
+
+static task<void> run(io_context &ctx, std::string path)
+{
+  // Missing file without create.
+  [[maybe_unused]] bool threw = false;
+  try
+  {
+    (void)co_await async_file::open(ctx, path + ".missing", open_mode::read);
+  }
+  catch (const std::system_error &e)
+  {
+    threw = e.code().value() == ENOENT;
+  }
+  assert(threw);
+
+  async_file f = co_await async_file::open(
+      ctx, path, open_mode::read | open_mode::write | open_mode::create | open_mode::truncate);
+  assert(f.is_open());
+  assert(f.size() == 0);
+
+  // Positional writes, with a hole in between.
+  std::string block(4096, '\0');
+  for (std::size_t i = 0; i < block.size(); ++i)
+  {
+    block[i] = static_cast<char>('a' + i % 26);
+  }
+  const std::string tail = "tail";
+
+  [[maybe_unused]] std::size_t n = co_await f.async_write_at(0, bytes(block));
+  assert(n == block.size());
+  n = co_await f.async_write_at(8192, bytes(tail));
+  assert(n == tail.size());
+  assert(f.size() == 8196);
+
+  std::vector<std::byte> buf(4096);
+  n = co_await f.async_read_at(0, buf);
+  assert(n == 4096);
+  assert(text(buf) == block);
+
+  n = co_await f.async_read_at(8192, buf);
+  assert(n == 4);
+  assert(text(std::span<const std::byte>(buf).first(4)) == tail);
+
+  n = co_await f.async_read_at(8196, buf);
+  assert(n == 0);
+
+  // Vectored I/O, including an empty buffer.
+  const std::string a = "abc";
+  const std::string b;
+  const std::string c = "defg";
+  const std::span<const std::byte> out[] = {bytes(a), bytes(b), bytes(c)};
+  n = co_await f.async_writev_at(100, out);
+  assert(n == 7);
+
+  std::vector<std::byte> x(3);
+  std::vector<std::byte> y(4);
+  const std::span<std::byte> in[] = {x, y};
+  n = co_await f.async_readv_at(100, in);
+  assert(n == 7);
+  assert(text(x) == "abc");
+  assert(text(y) == "defg");
+
+  // Several reads in flight on one file.
+  std::vector<std::byte> r1(26);
+  std::vector<std::byte> r2(26);
+  std::vector<std::byte> r3(26);
+  auto [n1, n2, n3] = co_await when_all(
+      ctx.get_scheduler(),
+      f.async_read_at(0, r1),
+      f.async_read_at(26, r2),
+      f.async_read_at(1024, r3));
+  assert(n1 == 26 && n2 == 26 && n3 == 26);
+  assert(text(r1) == block.substr(0, 26));
+  assert(text(r2) == block.substr(26, 26));
+  assert(text(r3) == block.substr(1024, 26));
+  (void)n1;
+  (void)n2;
+  (void)n3;
+
+  co_await f.async_fsync();
+  co_await f.async_fdatasync();
+
+  // Some file systems do not implement fallocate.
+  try
+  {
+    co_await f.async_fallocate(0, 65536);
+    assert(f.size() == 65536);
+  }
+  catch (const std::system_error &e)
+  {
+    assert(e.code().value() == EOPNOTSUPP);
+  }
+
+  // A cancelled token fails before submission.
+  cancel_source src;
+  src.request_cancel();
+  threw = false;
+  try
+  {
+    (void)co_await f.async_read_at(0, buf, src.token());
+  }
+  catch (const std::system_error &e)
+  {
+    threw = e.code() == cancelled_ec();
+  }
+  assert(threw);
+
+  // Moved-from files are closed; operations on a closed file fail.
+  async_file g = std::move(f);
+  assert(!f.is_open());
+  assert(g.is_open());
+
+  threw = false;
+  try
+  {
+    (void)co_await f.async_read_at(0, buf);
+  }
+  catch (const std::system_error &e)
+  {
+    threw = e.code() == make_error_code(errc::closed);
+  }
+  assert(threw);
+
+  g.close();
+  assert(!g.is_open());
+}
+
+int main()
+{
+  io_context ctx;
+  std::thread loop([&]()
+                   { ctx.run(); });
+
+  const std::string path =
+      (std::filesystem::temp_directory_path() /
+       ("vix_async_file_smoke_" + std::to_string(::getpid())))
+          .string();
+
+  auto done = std::make_shared<std::promise<void>>();
+  auto fut = done->get_future();
+
+  auto wrapper = [&ctx, path, done]() -> task<void>
+  {
+    try
+    {
+      co_await run(ctx, path);
+      done->set_value();
+    }
+    catch (...)
+    {
+      done->set_exception(std::current_exception());
+    }
+  };
+  std::move(wrapper()).start(ctx.get_scheduler());
+
+  fut.get();
+
+  const bool uring = ctx.files().uses_io_uring();
+
+  ctx.stop();
+  loop.join();
+  std::remove(path.c_str());
+
+  std::cout << "async_file_smoke: OK (" << (uring ? "io_uring" : "blocking pool") << ")\n";
+  return 0;
+}
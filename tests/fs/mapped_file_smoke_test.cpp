@@ -0,0 +1,188 @@
+/**
+ *
+ *  @file mapped_file_smoke_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <vix/async/core/cancel.hpp>
+#include <vix/async/core/error.hpp>
+#include <vix/async/core/io_context.hpp>
+#include <vix/async/core/task.hpp>
+#include <vix/async/fs/file.hpp>
+#include <vix/async/fs/mapped_file.hpp>
+
+using namespace vix::async::core;
+using vix::async::fs::async_file;
+using vix::async::fs::mapped_file;
+using vix::async::fs::open_mode;
+
+static constexpr std::size_t file_size = 1 << 20;
+
+static std::byte pattern_at(std::size_t i)
+{
+  return static_cast<std::byte>((i * 7 + 3) & 0xff);
+}
+
+[[maybe_unused]] static bool resident(std::span<const std::byte> range)
+{
+  const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  std::vector<unsigned char> vec((range.size() + page - 1) / page);
+  if (::mincore(const_cast<std::byte *>(range.data()), range.size(), vec.data()) != 0)
+  {
+    return false;
+  }
+  for (const unsigned char v : vec)
+  {
+    if ((v & 1) == 0)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+static task<void> run(io_context &ctx, std::string path)
+{
+  {
+    std::vector<std::byte> content(file_size);
+    for (std::size_t i = 0; i < content.size(); ++i)
+    {
+      content[i] = pattern_at(i);
+    }
+
+    async_file f = co_await async_file::open(ctx, path, open_mode::write | open_mode::create | open_mode::truncate);
+    (void)co_await f.async_write_at(0, content);
+  }
+
+  mapped_file m = co_await mapped_file::open(ctx, path);
+  assert(m.is_open());
+  assert(m.size() == file_size);
+
+  co_await m.prefetch(0, file_size);
+  assert(resident(m.data()));
+
+  // Unaligned range, clamped at the end.
+  co_await m.prefetch(4097, 10 * file_size);
+
+  for (std::size_t i = 0; i < file_size; i += 4093)
+  {
+    assert(m.data()[i] == pattern_at(i));
+  }
+
+  [[maybe_unused]] const auto tail = m.view(file_size - 10, 100);
+  assert(tail.size() == 10);
+  assert(tail[0] == pattern_at(file_size - 10));
+  assert(m.view(file_size, 1).empty());
+
+  [[maybe_unused]] bool threw = false;
+  try
+  {
+    (void)m.view(file_size + 1, 1);
+  }
+  catch (const std::system_error &e)
+  {
+    threw = e.code() == make_error_code(errc::invalid_argument);
+  }
+  assert(threw);
+
+  // A cancelled token fails before the pool is involved.
+  cancel_source src;
+  src.request_cancel();
+  threw = false;
+  try
+  {
+    co_await m.prefetch(0, 4096, src.token());
+  }
+  catch (const std::system_error &e)
+  {
+    threw = e.code() == cancelled_ec();
+  }
+  assert(threw);
+
+  mapped_file moved = std::move(m);
+  assert(!m.is_open() && m.data().empty());
+  assert(moved.size() == file_size);
+  moved.close();
+  assert(!moved.is_open());
+
+  // Empty files map to an open, empty view.
+  {
+    async_file f = co_await async_file::open(ctx, path, open_mode::write | open_mode::truncate);
+  }
+  mapped_file empty = co_await mapped_file::open(ctx, path);
+  assert(empty.is_open() && empty.size() == 0);
+  co_await empty.prefetch(0, 4096);
+
+  threw = false;
+  try
+  {
+    (void)co_await mapped_file::open(ctx, path + ".missing");
+  }
+  catch (const std::system_error &e)
+  {
+    threw = e.code().value() == ENOENT;
+  }
+  assert(threw);
+}
+
+int main()
+{
+  io_context ctx;
+  std::thread loop([&]()
+                   { ctx.run(); });
+
+  const std::string path =
+      (std::filesystem::temp_directory_path() /
+       ("vix_async_mapped_file_smoke_" + std::to_string(::getpid())))
+          .string();
+
+  auto done = std::make_shared<std::promise<void>>();
+  auto fut = done->get_future();
+
+  auto wrapper = [&ctx, path, done]() -> task<void>
+  {
+    try
+    {
+      co_await run(ctx, path);
+      done->set_value();
+    }
+    catch (...)
+    {
+      done->set_exception(std::current_exception());
+    }
+  };
+  std::move(wrapper()).start(ctx.get_scheduler());
+
+  fut.get();
+
+  ctx.stop();
+  loop.join();
+  std::remove(path.c_str());
+
+  std::cout << "async_mapped_file_smoke: OK\n";
+  return 0;
+}
@@ -0,0 +1,667 @@
+/**
+ *
+ *  @file http_smoke_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include <vix/async/core/io_context.hpp>
+#include <vix/async/core/spawn.hpp>
+#include <vix/async/core/task.hpp>
+#include <vix/async/core/timer.hpp>
+#include <vix/async/http/client.hpp>
+#include <vix/async/http/parser.hpp>
+#include <vix/async/http/server.hpp>
+#include <vix/async/net/tcp.hpp>
+
+using namespace vix::async;
+using namespace vix::async::core;
+using namespace vix::async::http;
+
+static void parser_checks()
+{
+  request_head req;
+  [[maybe_unused]] auto r = parse_request("GET /a?b=1 HTTP/1.1\r\nHost: x\r\nX-Pad:  v  \r\n\r\nrest", req);
+  assert(r.status == parse_status::complete && r.size == 45);
+  assert(req.method == "GET" && req.target == "/a?b=1" && req.version_minor == 1);
+  assert(req.headers.size() == 2 && req.header("x-pad") == "v" && req.header("HOST") == "x");
+  assert(keep_alive(req));
+  assert(request_body(req)->kind == body_kind::none);
+
+  assert(parse_request("GET / HTTP/1.1\r\nHost: x\r\n", req).status == parse_status::incomplete);
+  assert(parse_request("GET / HTTP/2.0\r\n\r\n", req).status == parse_status::invalid);
+  assert(parse_request("GET  / HTTP/1.1\r\n\r\n", req).status == parse_status::invalid);
+  assert(parse_request("GET / HTTP/1.1\r\nBad Name: x\r\n\r\n", req).status == parse_status::invalid);
+  assert(parse_request("GET / HTTP/1.1\r\nA: b\r\n folded\r\n\r\n", req).status == parse_status::invalid);
+  assert(parse_request("\r\nGET / HTTP/1.0\r\n\r\n", req).status == parse_status::complete);
+  assert(req.version_minor == 0 && !keep_alive(req));
+
+  // Body framing, including the ambiguous cases that must be refused.
+  assert(parse_request_head("POST / HTTP/1.1\r\nContent-Length: 12", req));
+  assert(request_body(req)->kind == body_kind::length && request_body(req)->length == 12);
+  assert(parse_request_head("POST / HTTP/1.1\r\nTransfer-Encoding: gzip, chunked", req));
+  assert(request_body(req)->kind == body_kind::chunked);
+  assert(parse_request_head("POST / HTTP/1.1\r\nContent-Length: 1\r\nTransfer-Encoding: chunked", req));
+  assert(!request_body(req));
+  assert(parse_request_head("POST / HTTP/1.1\r\nContent-Length: 1\r\nContent-Length: 2", req));
+  assert(!request_body(req));
+  assert(parse_request_head("POST / HTTP/1.1\r\nContent-Length: -1", req));
+  assert(!request_body(req));
+
+  response_head res;
+  assert(parse_response("HTTP/1.1 404 Not Found\r\nConnection: close\r\n\r\n", res).status == parse_status::complete);
+  assert(res.status == 404 && res.reason == "Not Found" && !keep_alive(res));
+  assert(response_body(res, "GET")->kind == body_kind::until_close);
+  assert(response_body(res, "HEAD")->kind == body_kind::none);
+  assert(parse_response_head("HTTP/1.1 204", res) && res.reason.empty());
+  assert(parse_response_head("HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked", res));
+  assert(response_body(res, "GET")->kind == body_kind::chunked);
+  assert(!parse_response_head("HTTP/1.1 20 OK", res));
+
+  assert(has_token("keep-alive, Upgrade", "upgrade") && !has_token("keep-alive", "close"));
+  assert(reason_phrase(431) == "Request Header Fields Too Large");
+}
+
+static task<void> handle(const request &req, response &res)
+{
+  const auto target = req.head.target;
+  if (target == "/echo")
+  {
+    res.add_header("Content-Type", "text/plain");
+    res.body.assign(req.body);
+  }
+  else if (target == "/stream")
+  {
+    co_await res.async_write_chunk("hello ");
+    co_await res.async_write_chunk("streamed ");
+    co_await res.async_write_chunk("world");
+  }
+  else if (target == "/throw")
+  {
+    throw std::runtime_error("handler failure");
+  }
+  else if (target.starts_with("/p"))
+  {
+    res.body.assign(target);
+  }
+  else
+  {
+    res.status = 404;
+    res.body = "missing";
+  }
+}
+
+static std::string text(std::span<const std::byte> b)
+{
+  return {reinterpret_cast<const char *>(b.data()), b.size()};
+}
+
+static std::span<const std::byte> bytes(std::string_view s)
+{
+  return std::as_bytes(std::span<const char>(s.data(), s.size()));
+}
+
+/**
+ * @brief Send raw bytes and read until the server closes the connection.
+ */
+static task<std::string> raw_exchange(io_context &ctx, const net::tcp_endpoint &ep, std::string_view data)
+{
+  auto s = net::make_tcp_stream(ctx);
+  co_await s->async_connect(ep);
+  (void)co_await s->async_write(bytes(data));
+
+  std::string out;
+  std::array<std::byte, 4096> buf{};
+  for (;;)
+  {
+    std::size_t n = 0;
+    try
+    {
+      n = co_await s->async_read(buf);
+    }
+    catch (const std::system_error &)
+    {
+      break;
+    }
+    if (n == 0)
+    {
+      break;
+    }
+    out.append(text(std::span<const std::byte>(buf.data(), n)));
+  }
+  co_return out;
+}
+
+[[maybe_unused]] static std::size_t count(std::string_view hay, std::string_view needle)
+{
+  std::size_t n = 0;
+  for (auto pos = hay.find(needle); pos != std::string_view::npos; pos = hay.find(needle, pos + 1))
+  {
+    ++n;
+  }
+  return n;
+}
+
+static task<void> exchanges(io_context &ctx, net::tcp_listener &listener, std::uint16_t port)
+{
+  const net::tcp_endpoint ep{"127.0.0.1", port};
+  client cl(ctx);
+
+  // Plain GET, then a POST on the same pooled connection.
+  {
+    [[maybe_unused]] auto r = co_await cl.async_get(ep, "/nope");
+    assert(r.status == 404 && r.reason == "Not Found" && r.body == "missing");
+    assert(r.header("content-length") == "7");
+    assert(cl.idle_connections() == 1);
+
+    client_request req;
+    req.method = "POST";
+    req.target = "/echo";
+    req.body = std::string(100000, 'x');
+    [[maybe_unused]] auto e = co_await cl.async_request(ep, req);
+    assert(e.status == 200 && e.body == req.body && e.header("Content-Type") == "text/plain");
+    assert(cl.idle_connections() == 1);
+  }
+
+  // Streamed response decoded from chunked encoding.
+  {
+    [[maybe_unused]] auto r = co_await cl.async_get(ep, "/stream");
+    assert(r.status == 200 && r.body == "hello streamed world");
+    assert(r.header("transfer-encoding") == "chunked");
+  }
+
+  // HEAD gets headers only and keeps the connection usable.
+  {
+    client_request req;
+    req.method = "HEAD";
+    req.target = "/p1";
+    [[maybe_unused]] auto r = co_await cl.async_request(ep, req);
+    assert(r.status == 200 && r.body.empty() && r.header("content-length") == "3");
+    [[maybe_unused]] auto g = co_await cl.async_get(ep, "/p2");
+    assert(g.body == "/p2");
+  }
+
+  // A failing handler yields 500 and closes the connection.
+  {
+    cl.close_idle();
+    [[maybe_unused]] auto r = co_await cl.async_get(ep, "/throw");
+    assert(r.status == 500 && r.header("connection") == "close");
+    assert(cl.idle_connections() == 0);
+  }
+
+  // Pipelined requests all get answered, in order.
+  {
+    std::string batch;
+    for (int i = 0; i < 10; ++i)
+    {
+      batch += "GET /p" + std::to_string(i) + " HTTP/1.1\r\nHost: x\r\n\r\n";
+    }
+    batch += "GET /plast HTTP/1.1\r\nHost: x\r\nConnection: close\r\n\r\n";
+    [[maybe_unused]] const auto out = co_await raw_exchange(ctx, ep, batch);
+    assert(count(out, "HTTP/1.1 200 OK\r\n") == 11);
+    assert(out.find("/p0") < out.find("/p9") && out.find("/p9") < out.find("/plast"));
+  }
+
+  // Chunked request body.
+  {
+    const std::string req =
+        "POST /echo HTTP/1.1\r\nHost: x\r\nTransfer-Encoding: chunked\r\nConnection: close\r\n\r\n"
+        "5\r\nhello\r\n6;ext=1\r\n world\r\n0\r\n\r\n";
+    [[maybe_unused]] const auto out = co_await raw_exchange(ctx, ep, req);
+    assert(out.starts_with("HTTP/1.1 200 OK\r\n"));
+    assert(out.find("Content-Length: 11\r\n") != std::string::npos);
+    assert(out.ends_with("\r\n\r\nhello world"));
+  }
+
+  // HTTP/1.0 closes after the response; streaming falls back to raw bytes.
+  {
+    [[maybe_unused]] const auto out = co_await raw_exchange(ctx, ep, "GET /stream HTTP/1.0\r\n\r\n");
+    assert(out.find("Connection: close\r\n") != std::string::npos);
+    assert(out.find("Transfer-Encoding") == std::string::npos);
+    assert(out.ends_with("\r\n\r\nhello streamed world"));
+  }
+
+  // Malformed and ambiguous requests are refused.
+  {
+    [[maybe_unused]] const auto bad = co_await raw_exchange(ctx, ep, "GET / HTTP/1.1\r\nBad Header\r\n\r\n");
+    assert(bad.starts_with("HTTP/1.1 400 Bad Request\r\n"));
+
+    [[maybe_unused]] const auto smuggle = co_await raw_exchange(
+        ctx, ep,
+        "POST /echo HTTP/1.1\r\nContent-Length: 3\r\nTransfer-Encoding: chunked\r\n\r\n0\r\n\r\n");
+    assert(smuggle.starts_with("HTTP/1.1 400 Bad Request\r\n"));
+
+    const std::string oversized =
+        "GET / HTTP/1.1\r\nX-Big: " + std::string(ASYNC_FRAME_BUFFER_SIZE, 'a') + "\r\n\r\n";
+    [[maybe_unused]] const auto big = co_await raw_exchange(ctx, ep, oversized);
+    assert(big.starts_with("HTTP/1.1 431 "));
+  }
+
+  cl.close_idle();
+  listener.close();
+}
+
+/**
+ * @brief Listen on the first free loopback port of a per-process range.
+ *
+ * @return The port, or 0 if none could be bound.
+ */
+static task<std::uint16_t> listen_any(io_context &ctx, std::unique_ptr<net::tcp_listener> &listener, std::uint16_t offset)
+{
+  const auto base = static_cast<std::uint16_t>(20000 + ::getpid() % 20000 + offset);
+  for (std::uint16_t i = 0; i < 16; ++i)
+  {
+    const net::tcp_endpoint bind_ep{"127.0.0.1", static_cast<std::uint16_t>(base + i)};
+    try
+    {
+      co_await listener->async_listen(bind_ep);
+      co_return bind_ep.port;
+    }
+    catch (const std::system_error &)
+    {
+      listener = net::make_tcp_listener(ctx);
+    }
+  }
+  co_return 0;
+}
+
+static task<void> serve(server &srv, net::tcp_listener &listener, std::shared_ptr<bool> served)
+{
+  co_await srv.async_serve(listener);
+  *served = true;
+}
+
+/**
+ * @brief Wait until the server has no connection left, for at most limit.
+ */
+static task<bool> drained(io_context &ctx, server &srv, std::chrono::milliseconds limit)
+{
+  const auto until = std::chrono::steady_clock::now() + limit;
+  while (srv.active_connections() != 0 && std::chrono::steady_clock::now() < until)
+  {
+    auto tick = ctx.timers().sleep_for(std::chrono::milliseconds(5));
+    co_await std::move(tick);
+  }
+  co_return srv.active_connections() == 0;
+}
+
+/**
+ * @brief Send one GET on an open connection and read its whole response.
+ *
+ * Relies on the test handler echoing the target as the body.
+ */
+static task<bool> keep_alive_get(net::tcp_stream &s, std::string target)
+{
+  const std::string req = "GET " + target + " HTTP/1.1\r\nHost: x\r\n\r\n";
+  (void)co_await s.async_write(bytes(req));
+
+  std::string out;
+  std::array<std::byte, 1024> buf{};
+  while (!out.ends_with("\r\n\r\n" + target))
+  {
+    std::size_t n = 0;
+    try
+    {
+      n = co_await s.async_read(buf);
+    }
+    catch (const std::system_error &)
+    {
+    }
+    if (n == 0)
+    {
+      co_return false;
+    }
+    out.append(text(std::span<const std::byte>(buf.data(), n)));
+  }
+  co_return out.starts_with("HTTP/1.1 200 OK\r\n");
+}
+
+// Silent peers are dropped: mid-head by header_timeout, after an error
+// response by linger_timeout.
+static task<void> timeouts(io_context &ctx)
+{
+  server_options opts;
+  opts.header_timeout = std::chrono::milliseconds(100);
+  opts.linger_timeout = std::chrono::milliseconds(100);
+  server srv(ctx, handle, opts);
+
+  auto listener = net::make_tcp_listener(ctx);
+  auto bound = listen_any(ctx, listener, 16);
+  const std::uint16_t port = co_await std::move(bound);
+  assert(port != 0);
+  const net::tcp_endpoint ep{"127.0.0.1", port};
+
+  auto served = std::make_shared<bool>(false);
+  spawn_detached(ctx, serve(srv, *listener, served));
+
+  // Incomplete head, then nothing: the server closes without answering.
+  {
+    auto s = net::make_tcp_stream(ctx);
+    co_await s->async_connect(ep);
+    (void)co_await s->async_write(bytes("GET / HTTP/1.1\r\nHost: x\r\n"));
+
+    std::array<std::byte, 256> buf{};
+    [[maybe_unused]] std::size_t n = 0;
+    try
+    {
+      n = co_await s->async_read(buf);
+    }
+    catch (const std::system_error &)
+    {
+    }
+    assert(n == 0);
+    auto wait = drained(ctx, srv, std::chrono::seconds(5));
+    [[maybe_unused]] const bool gone = co_await std::move(wait);
+    assert(gone);
+  }
+
+  // Keep-alive requests re-arm the connection's one deadline: no timer
+  // entry per request, and the connection outlives several header_timeouts
+  // while requests keep coming.
+  {
+    auto s = net::make_tcp_stream(ctx);
+    co_await s->async_connect(ep);
+
+    [[maybe_unused]] const auto before = ctx.metrics().timers.scheduled;
+    for (int i = 0; i < 20; ++i)
+    {
+      auto get = keep_alive_get(*s, "/p" + std::to_string(i));
+      [[maybe_unused]] const bool ok = co_await std::move(get);
+      assert(ok);
+    }
+#if ASYNC_ENABLE_METRICS
+    assert(ctx.metrics().timers.scheduled - before <= 1);
+#endif
+
+    for (int i = 0; i < 5; ++i)
+    {
+      auto pause = ctx.timers().sleep_for(std::chrono::milliseconds(40));
+      co_await std::move(pause);
+      auto get = keep_alive_get(*s, "/pslow" + std::to_string(i));
+      [[maybe_unused]] const bool ok = co_await std::move(get);
+      assert(ok);
+    }
+
+    // Idle: closed once header_timeout passes.
+    std::array<std::byte, 16> buf{};
+    [[maybe_unused]] std::size_t n = 0;
+    try
+    {
+      n = co_await s->async_read(buf);
+    }
+    catch (const std::system_error &)
+    {
+    }
+    assert(n == 0);
+  }
+
+  // Error response, then a peer that neither reads further nor closes.
+  {
+    auto s = net::make_tcp_stream(ctx);
+    co_await s->async_connect(ep);
+    (void)co_await s->async_write(bytes("GET / HTTP/1.1\r\nBad Header\r\n\r\n"));
+    auto wait = drained(ctx, srv, std::chrono::seconds(5));
+    [[maybe_unused]] const bool gone = co_await std::move(wait);
+    assert(gone);
+  }
+
+  listener->close();
+  while (!*served)
+  {
+    auto tick = ctx.timers().sleep_for(std::chrono::milliseconds(1));
+    co_await std::move(tick);
+  }
+}
+
+/**
+ * @brief What a scripted peer saw: connections accepted, request lines read.
+ */
+struct peer_log
+{
+  int connections{0};
+  std::vector<std::string> requests;
+
+  /** @brief Peer coroutines still running (accept loop and connections). */
+  int live{0};
+};
+
+// Answers "GET /ok"; reads anything else in full, then closes unanswered.
+static task<void> scripted_exchange(net::tcp_stream &s, peer_log &log)
+{
+  std::string in;
+  std::array<std::byte, 4096> buf{};
+  try
+  {
+    for (;;)
+    {
+      std::size_t end = in.find("\r\n\r\n");
+      while (end == std::string::npos)
+      {
+        const std::size_t n = co_await s.async_read(buf);
+        if (n == 0)
+        {
+          co_return;
+        }
+        in.append(text(std::span<const std::byte>(buf.data(), n)));
+        end = in.find("\r\n\r\n");
+      }
+
+      std::size_t length = 0;
+      if (const auto cl = in.find("Content-Length: "); cl < end)
+      {
+        length = std::stoul(in.substr(cl + 16));
+      }
+      while (in.size() < end + 4 + length)
+      {
+        const std::size_t n = co_await s.async_read(buf);
+        if (n == 0)
+        {
+          co_return;
+        }
+        in.append(text(std::span<const std::byte>(buf.data(), n)));
+      }
+
+      const std::string line = in.substr(0, in.find("\r\n"));
+      log.requests.push_back(line);
+      in.erase(0, end + 4 + length);
+
+      if (!line.starts_with("GET /ok "))
+      {
+        s.close();
+        co_return;
+      }
+      (void)co_await s.async_write(bytes("HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok"));
+    }
+  }
+  catch (const std::system_error &)
+  {
+  }
+}
+
+// One scripted connection; scripted_accept() counted it in log->live.
+static task<void> scripted_conn(std::unique_ptr<net::tcp_stream> s, std::shared_ptr<peer_log> log)
+{
+  auto exchange = scripted_exchange(*s, *log);
+  co_await std::move(exchange);
+  --log->live;
+}
+
+static task<void> scripted_accept(io_context &ctx, net::tcp_listener &listener, std::shared_ptr<peer_log> log)
+{
+  ++log->live;
+  try
+  {
+    for (;;)
+    {
+      auto s = co_await listener.async_accept();
+      ++log->connections;
+      ++log->live;
+      spawn_detached(ctx, scripted_conn(std::move(s), log));
+    }
+  }
+  catch (const std::system_error &)
+  {
+  }
+  --log->live;
+}
+
+[[maybe_unused]] static std::size_t count_requests(const peer_log &log, std::string_view line)
+{
+  std::size_t n = 0;
+  for (const auto &r : log.requests)
+  {
+    if (r == line)
+    {
+      ++n;
+    }
+  }
+  return n;
+}
+
+// A reused connection that dies after the request went out is retried only
+// for idempotent methods: the peer may already have acted on a POST.
+static task<void> stale_retries(io_context &ctx)
+{
+  auto listener = net::make_tcp_listener(ctx);
+  auto bound = listen_any(ctx, listener, 32);
+  const std::uint16_t port = co_await std::move(bound);
+  assert(port != 0);
+  const net::tcp_endpoint ep{"127.0.0.1", port};
+
+  auto log = std::make_shared<peer_log>();
+  spawn_detached(ctx, scripted_accept(ctx, *listener, log));
+
+  client cl(ctx);
+  [[maybe_unused]] auto warm = co_await cl.async_get(ep, "/ok");
+  assert(warm.status == 200 && cl.idle_connections() == 1);
+
+  client_request post;
+  post.method = "POST";
+  post.target = "/charge";
+  post.body = "abc";
+  [[maybe_unused]] bool failed = false;
+  try
+  {
+    (void)co_await cl.async_request(ep, post);
+  }
+  catch (const std::system_error &)
+  {
+    failed = true;
+  }
+  assert(failed);
+
+  auto settle = ctx.timers().sleep_for(std::chrono::milliseconds(100));
+  co_await std::move(settle);
+  assert(count_requests(*log, "POST /charge HTTP/1.1") == 1);
+  assert(log->connections == 1);
+
+  // The same failure on a GET is retried once on a fresh connection.
+  [[maybe_unused]] auto again = co_await cl.async_get(ep, "/ok");
+  assert(again.status == 200 && cl.idle_connections() == 1);
+  failed = false;
+  try
+  {
+    (void)co_await cl.async_get(ep, "/drop");
+  }
+  catch (const std::system_error &)
+  {
+    failed = true;
+  }
+  assert(failed);
+  assert(count_requests(*log, "GET /drop HTTP/1.1") == 2);
+  assert(log->connections == 3);
+
+  cl.close_idle();
+  listener->close();
+  while (log->live != 0)
+  {
+    auto tick = ctx.timers().sleep_for(std::chrono::milliseconds(1));
+    co_await std::move(tick);
+  }
+}
+
+static task<void> run(io_context &ctx)
+{
+  parser_checks();
+
+  server srv(ctx, handle);
+  auto listener = net::make_tcp_listener(ctx);
+  auto bound = listen_any(ctx, listener, 0);
+  const std::uint16_t port = co_await std::move(bound);
+  assert(port != 0);
+
+  auto served = std::make_shared<bool>(false);
+  spawn_detached(ctx, serve(srv, *listener, served));
+
+  auto talk = exchanges(ctx, *listener, port);
+  co_await std::move(talk);
+
+  // The accept loop ends with the listener; connections once the client closed them.
+  while (!*served || srv.active_connections() != 0)
+  {
+    auto tick = ctx.timers().sleep_for(std::chrono::milliseconds(1));
+    co_await std::move(tick);
+  }
+
+  auto limits = timeouts(ctx);
+  co_await std::move(limits);
+
+  auto retries = stale_retries(ctx);
+  co_await std::move(retries);
+}
+
+int main()
+{
+  io_context ctx;
+  std::thread loop([&]()
+                   { ctx.run(); });
+
+  auto done = std::make_shared<std::promise<void>>();
+  auto fut = done->get_future();
+
+  auto wrapper = [done, &ctx]() -> task<void>
+  {
+    try
+    {
+      co_await run(ctx);
+      done->set_value();
+    }
+    catch (...)
+    {
+      done->set_exception(std::current_exception());
+    }
+  };
+  std::move(wrapper()).start(ctx.get_scheduler());
+
+  fut.get();
+
+  ctx.stop();
+  loop.join();
+
+  std::cout << "async_http_smoke: OK\n";
+  return 0;
+}
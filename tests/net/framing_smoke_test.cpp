@@ -0,0 +1,376 @@
+/**
+ *
+ *  @file framing_smoke_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <vix/async/core/cancel.hpp>
+#include <vix/async/core/error.hpp>
+#include <vix/async/core/io_context.hpp>
+#include <vix/async/core/task.hpp>
+#include <vix/async/detail/scan.hpp>
+#include <vix/async/net/buffer_pool.hpp>
+#include <vix/async/net/framing.hpp>
+#include <vix/async/net/tcp.hpp>
+
+using namespace vix::async::core;
+using namespace vix::async::net;
+
+/**
+ * In-memory stream: reads hand out the scripted input in chunks of at
+ * most chunk bytes, writes are appended to output.
+ */
+class memory_stream final : public tcp_stream
+{
+public:
+  memory_stream(std::string input, std::size_t chunk)
+      : input_(std::move(input)), chunk_(chunk)
+  {
+  }
+
+  task<void> async_connect(const tcp_endpoint &, cancel_token) override
+  {
+    co_return;
+  }
+
+  task<std::size_t> async_read(std::span<std::byte> buf, cancel_token) override
+  {
+    ++reads;
+    const std::size_t n = std::min({buf.size(), chunk_, input_.size() - pos_});
+    std::memcpy(buf.data(), input_.data() + pos_, n);
+    pos_ += n;
+    co_return n;
+  }
+
+  task<std::size_t> async_write(std::span<const std::byte> buf, cancel_token) override
+  {
+    output.append(reinterpret_cast<const char *>(buf.data()), buf.size());
+    co_return buf.size();
+  }
+
+  void close() noexcept override {}
+  bool is_open() const noexcept override { return true; }
+
+  std::string output;
+  std::size_t reads{0};
+
+private:
+  std::string input_;
+  std::size_t chunk_;
+  std::size_t pos_{0};
+};
+
+static std::span<const std::byte> bytes(std::string_view s)
+{
+  return std::as_bytes(std::span<const char>(s.data(), s.size()));
+}
+
+[[maybe_unused]] static std::string text(std::span<const std::byte> b)
+{
+  return std::string(reinterpret_cast<const char *>(b.data()), b.size());
+}
+
+/**
+ * Every scan level the CPU supports must agree with std::string_view::find
+ * for all alignments, lengths and tails. The alphabet is tiny so that
+ * partial matches are frequent.
+ */
+static void scan_checks()
+{
+  namespace d = vix::async::detail;
+  const d::simd_level levels[] = {d::simd_level::scalar, d::simd_level::sse2, d::simd_level::avx2, d::simd_level::neon};
+
+  std::mt19937 rng(7);
+  const std::string_view alphabet = "ab\r\n";
+  std::string pool(512, 'a');
+  for (auto &c : pool)
+  {
+    c = alphabet[rng() % alphabet.size()];
+  }
+
+  std::vector<std::string> patterns{"", "\n", "\r\n", "\r\n\r\n", "ab", "aab", std::string(40, 'a')};
+  for (int i = 0; i < 16; ++i)
+  {
+    std::string p(1 + rng() % 8, 'a');
+    for (auto &c : p)
+    {
+      c = alphabet[rng() % alphabet.size()];
+    }
+    patterns.push_back(std::move(p));
+  }
+
+  for (const auto level : levels)
+  {
+    if (!d::scan_supported(level))
+    {
+      continue;
+    }
+
+    for (std::size_t offset = 0; offset < 33; ++offset)
+    {
+      for (std::size_t size = 0; offset + size <= pool.size(); size += 1 + size / 16)
+      {
+        const std::string_view hay(pool.data() + offset, size);
+        for (const auto &p : patterns)
+        {
+          const std::size_t want = std::min(hay.find(p), hay.size());
+          const std::size_t got = d::scan_pattern(level, hay.data(), hay.size(), p);
+          if (got != want)
+          {
+            std::cerr << "scan_pattern(" << d::to_string(level) << ") offset=" << offset
+                      << " size=" << size << " pattern.size=" << p.size()
+                      << ": got " << got << ", want " << want << "\n";
+            std::abort();
+          }
+        }
+      }
+    }
+
+    // A single match at every position, including the last vector's tail.
+    std::string zeros(300, '\0');
+    for (std::size_t at = 0; at + 4 <= zeros.size(); ++at)
+    {
+      zeros.replace(at, 4, "\r\n\r\n");
+      if (d::scan_pattern(level, zeros.data(), zeros.size(), "\r\n\r\n") != at ||
+          d::scan_byte(level, zeros.data(), zeros.size(), '\n') != at + 1)
+      {
+        std::cerr << "scan(" << d::to_string(level) << ") missed a match at " << at << "\n";
+        std::abort();
+      }
+      zeros.replace(at, 4, 4, '\0');
+    }
+  }
+
+  assert(d::find("GET / HTTP/1.1\r\n\r\n", "\r\n\r\n") == 14);
+  assert(d::find("a\r\nb\r\n", "\r\n", 2) == 4);
+  assert(d::find("abc", "\r\n") == std::string_view::npos);
+  assert(d::find("abc", "", 3) == 3);
+  assert(d::find("abc", "a", 4) == std::string_view::npos);
+  assert(d::scan_supported(d::scan_level()));
+}
+
+template <typename Fn>
+static task<std::error_code> error_of(Fn fn)
+{
+  try
+  {
+    co_await fn();
+  }
+  catch (const std::system_error &e)
+  {
+    co_return e.code();
+  }
+  co_return std::error_code{};
+}
+
+static task<void> run()
+{
+  // Round trip through the writers and readers, one byte per read.
+  for (const length_prefix prefix : {length_prefix::varint, length_prefix::u16_be, length_prefix::u32_be})
+  {
+    memory_stream out("", 0);
+    const std::string big(300, 'x');
+    co_await async_write_frame(out, bytes("hello"), prefix);
+    co_await async_write_frame(out, bytes(""), prefix);
+    co_await async_write_frame(out, bytes(big), prefix);
+
+    memory_stream in(out.output, 1);
+    buffered_reader r(in, 8);
+    length_prefixed_reader frames(r, prefix);
+
+    [[maybe_unused]] auto f1 = co_await frames.async_read_frame();
+    assert(f1 && text(*f1) == "hello");
+    [[maybe_unused]] auto f2 = co_await frames.async_read_frame();
+    assert(f2 && f2->empty());
+    [[maybe_unused]] auto f3 = co_await frames.async_read_frame();
+    assert(f3 && text(*f3) == big);
+    assert(r.capacity() >= big.size());
+    [[maybe_unused]] auto end = co_await frames.async_read_frame();
+    assert(!end);
+  }
+
+  // Many small frames in one read.
+  {
+    memory_stream out("", 0);
+    for (int i = 0; i < 100; ++i)
+    {
+      co_await async_write_frame(out, bytes("ping"));
+    }
+
+    memory_stream in(out.output, 1 << 20);
+    buffered_reader r(in);
+    length_prefixed_reader frames(r);
+    for (int i = 0; i < 100; ++i)
+    {
+      [[maybe_unused]] auto f = co_await frames.async_read_frame();
+      assert(f && text(*f) == "ping");
+    }
+    assert(in.reads == 1);
+  }
+
+  // Varint boundaries.
+  {
+    std::array<std::byte, max_length_prefix_size> buf;
+    assert(encode_length_prefix(length_prefix::varint, 127, buf) == 1);
+    assert(encode_length_prefix(length_prefix::varint, 128, buf) == 2);
+    assert(encode_length_prefix(length_prefix::varint, ~0ull, buf) == 10);
+    (void)buf;
+
+    [[maybe_unused]] const auto ec = co_await error_of([&]() -> task<void>
+                                                       {
+                                                         memory_stream s("", 0);
+                                                         const std::string payload(70000, 'a');
+                                                         co_await async_write_frame(s, bytes(payload), length_prefix::u16_be); });
+    assert(ec == make_error_code(errc::overflow));
+  }
+
+  // Size limit, truncation and malformed prefixes.
+  {
+    memory_stream out("", 0);
+    const std::string payload(100, 'a');
+    co_await async_write_frame(out, bytes(payload));
+
+    [[maybe_unused]] auto ec = co_await error_of([&]() -> task<void>
+                                                 {
+                                                   memory_stream in(out.output, 16);
+                                                   buffered_reader r(in);
+                                                   length_prefixed_reader frames(r, length_prefix::varint, 99);
+                                                   (void)co_await frames.async_read_frame(); });
+    assert(ec == make_error_code(errc::overflow));
+
+    ec = co_await error_of([&]() -> task<void>
+                           {
+                             memory_stream in(out.output.substr(0, 50), 16);
+                             buffered_reader r(in);
+                             length_prefixed_reader frames(r);
+                             (void)co_await frames.async_read_frame(); });
+    assert(ec == make_error_code(errc::closed));
+
+    ec = co_await error_of([&]() -> task<void>
+                           {
+                             memory_stream in(std::string(11, '\xff'), 16);
+                             buffered_reader r(in);
+                             length_prefixed_reader frames(r);
+                             (void)co_await frames.async_read_frame(); });
+    assert(ec == make_error_code(errc::overflow));
+  }
+
+  // Delimited frames, including a delimiter split across reads.
+  {
+    memory_stream out("", 0);
+    co_await async_write_delimited(out, bytes("GET / HTTP/1.1"), "\r\n");
+    co_await async_write_delimited(out, bytes("Host: x"), "\r\n");
+    co_await async_write_delimited(out, bytes(""), "\r\n");
+    assert(out.output == "GET / HTTP/1.1\r\nHost: x\r\n\r\n");
+
+    for (const std::size_t chunk : {std::size_t{1}, std::size_t{3}, std::size_t{64}})
+    {
+      memory_stream in(out.output, chunk);
+      buffered_reader r(in, 4);
+      delimited_reader lines(r, "\r\n");
+
+      [[maybe_unused]] auto l1 = co_await lines.async_read_frame();
+      assert(l1 && text(*l1) == "GET / HTTP/1.1");
+      [[maybe_unused]] auto l2 = co_await lines.async_read_frame();
+      assert(l2 && text(*l2) == "Host: x");
+      [[maybe_unused]] auto l3 = co_await lines.async_read_frame();
+      assert(l3 && l3->empty());
+      [[maybe_unused]] auto end = co_await lines.async_read_frame();
+      assert(!end);
+    }
+
+    [[maybe_unused]] auto ec = co_await error_of([&]() -> task<void>
+                                                 {
+                                                   memory_stream in(std::string(64, 'a') + "\n", 7);
+                                                   buffered_reader r(in, 8);
+                                                   delimited_reader lines(r, "\n", 32);
+                                                   (void)co_await lines.async_read_frame(); });
+    assert(ec == make_error_code(errc::overflow));
+
+    ec = co_await error_of([&]() -> task<void>
+                           {
+                             memory_stream in("no newline", 4);
+                             buffered_reader r(in);
+                             delimited_reader lines(r);
+                             (void)co_await lines.async_read_frame(); });
+    assert(ec == make_error_code(errc::closed));
+  }
+
+  // Pooled read buffers are recycled.
+  {
+    buffer_pool pool(64, 4);
+    {
+      memory_stream in("a\nb\n", 64);
+      buffered_reader r(in, pool);
+      assert(r.capacity() == 64);
+      delimited_reader lines(r);
+      [[maybe_unused]] auto a = co_await lines.async_read_frame();
+      assert(a && text(*a) == "a");
+    }
+    assert(pool.cached() == 1);
+    {
+      [[maybe_unused]] auto b1 = pool.acquire();
+      assert(pool.cached() == 0 && b1.bytes().size() == 64);
+    }
+    assert(pool.cached() == 1);
+  }
+}
+
+int main()
+{
+  scan_checks();
+
+  io_context ctx;
+  std::thread loop([&]()
+                   { ctx.run(); });
+
+  auto done = std::make_shared<std::promise<void>>();
+  auto fut = done->get_future();
+
+  auto wrapper = [done]() -> task<void>
+  {
+    try
+    {
+      co_await run();
+      done->set_value();
+    }
+    catch (...)
+    {
+      done->set_exception(std::current_exception());
+    }
+  };
+  std::move(wrapper()).start(ctx.get_scheduler());
+
+  fut.get();
+
+  ctx.stop();
+  loop.join();
+
+  std::cout << "async_framing_smoke: OK\n";
+  return 0;
+}
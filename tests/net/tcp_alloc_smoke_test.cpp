@@ -0,0 +1,184 @@
+/**
+ *
+ *  @file tcp_alloc_smoke_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <span>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include <unistd.h>
+
+#include <vix/async/core/io_context.hpp>
+#include <vix/async/core/task.hpp>
+#include <vix/async/core/when.hpp>
+#include <vix/async/net/tcp.hpp>
+
+using namespace vix::async::core;
+using namespace vix::async::net;
+
+// Every heap allocation of the process, on any thread.
+static std::atomic<std::uint64_t> g_allocs{0};
+
+void *operator new(std::size_t n)
+{
+  g_allocs.fetch_add(1, std::memory_order_relaxed);
+  if (void *p = std::malloc(n != 0 ? n : 1))
+  {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+/**
+ * Task frames still come from the heap: one per I/O method call, which
+ * awaits the Asio operation directly.
+ */
+constexpr std::uint64_t frames_per_op = 1;
+
+static task<std::unique_ptr<tcp_stream>> accept_one(tcp_listener &listener)
+{
+  co_return co_await listener.async_accept();
+}
+
+static task<std::unique_ptr<tcp_stream>> connect_to(io_context &ctx, std::uint16_t port)
+{
+  auto s = make_tcp_stream(ctx);
+  const tcp_endpoint ep{"127.0.0.1", port};
+  co_await s->async_connect(ep);
+  co_return s;
+}
+
+// Counts the I/O calls it makes, in case a read comes back short.
+static task<void> ping(tcp_stream &out, tcp_stream &in, std::span<std::byte> buf, std::uint64_t &ops)
+{
+  std::size_t sent = co_await out.async_write(buf);
+  ++ops;
+  while (sent > 0)
+  {
+    sent -= co_await in.async_read(buf.subspan(0, sent));
+    ++ops;
+  }
+}
+
+static task<void> run(io_context &ctx)
+{
+  auto listener = make_tcp_listener(ctx);
+
+  const auto base = static_cast<std::uint16_t>(30000 + ::getpid() % 20000);
+  std::uint16_t port = 0;
+  for (std::uint16_t i = 0; i < 16 && port == 0; ++i)
+  {
+    const tcp_endpoint bind_ep{"127.0.0.1", static_cast<std::uint16_t>(base + i)};
+    try
+    {
+      co_await listener->async_listen(bind_ep);
+      port = bind_ep.port;
+    }
+    catch (const std::system_error &)
+    {
+      listener = make_tcp_listener(ctx);
+    }
+  }
+  assert(port != 0);
+
+  auto pair = when_all(ctx.get_scheduler(), accept_one(*listener), connect_to(ctx, port));
+  auto [server, client] = co_await std::move(pair);
+
+  std::array<std::byte, 64> buf{};
+
+  // Warm up: the reactor registers the sockets on their first operations
+  // and the scheduler queues reach their working size.
+  std::uint64_t ops = 0;
+  for (int i = 0; i < 100; ++i)
+  {
+    co_await ping(*client, *server, buf, ops);
+    co_await ping(*server, *client, buf, ops);
+  }
+
+  constexpr std::uint64_t rounds = 2000;
+  ops = 0;
+  const std::uint64_t before = g_allocs.load(std::memory_order_relaxed);
+  for (std::uint64_t i = 0; i < rounds; ++i)
+  {
+    co_await ping(*client, *server, buf, ops);
+    co_await ping(*server, *client, buf, ops);
+  }
+  const std::uint64_t allocs = g_allocs.load(std::memory_order_relaxed) - before;
+
+  // Exactly the task frames: two ping frames per round plus one per write
+  // or read. Anything more is an allocation on the I/O path. Checked
+  // without assert() so that release builds catch it too.
+  const std::uint64_t frames = rounds * 2 + ops * frames_per_op;
+  if (allocs != frames)
+  {
+    std::cerr << "async_tcp_alloc_smoke: " << allocs << " allocations, expected "
+              << frames << " task frames\n";
+    std::abort();
+  }
+
+  client->close();
+  server->close();
+  listener->close();
+}
+
+int main()
+{
+  io_context ctx;
+  std::thread loop([&]()
+                   { ctx.run(); });
+
+  auto done = std::make_shared<std::promise<void>>();
+  auto fut = done->get_future();
+
+  auto wrapper = [done, &ctx]() -> task<void>
+  {
+    try
+    {
+      co_await run(ctx);
+      done->set_value();
+    }
+    catch (...)
+    {
+      done->set_exception(std::current_exception());
+    }
+  };
+  std::move(wrapper()).start(ctx.get_scheduler());
+
+  fut.get();
+
+  ctx.stop();
+  loop.join();
+
+  std::cout << "async_tcp_alloc_smoke: OK\n";
+  return 0;
+}
@@ -0,0 +1,247 @@
+/**
+ *
+ *  @file process_smoke_test.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <cassert>
+#include <cerrno>
+#include <csignal>
+#include <cstddef>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <vix/async/core/cancel.hpp>
+#include <vix/async/core/error.hpp>
+#include <vix/async/core/io_context.hpp>
+#include <vix/async/core/task.hpp>
+#include <vix/async/process/process.hpp>
+
+using namespace vix::async::core;
+using namespace vix::async::process;
+
+static std::span<const std::byte> bytes(const std::string &s)
+{
+  return std::as_bytes(std::span<const char>(s.data(), s.size()));
+}
+
+static task<std::string> read_all(pipe_stream &p)
+{
+  std::string out;
+  std::byte buf[256];
+  for (;;)
+  {
+    const std::size_t n = co_await p.async_read(buf);
+    if (n == 0)
+    {
+      co_return out;
+    }
+    out.append(reinterpret_cast<const char *>(buf), n);
+  }
+}
+
+static process_options sh(std::string script)
+{
+  process_options o;
+  o.program = "sh";
+  o.args = {"-c", std::move(script)};
+  return o;
+}
+
+static task<void> run(io_context &ctx)
+{
+  // Exit code.
+  {
+    auto p = spawn(ctx, sh("exit 3"));
+    assert(p->pid() > 0);
+    assert(p->stdin_pipe() == nullptr && p->stdout_pipe() == nullptr);
+
+    [[maybe_unused]] const exit_status s = co_await p->async_wait();
+    assert(s.exited() && s.code == 3 && !s.success());
+
+    // Reaped: waiting again returns the cached status, kill is a no-op.
+    [[maybe_unused]] const exit_status again = co_await p->async_wait();
+    assert(again.code == 3);
+    p->kill(SIGKILL);
+  }
+
+  // stdin -> stdout round trip; closing stdin ends the child's input.
+  {
+    process_options o;
+    o.program = "cat";
+    o.in = stdio::pipe;
+    o.out = stdio::pipe;
+    auto p = spawn(ctx, o);
+
+    const std::string msg = "hello through a pipe\n";
+    [[maybe_unused]] const std::size_t n = co_await p->stdin_pipe()->async_write(bytes(msg));
+    assert(n == msg.size());
+    p->stdin_pipe()->close();
+    assert(!p->stdin_pipe()->is_open());
+
+    [[maybe_unused]] const std::string echoed = co_await read_all(*p->stdout_pipe());
+    assert(echoed == msg);
+
+    [[maybe_unused]] bool threw = false;
+    try
+    {
+      std::byte b[1];
+      (void)co_await p->stdout_pipe()->async_write(std::span<const std::byte>(b));
+    }
+    catch (const std::system_error &e)
+    {
+      threw = e.code() == make_error_code(errc::not_supported);
+    }
+    assert(threw);
+
+    [[maybe_unused]] const exit_status s = co_await p->async_wait();
+    assert(s.success());
+  }
+
+  // stderr capture, stdout to /dev/null.
+  {
+    auto o = sh("echo out; echo err >&2");
+    o.out = stdio::null;
+    o.err = stdio::pipe;
+    auto p = spawn(ctx, o);
+    assert(p->stdout_pipe() == nullptr);
+
+    [[maybe_unused]] const std::string err = co_await read_all(*p->stderr_pipe());
+    assert(err == "err\n");
+    [[maybe_unused]] const exit_status s = co_await p->async_wait();
+    assert(s.success());
+  }
+
+  // Environment and working directory.
+  {
+    auto o = sh("printf '%s:%s' \"$FOO\" \"$(pwd)\"");
+    o.env = std::vector<std::string>{"FOO=bar", "PATH=/usr/bin:/bin"};
+    o.cwd = "/";
+    o.out = stdio::pipe;
+    auto p = spawn(ctx, o);
+
+    [[maybe_unused]] const std::string out = co_await read_all(*p->stdout_pipe());
+    assert(out == "bar:/");
+    [[maybe_unused]] const exit_status s = co_await p->async_wait();
+    assert(s.success());
+  }
+
+  // Killed by a signal.
+  {
+    process_options o;
+    o.program = "sleep";
+    o.args = {"10"};
+    auto p = spawn(ctx, o);
+    p->kill(SIGKILL);
+
+    [[maybe_unused]] const exit_status s = co_await p->async_wait();
+    assert(!s.exited() && s.signal == SIGKILL && s.code == -1);
+  }
+
+  // Cancelling a wait leaves the child alone.
+  {
+    process_options o;
+    o.program = "sleep";
+    o.args = {"10"};
+    auto p = spawn(ctx, o);
+
+    cancel_source src;
+    src.request_cancel();
+    [[maybe_unused]] bool threw = false;
+    try
+    {
+      (void)co_await p->async_wait(src.token());
+    }
+    catch (const std::system_error &e)
+    {
+      threw = e.code() == cancelled_ec();
+    }
+    assert(threw);
+
+    p->kill(SIGTERM);
+    [[maybe_unused]] const exit_status s = co_await p->async_wait();
+    assert(s.signal == SIGTERM);
+  }
+
+  // Many concurrent children, no thread per child.
+  {
+    constexpr int count = 64;
+    std::vector<std::unique_ptr<async_process>> procs;
+    for (int i = 0; i < count; ++i)
+    {
+      procs.push_back(spawn(ctx, sh("exit " + std::to_string(i % 7))));
+    }
+    for (int i = 0; i < count; ++i)
+    {
+      [[maybe_unused]] const exit_status s = co_await procs[static_cast<std::size_t>(i)]->async_wait();
+      assert(s.code == i % 7);
+    }
+  }
+
+  // Dropping a running handle reaps the child in the background.
+  {
+    auto p = spawn(ctx, sh("sleep 0.05"));
+    p.reset();
+  }
+
+  // Missing program.
+  {
+    process_options o;
+    o.program = "vix-async-no-such-program";
+    [[maybe_unused]] bool threw = false;
+    try
+    {
+      (void)spawn(ctx, o);
+    }
+    catch (const std::system_error &e)
+    {
+      threw = e.code().value() == ENOENT;
+    }
+    assert(threw);
+  }
+}
+
+int main()
+{
+  io_context ctx;
+  std::thread loop([&]()
+                   { ctx.run(); });
+
+  auto done = std::make_shared<std::promise<void>>();
+  auto fut = done->get_future();
+
+  auto wrapper = [&ctx, done]() -> task<void>
+  {
+    try
+    {
+      co_await run(ctx);
+      done->set_value();
+    }
+    catch (...)
+    {
+      done->set_exception(std::current_exception());
+    }
+  };
+  std::move(wrapper()).start(ctx.get_scheduler());
+
+  fut.get();
+
+  ctx.stop();
+  loop.join();
+
+  std::cout << "async_process_smoke: OK\n";
+  return 0;
+}